@@ -308,77 +308,94 @@ public:
 		// grid point
 
 		//! Graph to construct
+		Graph gp;
 
-		Graph gp(g.size());
+		// Get the combinations of dimension d, in the order the edges are created
+
+		std::vector<comb<dim>> c;
+
+		for (long int d = dim-1 ; d >= dim_c ; d--)
+		{
+			std::vector<comb<dim>> c_d = hc.getCombinations_R(d);
+			c.insert(c.end(),c_d.begin(),c_d.end());
+		}
+
+		// Size of the face shared by the two vertices of an edge (communication weight)
+
+		std::vector<T> ele_sz(c.size());
+
+		for (size_t j = 0; j < c.size(); j++)
+		{
+			ele_sz[j] = 0;
+
+			// for each dimension multiply and reduce
+
+			for (size_t s = 0 ; s < dim ; s++)
+				ele_sz[j] += szd[s] * abs(c[j][s]);
+		}
+
+		typedef typename to_boost_vmpl<pos...>::type p;
 
 		/******************
 		 *
 		 * Create the edges and fill spatial
-		 * information properties
+		 * information properties, the graph is constructed
+		 * in compact form in parallel
 		 *
 		 ******************/
 
-		//! Construct a key iterator
-		grid_key_dx_iterator<dim> k_it(g);
+		// Number of edges of a vertex (the neighborhood vertices that exist)
 
-		//! Iterate through all the elements
+		auto n_edges = [&](size_t v)
+		{
+			grid_key_dx<dim> key = g.InvLinId(v);
+
+			size_t n_adj = 0;
+
+			for (size_t j = 0; j < c.size(); j++)
+			{
+				if (CheckExistence::valid(g.template LinId<CheckExistence>(key,c[j].getComb(),bc),g.size()) == true)
+				{n_adj++;}
+			}
+
+			return n_adj;
+		};
 
-		while (k_it.isNext())
+		// Fill the vertex properties and the edges of a vertex
+
+		auto fill = [&](size_t v, typename Graph::adjacency_writer & aw)
 		{
-			grid_key_dx<dim> key = k_it.get();
+			grid_key_dx<dim> key = g.InvLinId(v);
 
 			// Vertex object
 
-			auto obj = gp.vertex(g.LinId(key));
-
-			typedef typename to_boost_vmpl<pos...>::type p;
+			auto obj = gp.vertex(v);
 
 			// vertex spatial properties functor
 
-			fill_prop<dim, lin_id, T, decltype(gp.vertex(g.LinId(key))), typename to_boost_vmpl<pos...>::type, fill_prop_by_type<dim,sizeof...(pos), p, Graph, pos...>::value> flp(obj, szd, key, g, dom);
+			fill_prop<dim, lin_id, T, decltype(gp.vertex(v)), p, fill_prop_by_type<dim,sizeof...(pos), p, Graph, pos...>::value> flp(obj, szd, key, g, dom);
 
 			// fill properties
 
 			boost::mpl::for_each<boost::mpl::range_c<int, 0, sizeof...(pos)> >(flp);
 
-			// Get the combinations of dimension d
+			// for each combination calculate a safe linearization and create an edge
 
-			for (long int d = dim-1 ; d >= dim_c ; d--)
+			for (size_t j = 0; j < c.size(); j++)
 			{
-				// create the edges for that dimension
-
-				std::vector<comb<dim>> c = hc.getCombinations_R(d);
-
-				// for each combination calculate a safe linearization and create an edge
-
-				for (size_t j = 0; j < c.size(); j++)
-				{
-					// Calculate the element size
-
-					T ele_sz = 0;
+				// Calculate the end point vertex id
 
-					// for each dimension multiply and reduce
+				size_t end_v = g.template LinId<CheckExistence>(key,c[j].getComb(),bc);
 
+				if (CheckExistence::valid(end_v,g.size()) == false)
+				{continue;}
 
-					for (size_t s = 0 ; s < dim ; s++)
-						ele_sz += szd[s] * abs(c[j][s]);
-
-					// Calculate the end point vertex id
-					// Calculate the start point id
-
-					size_t start_v = g.LinId(key);
-
-					size_t end_v = g.template LinId<CheckExistence>(key,c[j].getComb(),bc);
-
-					// Add an edge and set the the edge property to the size of the face (communication weight)
-					gp.template addEdge<CheckExistence>(start_v, end_v).template get<se>() = ele_sz;
-				}
+				// Add an edge and set the the edge property to the size of the face (communication weight)
+				aw.addEdge(end_v).template get<se>() = ele_sz[j];
 			}
+		};
 
-			// Fill vertex properties
-
-			++k_it;
-		}
+		gp.buildCompact(g.size(),n_edges,fill);
 
 		return gp;
 	}
@@ -430,66 +447,80 @@ public:
 		// grid point
 
 		//! Graph to construct
+		Graph gp;
 
-		Graph gp(g.size());
+		// Get the combinations of dimension d, in the order the edges are created
+
+		std::vector<comb<dim>> c;
+
+		for (long int d = dim-1 ; d >= dim_c ; d--)
+		{
+			std::vector<comb<dim>> c_d = hc.getCombinations_R(d);
+			c.insert(c.end(),c_d.begin(),c_d.end());
+		}
+
+		typedef typename to_boost_vmpl<pos...>::type p;
 
 		/******************
 		 *
 		 * Create the edges and fill spatial
-		 * information properties
+		 * information properties, the graph is constructed
+		 * in compact form in parallel
 		 *
 		 ******************/
 
-		//! Construct a key iterator
-		grid_key_dx_iterator<dim> k_it(g);
+		// Number of edges of a vertex (the neighborhood vertices that exist)
 
-		//! Iterate through all the elements
+		auto n_edges = [&](size_t v)
+		{
+			grid_key_dx<dim> key = g.InvLinId(v);
 
-		while (k_it.isNext())
+			size_t n_adj = 0;
+
+			for (size_t j = 0; j < c.size(); j++)
+			{
+				if (CheckExistence::valid(g.template LinId<CheckExistence>(key,c[j].getComb(),bc),g.size()) == true)
+				{n_adj++;}
+			}
+
+			return n_adj;
+		};
+
+		// Fill the vertex properties and the edges of a vertex
+
+		auto fill = [&](size_t v, typename Graph::adjacency_writer & aw)
 		{
-			grid_key_dx<dim> key = k_it.get();
+			grid_key_dx<dim> key = g.InvLinId(v);
 
 			// Vertex object
-			auto obj = gp.vertex(g.LinId(key));
 
-			typedef typename to_boost_vmpl<pos...>::type p;
+			auto obj = gp.vertex(v);
 
 			// vertex spatial properties functor
 
-			fill_prop<dim, lin_id, T, decltype(gp.vertex(g.LinId(key))), typename to_boost_vmpl<pos...>::type, fill_prop_by_type<dim,sizeof...(pos), p, Graph, pos...>::value> flp(obj, szd, key, g, dom);
+			fill_prop<dim, lin_id, T, decltype(gp.vertex(v)), p, fill_prop_by_type<dim,sizeof...(pos), p, Graph, pos...>::value> flp(obj, szd, key, g, dom);
 
 			// fill properties
 
 			boost::mpl::for_each_ref<boost::mpl::range_c<int, 0, sizeof...(pos)> >(flp);
 
-			// Get the combinations of dimension d
+			// for each combination calculate a safe linearization and create an edge
 
-			for (long int d = dim-1 ; d >= dim_c ; d--)
+			for (size_t j = 0; j < c.size(); j++)
 			{
-				// create the edges for that dimension
+				// Calculate the end point vertex id
 
-				std::vector<comb<dim>> c = hc.getCombinations_R(d);
+				size_t end_v = g.template LinId<CheckExistence>(key,c[j].getComb(),bc);
 
-				// for each combination calculate a safe linearization and create an edge
+				if (CheckExistence::valid(end_v,g.size()) == false)
+				{continue;}
 
-				for (size_t j = 0; j < c.size(); j++)
-				{
-					// Calculate the end point vertex id
-					// Calculate the start point id
-
-					size_t start_v = g.LinId(key);
-
-					size_t end_v = g.template LinId<CheckExistence>(key,c[j].getComb(),bc);
-
-					// Add an edge and set the the edge property to the size of the face (communication weight)
-					gp.template addEdge<CheckExistence>(start_v, end_v);
-				}
+				// Add an edge
+				aw.addEdge(end_v);
 			}
+		};
 
-			// Fill vertex properties
-
-			++k_it;
-		}
+		gp.buildCompact(g.size(),n_edges,fill);
 
 		return gp;
 	}
@@ -10,6 +10,7 @@
 
 #include "config.h"
 #include "map_graph.hpp"
+#include "CartesianGraphFactory.hpp"
 #include "Point_test.hpp"
 
 BOOST_AUTO_TEST_SUITE( graph_test )
@@ -194,6 +195,307 @@ BOOST_AUTO_TEST_CASE( graph_use)
 	std::cout << "Graph unit test end" << "\n";
 }
 
+BOOST_AUTO_TEST_CASE( graph_slot_growth )
+{
+	Graph_CSR<aggregate<float>,aggregate<float>> g;
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		g.addVertex();
+		g.vertex(i).template get<0>() = i;
+	}
+
+	// more edges than the initial slots (16), the adjacency list is reallocated two times
+
+	for (size_t j = 0 ; j < 40 ; j++)
+	{
+		for (size_t i = 0 ; i < 100 ; i++)
+		{g.addEdge(i,(i+j+1)%100).template get<0>() = i*100 + j;}
+	}
+
+	BOOST_REQUIRE_EQUAL(g.getNVertex(),100ul);
+	BOOST_REQUIRE_EQUAL(g.getNEdge(),4000ul);
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		match &= g.vertex(i).template get<0>() == i;
+		match &= g.getNChilds(i) == 40;
+
+		for (size_t j = 0 ; j < 40 ; j++)
+		{
+			match &= g.getChild(i,j) == (i+j+1)%100;
+			match &= g.getChildEdge(i,j).template get<0>() == i*100 + j;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+/*! \brief Check that two graphs have the same vertices, adjacency lists and edge properties
+ *
+ * \param g1 first graph
+ * \param g2 second graph
+ *
+ * \return true if they match
+ *
+ */
+template<typename Graph> bool graph_same_adjacency(Graph & g1, Graph & g2)
+{
+	bool match = true;
+
+	match &= g1.getNVertex() == g2.getNVertex();
+	match &= g1.getNEdge() == g2.getNEdge();
+
+	if (match == false)	{return false;}
+
+	for (size_t i = 0 ; i < g1.getNVertex() ; i++)
+	{
+		match &= g1.vertex(i).template get<0>() == g2.vertex(i).template get<0>();
+		match &= g1.getNChilds(i) == g2.getNChilds(i);
+
+		if (match == false)	{return false;}
+
+		for (size_t j = 0 ; j < g1.getNChilds(i) ; j++)
+		{
+			match &= g1.getChild(i,j) == g2.getChild(i,j);
+			match &= g1.getChildEdge(i,j).template get<0>() == g2.getChildEdge(i,j).template get<0>();
+		}
+	}
+
+	return match;
+}
+
+BOOST_AUTO_TEST_CASE( graph_compact )
+{
+	typedef Graph_CSR<aggregate<float>,aggregate<float>> graph;
+
+	// large enough to use the parallel scan and sort
+	const size_t n_v = 20000;
+
+	// number of adjacent vertices of the vertex i, some vertices overflow the 16 initial slots
+	auto n_edges = [](size_t i) {return (i*7) % 23;};
+
+	graph g;
+
+	for (size_t i = 0 ; i < n_v ; i++)
+	{
+		g.addVertex();
+		g.vertex(i).template get<0>() = i;
+	}
+
+	for (size_t i = 0 ; i < n_v ; i++)
+	{
+		for (size_t j = 0 ; j < n_edges(i) ; j++)
+		{g.addEdge(i,(i*13 + j*31) % n_v).template get<0>() = i*100.0f + j;}
+	}
+
+	// Convert the slotted graph into compact form
+
+	graph gc = g.duplicate();
+	gc.compact();
+
+	BOOST_REQUIRE_EQUAL(g.isCompact(),false);
+	BOOST_REQUIRE_EQUAL(gc.isCompact(),true);
+	BOOST_REQUIRE_EQUAL(graph_same_adjacency(g,gc),true);
+
+	// edge iterator on the compact form
+
+	size_t n_it = 0;
+	auto eit = gc.getEdgeIterator();
+
+	while (eit.isNext())
+	{
+		n_it += (eit.target() == g.getChild(eit.source(),eit.get().pos_e));
+		++eit;
+	}
+
+	BOOST_REQUIRE_EQUAL(n_it,g.getNEdge());
+
+	// Move and copy assign a compact graph into an existing slotted graph
+
+	graph gm;
+	gm.addVertex();
+	gm.addEdge(0,0);
+	gm = gc.duplicate();
+
+	graph gcp;
+	gcp.addVertex();
+	gcp.addEdge(0,0);
+	gcp = gc;
+
+	BOOST_REQUIRE_EQUAL(gm.isCompact(),true);
+	BOOST_REQUIRE_EQUAL(gcp.isCompact(),true);
+	BOOST_REQUIRE_EQUAL(graph_same_adjacency(g,gm),true);
+	BOOST_REQUIRE_EQUAL(graph_same_adjacency(g,gcp),true);
+
+	// Construct the same graph in parallel from the number of edges of each vertex
+
+	graph gb;
+
+	gb.buildCompact(n_v,n_edges,[&gb](size_t i, graph::adjacency_writer & aw)
+	{
+		gb.vertex(i).template get<0>() = i;
+
+		for (size_t j = 0 ; j < (i*7) % 23 ; j++)
+		{aw.addEdge((i*13 + j*31) % n_v).template get<0>() = i*100.0f + j;}
+	});
+
+	BOOST_REQUIRE_EQUAL(gb.isCompact(),true);
+	BOOST_REQUIRE_EQUAL(graph_same_adjacency(g,gb),true);
+	BOOST_REQUIRE(gb == gc);
+
+	// Construct the same graph from a list of edges not ordered by source vertex
+
+	openfpm::vector<std::pair<size_t,size_t>> el;
+
+	for (size_t j = 0 ; j < 23 ; j++)
+	{
+		for (size_t i = 0 ; i < n_v ; i++)
+		{
+			if (j < n_edges(i))
+			{el.add(std::pair<size_t,size_t>(i,(i*13 + j*31) % n_v));}
+		}
+	}
+
+	graph gl;
+
+	gl.buildCompact(n_v,el);
+
+	for (size_t i = 0 ; i < el.size() ; i++)
+	{
+		gl.template edge_p<0>(i) = el.get(i).first*100.0f + g.getNEdge();
+	}
+
+	bool match = gl.getNEdge() == g.getNEdge();
+
+	for (size_t i = 0 ; i < n_v ; i++)
+	{
+		gl.vertex(i).template get<0>() = i;
+		match &= gl.getNChilds(i) == n_edges(i);
+
+		for (size_t j = 0 ; j < gl.getNChilds(i) ; j++)
+		{
+			match &= gl.getChild(i,j) == g.getChild(i,j);
+			match &= gl.getChildEdge(i,j).template get<0>() == i*100.0f + g.getNEdge();
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// Adding vertices and edges to a compact graph convert it back to the slotted form
+
+	gc.addVertex();
+	gc.vertex(n_v).template get<0>() = n_v;
+	BOOST_REQUIRE_EQUAL(gc.isCompact(),true);
+
+	g.addVertex();
+	g.vertex(n_v).template get<0>() = n_v;
+
+	for (size_t j = 0 ; j < 40 ; j++)
+	{
+		g.addEdge(n_v,j).template get<0>() = j;
+		gc.addEdge(n_v,j).template get<0>() = j;
+		g.addEdge(j,n_v).template get<0>() = j;
+		gc.addEdge(j,n_v).template get<0>() = j;
+	}
+
+	BOOST_REQUIRE_EQUAL(gc.isCompact(),false);
+	BOOST_REQUIRE_EQUAL(graph_same_adjacency(g,gc),true);
+}
+
+BOOST_AUTO_TEST_CASE( graph_cartesian_factory )
+{
+	typedef Graph_CSR<aggregate<float[3],size_t>,aggregate<float>> graph;
+
+	size_t sz[3] = {12,13,14};
+	Box<3,float> dom({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t bc_np[3] = {NON_PERIODIC,NON_PERIODIC,NON_PERIODIC};
+	size_t bc_p[3] = {PERIODIC,NON_PERIODIC,PERIODIC};
+
+	// graph of the faces of a 3D grid
+
+	graph g = CartesianGraphFactory<3,graph>::construct<0,1,float,2,0>(sz,dom,bc_np);
+	graph gp = CartesianGraphFactory<3,graph>::construct<0,1,float,2,0>(sz,dom,bc_p);
+
+	grid_sm<3,void> gs(sz);
+
+	BOOST_REQUIRE_EQUAL(g.isCompact(),true);
+	BOOST_REQUIRE_EQUAL(g.getNVertex(),gs.size());
+	BOOST_REQUIRE_EQUAL(g.getNEdge(),2*(11*13*14 + 12*12*14 + 12*13*13));
+	BOOST_REQUIRE_EQUAL(gp.getNEdge(),2*(12*13*14 + 12*12*14 + 12*13*14));
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < g.getNVertex() ; i++)
+	{
+		grid_key_dx<3> key = gs.InvLinId(i);
+
+		match &= g.vertex(i).template get<1>() == i;
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{match &= fabs(g.vertex(i).template get<0>()[d] - key.get(d) / (float)sz[d]) < 1e-6;}
+
+		size_t n_adj = 0;
+		for (size_t d = 0 ; d < 3 ; d++)
+		{n_adj += (key.get(d) != 0) + (key.get(d) != (long int)sz[d] - 1);}
+
+		match &= g.getNChilds(i) == n_adj;
+
+		for (size_t j = 0 ; j < g.getNChilds(i) ; j++)
+		{
+			grid_key_dx<3> key_n = gs.InvLinId(g.getChild(i,j));
+
+			// the neighborhood differ in one direction, the edge is the spacing in that direction
+			size_t n_diff = 0;
+			for (size_t d = 0 ; d < 3 ; d++)
+			{
+				if (key_n.get(d) != key.get(d))
+				{
+					n_diff++;
+					match &= abs(key_n.get(d) - key.get(d)) == 1;
+					match &= fabs(g.getChildEdge(i,j).template get<0>() - 1.0 / sz[d]) < 1e-6;
+				}
+			}
+
+			match &= n_diff == 1;
+		}
+
+		match &= gp.getNChilds(i) == 4 + (key.get(1) != 0) + (key.get(1) != (long int)sz[1] - 1);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// Assign the constructed graph to an existing graph
+
+	graph g2(16);
+	g2.addEdge(0,1);
+	g2 = CartesianGraphFactory<3,graph>::construct<0,1,float,2,0>(sz,dom,bc_np);
+
+	graph g3(16);
+	g3.addEdge(0,1);
+	g3 = g2;
+
+	BOOST_REQUIRE_EQUAL(g2.getNVertex(),g.getNVertex());
+	BOOST_REQUIRE_EQUAL(g3.getNVertex(),g.getNVertex());
+
+	for (size_t i = 0 ; i < g.getNVertex() ; i++)
+	{
+		match &= g2.getNChilds(i) == g.getNChilds(i);
+		match &= g3.getNChilds(i) == g.getNChilds(i);
+
+		for (size_t j = 0 ; j < g.getNChilds(i) ; j++)
+		{
+			match &= g2.getChild(i,j) == g.getChild(i,j);
+			match &= g3.getChild(i,j) == g.getChild(i,j);
+			match &= g2.getChildEdge(i,j).template get<0>() == g.getChildEdge(i,j).template get<0>();
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -38,12 +38,23 @@
  *
  *  Vertex properties and edge properties are stored in a separate structure
  *
+ *  A graph can also be stored in compact form (v_slot == 0), where the adjacency lists are
+ *  stored one after the other without unused slots and a start offset is stored for each vertex.
+ *  For the example above
+ *
+ *  Start list  0 3 4 6
+ *  Edge list   2 3 4 1 4 1 1 3
+ *
+ *  The compact form is produced by buildCompact (in parallel) or by compact(). Adding an edge
+ *  to a compact graph convert it back to the slotted form
+ *
  */
 
 #ifndef MAP_GRAPH_HPP_
 #define MAP_GRAPH_HPP_
 
 #include "Vector/map_vector.hpp"
+#include "util/openmp_util.hpp"
 #include <unordered_map>
 #ifdef METIS_GP
 #include "metis_util.hpp"
@@ -184,6 +195,12 @@ public:
 			g(g)
 	{
 		ek.begin();
+
+		// skip every vertex without edges
+		while (ek.pos < g.getNVertex() && g.getNChilds(ek.pos) == 0)
+		{
+			ek.pos++;
+		}
 	}
 
 	/*! \brief Get the next element
@@ -303,7 +320,7 @@ template<typename V, typename E = no_edge,
 		  typename grow_p = openfpm::grow_policy_double>
 class Graph_CSR
 {
-	//! number of slot per vertex
+	//! number of slot per vertex (0 when the graph is in compact form)
 	size_t v_slot;
 
 	//! Structure that store the vertex properties
@@ -321,6 +338,77 @@ class Graph_CSR
 	//! invalid edge element, when a function try to create an in valid edge this object is returned
 	openfpm::vector<E, Memory, layout_e_base, grow_p, openfpm::vect_isel<E>::value> e_invalid;
 
+	//! Structure that store for each vertex the start of its adjacency list in e_l (only in compact form)
+	openfpm::vector<size_t, Memory, layout_v_base,grow_p, openfpm::vect_isel<size_t>::value> e_start;
+
+	/*! \brief Return the position in e_l of the adjacent vertex i of the vertex v
+	 *
+	 * \param v vertex
+	 * \param i adjacent vertex
+	 *
+	 * \return the position in e_l
+	 *
+	 */
+	inline size_t e_pos(size_t v, size_t i) const
+	{
+		return (v_slot != 0)?v * v_slot + i:e_start.template get<0>(v) + i;
+	}
+
+	/*! \brief Convert a graph in compact form into the slotted form
+	 *
+	 * The number of slots is the smallest power of two, greater than the maximum number of
+	 * adjacent vertices and at least 16. The adjacency lists are moved in place starting from
+	 * the last vertex (the new position of an entry is never smaller than the old one)
+	 *
+	 */
+	void toSlotted()
+	{
+		size_t max_adj = 0;
+
+		for (size_t i = 0 ; i < v_l.size() ; i++)
+		{max_adj = std::max(max_adj,v_l.template get<0>(i));}
+
+		size_t v_slot_new = 16;
+		while (v_slot_new <= max_adj)
+		{v_slot_new *= 2;}
+
+		e_l.resize(v.size() * v_slot_new);
+
+		for (long int i = (long int)v.size() - 1 ; i >= 0 ; i--)
+		{
+			size_t n_adj = v_l.template get<0>(i);
+			size_t start = e_start.template get<0>(i);
+
+			for (long int s = (long int)n_adj - 1 ; s >= 0 ; s--)
+			{
+				e_l.template get<e_map::vid>(i * v_slot_new + s) = e_l.template get<e_map::vid>(start + s);
+				e_l.template get<e_map::eid>(i * v_slot_new + s) = e_l.template get<e_map::eid>(start + s);
+			}
+		}
+
+		e_start.clear();
+		v_slot = v_slot_new;
+	}
+
+	/*! \brief Replace the edges with n_e unset edges of exact size
+	 *
+	 * The old structures are released instead of resized, so the old edges are not copied
+	 *
+	 * \param n_e number of edges
+	 *
+	 */
+	void allocateCompact(size_t n_e)
+	{
+		openfpm::vector<e_map, Memory, layout_e_base , grow_p, openfpm::vect_isel<e_map>::value> e_l_c;
+		openfpm::vector<E, Memory, layout_e_base, grow_p, openfpm::vect_isel<E>::value> e_c;
+
+		e_l_c.resize(n_e);
+		e_c.resize(n_e);
+
+		e_l.swap(e_l_c);
+		e.swap(e_c);
+	}
+
 	/*! \brief add edge on the graph
 	 *
 	 * add edge on the graph
@@ -340,6 +428,10 @@ class Graph_CSR
 		if (CheckPolicy::valid(v2, v.size()) == false)
 			return (size_t)NO_EDGE;
 
+		// A compact graph does not have free slots
+		if (v_slot == 0)
+		{toSlotted();}
+
 		// get the number of adjacent vertex
 		size_t id_x_end = v_l.template get<0>(v1);
 
@@ -355,7 +447,7 @@ class Graph_CSR
 
 		for (size_t s = 0; s < id_x_end; s++)
 		{
-			if (e_l.template get<e_map::vid>(v1 * v_slot + s) == v2)
+			if (e_l.template get<e_map::vid>(e_pos(v1,s)) == v2)
 			{
 				std::cerr << "Error graph: the edge already exist" << std::endl;
 			}
@@ -366,25 +458,26 @@ class Graph_CSR
 
 		if (id_x_end >= v_slot)
 		{
-			// Unfortunately there is not space we need to reallocate memory
-			// Reallocate with double slot
-
-			// Create an new Graph
+			// Unfortunately there is not space, double the slots of every vertex.
+			// Only the adjacency list change, it is moved in place starting from the
+			// last vertex (the new position of an entry is never smaller than the old one)
 
-			Graph_CSR<V, E> g_new(2 * v_slot, v.size());
+			size_t v_slot_new = 2 * v_slot;
 
-			// Copy the graph
+			e_l.resize(v.size() * v_slot_new);
 
-			for (size_t i = 0; i < v.size(); i++)
+			for (long int i = (long int)v.size() - 1 ; i > 0 ; i--)
 			{
-				// copy the property from the old graph
+				size_t n_adj = v_l.template get<0>(i);
 
-				g_new.v.set(i, v, 2 * i);
+				for (size_t s = 0 ; s < n_adj ; s++)
+				{
+					e_l.template get<e_map::vid>(i * v_slot_new + s) = e_l.template get<e_map::vid>(i * v_slot + s);
+					e_l.template get<e_map::eid>(i * v_slot_new + s) = e_l.template get<e_map::eid>(i * v_slot + s);
+				}
 			}
 
-			// swap the new graph with the old one
-
-			swap(g_new);
+			v_slot = v_slot_new;
 		}
 
 		// Here we are sure than v and e has enough slots to store a new edge
@@ -426,6 +519,9 @@ public:
 	//! Object container for the edge, for example can be encap<...> (map_grid or openfpm::vector)
 	typedef typename openfpm::vector<E, Memory, layout_e_base, grow_p, openfpm::vect_isel<E>::value>::container E_container;
 
+	//! Object returned when an edge is accessed
+	typedef decltype(std::declval<openfpm::vector<E, Memory, layout_e_base, grow_p, openfpm::vect_isel<E>::value> &>().get(0)) E_container_ref;
+
 	/*! \brief Check if two graph exactly match
 	 *
 	 * \warning The requirement to match is more restrictive than simply content matching
@@ -446,6 +542,7 @@ public:
 		ret &= (v_l == g.v_l);
 		ret &= (e == g.e);
 		ret &= (e_l == g.e_l);
+		ret &= (e_start == g.e_start);
 
 		return ret;
 	}
@@ -469,6 +566,7 @@ public:
 		dup.e.swap(e.duplicate());
 		dup.e_l.swap(e_l.duplicate());
 		dup.e_invalid.swap(e_invalid.duplicate());
+		dup.e_start.swap(e_start.duplicate());
 
 		return dup;
 	}
@@ -500,7 +598,7 @@ public:
 	 * \param n_vertex number of vertices
 	 * \param n_slot number of slots (around how many edge has
 	 *        a vertex, it is not fundamental parameter is just
-	 *        an indication)
+	 *        an indication), 0 create the graph in compact form
 	 *
 	 */
 	Graph_CSR(size_t n_vertex, size_t n_slot)
@@ -514,6 +612,12 @@ public:
 		v_l.fill(0);
 		//! create one invalid edge
 		e_invalid.resize(1);
+
+		if (v_slot == 0)
+		{
+			e_start.resize(n_vertex);
+			e_start.fill(0);
+		}
 	}
 
 	/*! \brief Copy constructor
@@ -535,9 +639,7 @@ public:
 	 */
 	Graph_CSR<V, E, Memory> & operator=(Graph_CSR<V, E, Memory> && g)
 	{
-		size_t vs_tmp = v_slot;
-		v_slot = g.v_slot;
-		g.v_slot = vs_tmp;
+		// swap exchange also v_slot
 		swap(g);
 
 		return *this;
@@ -672,6 +774,7 @@ public:
 		v_l.clear();
 		e_l.clear();
 		e_invalid.clear();
+		e_start.clear();
 	}
 
 
@@ -692,6 +795,8 @@ public:
 		e_l.shrink_to_fit();
 		e_invalid.clear();
 		e_invalid.shrink_to_fit();
+		e_start.clear();
+		e_start.shrink_to_fit();
 	}
 
 	/*! \brief Access the edge
@@ -730,7 +835,7 @@ public:
 	 */
 	auto edge(edge_key ek) const -> const decltype ( e.get(0) )
 	{
-		return e.get(e_l.template get<e_map::eid>(ek.pos * v_slot + ek.pos_e));
+		return e.get(e_l.template get<e_map::eid>(e_pos(ek.pos,ek.pos_e)));
 	}
 
 	/*! \brief operator to access the edge
@@ -797,7 +902,7 @@ public:
 	inline auto getChildEdge(size_t v, size_t v_e) -> decltype(e.get(0))
 	{
 		// Get the edge id
-		return e.get(e_l.template get<e_map::eid>(v * v_slot + v_e));
+		return e.get(e_l.template get<e_map::eid>(e_pos(v,v_e)));
 	}
 
 	/*! \brief Get the child vertex id
@@ -823,7 +928,7 @@ public:
 		}
 #endif
 		// Get the target vertex id
-		return e_l.template get<e_map::vid>(v * v_slot + i);
+		return e_l.template get<e_map::vid>(e_pos(v,i));
 	}
 
 	/*! \brief Get the child edge
@@ -842,14 +947,14 @@ public:
 			std::cerr << "Error " << __FILE__ << " line: " << __LINE__ << "    vertex " << v.get() << " does not have edge " << i << std::endl;
 		}
 
-		if (e.size() <= e_l.template get<e_map::eid>(v.get() * v_slot + i))
+		if (e.size() <= e_l.template get<e_map::eid>(e_pos(v.get(),i)))
 		{
 			std::cerr << "Error " << __FILE__ << " " << __LINE__ << " vertex " << v.get() << " does not have edge "<< i << std::endl;
 		}
 #endif
 
 		// Get the edge id
-		return e_l.template get<e_map::vid>(v.get() * v_slot + i);
+		return e_l.template get<e_map::vid>(e_pos(v.get(),i));
 	}
 
 	/*! \brief add vertex
@@ -866,9 +971,18 @@ public:
 
 		v_l.add(0ul);
 
-		// Add a slot for the vertex adjacency list
+		// Add a slot for the vertex adjacency list (in compact form the list is empty)
 
-		e_l.resize(e_l.size() + v_slot);
+		if (v_slot == 0)
+		{e_start.add(e_l.size());}
+		else
+		{
+			// grow geometrically, resizing of v_slot every time copy the adjacency lists at every vertex
+			if (e_l.size() + v_slot > e_l.capacity())
+			{e_l.reserve(grow_p::grow(e_l.capacity(),e_l.size() + v_slot));}
+
+			e_l.resize(e_l.size() + v_slot);
+		}
 	}
 
 	/*! \brief add an empty vertex
@@ -883,9 +997,18 @@ public:
 
 		v_l.add(0ul);
 
-		// Add a slot for the vertex adjacency list
+		// Add a slot for the vertex adjacency list (in compact form the list is empty)
 
-		e_l.resize(e_l.size() + v_slot);
+		if (v_slot == 0)
+		{e_start.add(e_l.size());}
+		else
+		{
+			// grow geometrically, resizing of v_slot every time copy the adjacency lists at every vertex
+			if (e_l.size() + v_slot > e_l.capacity())
+			{e_l.reserve(grow_p::grow(e_l.capacity(),e_l.size() + v_slot));}
+
+			e_l.resize(e_l.size() + v_slot);
+		}
 	}
 
 	/*! \brief add edge on the graph
@@ -965,6 +1088,238 @@ public:
 		return e.get(id_x_end);
 	}
 
+	/*! \brief Writer for the adjacency list of one vertex, it is passed to the fill functor of buildCompact
+	 *
+	 */
+	class adjacency_writer
+	{
+		//! Graph
+		Graph_CSR<V, E, Memory,layout_v_base,layout_e_base, grow_p> & g;
+
+		//! Next position in the adjacency list
+		size_t pos;
+
+		//! End of the adjacency list
+		size_t stop;
+
+	public:
+
+		/*! \brief Constructor
+		 *
+		 * \param g graph
+		 * \param start start of the adjacency list in e_l
+		 * \param stop end of the adjacency list in e_l
+		 *
+		 */
+		adjacency_writer(Graph_CSR<V, E, Memory,layout_v_base,layout_e_base, grow_p> & g, size_t start, size_t stop)
+		:g(g),pos(start),stop(stop)
+		{}
+
+		/*! \brief Add the next adjacent vertex
+		 *
+		 * \param v2 target vertex
+		 *
+		 * \return the edge object
+		 *
+		 */
+		inline E_container_ref addEdge(size_t v2)
+		{
+#ifdef SE_CLASS1
+			if (pos >= stop)
+			{
+				std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " adding more edges than declared to a vertex" << std::endl;
+			}
+#endif
+
+			g.e_l.template get<e_map::vid>(pos) = v2;
+			g.e_l.template get<e_map::eid>(pos) = pos;
+
+			return g.e.get(pos++);
+		}
+
+		/*! \brief Return true if all the declared edges has been added
+		 *
+		 * \return true if the adjacency list is full
+		 *
+		 */
+		inline bool isFull() const
+		{
+			return pos == stop;
+		}
+	};
+
+	/*! \brief Construct the graph in compact form in parallel
+	 *
+	 * The graph is resized to n_vertex vertices (vertex properties are kept) and all the edges
+	 * are replaced. The number of adjacent vertices of each vertex is calculated with n_edges,
+	 * an exclusive scan give the start of each adjacency list, and each list is filled with fill,
+	 * without reallocation. The edge id is the position in the adjacency list structure,
+	 * the edges are ordered by source vertex
+	 *
+	 * \param n_vertex number of vertices
+	 * \param n_edges functor n_edges(v) that return the number of adjacent vertices of v
+	 * \param fill functor fill(v,aw) that add exactly n_edges(v) edges with aw.addEdge(target),
+	 *        it can also set the properties of the vertex v
+	 *
+	 * \note both the functors are called concurrently from several threads
+	 *
+	 */
+	template<typename n_edges_functor, typename fill_functor>
+	void buildCompact(size_t n_vertex, n_edges_functor n_edges, fill_functor fill)
+	{
+		v.resize(n_vertex);
+		v_l.resize(n_vertex);
+		e_start.resize(n_vertex);
+		v_slot = 0;
+
+		size_t * n_adj = (size_t *)v_l.getPointer();
+		size_t * start = (size_t *)e_start.getPointer();
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0 ; i < n_vertex ; i++)
+		{n_adj[i] = n_edges(i);}
+
+		size_t n_e = openfpm::omp::exclusive_scan(n_adj,start,n_vertex);
+
+		allocateCompact(n_e);
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0 ; i < n_vertex ; i++)
+		{
+			adjacency_writer aw(*this,start[i],start[i] + n_adj[i]);
+
+			fill(i,aw);
+
+#ifdef SE_CLASS1
+			if (aw.isFull() == false)
+			{
+				std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " vertex " << i << " has less edges than declared" << std::endl;
+			}
+#endif
+		}
+	}
+
+	/*! \brief Construct the graph in compact form in parallel from a list of edges
+	 *
+	 * The graph is resized to n_vertex vertices (vertex properties are kept) and all the edges
+	 * are replaced. The edges of the list are sorted by source vertex with a parallel stable
+	 * radix sort, so the adjacent vertices of a vertex are in the same order of the list.
+	 * The edge i of the list has edge id i (its properties are edge_p<...>(i))
+	 *
+	 * \param n_vertex number of vertices
+	 * \param el list of edges, el.get(i).first is the source and el.get(i).second the target
+	 *
+	 */
+	template<typename vector_edge_type>
+	void buildCompact(size_t n_vertex, const vector_edge_type & el)
+	{
+		size_t n_e = el.size();
+
+		v.resize(n_vertex);
+		v_l.resize(n_vertex);
+		e_start.resize(n_vertex);
+		v_slot = 0;
+
+		// sort the edge ids by source vertex
+
+		openfpm::vector<size_t> eid;
+		openfpm::vector<size_t> tmp;
+		eid.resize(n_e);
+		tmp.resize(n_e);
+
+		size_t * eid_p = (size_t *)eid.getPointer();
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0 ; i < n_e ; i++)
+		{eid_p[i] = i;}
+
+		auto src = [&el](size_t i) {return (size_t)el.get(i).first;};
+
+		openfpm::omp::radix_sort(eid_p,(size_t *)tmp.getPointer(),n_e,src,n_vertex);
+
+		// Count the adjacent vertices, the edges of a vertex are now contiguous so the start
+		// of each list is the first occurrence of the vertex
+
+		size_t * n_adj = (size_t *)v_l.getPointer();
+		size_t * start = (size_t *)e_start.getPointer();
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0 ; i < n_vertex ; i++)
+		{n_adj[i] = 0;}
+
+		#pragma omp parallel for schedule(static)
+		for (size_t k = 0 ; k < n_e ; k++)
+		{
+			size_t s = src(eid_p[k]);
+
+			if (k == 0 || src(eid_p[k-1]) != s)
+			{
+				size_t k_end = k + 1;
+				while (k_end < n_e && src(eid_p[k_end]) == s)
+				{k_end++;}
+
+				n_adj[s] = k_end - k;
+			}
+		}
+
+		openfpm::omp::exclusive_scan(n_adj,start,n_vertex);
+
+		allocateCompact(n_e);
+
+		#pragma omp parallel for schedule(static)
+		for (size_t k = 0 ; k < n_e ; k++)
+		{
+			e_l.template get<e_map::vid>(k) = el.get(eid_p[k]).second;
+			e_l.template get<e_map::eid>(k) = eid_p[k];
+		}
+	}
+
+	/*! \brief Convert the graph into compact form
+	 *
+	 * The adjacency lists are copied in parallel into a structure of exact size, without
+	 * unused slots
+	 *
+	 */
+	void compact()
+	{
+		if (v_slot == 0)	{return;}
+
+		size_t n_vertex = v.size();
+
+		e_start.resize(n_vertex);
+
+		size_t * n_adj = (size_t *)v_l.getPointer();
+		size_t * start = (size_t *)e_start.getPointer();
+
+		size_t n_e = openfpm::omp::exclusive_scan(n_adj,start,n_vertex);
+
+		openfpm::vector<e_map, Memory, layout_e_base , grow_p, openfpm::vect_isel<e_map>::value> e_l_c;
+		e_l_c.resize(n_e);
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0 ; i < n_vertex ; i++)
+		{
+			for (size_t s = 0 ; s < n_adj[i] ; s++)
+			{
+				e_l_c.template get<e_map::vid>(start[i] + s) = e_l.template get<e_map::vid>(i * v_slot + s);
+				e_l_c.template get<e_map::eid>(start[i] + s) = e_l.template get<e_map::eid>(i * v_slot + s);
+			}
+		}
+
+		e_l.swap(e_l_c);
+		v_slot = 0;
+	}
+
+	/*! \brief Return true if the graph is in compact form
+	 *
+	 * \return true if the adjacency lists does not have unused slots
+	 *
+	 */
+	inline bool isCompact() const
+	{
+		return v_slot == 0;
+	}
+
 	/*! \brief swap the memory of g with this graph
 	 *
 	 * it is basically used for move semantic
@@ -982,6 +1337,7 @@ public:
 		v_l.swap(g.v_l);
 		e_l.swap(g.e_l);
 		e_invalid.swap(g.e_invalid);
+		e_start.swap(g.e_start);
 
 		size_t v_slot_tmp = g.v_slot;
 		g.v_slot = v_slot;
@@ -1004,6 +1360,7 @@ public:
 		v_l.swap(g.v_l);
 		e_l.swap(g.e_l);
 		e_invalid.swap(g.e_invalid);
+		e_start.swap(g.e_start);
 
 		size_t v_slot_tmp = g.v_slot;
 		g.v_slot = v_slot;
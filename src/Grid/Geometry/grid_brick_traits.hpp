@@ -0,0 +1,97 @@
+/*
+ * grid_brick_traits.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef OPENFPM_DATA_SRC_GRID_GEOMETRY_GRID_BRICK_TRAITS_HPP_
+#define OPENFPM_DATA_SRC_GRID_GEOMETRY_GRID_BRICK_TRAITS_HPP_
+
+#include <type_traits>
+#include "Grid/grid_sm.hpp"
+#include "Grid/Geometry/grid_smb.hpp"
+#include "Grid/Geometry/grid_zmb.hpp"
+
+/*! \brief Check if a linearizer store the points in bricks
+ *
+ * type is std::true_type for bricked linearizers (grid_smb, grid_zmb), value is the
+ * edge of the brick (0 for the linearizers that are not bricked)
+ *
+ * \tparam linearizer linearizer
+ *
+ */
+template<typename linearizer>
+struct grid_brick_edge
+{
+	typedef std::false_type type;
+
+	static const unsigned int value = 0;
+};
+
+template<unsigned int dim, unsigned int blockEdgeSize, typename indexT>
+struct grid_brick_edge<grid_smb<dim,blockEdgeSize,indexT>>
+{
+	typedef std::true_type type;
+
+	static const unsigned int value = blockEdgeSize;
+};
+
+template<unsigned int dim, unsigned int blockEdgeSize, typename indexT>
+struct grid_brick_edge<grid_zmb<dim,blockEdgeSize,indexT>>
+{
+	typedef std::true_type type;
+
+	static const unsigned int value = blockEdgeSize;
+};
+
+/*! \brief Number of elements to allocate for a grid
+ *
+ * \param g linearizer
+ *
+ * \return the number of points of the grid
+ *
+ */
+template<typename linearizer>
+inline size_t grid_storage_size(const linearizer & g)
+{
+	return g.size();
+}
+
+/*! \brief Number of elements to allocate for a grid stored in bricks
+ *
+ * When the size is not a multiple of the brick edge, the bricks at the border are
+ * only partially inside the grid, but they are allocated completely
+ *
+ * \param g linearizer
+ *
+ * \return the number of bricks multiplied by the points in a brick
+ *
+ */
+template<unsigned int dim, unsigned int blockEdgeSize, typename indexT>
+inline size_t grid_storage_size(const grid_smb<dim,blockEdgeSize,indexT> & g)
+{
+	return g.size_blocks() * g.getBlockSize();
+}
+
+/*! \brief Number of elements to allocate for a grid stored in bricks in morton order
+ *
+ * The bricks are numbered along a morton curve over a power of two number of bricks
+ *
+ * \param g linearizer
+ *
+ * \return the number of elements to allocate
+ *
+ */
+template<unsigned int dim, unsigned int blockEdgeSize, typename indexT>
+inline size_t grid_storage_size(const grid_zmb<dim,blockEdgeSize,indexT> & g)
+{
+	grid_key_dx<dim> k_last;
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{k_last.set_d(i,(g.size(i) == 0)?0:g.size(i) - 1);}
+
+	return (g.size() == 0)?0:g.LinId(k_last) - g.LinId(k_last) % g.getBlockSize() + g.getBlockSize();
+}
+
+#endif /* OPENFPM_DATA_SRC_GRID_GEOMETRY_GRID_BRICK_TRAITS_HPP_ */
@@ -9,6 +9,8 @@
 #define OPENFPM_DATA_SRC_GRID_COPY_GRID_FAST_HPP_
 
 #include "Grid/iterators/grid_key_dx_iterator.hpp"
+#include "Grid/Geometry/grid_brick_traits.hpp"
+#include "util/openmp_util.hpp"
 
 template<unsigned int dim>
 struct striding
@@ -1276,4 +1278,374 @@ struct unpack_with_iterator<3,grid,
 	}
 };
 
+/*! \brief Call f for each segment of contiguous points of the box [start,stop] of a grid stored in bricks
+ *
+ * The rows of the box along the dimension 0 are cut at the border of the bricks, the rows
+ * are distributed between the OpenMP threads
+ *
+ * \see grid_for_each_segment
+ *
+ */
+template<unsigned int dim, typename linearizer, typename lambda_t>
+void grid_for_each_segment(const linearizer & g, const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop, lambda_t f, std::true_type)
+{
+	static const long int B = grid_brick_edge<linearizer>::value;
+
+	long int n_rows = 1;
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		if (stop.get(i) < start.get(i))	{return;}
+
+		if (i != 0)
+		{n_rows *= stop.get(i) - start.get(i) + 1;}
+	}
+
+	long int ext0 = stop.get(0) - start.get(0) + 1;
+
+	#pragma omp parallel for schedule(static) if (n_rows*ext0 >= 32768)
+	for (long int r = 0 ; r < n_rows ; r++)
+	{
+		grid_key_dx<dim> key;
+		long int rr = r;
+
+		for (size_t i = 1 ; i < dim ; i++)
+		{
+			long int ext = stop.get(i) - start.get(i) + 1;
+			key.set_d(i,start.get(i) + rr % ext);
+			rr /= ext;
+		}
+
+		long int x = start.get(0);
+		while (x <= stop.get(0))
+		{
+			long int x_end = std::min((long int)stop.get(0),(x / B + 1)*B - 1);
+
+			key.set_d(0,x);
+			f((const grid_key_dx<dim> &)key,(long int)g.LinId(key),(size_t)(x_end - x + 1),(size_t)(r*ext0 + x - start.get(0)));
+
+			x = x_end + 1;
+		}
+	}
+}
+
+/*! \brief Call f for the segments [s_start,s_stop) of the box [start,stop] of a grid (rows along the dimension 0)
+ *
+ * Each row is cut in n_chunk segments of chunk points, the key of the first segment is calculated
+ * and then incremented
+ *
+ */
+template<unsigned int dim, typename linearizer, typename lambda_t>
+void grid_for_each_segment_range(const linearizer & g, const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop, lambda_t & f,
+								 long int n_chunk, long int chunk, size_t s_start, size_t s_stop)
+{
+	long int ext0 = stop.get(0) - start.get(0) + 1;
+
+	grid_key_dx<dim> key;
+	long int r = s_start / n_chunk;
+	long int c = s_start % n_chunk;
+	long int rr = r;
+
+	for (size_t i = 1 ; i < dim ; i++)
+	{
+		long int ext = stop.get(i) - start.get(i) + 1;
+		key.set_d(i,start.get(i) + rr % ext);
+		rr /= ext;
+	}
+
+	if (n_chunk == 1)
+	{
+		// one segment for each row
+		key.set_d(0,start.get(0));
+		size_t id = r*ext0;
+
+		for (size_t s = s_start ; s < s_stop ; s++)
+		{
+			f((const grid_key_dx<dim> &)key,(long int)g.LinId(key),(size_t)ext0,id);
+			id += ext0;
+
+			// next row
+			for (size_t i = 1 ; i < dim ; i++)
+			{
+				if (key.get(i) < stop.get(i))
+				{
+					key.set_d(i,key.get(i) + 1);
+					break;
+				}
+				key.set_d(i,start.get(i));
+			}
+		}
+
+		return;
+	}
+
+	for (size_t s = s_start ; s < s_stop ; s++)
+	{
+		long int x = c * chunk;
+		long int n = std::min(chunk,ext0 - x);
+
+		if (n > 0)
+		{
+			key.set_d(0,start.get(0) + x);
+			f((const grid_key_dx<dim> &)key,(long int)g.LinId(key),(size_t)n,(size_t)(r*ext0 + x));
+		}
+
+		// next segment
+		c++;
+		if (c == n_chunk)
+		{
+			c = 0;
+			r++;
+
+			for (size_t i = 1 ; i < dim ; i++)
+			{
+				if (key.get(i) < stop.get(i))
+				{
+					key.set_d(i,key.get(i) + 1);
+					break;
+				}
+				key.set_d(i,start.get(i));
+			}
+		}
+	}
+}
+
+/*! \brief Call f for each segment of contiguous points of the box [start,stop] of a grid (rows along the dimension 0)
+ *
+ * When the box has less rows than threads the rows are cut in chunks
+ *
+ */
+template<unsigned int dim, typename linearizer, typename lambda_t>
+void grid_for_each_segment(const linearizer & g, const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop, lambda_t f, std::false_type)
+{
+	long int n_rows = 1;
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		if (stop.get(i) < start.get(i))	{return;}
+
+		if (i != 0)
+		{n_rows *= stop.get(i) - start.get(i) + 1;}
+	}
+
+	long int ext0 = stop.get(0) - start.get(0) + 1;
+	long int nth = openfpm::omp::get_max_threads();
+
+	// small boxes are not worth a parallel region
+	if (n_rows*ext0 < 32768 || nth == 1)
+	{
+		grid_for_each_segment_range(g,start,stop,f,1,ext0,0,n_rows);
+		return;
+	}
+
+	// few long rows are cut in chunks of at least 4096 points
+	long int n_chunk = 1;
+	if (n_rows < nth)
+	{n_chunk = std::max(1l,std::min((nth + n_rows - 1) / n_rows,ext0 / 4096));}
+
+	long int chunk = (ext0 + n_chunk - 1) / n_chunk;
+	size_t n_seg = n_rows*n_chunk;
+
+	#pragma omp parallel
+	{
+		// each thread walk a contiguous range of segments
+		size_t s_start;
+		size_t s_stop;
+		openfpm::omp::thread_range(n_seg,openfpm::omp::get_num_threads(),openfpm::omp::get_thread_num(),s_start,s_stop);
+
+		grid_for_each_segment_range(g,start,stop,f,n_chunk,chunk,s_start,s_stop);
+	}
+}
+
+/*! \brief Call f for each segment of contiguous points of the box [start,stop] of a grid
+ *
+ * f(key,lin,n,id) is called for each segment with the first point key, its linear id lin, the number of
+ * points n of the segment and the position id of key in the box (dimension 0 fastest, as grid_key_dx_iterator_sub).
+ * The segments are the rows of the box along the dimension 0, for grids stored in bricks they are cut at the
+ * border of the bricks. The segments are distributed between the OpenMP threads, f must be thread safe
+ *
+ * \param g linearizer
+ * \param start start point
+ * \param stop stop point (included)
+ * \param f functor
+ *
+ */
+template<unsigned int dim, typename linearizer, typename lambda_t>
+void grid_for_each_segment(const linearizer & g, const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop, lambda_t f)
+{
+	grid_for_each_segment(g,start,stop,f,typename grid_brick_edge<linearizer>::type());
+}
+
+/*! \brief Copy n objects of obj_byte bytes
+ *
+ * Short segments (ghost layers are few points thick) are copied with a copy of known size, that
+ * the compiler can inline (as pack_with_iterator_shortx)
+ *
+ * \tparam obj_byte size of the object
+ *
+ * \param dst destination
+ * \param src source
+ * \param n number of objects
+ *
+ */
+template<unsigned int obj_byte>
+inline void copy_segment_bytes(unsigned char * dst, const unsigned char * src, size_t n)
+{
+	switch (n)
+	{
+	case 1:
+		__builtin_memcpy(dst,src,obj_byte);
+		break;
+	case 2:
+		__builtin_memcpy(dst,src,2*obj_byte);
+		break;
+	case 3:
+		__builtin_memcpy(dst,src,3*obj_byte);
+		break;
+	case 4:
+		__builtin_memcpy(dst,src,4*obj_byte);
+		break;
+	default:
+		memcpy(dst,src,n*obj_byte);
+	}
+}
+
+/*! \brief Pack a sub-box of a grid into a vector like structure B in parallel
+ *
+ * The sub-box is split in segments of contiguous points (see grid_for_each_segment) and the segments are
+ * packed in parallel. The points are packed in the order of the sub-grid iterator (dimension 0 fastest).
+ * The structure B is always an array of objects with the packed properties. When is_memcpy is true (no
+ * pack_gen properties and the packed object has the same layout of the grid: memory_traits_lin with all
+ * the properties, or memory_traits_inte with one scalar property) each segment is copied with one memcpy,
+ * otherwise point by point
+ *
+ * \tparam is_memcpy copy the segments with memcpy
+ * \tparam dim Dimensionality of the grid
+ * \tparam boost_vct properties of the grid (boost::fusion::vector)
+ * \tparam it type of iterator of the grid-structure
+ * \tparam dtype type of the structure B
+ * \tparam prp properties to pack
+ *
+ */
+template <bool is_memcpy,
+		  unsigned int dim,
+		  typename grid,
+          typename encap_src,
+		  typename encap_dst,
+		  typename boost_vct,
+		  typename it,
+		  typename dtype,
+		  int ... prp>
+struct pack_with_iterator_par
+{
+	/*! \brief Pack a sub-box of a grid
+	 *
+	 * \param gr grid to pack
+	 * \param sub_it sub-grid iterator
+	 * \param dest where to pack
+	 *
+	 */
+	static void pack(grid & gr, it & sub_it, dtype & dest)
+	{
+		grid_for_each_segment(gr.getGrid(),sub_it.getStart(),sub_it.getStop(),
+				              [&](const grid_key_dx<dim> & key, long int lin, size_t n, size_t id)
+		{
+			for (size_t i = 0 ; i < n ; i++)
+			{object_si_d<encap_src,encap_dst,OBJ_ENCAP,prp...>(gr.get_o(lin + i),dest.get(id + i));}
+		});
+	}
+};
+
+//! Pack a sub-box of a grid, one memcpy for each segment
+template <unsigned int dim,
+		  typename grid,
+          typename encap_src,
+		  typename encap_dst,
+		  typename boost_vct,
+		  typename it,
+		  typename dtype,
+		  int ... prp>
+struct pack_with_iterator_par<true,dim,grid,encap_src,encap_dst,boost_vct,it,dtype,prp...>
+{
+	static void pack(grid & gr, it & sub_it, dtype & dest)
+	{
+		typedef typename dtype::value_type prp_object;
+
+		unsigned char * ptr_gr = (unsigned char *)gr.template getPointer<first_variadic<prp...>::type::value>();
+		unsigned char * ptr_dest = (unsigned char *)dest.getPointer();
+
+		grid_for_each_segment(gr.getGrid(),sub_it.getStart(),sub_it.getStop(),
+				              [&](const grid_key_dx<dim> & key, long int lin, size_t n, size_t id)
+		{
+			copy_segment_bytes<sizeof(prp_object)>(ptr_dest + id*sizeof(prp_object),ptr_gr + lin*sizeof(prp_object),n);
+		});
+	}
+};
+
+/*! \brief Unpack a vector like structure B into a sub-box of a grid in parallel
+ *
+ * \see pack_with_iterator_par, the structure B is always an array of objects with the unpacked properties,
+ * when is_memcpy is true (memory_traits_lin with all the properties, or memory_traits_inte with one scalar
+ * property) each segment is copied with one memcpy
+ *
+ * \tparam is_memcpy copy the segments with memcpy
+ * \tparam dim Dimensionality of the grid
+ * \tparam it type of iterator of the grid-structure
+ * \tparam stype type of the structure B
+ * \tparam prp properties to unpack
+ *
+ */
+template <bool is_memcpy,
+		  unsigned int dim,
+		  typename grid,
+          typename encap_src,
+		  typename encap_dst,
+		  typename it,
+		  typename stype,
+		  int ... prp>
+struct unpack_with_iterator_par
+{
+	/*! \brief Unpack into a sub-box of a grid
+	 *
+	 * \param gr grid where to unpack
+	 * \param sub_it sub-grid iterator
+	 * \param src packed data
+	 *
+	 */
+	static void unpack(grid & gr, it & sub_it, stype & src)
+	{
+		grid_for_each_segment(gr.getGrid(),sub_it.getStart(),sub_it.getStop(),
+				              [&](const grid_key_dx<dim> & key, long int lin, size_t n, size_t id)
+		{
+			for (size_t i = 0 ; i < n ; i++)
+			{object_s_di<encap_src,encap_dst,OBJ_ENCAP,prp...>(src.get(id + i),gr.get_o(lin + i));}
+		});
+	}
+};
+
+//! Unpack into a sub-box of a grid, one memcpy for each segment
+template <unsigned int dim,
+		  typename grid,
+          typename encap_src,
+		  typename encap_dst,
+		  typename it,
+		  typename stype,
+		  int ... prp>
+struct unpack_with_iterator_par<true,dim,grid,encap_src,encap_dst,it,stype,prp...>
+{
+	static void unpack(grid & gr, it & sub_it, stype & src)
+	{
+		typedef typename stype::value_type prp_object;
+
+		unsigned char * ptr_gr = (unsigned char *)gr.template getPointer<first_variadic<prp...>::type::value>();
+		unsigned char * ptr_src = (unsigned char *)src.getPointer();
+
+		grid_for_each_segment(gr.getGrid(),sub_it.getStart(),sub_it.getStop(),
+				              [&](const grid_key_dx<dim> & key, long int lin, size_t n, size_t id)
+		{
+			copy_segment_bytes<sizeof(prp_object)>(ptr_gr + lin*sizeof(prp_object),ptr_src + id*sizeof(prp_object),n);
+		});
+	}
+};
+
 #endif /* OPENFPM_DATA_SRC_GRID_COPY_GRID_FAST_HPP_ */
@@ -0,0 +1,265 @@
+/*
+ * grid_base_conv_opt.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef GRID_BASE_CONV_OPT_HPP_
+#define GRID_BASE_CONV_OPT_HPP_
+
+#if !defined(__NVCC__) || defined(CUDA_ON_CPU) || defined(__HIP__)
+// Nvcc does not like VC ... for some reason
+#include <Vc/Vc>
+#define GRID_BASE_CONV_USE_VC
+#endif
+
+#include "Grid/iterators/grid_key_dx_iterator_par.hpp"
+
+#ifdef GRID_BASE_CONV_USE_VC
+
+/*! \brief Values of the cross stencil around a set of points
+ *
+ * xm,xp,ym,yp,zm,zp are the values at -1,+1 in direction x,y,z
+ *
+ */
+template<typename prop_type>
+struct cross_stencil_v
+{
+	Vc::Vector<prop_type> xm;
+	Vc::Vector<prop_type> xp;
+	Vc::Vector<prop_type> ym;
+	Vc::Vector<prop_type> yp;
+	Vc::Vector<prop_type> zm;
+	Vc::Vector<prop_type> zp;
+};
+
+/*! \brief Access to the points of a row of a property of a dense grid
+ *
+ * The points of a row are at distance stride (in bytes). With memory_traits_inte
+ * the stride is the size of the property and the vectors are loaded directly,
+ * with memory_traits_lin the values are gathered in an aligned buffer
+ *
+ * \tparam prop_type type of the property
+ * \tparam is_contiguous true if the stride is the size of the property
+ *
+ */
+template<typename prop_type, bool is_contiguous>
+struct conv_dense_row
+{
+	typedef Vc::Vector<prop_type> vect;
+
+	/*! \brief Load cnt values starting from the linear id lin
+	 *
+	 * \param base address of the property of the point 0
+	 * \param stride distance in bytes between two consecutive points
+	 * \param lin linear id of the first point
+	 * \param cnt number of values to load (the other lanes are zero)
+	 *
+	 */
+	static inline vect load(const char * base, size_t stride, long int lin, size_t cnt)
+	{
+		if (is_contiguous == true && cnt == vect::Size)
+		{return vect((const prop_type *)(base + lin*stride),Vc::Unaligned);}
+
+		alignas(64) prop_type buf[vect::Size];
+
+		for (size_t i = 0 ; i < vect::Size ; i++)
+		{buf[i] = (i < cnt)?*(const prop_type *)(base + (lin+i)*stride):prop_type(0);}
+
+		return vect(buf,Vc::Aligned);
+	}
+
+	/*! \brief Store cnt values starting from the linear id lin
+	 *
+	 * \param v values to store
+	 * \param base address of the property of the point 0
+	 * \param stride distance in bytes between two consecutive points
+	 * \param lin linear id of the first point
+	 * \param cnt number of values to store
+	 *
+	 */
+	static inline void store(const vect & v, char * base, size_t stride, long int lin, size_t cnt)
+	{
+		if (is_contiguous == true && cnt == vect::Size)
+		{
+			v.store((prop_type *)(base + lin*stride),Vc::Unaligned);
+			return;
+		}
+
+		alignas(64) prop_type buf[vect::Size];
+		v.store(buf,Vc::Aligned);
+
+		for (size_t i = 0 ; i < cnt ; i++)
+		{*(prop_type *)(base + (lin+i)*stride) = buf[i];}
+	}
+};
+
+/*! \brief Get the address and the stride of a property of a dense grid
+ *
+ * \param grid dense grid
+ * \param stride distance in bytes between two consecutive points
+ *
+ * \return the address of the property of the point 0
+ *
+ */
+template<unsigned int prp, typename grid_type>
+char * conv_dense_base(grid_type & grid, size_t & stride)
+{
+	typedef typename boost::mpl::at<typename grid_type::value_type::type, boost::mpl::int_<prp>>::type prop_type;
+
+	char * base = (char *)&grid.template get<prp>((size_t)0);
+	stride = (grid.size() > 1)?(char *)&grid.template get<prp>((size_t)1) - base:sizeof(prop_type);
+
+	return base;
+}
+
+/*! \brief Convolution with the cross stencil on dense grids (implemented only in 3D)
+ *
+ * \tparam dim dimensionality
+ *
+ */
+template<unsigned int dim>
+struct conv_dense_cross_impl
+{
+	template<bool is_contiguous, unsigned int prop_src, unsigned int prop_dst, typename grid_type, typename lambda_f, typename ... ArgsT>
+	static void conv_cross(grid_key_dx<dim> &, grid_key_dx<dim> &, grid_type &, lambda_f &, ArgsT & ...)
+	{
+		static_assert(dim == 3,"conv_cross is implemented only for 3D dense grids");
+	}
+};
+
+/*! \brief Convolution with the cross stencil on 3D dense grids
+ *
+ * func(Vc::Vector<prop_type> & cmd, cross_stencil_v<prop_type> & s, unsigned char * mask_sum, args ...)
+ * return the result, cmd contain the values at the center
+ *
+ */
+template<>
+struct conv_dense_cross_impl<3>
+{
+	template<bool is_contiguous, unsigned int prop_src, unsigned int prop_dst, typename grid_type, typename lambda_f, typename ... ArgsT>
+	static void conv_cross(grid_key_dx<3> & start, grid_key_dx<3> & stop, grid_type & grid, lambda_f & func, ArgsT & ... args)
+	{
+		typedef typename boost::mpl::at<typename grid_type::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
+		typedef Vc::Vector<prop_type> vect;
+		typedef conv_dense_row<prop_type,is_contiguous> row;
+
+		grid_key_dx<3> stencil_pnt[7] = {{0,0,0},{-1,0,0},{1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+
+		size_t stride_src;
+		size_t stride_dst;
+		const char * base_src = conv_dense_base<prop_src>(grid,stride_src);
+		char * base_dst = conv_dense_base<prop_dst>(grid,stride_dst);
+
+		auto it = grid.getIteratorStencilPar(start,stop,stencil_pnt);
+
+		it.forEachRow([&](const grid_key_dx<3> &, const stencil_offset_compute<3,7> & stl, size_t n)
+		{
+			unsigned char mask_sum[vect::Size];
+			for (size_t i = 0 ; i < vect::Size ; i++)
+			{mask_sum[i] = 6;}
+
+			for (size_t i = 0 ; i < n ; i += vect::Size)
+			{
+				size_t cnt = (n - i < vect::Size)?n - i:vect::Size;
+
+				cross_stencil_v<prop_type> cs;
+
+				vect cmd = row::load(base_src,stride_src,stl.stencil_offset[0] + i,cnt);
+				cs.xm = row::load(base_src,stride_src,stl.stencil_offset[1] + i,cnt);
+				cs.xp = row::load(base_src,stride_src,stl.stencil_offset[2] + i,cnt);
+				cs.ym = row::load(base_src,stride_src,stl.stencil_offset[3] + i,cnt);
+				cs.yp = row::load(base_src,stride_src,stl.stencil_offset[4] + i,cnt);
+				cs.zm = row::load(base_src,stride_src,stl.stencil_offset[5] + i,cnt);
+				cs.zp = row::load(base_src,stride_src,stl.stencil_offset[6] + i,cnt);
+
+				vect res = func(cmd,cs,mask_sum,args ...);
+
+				row::store(res,base_dst,stride_dst,stl.stencil_offset[0] + i,cnt);
+			}
+		});
+	}
+};
+
+/*! \brief Vectorized convolutions on dense grids
+ *
+ * The box [start,stop] is divided in tiles processed in parallel (grid_key_dx_iterator_par), every
+ * row along the direction 0 is processed in blocks of Vc::Vector<prop_type>::Size points. The last
+ * block of a row is completed with zeros and only the valid lanes are stored. As for the sparse grid
+ * the functions receive also mask_sum, that for the dense grid is always the number of stencil points
+ *
+ * \tparam dim dimensionality
+ *
+ */
+template<unsigned int dim>
+struct conv_dense_impl
+{
+	/*! \brief Convolution with a generic stencil of N points
+	 *
+	 * func(Vc::Vector<prop_type> (& xs)[N+1], unsigned char * mask_sum, args ...) return the result,
+	 * xs[0] contain the values at the center and xs[s] the values at the stencil point s-1
+	 *
+	 */
+	template<bool is_contiguous, unsigned int prop_src, unsigned int prop_dst, unsigned int N, typename grid_type, typename lambda_f, typename ... ArgsT>
+	static void conv(int (& stencil)[N][dim], grid_key_dx<dim> & start, grid_key_dx<dim> & stop, grid_type & grid, lambda_f & func, ArgsT & ... args)
+	{
+		typedef typename boost::mpl::at<typename grid_type::value_type::type, boost::mpl::int_<prop_src>>::type prop_type;
+		typedef Vc::Vector<prop_type> vect;
+		typedef conv_dense_row<prop_type,is_contiguous> row;
+
+		grid_key_dx<dim> stencil_pnt[N+1];
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{stencil_pnt[0].set_d(i,0);}
+
+		for (size_t s = 0 ; s < N ; s++)
+		{
+			for (size_t i = 0 ; i < dim ; i++)
+			{stencil_pnt[s+1].set_d(i,stencil[s][i]);}
+		}
+
+		size_t stride_src;
+		size_t stride_dst;
+		const char * base_src = conv_dense_base<prop_src>(grid,stride_src);
+		char * base_dst = conv_dense_base<prop_dst>(grid,stride_dst);
+
+		auto it = grid.getIteratorStencilPar(start,stop,stencil_pnt);
+
+		it.forEachRow([&](const grid_key_dx<dim> &, const stencil_offset_compute<dim,N+1> & stl, size_t n)
+		{
+			unsigned char mask_sum[vect::Size];
+			for (size_t i = 0 ; i < vect::Size ; i++)
+			{mask_sum[i] = N;}
+
+			for (size_t i = 0 ; i < n ; i += vect::Size)
+			{
+				size_t cnt = (n - i < vect::Size)?n - i:vect::Size;
+
+				vect xs[N+1];
+
+				for (size_t s = 0 ; s < N+1 ; s++)
+				{xs[s] = row::load(base_src,stride_src,stl.stencil_offset[s] + i,cnt);}
+
+				vect res = func(xs,mask_sum,args ...);
+
+				row::store(res,base_dst,stride_dst,stl.stencil_offset[0] + i,cnt);
+			}
+		});
+	}
+
+	/*! \brief Convolution with the cross stencil
+	 *
+	 * \see conv_dense_cross_impl
+	 *
+	 */
+	template<bool is_contiguous, unsigned int prop_src, unsigned int prop_dst, typename grid_type, typename lambda_f, typename ... ArgsT>
+	static void conv_cross(grid_key_dx<dim> & start, grid_key_dx<dim> & stop, grid_type & grid, lambda_f & func, ArgsT & ... args)
+	{
+		conv_dense_cross_impl<dim>::template conv_cross<is_contiguous,prop_src,prop_dst>(start,stop,grid,func,args ...);
+	}
+};
+
+#endif
+
+#endif /* GRID_BASE_CONV_OPT_HPP_ */
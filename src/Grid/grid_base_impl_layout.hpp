@@ -13,6 +13,7 @@
 #include <boost/fusion/include/for_each.hpp>
 #include "memory_ly/Encap.hpp"
 #include "Space/Shape/Box.hpp"
+#include "Grid/Geometry/grid_brick_traits.hpp"
 
 /*! \brief this class is a functor for "for_each" algorithm
  *
@@ -108,7 +109,7 @@ struct frswap_nomode
 template<typename S, typename layout, typename data_type, typename g1_type, unsigned int sel = 2*is_layout_mlin<layout>::value + is_layout_inte<layout>::value >
 struct mem_setm
 {
-	static inline void setMemory(data_type & data_, const g1_type & g1, bool & is_mem_init)
+	static inline void setMemory(data_type & data_, const g1_type & g1, bool & is_mem_init, bool skip_init = false)
 	{
 		S * mem = new S();
 
@@ -116,7 +117,7 @@ struct mem_setm
 		data_.setMemory(*mem);
 
 		//! Allocate the memory and create the representation
-		if (g1.size() != 0) data_.allocate(g1.size());
+		if (g1.size() != 0) data_.allocate(grid_storage_size(g1),skip_init);
 
 		is_mem_init = true;
 	}
@@ -126,10 +127,10 @@ struct mem_setm
 template<typename S, typename layout, typename data_type, typename g1_type>
 struct mem_setm<S,layout,data_type,g1_type,1>
 {
-	static inline void setMemory(data_type & data_, const g1_type & g1, bool & is_mem_init)
+	static inline void setMemory(data_type & data_, const g1_type & g1, bool & is_mem_init, bool skip_init = false)
 	{
 		//! Create an allocate object
-		allocate<S> all(g1.size());
+		allocate<S> all(grid_storage_size(g1));
 
 		//! for each element in the vector allocate the buffer
 		boost::fusion::for_each(data_,all);
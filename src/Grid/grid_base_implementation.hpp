@@ -13,6 +13,8 @@
 #include "cuda/cuda_grid_gpu_funcs.cuh"
 #include "util/create_vmpl_sequence.hpp"
 #include "util/object_si_di.hpp"
+#include "grid_base_conv_opt.hpp"
+#include "util/prp_trivially_copyable.hpp"
 
 constexpr int DATA_ON_HOST = 32;
 constexpr int DATA_ON_DEVICE = 64;
@@ -360,6 +362,51 @@ struct copy_grid_fast_caller<index_tuple_sq<prp ...>>
 	}
 };
 
+/*! \brief Copy with memcpy the first n elements of each property component of a grid with memory_traits_inte
+ *
+ * The components of an array property are stored with a stride equal to the number of elements of the grid
+ *
+ * \tparam T type of the grid elements
+ * \tparam grid_type grid
+ *
+ */
+template<typename T, typename grid_type>
+struct resize_memcpy_prp
+{
+	//! destination grid
+	grid_type & dst;
+
+	//! source grid
+	grid_type & src;
+
+	//! number of elements to copy
+	size_t n;
+
+	//! constructor
+	inline resize_memcpy_prp(grid_type & dst, grid_type & src, size_t n)
+	:dst(dst),src(src),n(n)
+	{};
+
+	//! Copy the property
+	template<typename prp_type>
+	inline void operator()(prp_type & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,prp_type>::type ele_type;
+		typedef typename std::remove_all_extents<ele_type>::type scalar_type;
+
+		size_t n_comp = sizeof(ele_type) / sizeof(scalar_type);
+		char * base_dst = (char *)dst.template getPointer<prp_type::value>();
+		char * base_src = (char *)src.template getPointer<prp_type::value>();
+
+		for (size_t c = 0 ; c < n_comp ; c++)
+		{
+			memcpy(base_dst + c*dst.getGrid().size()*sizeof(scalar_type),
+				   base_src + c*src.getGrid().size()*sizeof(scalar_type),
+				   n*sizeof(scalar_type));
+		}
+	}
+};
+
 /*! \brief
  *
  * Implementation of a N-dimensional grid
@@ -583,12 +630,115 @@ private:
 #endif
 	}
 
-	void resize_impl_host(const size_t (& sz)[dim], grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new)
+	//! true if resize can relocate the elements with memcpy (trivially copyable properties, standard linearization)
+	typedef std::integral_constant<bool,prp_trivially_copyable<typename T::type>::value &&
+										std::is_same<ord_type,grid_sm<dim,void>>::value &&
+										(is_layout_inte<layout_base<T>>::value || is_layout_mlin<layout_base<T>>::value)> resize_memcpy;
+
+	/*! \brief Check if resize can copy the old elements with memcpy
+	 *
+	 * The kept elements must be the first elements of both the grids, it is the case of a vector (1D grid),
+	 * or of a grid that change only the size of the last dimension
+	 *
+	 * \param sz new size
+	 *
+	 * \return true if the elements can be copied with memcpy
+	 *
+	 */
+	bool resize_is_memcpy(const size_t (& sz)[dim]) const
+	{
+		if (resize_memcpy::value == false)
+		{return false;}
+
+		for (size_t i = 0 ; i + 1 < dim ; i++)
+		{
+			if (g1.size(i) != sz[i])
+			{return false;}
+		}
+
+		return true;
+	}
+
+	/*! \brief Copy the old elements in the resized grid, one memcpy for the grid (memory_traits_lin)
+	 *
+	 * T::type is a boost::fusion::vector and is not trivially copyable itself, the copy is done on the
+	 * raw bytes because resize_memcpy guarantee that all its members are trivially copyable
+	 *
+	 * \param grid_new resized grid
+	 * \param n number of elements to copy
+	 * \param init_tail if true the new elements are constructed (the memory has been allocated without initialization)
+	 *
+	 */
+	void resize_memcpy_layout(grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new, size_t n, bool init_tail, std::false_type)
+	{
+		typedef typename T::type T_type;
+
+		void * dst = grid_new.getPointer();
+
+		if (n != 0)
+		{memcpy(dst,getPointer(),n*sizeof(T_type));}
+
+		size_t n_tot = grid_storage_size(grid_new.g1);
+
+		if (init_tail == true)
+		{
+			for (size_t i = n ; i < n_tot ; i++)
+			{new (static_cast<char *>(dst) + i*sizeof(T_type)) T_type();}
+		}
+	}
+
+	/*! \brief Copy the old elements in the resized grid, one memcpy for each property component (memory_traits_inte)
+	 *
+	 * \param grid_new resized grid
+	 * \param n number of elements to copy
+	 * \param init_tail unused (memory_traits_inte does not construct the elements)
+	 *
+	 */
+	void resize_memcpy_layout(grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new, size_t n, bool init_tail, std::true_type)
+	{
+		if (n == 0)
+		{return;}
+
+		resize_memcpy_prp<T,grid_base_impl<dim,T,S,layout_base,ord_type>> cp(grid_new,*this,n);
+
+		boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(cp);
+	}
+
+	/*! \brief The elements cannot be copied with memcpy (never called)
+	 *
+	 */
+	void resize_impl_memcpy(size_t n, grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new, bool init_tail, std::false_type)
+	{}
+
+	/*! \brief Copy the old elements in the resized grid with memcpy
+	 *
+	 * \param n number of elements to copy
+	 * \param grid_new resized grid
+	 * \param init_tail if true the new elements are constructed
+	 *
+	 */
+	void resize_impl_memcpy(size_t n, grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new, bool init_tail, std::true_type)
+	{
+		resize_memcpy_layout(grid_new,n,init_tail,typename is_layout_inte<layout_base<T>>::type());
+	}
+
+	void resize_impl_host(const size_t (& sz)[dim], grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new, bool init_tail = false)
 	{
 		size_t sz_c[dim];
 		for (size_t i = 0 ; i < dim ; i++)
 		{sz_c[i] = (g1.size(i) < sz[i])?g1.size(i):sz[i];}
 
+		// Trivially copyable properties are relocated with memcpy
+		if (resize_is_memcpy(sz) == true)
+		{
+			size_t n = 1;
+			for (size_t i = 0 ; i < dim ; i++)
+			{n *= sz_c[i];}
+
+			resize_impl_memcpy(n,grid_new,init_tail,resize_memcpy());
+			return;
+		}
+
 		grid_sm<dim,void> g1_c(sz_c);
 
 		//! create a source grid iterator
@@ -607,7 +757,7 @@ private:
 		}
 	}
 
-	void resize_impl_memset(grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new)
+	void resize_impl_memset(grid_base_impl<dim,T,S,layout_base,ord_type> & grid_new, bool skip_init = false)
 	{
 		//! Set the allocator and allocate the memory
 		if (isExternal == true)
@@ -615,7 +765,7 @@ private:
 			mem_setext<typename std::remove_reference<decltype(grid_new)>::type,S,layout_base<T>,decltype(data_)>::set(grid_new,*this,this->data_);
 		}
 		else
-			grid_new.setMemory();
+			grid_new.setMemory_impl(skip_init);
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
 
@@ -698,7 +848,7 @@ public:
 	 * \return itself
 	 *
 	 */
-	grid_base_impl<dim,T,S,layout_base> & operator=(const grid_base_impl<dim,T,S,layout_base> & g)
+	grid_base_impl<dim,T,S,layout_base,ord_type> & operator=(const grid_base_impl<dim,T,S,layout_base,ord_type> & g)
 	{
 		swap(g.duplicate());
 
@@ -719,7 +869,7 @@ public:
 	 * \return itself
 	 *
 	 */
-	grid_base_impl<dim,T,S,layout_base> & operator=(grid_base_impl<dim,T,S,layout_base> && g)
+	grid_base_impl<dim,T,S,layout_base,ord_type> & operator=(grid_base_impl<dim,T,S,layout_base,ord_type> && g)
 	{
 		swap(g);
 
@@ -739,11 +889,14 @@ public:
 	 * \return true if they match
 	 *
 	 */
-	bool operator==(const grid_base_impl<dim,T,S,layout_base> & g)
+	bool operator==(const grid_base_impl<dim,T,S,layout_base,ord_type> & g)
 	{
 		// check if the have the same size
-		if (g1 != g.g1)
-			return false;
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			if (g1.size(i) != g.g1.size(i))
+				return false;
+		}
 
 		auto it = getIterator();
 
@@ -765,11 +918,16 @@ public:
 	 * \return a duplicated version of the grid
 	 *
 	 */
-	grid_base_impl<dim,T,S,layout_base> duplicate() const THROW
+	grid_base_impl<dim,T,S,layout_base,ord_type> duplicate() const THROW
 	{
 		//! Create a completely new grid with sz
 
-		grid_base_impl<dim,T,S,layout_base> grid_new(g1.getSize());
+		size_t sz[dim];
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{sz[i] = g1.size(i);}
+
+		grid_base_impl<dim,T,S,layout_base,ord_type> grid_new(sz);
 
 		//! Set the allocator and allocate the memory
 		grid_new.setMemory();
@@ -785,7 +943,7 @@ public:
 			//! N-D copy
 
 			//! create a source grid iterator
-			grid_key_dx_iterator<dim> it(g1);
+			auto it = getIterator();
 
 			while(it.isNext())
 			{
@@ -846,7 +1004,19 @@ public:
 
 	void setMemory()
 	{
-		mem_setm<S,layout_base<T>,decltype(this->data_),decltype(this->g1)>::setMemory(data_,g1,is_mem_init);
+		setMemory_impl(false);
+	}
+
+	/*! \brief Create the object that provide memory
+	 *
+	 * \param skip_init if true the elements are not constructed (memory_traits_lin)
+	 *
+	 */
+	void setMemory_impl(bool skip_init)
+	{
+		mem_setm<S,layout_base<T>,decltype(this->data_),decltype(this->g1)>::setMemory(data_,g1,is_mem_init,skip_init);
+
+		CONTAINER_STAT_GRID_ALLOC(grid_storage_size(g1)*sizeof(T));
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
 
@@ -887,7 +1057,7 @@ public:
 
 		bool skip_ini = skip_init<has_noPointers<T>::value,T>::skip_();
 
-		mem_setmemory<decltype(data_),S,layout_base<T>>::template setMemory<p>(data_,m,g1.size(),skip_ini);
+		mem_setmemory<decltype(data_),S,layout_base<T>>::template setMemory<p>(data_,m,grid_storage_size(g1),skip_ini);
 
 		is_mem_init = true;
 
@@ -916,7 +1086,7 @@ public:
 
 		bool skip_ini = skip_init<has_noPointers<T>::value,T>::skip_();
 
-		mem_setmemory<decltype(data_),S,layout_base<T>>::template setMemoryArray(*this,m,g1.size(),skip_ini);
+		mem_setmemory<decltype(data_),S,layout_base<T>>::template setMemoryArray(*this,m,grid_storage_size(g1),skip_ini);
 
 		is_mem_init = true;
 
@@ -1222,7 +1392,7 @@ public:
 			std::cout << "Error: " << __FILE__ << ":" << __LINE__ << " unsupported fill operation " << std::endl;
 		}
 
-		memset(getPointer(),fl,size() * sizeof(T));
+		memset(getPointer(),fl,grid_storage_size(g1) * sizeof(T));
 	}
 
 	/*! \brief Remove all the points in this region
@@ -1266,7 +1436,7 @@ public:
 	 * \param box_dst destination box
 	 *
 	 */
-	void copy_to(const grid_base_impl<dim,T,S,layout_base> & grid_src,
+	void copy_to(const grid_base_impl<dim,T,S,layout_base,ord_type> & grid_src,
 			     const Box<dim,long int> & box_src,
 				 const Box<dim,long int> & box_dst)
 	{
@@ -1302,9 +1472,7 @@ public:
 			}
 		}
 
-        typedef typename to_int_sequence<0,T::max_prop>::type result;
-
-        copy_grid_fast_caller<result>::call(*this,grid_src,box_src_,box_dst_);
+        copy_to_impl(grid_src,box_src_,box_dst_,typename grid_brick_edge<ord_type>::type());
 
 /*        copy_grid_fast<!is_contiguos<prp...>::type::value || has_pack_gen<typename device_grid::value_type>::value,
                                    dim,
@@ -1318,6 +1486,68 @@ public:
 		/////////////////////////////////////////
 	}
 
+	/*! \brief copy the box_src of grid_src into the box_dst of this grid (linearizer like grid_sm)
+	 *
+	 * \param grid_src source grid
+	 * \param box_src source box
+	 * \param box_dst destination box
+	 *
+	 */
+	void copy_to_impl(const grid_base_impl<dim,T,S,layout_base,ord_type> & grid_src,
+			          const Box<dim,size_t> & box_src,
+			          const Box<dim,size_t> & box_dst,
+			          std::false_type)
+	{
+        typedef typename to_int_sequence<0,T::max_prop>::type result;
+
+        copy_grid_fast_caller<result>::call(*this,grid_src,box_src,box_dst);
+	}
+
+	/*! \brief copy the box_src of grid_src into the box_dst of this grid (grids stored in bricks)
+	 *
+	 * The destination box is processed in segments of rows contained in one brick, every segment is
+	 * divided again at the borders of the bricks of the source, inside a piece both the source and the
+	 * destination points are contiguous. The rows are copied in parallel
+	 *
+	 * \param grid_src source grid
+	 * \param box_src source box
+	 * \param box_dst destination box
+	 *
+	 */
+	void copy_to_impl(const grid_base_impl<dim,T,S,layout_base,ord_type> & grid_src,
+			          const Box<dim,size_t> & box_src,
+			          const Box<dim,size_t> & box_dst,
+			          std::true_type)
+	{
+		const long int B = grid_brick_edge<ord_type>::value;
+
+		grid_key_dx<dim> shift;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{shift.set_d(i,(long int)box_src.getLow(i) - (long int)box_dst.getLow(i));}
+
+		grid_for_each_segment(g1,box_dst.getKP1(),box_dst.getKP2(),[&](const grid_key_dx<dim> & key, long int lin, size_t n, size_t id)
+		{
+			grid_key_dx<dim> key_src = key + shift;
+			long int x0 = key_src.get(0);
+
+			size_t i = 0;
+			while (i < n)
+			{
+				long int x_src = x0 + i;
+				size_t n_src = std::min((size_t)(B - x_src % B),n - i);
+
+				key_src.set_d(0,x_src);
+				long int lin_src = grid_src.g1.LinId(key_src);
+
+				for (size_t j = 0 ; j < n_src ; j++)
+				{this->get_o(lin + i + j) = grid_src.get_o(lin_src + j);}
+
+				i += n_src;
+			}
+		});
+	}
+
 	/*! \brief copy an external grid into a specific place into this grid
 	 *
 	 * It copy the area indicated by the  box_src from grid_src into this grid
@@ -1329,7 +1559,7 @@ public:
 	 *
 	 */
 	template<unsigned int ... prp>
-	void copy_to_prp(const grid_base_impl<dim,T,S,layout_base> & grid_src,
+	void copy_to_prp(const grid_base_impl<dim,T,S,layout_base,ord_type> & grid_src,
 			     const Box<dim,size_t> & box_src,
 				 const Box<dim,size_t> & box_dst)
 	{
@@ -1368,7 +1598,7 @@ public:
 	 *
 	 */
 	template<template<typename,typename> class op, unsigned int ... prp>
-	void copy_to_op(const grid_base_impl<dim,T,S,layout_base> & gs,
+	void copy_to_op(const grid_base_impl<dim,T,S,layout_base,ord_type> & gs,
 			     const Box<dim,size_t> & bx_src,
 				 const Box<dim,size_t> & bx_dst)
 	{
@@ -1413,12 +1643,15 @@ public:
 
 		grid_base_impl<dim,T,S,layout_base,ord_type> grid_new(sz);
 
-		resize_impl_memset(grid_new);
+		// Elements relocated with memcpy does not need to be constructed
+		bool skip_init = (opt & DATA_ON_HOST) && isExternal == false && resize_is_memcpy(sz);
+
+		resize_impl_memset(grid_new,skip_init);
 
 		//! N-D copy
 
 		if (opt & DATA_ON_HOST)
-		{resize_impl_host(sz,grid_new);}
+		{resize_impl_host(sz,grid_new,skip_init);}
 
 		if (opt & DATA_ON_DEVICE && S::isDeviceHostSame() == false)
 		{resize_impl_device(sz,grid_new,blockSize);}
@@ -1445,10 +1678,13 @@ public:
 	{
 		//! Create a completely new grid with sz
 
-		grid_base_impl<dim,T,S,layout_base> grid_new(sz);
+		grid_base_impl<dim,T,S,layout_base,ord_type> grid_new(sz);
+
+		// Elements relocated with memcpy does not need to be constructed
+		bool skip_init = isExternal == false && resize_is_memcpy(sz);
 
-		resize_impl_memset(grid_new);
-		resize_impl_host(sz,grid_new);
+		resize_impl_memset(grid_new,skip_init);
+		resize_impl_host(sz,grid_new,skip_init);
 
 		this->swap(grid_new);
 	}
@@ -1505,7 +1741,7 @@ public:
 	 *
 	 */
 
-	void swap_nomode(grid_base_impl<dim,T,S,layout_base> & grid)
+	void swap_nomode(grid_base_impl<dim,T,S,layout_base,ord_type> & grid)
 	{
 		mem_swap<T,layout_base<T>,decltype(data_),decltype(grid)>::template swap_nomode<S>(data_,grid.data_);
 
@@ -1564,7 +1800,7 @@ public:
 	 *
 	 */
 
-	void swap(grid_base_impl<dim,T,S,layout_base> && grid)
+	void swap(grid_base_impl<dim,T,S,layout_base,ord_type> && grid)
 	{
 		swap(grid);
 	}
@@ -1602,7 +1838,7 @@ public:
 #endif
 
 		// create the object to copy the properties
-		copy_cpu_encap<dim,grid_base_impl<dim,T,S,layout_base>,layout> cp(dx,*this,obj);
+		copy_cpu_encap<dim,grid_base_impl<dim,T,S,layout_base,ord_type>,layout> cp(dx,*this,obj);
 
 		// copy each property
 		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(cp);
@@ -1637,7 +1873,7 @@ public:
 	 */
 
 	inline void set(const grid_key_dx<dim> & key1,
-			        const grid_base_impl<dim,T,S,layout_base> & g,
+			        const grid_base_impl<dim,T,S,layout_base,ord_type> & g,
 					const grid_key_dx<dim> & key2)
 	{
 #ifdef SE_CLASS1
@@ -1658,7 +1894,7 @@ public:
 	 */
 
 	inline void set(const size_t key1,
-			        const grid_base_impl<dim,T,S,layout_base> & g,
+			        const grid_base_impl<dim,T,S,layout_base,ord_type> & g,
 					const size_t key2)
 	{
 #ifdef SE_CLASS1
@@ -1943,6 +2179,142 @@ public:
 		return grid_key_dx_iterator_sub<dim>(gvoid,start,stop);
 	}
 
+	/*! \brief Return a parallel tiled iterator over the grid
+	 *
+	 * \see grid_key_dx_iterator_par
+	 *
+	 * \return a parallel iterator
+	 *
+	 */
+	inline grid_key_dx_iterator_par<dim,no_stencil,linearizer_type> getIteratorPar() const
+	{
+		grid_key_dx<dim> start;
+		grid_key_dx<dim> stop;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			start.set_d(i,0);
+			stop.set_d(i,(long int)g1.size(i) - 1);
+		}
+
+		return grid_key_dx_iterator_par<dim,no_stencil,linearizer_type>(g1,start,stop);
+	}
+
+	/*! \brief Return a parallel tiled iterator over all the points between start and stop
+	 *
+	 * \see grid_key_dx_iterator_par
+	 *
+	 * \param start start point
+	 * \param stop stop point (included)
+	 *
+	 * \return a parallel iterator
+	 *
+	 */
+	inline grid_key_dx_iterator_par<dim,no_stencil,linearizer_type> getIteratorPar(const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop) const
+	{
+		return grid_key_dx_iterator_par<dim,no_stencil,linearizer_type>(g1,start,stop);
+	}
+
+	/*! \brief Return a parallel tiled iterator with stencil over all the points between start and stop
+	 *
+	 * The stencil points of all the points between start and stop must be inside the grid
+	 *
+	 * \see grid_key_dx_iterator_par
+	 *
+	 * \param start start point
+	 * \param stop stop point (included)
+	 * \param stencil_pnt stencil points
+	 *
+	 * \return a parallel iterator with stencil
+	 *
+	 */
+	template<unsigned int Np>
+	inline grid_key_dx_iterator_par<dim,stencil_offset_compute<dim,Np>,linearizer_type>
+	getIteratorStencilPar(const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop, const grid_key_dx<dim> (& stencil_pnt)[Np]) const
+	{
+		return grid_key_dx_iterator_par<dim,stencil_offset_compute<dim,Np>,linearizer_type>(g1,start,stop,stencil_pnt);
+	}
+
+#ifdef GRID_BASE_CONV_USE_VC
+
+	/*! \brief apply a convolution from start to stop point using the stencil and the function func
+	 *
+	 * func(Vc::Vector<prop_type> (& xs)[N+1], unsigned char * mask_sum, args ...) return the vector of
+	 * results, xs[0] contain the values of prop_src at the points and xs[s] the values at the stencil
+	 * point s-1. The rows are processed in parallel in blocks of Vc::Vector<prop_type>::Size points.
+	 * The lambda is the same of the sparse grid, for a dense grid mask_sum is always N
+	 *
+	 * \tparam prop_src source property
+	 * \tparam prop_dst destination property
+	 * \tparam stencil_size unused (for compatibility with the sparse grid)
+	 *
+	 * \param stencil stencil points (relative to the point)
+	 * \param start point
+	 * \param stop point (the stencil must be inside the grid for all the points between start and stop)
+	 * \param func lambda function
+	 * \param args arguments to pass
+	 *
+	 */
+	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, unsigned int N, typename lambda_f, typename ... ArgsT >
+	void conv(int (& stencil)[N][dim], grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
+	{
+		static_assert(grid_brick_edge<ord_type>::value == 0,"conv is not available for grids stored in bricks");
+
+		if (conv_is_contiguous<prop_src,prop_dst>() == true)
+		{conv_dense_impl<dim>::template conv<true,prop_src,prop_dst>(stencil,start,stop,*this,func,args ...);}
+		else
+		{conv_dense_impl<dim>::template conv<false,prop_src,prop_dst>(stencil,start,stop,*this,func,args ...);}
+	}
+
+	/*! \brief apply a convolution with the cross stencil from start to stop point using the function func
+	 *
+	 * func(Vc::Vector<prop_type> & cmd, cross_stencil_v<prop_type> & s, unsigned char * mask_sum, args ...)
+	 * return the vector of results, cmd contain the values of prop_src at the points, s the values of
+	 * the neighborhood points. The lambda is the same of the sparse grid, for a dense grid mask_sum
+	 * is always 6 (only 3D)
+	 *
+	 * \tparam prop_src source property
+	 * \tparam prop_dst destination property
+	 * \tparam stencil_size unused (for compatibility with the sparse grid)
+	 *
+	 * \param start point
+	 * \param stop point (the stencil must be inside the grid for all the points between start and stop)
+	 * \param func lambda function
+	 * \param args arguments to pass
+	 *
+	 */
+	template<unsigned int prop_src, unsigned int prop_dst, unsigned int stencil_size, typename lambda_f, typename ... ArgsT >
+	void conv_cross(grid_key_dx<dim> start, grid_key_dx<dim> stop , lambda_f func, ArgsT ... args)
+	{
+		static_assert(grid_brick_edge<ord_type>::value == 0,"conv_cross is not available for grids stored in bricks");
+
+		if (conv_is_contiguous<prop_src,prop_dst>() == true)
+		{conv_dense_impl<dim>::template conv_cross<true,prop_src,prop_dst>(start,stop,*this,func,args ...);}
+		else
+		{conv_dense_impl<dim>::template conv_cross<false,prop_src,prop_dst>(start,stop,*this,func,args ...);}
+	}
+
+	/*! \brief Check if consecutive points of prop_src and prop_dst are contiguous in memory
+	 *
+	 * \return true if they are contiguous (memory_traits_inte or one property)
+	 *
+	 */
+	template<unsigned int prop_src, unsigned int prop_dst>
+	bool conv_is_contiguous()
+	{
+		typedef typename boost::mpl::at<typename T::type, boost::mpl::int_<prop_src>>::type prop_type_src;
+		typedef typename boost::mpl::at<typename T::type, boost::mpl::int_<prop_dst>>::type prop_type_dst;
+
+		size_t stride_src;
+		size_t stride_dst;
+		conv_dense_base<prop_src>(*this,stride_src);
+		conv_dense_base<prop_dst>(*this,stride_dst);
+
+		return stride_src == sizeof(prop_type_src) && stride_dst == sizeof(prop_type_dst);
+	}
+
+#endif
+
 	/*! \brief return the internal data_
 	 *
 	 * return the internal data_
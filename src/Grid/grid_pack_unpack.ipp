@@ -283,7 +283,9 @@ struct unpack_simple_cond<true, prp ...>
 	 *
 	 */
 	template<int ... prp> inline void pack(ExtPreAlloc<S> & mem, Pack_stat & sts) const
-	{	
+	{
+		CONTAINER_STAT_SCOPE(CSTAT_TIME_PACK);
+
 		//If all of the aggregate properties are simple (don't have "pack()" member)
 		if (has_pack_agg<T,prp...>::result::value == false)
 		{
@@ -377,39 +379,312 @@ struct unpack_simple_cond<true, prp ...>
 	 */
 	template<int ... prp> void pack(ExtPreAlloc<S> & mem, grid_key_dx_iterator_sub<dims> & sub_it, Pack_stat & sts)
 	{
+		CONTAINER_STAT_SCOPE(CSTAT_TIME_PACK);
+
 #ifdef SE_CLASS1
 		if (mem.ref() == 0)
 			std::cerr << "Error : " << __FILE__ << ":" << __LINE__ << " the reference counter of mem should never be zero when packing \n";
 #endif
 
-		// Sending property object
+		// Sending property object (for every layout an array of objects with the selected properties, see unpack)
 		typedef object<typename object_creator<typename grid_base_impl<dim,T,S,layout_base,ord_type>::value_type::type,prp...>::type> prp_object;
-		typedef openfpm::vector<prp_object,ExtPreAlloc<S>, layout_base,openfpm::grow_policy_identity> dtype;
+		typedef openfpm::vector<prp_object,ExtPreAlloc<S>, memory_traits_lin,openfpm::grow_policy_identity> dtype;
 
 		// Create an object over the preallocated memory (No allocation is produced)
 		dtype dest;
 		dest.setMemory(mem);
 		dest.resize(sub_it.getVolume());
 
+		pack_sub<prp...>(sub_it,dest);
+
+		// Update statistic
+		sts.incReq();
+	}
+
+	/*! \brief Pack a sub-grid into an object created over the preallocated memory
+	 *
+	 * The segments of contiguous points of the sub-grid are packed in parallel (see pack_with_iterator_par)
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param sub_it sub grid iterator
+	 * \param dest where to pack
+	 *
+	 */
+	template<int ... prp, typename dtype> void pack_sub(grid_key_dx_iterator_sub<dims> & sub_it, dtype & dest)
+	{
 		// copy all the object in the send buffer
 		typedef encapc<dims,value_type,layout > encap_src;
 		// destination object type
-		typedef encapc<1,prp_object,typename dtype::layout_type > encap_dst;
+		typedef encapc<1,typename dtype::value_type,typename dtype::layout_type > encap_dst;
+
+		typedef pack_with_iterator_par<pack_zero_copy<prp...>::value,
+									   dims,
+									   decltype(*this),
+									   encap_src,
+									   encap_dst,
+									   typename grid_base_impl<dim,T,S,layout_base,ord_type>::value_type::type,
+									   grid_key_dx_iterator_sub<dims>,
+									   dtype,
+									   prp...> packer;
+
+		packer::pack(*this,sub_it,dest);
+	}
+
+	/*! \brief Pack several sub-grids concurrently
+	 *
+	 * The result is the same of calling pack(mem,sub_its.get(i),sts) for each sub-grid in order. The space
+	 * of each sub-grid is reserved in mem in order (each sub-grid is packed at a precomputed offset) and the
+	 * sub-grids are packed in parallel, one sub-grid for each thread. When there are less sub-grids than
+	 * threads the sub-grids are packed one after the other and each one is packed in parallel. With
+	 * only one thread it calls pack for each sub-grid, without opening any parallel region
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param mem preallocated memory where to pack the objects (see packRequest)
+	 * \param sub_its sub-grid iterators
+	 * \param sts pack statistic
+	 *
+	 */
+	template<int ... prp> void packMulti(ExtPreAlloc<S> & mem, openfpm::vector<grid_key_dx_iterator_sub<dims>> & sub_its, Pack_stat & sts)
+	{
+		CONTAINER_STAT_SCOPE(CSTAT_TIME_PACK);
+
+#ifdef SE_CLASS1
+		if (mem.ref() == 0)
+			std::cerr << "Error : " << __FILE__ << ":" << __LINE__ << " the reference counter of mem should never be zero when packing \n";
+#endif
+
+		long int n_sub = sub_its.size();
+		long int nth = openfpm::omp::get_max_threads();
+
+		if (nth == 1)
+		{
+			for (long int i = 0 ; i < n_sub ; i++)
+			{pack<prp...>(mem,sub_its.get(i),sts);}
+
+			return;
+		}
+
+		// Sending property object (see pack)
+		typedef object<typename object_creator<typename grid_base_impl<dim,T,S,layout_base,ord_type>::value_type::type,prp...>::type> prp_object;
+		typedef openfpm::vector<prp_object,ExtPreAlloc<S>, memory_traits_lin,openfpm::grow_policy_identity> dtype;
+
+		// reserve the space of each sub-grid (No allocation is produced)
+		std::vector<dtype> dest(n_sub);
+
+		for (long int i = 0 ; i < n_sub ; i++)
+		{
+			dest[i].setMemory(mem);
+			dest[i].resize(sub_its.get(i).getVolume());
+		}
+
+		#pragma omp parallel for schedule(dynamic) if (n_sub >= nth)
+		for (long int i = 0 ; i < n_sub ; i++)
+		{pack_sub<prp...>(sub_its.get(i),dest[i]);}
+
+		// Update statistic
+		for (long int i = 0 ; i < n_sub ; i++)
+		{sts.incReq();}
+	}
+
+
+	/*! \brief Add the segments of memory of a sub-grid for one property
+	 *
+	 * The rows of the sub-grid along the dimension 0 are contiguous in memory, for grids stored
+	 * in bricks they are cut at the border of the bricks
+	 *
+	 * \tparam p property (with memory_traits_lin all the properties are stored together)
+	 * \tparam ele_type type stored in the memory of the property
+	 *
+	 * \param sub_it sub-grid iterator
+	 * \param segs list of segments
+	 *
+	 */
+	template<unsigned int p, typename ele_type>
+	void sub_grid_segments(grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs)
+	{
+		static const long int B = grid_brick_edge<ord_type>::value;
+
+		const grid_key_dx<dims> & start = sub_it.getStart();
+		const grid_key_dx<dims> & stop = sub_it.getStop();
+
+		size_t n_rows = 1;
+
+		for (size_t i = 0 ; i < dims ; i++)
+		{
+			if (stop.get(i) < start.get(i))	{return;}
+
+			if (i != 0)
+			{n_rows *= stop.get(i) - start.get(i) + 1;}
+		}
+
+		char * base = (char *)this->template getPointer<p>();
+
+		grid_key_dx<dims> key;
+
+		for (size_t r = 0 ; r < n_rows ; r++)
+		{
+			size_t rr = r;
+
+			for (size_t i = 1 ; i < dims ; i++)
+			{
+				size_t ext = stop.get(i) - start.get(i) + 1;
+				key.set_d(i,start.get(i) + rr % ext);
+				rr /= ext;
+			}
+
+			long int x = start.get(0);
+			while (x <= stop.get(0))
+			{
+				long int x_end = (B == 0)?stop.get(0):std::min((long int)stop.get(0),(x / B + 1)*B - 1);
+
+				key.set_d(0,x);
+				segs.add(base + this->getGrid().LinId(key)*sizeof(ele_type),(x_end - x + 1)*sizeof(ele_type));
+
+				x = x_end + 1;
+			}
+		}
+	}
+
+	//! It add the segments of a sub-grid for each property
+	template<typename grid_type>
+	struct sub_grid_segments_prp
+	{
+		//! grid
+		grid_type & g;
+
+		//! sub-grid iterator
+		grid_key_dx_iterator_sub<dims> & sub_it;
+
+		//! list of segments
+		pack_segment_list & segs;
+
+		//! constructor
+		inline sub_grid_segments_prp(grid_type & g, grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs)
+		:g(g),sub_it(sub_it),segs(segs)
+		{};
+
+		//! It add the segments of the property
+		template<typename prp_type>
+		inline void operator()(prp_type & t)
+		{
+			typedef typename boost::mpl::at<typename T::type,prp_type>::type ele_type;
+
+			g.template sub_grid_segments<prp_type::value,ele_type>(sub_it,segs);
+		}
+	};
+
+	/*! \brief Add the segments of a sub-grid (memory_traits_lin, all the properties)
+	 *
+	 */
+	template<int ... prp>
+	inline void sub_grid_segments_layout(grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs, std::false_type)
+	{
+		sub_grid_segments<0,typename T::type>(sub_it,segs);
+	}
+
+	/*! \brief Add the segments of a sub-grid (memory_traits_inte, the array of the property)
+	 *
+	 */
+	template<int ... prp>
+	inline void sub_grid_segments_layout(grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs, std::true_type)
+	{
+		sub_grid_segments_prp<decltype(*this)> sgs(*this,sub_it,segs);
+
+		boost::mpl::for_each_ref<typename to_boost_vmpl<prp...>::type>(sgs);
+	}
+
+	/*! \brief Check if the packed sub-grid has the same layout of the memory of the grid
+	 *
+	 * pack and unpack store the sub-grid as an array of objects with the selected properties, the rows
+	 * of the sub-grid match the memory of the grid with memory_traits_inte and one scalar property, or
+	 * with memory_traits_lin and all the properties
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 */
+	template<int ... prp>
+	struct pack_zero_copy
+	{
+		typedef object<typename object_creator<typename T::type,prp...>::type> prp_object;
 
-		pack_with_iterator<sizeof...(prp) != T::max_prop || has_pack_gen<prp_object>::value,
-						   dims,
-						   decltype(*this),
-						   encap_src,
-						   encap_dst,
-						   typename grid_base_impl<dim,T,S,layout_base,ord_type>::value_type::type,
-						   grid_key_dx_iterator_sub<dims>,
-						   dtype,
-						   prp...>::pack(*this,sub_it,dest);
+		static const bool value = has_pack_gen<prp_object>::value == false &&
+								  ((is_layout_inte<layout_base_>::value && sizeof...(prp) == 1 && pack_prp_scalar<typename T::type,prp...>::value) ||
+								   (is_layout_inte<layout_base_>::value == false && sizeof...(prp) != 0 && pack_prp_all<T::max_prop,prp...>::value));
+	};
+
+	/*! \brief Pack a sub-grid as a list of segments (the layout match, no copy)
+	 *
+	 */
+	template<int ... prp>
+	inline void packSegments_impl(ExtPreAlloc<S> & mem, grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs, Pack_stat & sts, std::true_type)
+	{
+		sub_grid_segments_layout<prp...>(sub_it,segs,typename is_layout_inte<layout_base_>::type());
 
 		// Update statistic
 		sts.incReq();
 	}
 
+	/*! \brief Pack a sub-grid as a list of segments (the layout does not match, the sub-grid is packed in mem)
+	 *
+	 */
+	template<int ... prp>
+	inline void packSegments_impl(ExtPreAlloc<S> & mem, grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs, Pack_stat & sts, std::false_type)
+	{
+		size_t off = mem.getOffsetEnd();
+
+		pack<prp...>(mem,sub_it,sts);
+
+		segs.addCopy((char *)mem.getPointerBase() + off,mem.getOffsetEnd() - off);
+	}
+
+	/*! \brief Pack a sub-grid as a list of segments (scatter/gather)
+	 *
+	 * Concatenating the segments give exactly the bytes produced by pack(mem,sub_it,sts). When
+	 * the packed sub-grid has the same layout of the grid (memory_traits_inte with one scalar property,
+	 * or memory_traits_lin with all the properties) the segments point to the contiguous rows of the
+	 * sub-grid in the memory of the grid and nothing is copied, otherwise the sub-grid is packed in mem
+	 * and the segment point to mem. The segments pointing to the grid are valid until the grid is modified
+	 *
+	 * \tparam prp properties to pack
+	 *
+	 * \param mem preallocated memory used when the sub-grid must be copied
+	 * \param sub_it sub-grid iterator
+	 * \param segs list of segments where to add the segments of the sub-grid
+	 * \param sts pack statistic
+	 *
+	 */
+	template<int ... prp> void packSegments(ExtPreAlloc<S> & mem, grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs, Pack_stat & sts)
+	{
+		packSegments_impl<prp...>(mem,sub_it,segs,sts,std::integral_constant<bool,pack_zero_copy<prp...>::value>());
+	}
+
+	/*! \brief Get the segments of the grid where a packed sub-grid can be received directly
+	 *
+	 * When the layout of the message produced by pack(mem,sub_it,sts) match the memory of the grid
+	 * (memory_traits_inte with one scalar property, or memory_traits_lin with all the properties) the
+	 * message can be received (or copied with pack_segment_list::scatter) directly into the segments
+	 * and no unpack is needed. Otherwise the function return false and the message must be unpacked
+	 * with unpack
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param sub_it sub-grid iterator
+	 * \param segs list of segments where to add the segments of the sub-grid
+	 *
+	 * \return true if the segments has been added
+	 *
+	 */
+	template<unsigned int ... prp> bool unpackSegments(grid_key_dx_iterator_sub<dims> & sub_it, pack_segment_list & segs)
+	{
+		if (pack_zero_copy<prp...>::value == false)
+		{return false;}
+
+		sub_grid_segments_layout<prp...>(sub_it,segs,typename is_layout_inte<layout_base_>::type());
+
+		return true;
+	}
 
 	/*! \brief Insert an allocation request
 	 *
@@ -458,21 +733,90 @@ struct unpack_simple_cond<true, prp ...>
 		src.setMemory(ptr);
 		src.resize(sub_it.getVolume());
 
+		unpack_sub<prp...>(sub_it,src);
+
+		ps.addOffset(size);
+	}
+
+	/*! \brief Unpack a sub-grid from an object created over the received memory
+	 *
+	 * The segments of contiguous points of the sub-grid are unpacked in parallel (see unpack_with_iterator_par)
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param sub_it sub-grid iterator
+	 * \param src packed sub-grid
+	 *
+	 */
+	template<unsigned int ... prp, typename stype> void unpack_sub(grid_key_dx_iterator_sub<dims> & sub_it, stype & src)
+	{
 		// copy all the object in the send buffer
 		typedef encapc<dims,typename grid_base_impl<dim,T,S,layout_base,ord_type>::value_type,layout > encap_dst;
 		// destination object type
-		typedef encapc<1,prp_object,typename memory_traits_lin<prp_object>::type > encap_src;
+		typedef encapc<1,typename stype::value_type,typename memory_traits_lin<typename stype::value_type>::type > encap_src;
+
+		typedef unpack_with_iterator_par<pack_zero_copy<prp...>::value,
+										 dims,
+										 decltype(*this),
+										 encap_src,
+										 encap_dst,
+										 grid_key_dx_iterator_sub<dims>,
+										 stype,
+										 prp...> unpacker;
+
+		unpacker::unpack(*this,sub_it,src);
+	}
 
-		unpack_with_iterator<dims,
-							 decltype(*this),
-							 encap_src,
-							 encap_dst,
-							 typename grid_base_impl<dim,T,S,layout_base,ord_type>::value_type::type,
-							 grid_key_dx_iterator_sub<dims>,
-							 stype,
-							 prp...>::unpack(*this,sub_it,src);
+	/*! \brief Unpack several sub-grids concurrently
+	 *
+	 * It unpack the message produced by packMulti (or by pack called for each sub-grid in order), the
+	 * offset of each sub-grid in mem is precomputed and the sub-grids are unpacked in parallel (see packMulti).
+	 * With only one thread the sub-grids are unpacked one after the other, without opening any parallel region
+	 *
+	 * \tparam prp properties to unpack
+	 *
+	 * \param mem preallocated memory from where to unpack the sub-grids
+	 * \param sub_its sub-grid iterators
+	 * \param ps unpack statistic
+	 *
+	 */
+	template<unsigned int ... prp,typename S2>
+	void unpackMulti(ExtPreAlloc<S2> & mem, openfpm::vector<grid_key_dx_iterator_sub<dims>> & sub_its, Unpack_stat & ps)
+	{
+		// object that store the information in mem
+		typedef object<typename object_creator<typename grid_base_impl<dim,T,S,layout_base,ord_type>::value_type::type,prp...>::type> prp_object;
+		typedef openfpm::vector<prp_object,PtrMemory, memory_traits_lin ,openfpm::grow_policy_identity> stype;
 
-		ps.addOffset(size);
+		long int n_sub = sub_its.size();
+
+		std::vector<stype> src(n_sub);
+
+		for (long int i = 0 ; i < n_sub ; i++)
+		{
+			size_t size = stype::template calculateMem(sub_its.get(i).getVolume(),0);
+
+			// Create an object over the preallocated memory (No allocation is produced)
+			PtrMemory & ptr = *(new PtrMemory(mem.getPointerOffset(ps.getOffset()),size));
+
+			src[i].setMemory(ptr);
+			src[i].resize(sub_its.get(i).getVolume());
+
+			ps.addOffset(size);
+		}
+
+		long int nth = openfpm::omp::get_max_threads();
+
+		if (nth == 1)
+		{
+			for (long int i = 0 ; i < n_sub ; i++)
+			{unpack_sub<prp...>(sub_its.get(i),src[i]);}
+
+			return;
+		}
+
+		#pragma omp parallel for schedule(dynamic) if (n_sub >= nth)
+		for (long int i = 0 ; i < n_sub ; i++)
+		{unpack_sub<prp...>(sub_its.get(i),src[i]);}
 	}
 
 	/*! \brief unpack the sub-grid object applying an operation
@@ -558,3 +902,200 @@ struct unpack_simple_cond<true, prp ...>
 	}
 	
 
+	//! It add the memory of each property of the grid for a checkpoint
+	template<typename grid_type>
+	struct grid_checkpoint_prp
+	{
+		//! grid
+		grid_type & g;
+
+		//! list of segments
+		pack_segment_list & segs;
+
+		//! number of elements stored
+		size_t n;
+
+		//! constructor
+		inline grid_checkpoint_prp(grid_type & g, pack_segment_list & segs, size_t n)
+		:g(g),segs(segs),n(n)
+		{};
+
+		//! It add the memory of the property
+		template<typename prp_type>
+		inline void operator()(prp_type & t)
+		{
+			// with memory_traits_lin there is a single memory with all the properties
+			typedef typename std::conditional<is_layout_inte<layout_base_>::value,
+											  typename boost::mpl::at<typename T::type,prp_type>::type,
+											  T>::type ele_type;
+
+			segs.add(g.template getPointer<prp_type::value>(),n*sizeof(ele_type));
+		}
+	};
+
+	//! It set the memory of each property of the grid over a mapped checkpoint
+	template<typename grid_type>
+	struct grid_checkpoint_map
+	{
+		//! grid
+		grid_type & g;
+
+		//! pointer to the mapped data
+		char * ptr;
+
+		//! number of elements stored
+		size_t n;
+
+		//! constructor
+		inline grid_checkpoint_map(grid_type & g, char * ptr, size_t n)
+		:g(g),ptr(ptr),n(n)
+		{};
+
+		//! It set the memory of the property
+		template<typename prp_type>
+		inline void operator()(prp_type & t)
+		{
+			// with memory_traits_lin there is a single memory with all the properties
+			typedef typename std::conditional<is_layout_inte<layout_base_>::value,
+											  typename boost::mpl::at<typename T::type,prp_type>::type,
+											  T>::type ele_type;
+
+			PtrMemory & mem = *(new PtrMemory(ptr,n*sizeof(ele_type)));
+			g.template setMemory<prp_type::value>(mem);
+
+			ptr += n*sizeof(ele_type);
+		}
+	};
+
+	//! number of memories of the grid (one for memory_traits_lin, one for each property for memory_traits_inte)
+	typedef boost::mpl::range_c<int,0,(is_layout_inte<layout_base_>::value)?T::max_prop:1> checkpoint_prp_range;
+
+	/*! \brief Fill the header of a checkpoint of this grid
+	 *
+	 * \param h header
+	 *
+	 */
+	void checkpointHeader(checkpoint_header & h) const
+	{
+		static_assert(dim <= CHECKPOINT_MAX_DIM,"grid dimensionality bigger than CHECKPOINT_MAX_DIM");
+
+		h.kind = CHECKPOINT_GRID;
+		h.type_hash = checkpoint_type_hash<T>();
+		h.lin_hash = checkpoint_name_hash<ord_type>();
+		h.is_inte = is_layout_inte<layout_base_>::value;
+		h.dim = dim;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{h.sz[i] = g1.size(i);}
+
+		h.n_ele = g1.size();
+	}
+
+	/*! \brief Allocate the grid to receive the checkpoint
+	 *
+	 * The content of the grid is not preserved
+	 *
+	 * \param h header of the checkpoint
+	 *
+	 * \return false if the checkpoint does not contain a grid of this type
+	 *
+	 */
+	bool checkpointPrepare(const checkpoint_header & h)
+	{
+		if (h.match(CHECKPOINT_GRID,checkpoint_type_hash<T>(),checkpoint_name_hash<ord_type>(),is_layout_inte<layout_base_>::value,dim) == false)
+		{return false;}
+
+		size_t sz[dim];
+		bool same = true;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			sz[i] = h.sz[i];
+			same &= (sz[i] == g1.size(i));
+		}
+
+		if (same == true && is_mem_init == true)
+		{return true;}
+
+		grid_base_impl<dim,T,S,layout_base,ord_type> tmp(sz);
+		tmp.setMemory();
+		swap(tmp);
+
+		return true;
+	}
+
+	/*! \brief Called after the segments of the checkpoint has been read
+	 *
+	 * \return true
+	 *
+	 */
+	bool checkpointFinalize()
+	{
+		return true;
+	}
+
+	/*! \brief Get the segments of memory that a checkpoint of this grid contain
+	 *
+	 * The segments are the memory of the grid (one for memory_traits_lin, one for each property
+	 * for memory_traits_inte), padding included. The grid must not contain objects with pointers
+	 *
+	 * \param segs list of segments where to add the segments of the grid
+	 *
+	 */
+	void checkpointSegments(pack_segment_list & segs) const
+	{
+		static_assert(has_pack_agg<T>::result::value == false,"a checkpoint require a grid of objects without pointers");
+
+		typedef grid_base_impl<dim,T,S,layout_base,ord_type> self;
+
+		grid_checkpoint_prp<self> gc(const_cast<self &>(*this),segs,grid_storage_size(g1));
+
+		boost::mpl::for_each_ref<checkpoint_prp_range>(gc);
+	}
+
+	/*! \brief Create the grid over a mapped checkpoint (no copy)
+	 *
+	 * The grid use the memory of the mapping, it must be a grid with PtrMemory
+	 *
+	 * \param mp mapped checkpoint
+	 *
+	 * \return false if the checkpoint does not contain a grid of this type
+	 *
+	 */
+	bool checkpointMap(checkpoint_mapping & mp)
+	{
+		static_assert(std::is_same<S,PtrMemory>::value,"checkpointMap require a grid with PtrMemory");
+		static_assert(has_pack_agg<T>::result::value == false,"a checkpoint require a grid of objects without pointers");
+
+		const checkpoint_header & h = mp.getHeader();
+
+		if (h.match(CHECKPOINT_GRID,checkpoint_type_hash<T>(),checkpoint_name_hash<ord_type>(),is_layout_inte<layout_base_>::value,dim) == false)
+		{return false;}
+
+		size_t sz[dim];
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{sz[i] = h.sz[i];}
+
+		typedef grid_base_impl<dim,T,S,layout_base,ord_type> self;
+
+		self tmp(sz);
+
+		// the grid must cover exactly the data of the checkpoint
+		size_t ele_size = (is_layout_inte<layout_base_>::value)?checkpoint_prp_size<T>():sizeof(T);
+
+		if (grid_storage_size(tmp.getGrid())*ele_size != h.data_size)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error, the size of the checkpoint does not match the grid" << std::endl;
+			return false;
+		}
+
+		grid_checkpoint_map<self> gm(tmp,(char *)mp.getData(),grid_storage_size(tmp.getGrid()));
+
+		boost::mpl::for_each_ref<checkpoint_prp_range>(gm);
+
+		swap(tmp);
+
+		return true;
+	}
+
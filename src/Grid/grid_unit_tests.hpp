@@ -772,6 +772,62 @@ BOOST_AUTO_TEST_CASE(grid_resize_less)
 	BOOST_REQUIRE_EQUAL(g1.size(),25ul);
 }
 
+template<typename grid_type>
+inline void test_grid_resize_keep(size_t (& sz1)[2], size_t (& sz2)[2])
+{
+	grid_type g(sz1);
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 1000*key.get(1);
+		g.template get<1>(key)[2] = key.get(0) - key.get(1);
+
+		++it;
+	}
+
+	g.resize(sz2);
+
+	size_t sz_c[2] = {std::min(sz1[0],sz2[0]),std::min(sz1[1],sz2[1])};
+	grid_sm<2,void> gc(sz_c);
+	grid_key_dx_iterator<2> it2(gc);
+
+	bool match = true;
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g.template get<0>(key) == key.get(0) + 1000*key.get(1);
+		match &= g.template get<1>(key)[2] == key.get(0) - key.get(1);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE(grid_resize_memcpy)
+{
+	typedef aggregate<double,float[3]> T;
+
+	// only the last dimension change (memcpy), the first dimension change (element copy)
+	size_t sz1[] = {37,20};
+	size_t sz2[] = {37,45};
+	size_t sz3[] = {40,45};
+	size_t sz4[] = {37,11};
+
+	test_grid_resize_keep<grid_cpu<2,T>>(sz1,sz2);
+	test_grid_resize_keep<grid_cpu<2,T>>(sz1,sz3);
+	test_grid_resize_keep<grid_cpu<2,T>>(sz1,sz4);
+
+	test_grid_resize_keep<grid_base<2,T,HeapMemory,typename memory_traits_inte<T>::type>>(sz1,sz2);
+	test_grid_resize_keep<grid_base<2,T,HeapMemory,typename memory_traits_inte<T>::type>>(sz1,sz3);
+	test_grid_resize_keep<grid_base<2,T,HeapMemory,typename memory_traits_inte<T>::type>>(sz1,sz4);
+}
+
 BOOST_AUTO_TEST_CASE(copy_encap_vector_fusion_test)
 {
 	size_t sz2[] = {5,5};
@@ -837,6 +893,518 @@ BOOST_AUTO_TEST_CASE(grid_test_copy_to)
 }
 
 
+template<typename grid_type>
+inline void test_grid_conv_cross()
+{
+	typedef typename boost::mpl::at<typename grid_type::value_type::type,boost::mpl::int_<0>>::type prop_type;
+
+	size_t sz[] = {37,21,18};
+	grid_type g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0)*key.get(0) + 2*key.get(1) + key.get(2)*key.get(2)*key.get(2);
+		g.template get<1>(key) = -1;
+
+		++it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({35,19,16});
+
+	g.template conv_cross<0,1,1>(start,stop,[](Vc::Vector<prop_type> & cmd, cross_stencil_v<prop_type> & s, unsigned char * mask_sum)
+	{
+		Vc::Vector<prop_type> Lap = s.xm + s.xp + s.ym + s.yp + s.zm + s.zp - prop_type(6)*cmd;
+
+		Vc::Mask<prop_type> surround;
+
+		for (size_t i = 0 ; i < Vc::Vector<prop_type>::Size ; i++)
+		{surround[i] = (mask_sum[i] == 6);}
+
+		return Vc::iif(surround,Lap,Vc::Vector<prop_type>(prop_type(0)));
+	});
+
+	bool match = true;
+	auto it2 = g.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		bool inside = true;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{inside &= key.get(i) >= start.get(i) && key.get(i) <= stop.get(i);}
+
+		// Laplacian of x^2 + 2y + z^3 is 2 + 6z
+		prop_type expected = (inside == true)?prop_type(2 + 6*key.get(2)):prop_type(-1);
+
+		match &= g.template get<1>(key) == expected;
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE(grid_conv_cross_test)
+{
+	test_grid_conv_cross<grid_cpu<3,aggregate<double,double>>>();
+	test_grid_conv_cross<grid_cpu<3,aggregate<float,float>>>();
+	test_grid_conv_cross<grid_base<3,aggregate<double,double>,HeapMemory,typename memory_traits_inte<aggregate<double,double>>::type>>();
+	test_grid_conv_cross<grid_base<3,aggregate<float,float>,HeapMemory,typename memory_traits_inte<aggregate<float,float>>::type>>();
+}
+
+BOOST_AUTO_TEST_CASE(grid_conv_stencil_test)
+{
+	size_t sz[] = {45,30};
+	grid_base<2,aggregate<double,double>,HeapMemory,typename memory_traits_inte<aggregate<double,double>>::type> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 100*key.get(1);
+		g.template get<1>(key) = 0.0;
+
+		++it;
+	}
+
+	grid_key_dx<2> start({2,1});
+	grid_key_dx<2> stop({42,28});
+
+	// forward differences in x (two points) and y
+	int stencil[3][2] = {{1,0},{2,0},{0,1}};
+
+	g.template conv<0,1,1>(stencil,start,stop,[](Vc::double_v (& xs)[4], unsigned char * mask_sum)
+	{
+		return xs[1] + xs[2] + xs[3] - 3.0*xs[0];
+	});
+
+	bool match = true;
+	auto it2 = g.getIterator(start,stop);
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g.template get<1>(key) == 103.0;
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(g.template get<1>(grid_key_dx<2>({1,1})),0.0);
+}
+
+
+template<typename grid_type>
+inline void test_grid_blocked()
+{
+	size_t sz[] = {37,21,18};
+	grid_type g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0)*key.get(0) + 2*key.get(1) + key.get(2)*key.get(2)*key.get(2);
+		g.template get<1>(key) = 0;
+
+		++it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({35,19,16});
+
+	// every point is visited once by the parallel iterator and its rows
+
+	auto itp = g.getIteratorPar(start,stop);
+	size_t tile[3] = {5,3,2};
+	itp.setTileSize(tile);
+
+	BOOST_REQUIRE_EQUAL(itp.getTileSize(0) % grid_brick_edge<typename grid_type::linearizer_type>::value,0ul);
+
+	// the rows are cut at the border of the blocks, so the points of a row are contiguous in memory
+	itp.forEachRow([&](const grid_key_dx<3> & key, size_t n)
+	{
+		long int lin = g.getGrid().LinId(key);
+		grid_key_dx<3> k = key;
+
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			k.set_d(0,key.get(0) + i);
+			g.template get<1>(lin + i) += (g.getGrid().LinId(k) == lin + (long int)i)?1:100;
+		}
+	});
+
+	itp.forEach([&](const grid_key_dx<3> & key)
+	{
+		g.template get<1>(key) += 1;
+	});
+
+	bool match = true;
+	auto it2 = g.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		bool inside = true;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{inside &= key.get(i) >= start.get(i) && key.get(i) <= stop.get(i);}
+
+		match &= g.template get<0>(key) == key.get(0)*key.get(0) + 2*key.get(1) + key.get(2)*key.get(2)*key.get(2);
+		match &= g.template get<1>(key) == ((inside == true)?2:0);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// Laplacian with the parallel iterator
+
+	grid_key_dx<3> star_stencil[7] = {{0,0,0},{-1,0,0},{1,0,0},{0,-1,0},{0,1,0},{0,0,-1},{0,0,1}};
+
+	g.getIteratorStencilPar(start,stop,star_stencil).forEach([&](const grid_key_dx<3> & key, const stencil_offset_compute<3,7> & stl)
+	{
+		g.template get<1>(stl.template getStencil<0>()) = g.template get<0>(stl.template getStencil<1>()) + g.template get<0>(stl.template getStencil<2>()) +
+														  g.template get<0>(stl.template getStencil<3>()) + g.template get<0>(stl.template getStencil<4>()) +
+														  g.template get<0>(stl.template getStencil<5>()) + g.template get<0>(stl.template getStencil<6>()) -
+														  6*g.template get<0>(stl.template getStencil<0>());
+	});
+
+	match = true;
+	auto it3 = g.getIterator(start,stop);
+
+	while (it3.isNext())
+	{
+		auto key = it3.get();
+
+		// Laplacian of x^2 + 2y + z^3 is 2 + 6z
+		match &= g.template get<1>(key) == 2 + 6*key.get(2);
+
+		++it3;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// copy, assignment and duplicate are deep and keep the blocks
+
+	grid_type g_cp(g);
+	grid_type g_as;
+	g_as = g;
+	grid_type g_dp;
+	g_dp = g.duplicate();
+
+	auto same = [&](grid_type & g_a)
+	{
+		bool m = true;
+		auto it = g.getIterator();
+
+		while (it.isNext())
+		{
+			auto key = it.get();
+
+			m &= g_a.template get<0>(key) == g.template get<0>(key);
+			m &= g_a.template get<1>(key) == g.template get<1>(key);
+
+			++it;
+		}
+
+		return m;
+	};
+
+	BOOST_REQUIRE_EQUAL(same(g_cp),true);
+	BOOST_REQUIRE_EQUAL(same(g_as),true);
+	BOOST_REQUIRE_EQUAL(same(g_dp),true);
+	BOOST_REQUIRE(&g_cp.template get<0>(start) != &g.template get<0>(start));
+	BOOST_REQUIRE(&g_as.template get<0>(start) != &g.template get<0>(start));
+
+	g.template get<0>(start) = -1;
+
+	BOOST_REQUIRE(g_cp.template get<0>(start) == 4);
+	BOOST_REQUIRE(g_as.template get<0>(start) == 4);
+	BOOST_REQUIRE(g_dp.template get<0>(start) == 4);
+	BOOST_REQUIRE_EQUAL(same(g_dp),false);
+
+	grid_type g_mv;
+	g_mv = std::move(g_cp);
+	g_mv.swap(g_as);
+
+	match = true;
+	auto it4 = g_mv.getIterator();
+
+	while (it4.isNext())
+	{
+		auto key = it4.get();
+
+		match &= g_mv.template get<0>(key) == key.get(0)*key.get(0) + 2*key.get(1) + key.get(2)*key.get(2)*key.get(2);
+		match &= g_as.template get<0>(key) == g_mv.template get<0>(key);
+
+		++it4;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
+BOOST_AUTO_TEST_CASE(grid_blocked_iterators_test)
+{
+	test_grid_blocked<grid_cpu<3,aggregate<float,float>,grid_smb<3,8>>>();
+	test_grid_blocked<grid_cpu<3,aggregate<float,float>,grid_smb<3,4>>>();
+	test_grid_blocked<grid_cpu<3,aggregate<float,float>,grid_zmb<3,4,long int>>>();
+	test_grid_blocked<grid_base<3,aggregate<float,float>,HeapMemory,typename memory_traits_inte<aggregate<float,float>>::type,grid_smb<3,8>>>();
+
+	// comparison of grids stored in blocks
+
+	size_t sz[] = {11,9,10};
+	grid_cpu<3,aggregate<float,float>,grid_smb<3,4>> g1(sz);
+	g1.setMemory();
+	g1.getIteratorPar().forEach([&](const grid_key_dx<3> & key)
+	{
+		g1.template get<0>(key) = key.get(0) + 10*key.get(1) + 100*key.get(2);
+		g1.template get<1>(key) = 1;
+	});
+
+	grid_cpu<3,aggregate<float,float>,grid_smb<3,4>> g2(g1);
+
+	BOOST_REQUIRE(g2 == g1);
+
+	g2.template get<1>(grid_key_dx<3>({10,8,9})) = 2;
+
+	BOOST_REQUIRE(!(g2 == g1));
+}
+
+BOOST_AUTO_TEST_CASE(grid_blocked_copy_pack_test)
+{
+	size_t sz[] = {37,21,18};
+	grid_cpu<3,aggregate<float,float[3]>,grid_smb<3,4>> g_src(sz);
+	grid_cpu<3,aggregate<float,float[3]>,grid_smb<3,4>> g_dst(sz);
+	grid_cpu<3,aggregate<float,float[3]>> g_ref(sz);
+	g_src.setMemory();
+	g_dst.setMemory();
+	g_ref.setMemory();
+
+	auto it = g_src.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g_src.template get<0>(key) = key.get(0) + 100*key.get(1) + 10000*key.get(2);
+		g_src.template get<1>(key)[0] = key.get(0);
+		g_src.template get<1>(key)[1] = key.get(1);
+		g_src.template get<1>(key)[2] = key.get(2);
+
+		g_dst.template get<0>(key) = -1;
+		g_ref.template get<0>(key) = -1;
+
+		++it;
+	}
+
+	// the boxes are not aligned to the bricks and not aligned between them
+
+	Box<3,long int> box_src({3,2,1},{20,17,13});
+	Box<3,long int> box_dst({6,1,3},{23,16,15});
+
+	g_dst.copy_to(g_src,box_src,box_dst);
+
+	bool match = true;
+	auto it2 = g_dst.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		bool inside = true;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{inside &= key.get(i) >= box_dst.getLow(i) && key.get(i) <= box_dst.getHigh(i);}
+
+		grid_key_dx<3> key_src = key;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{key_src.set_d(i,key.get(i) - box_dst.getLow(i) + box_src.getLow(i));}
+
+		match &= g_dst.template get<0>(key) == ((inside == true)?g_src.template get<0>(key_src):-1.0f);
+
+		if (inside == true)
+		{match &= g_dst.template get<1>(key)[2] == key_src.get(2);}
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// pack a sub-box of the bricked grid and unpack it in a grid_sm grid
+
+	grid_sm<3,void> ginfo(sz);
+	grid_key_dx_iterator_sub<3> sub(ginfo,{2,3,5},{30,12,17});
+
+	size_t req = 0;
+	g_src.template packRequest<0,1>(sub,req);
+
+	HeapMemory pmem;
+	pmem.allocate(req);
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	g_src.template pack<0,1>(mem,sub,sts);
+
+	Unpack_stat ps;
+	int gpuContext;
+	g_ref.template unpack<0,1>(mem,sub,ps,gpuContext,rem_copy_opt::NONE_OPT);
+
+	match = true;
+	sub.reset();
+
+	while (sub.isNext())
+	{
+		auto key = sub.get();
+
+		match &= g_ref.template get<0>(key) == g_src.template get<0>(key);
+		match &= g_ref.template get<1>(key)[0] == key.get(0);
+		match &= g_ref.template get<1>(key)[1] == key.get(1);
+
+		++sub;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// unpack again in a bricked grid
+
+	Unpack_stat ps2;
+	g_dst.template unpack<0,1>(mem,sub,ps2,gpuContext,rem_copy_opt::NONE_OPT);
+
+	match = true;
+	sub.reset();
+
+	while (sub.isNext())
+	{
+		auto key = sub.get();
+
+		match &= g_dst.template get<0>(key) == g_src.template get<0>(key);
+		match &= g_dst.template get<1>(key)[2] == key.get(2);
+
+		++sub;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	mem.decRef();
+	delete &mem;
+}
+
+template<typename grid, typename grid_map>
+inline void test_grid_checkpoint()
+{
+	size_t sz[] = {37,21,18};
+	grid g1(sz);
+	g1.setMemory();
+
+	auto it = g1.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g1.template get<0>(key) = key.get(0) + 100*key.get(1) + 10000*key.get(2);
+		g1.template get<1>(key)[0] = key.get(0);
+		g1.template get<1>(key)[1] = key.get(1);
+		g1.template get<1>(key)[2] = key.get(2);
+		g1.template get<2>(key) = key.get(2);
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(checkpoint_save("test_checkpoint_grid",g1),true);
+
+	// load in a grid of different size
+
+	size_t sz2[] = {5,5,5};
+	grid g2(sz2);
+	g2.setMemory();
+	BOOST_REQUIRE_EQUAL(checkpoint_load("test_checkpoint_grid",g2),true);
+
+	checkpoint_mapping mp;
+	BOOST_REQUIRE_EQUAL(mp.open("test_checkpoint_grid"),true);
+
+	grid_map g3;
+	BOOST_REQUIRE_EQUAL(g3.checkpointMap(mp),true);
+
+	for (size_t i = 0 ; i < 3 ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(g2.getGrid().size(i),sz[i]);
+		BOOST_REQUIRE_EQUAL(g3.getGrid().size(i),sz[i]);
+	}
+
+	bool match = true;
+	auto it2 = g1.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		match &= g1.template get<0>(key) == g2.template get<0>(key);
+		match &= g1.template get<0>(key) == g3.template get<0>(key);
+
+		for (size_t i = 0 ; i < 3 ; i++)
+		{
+			match &= g1.template get<1>(key)[i] == g2.template get<1>(key)[i];
+			match &= g1.template get<1>(key)[i] == g3.template get<1>(key)[i];
+		}
+
+		match &= g1.template get<2>(key) == g2.template get<2>(key);
+		match &= g1.template get<2>(key) == g3.template get<2>(key);
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the mapping is private, modify it does not change the file
+
+	g3.template get<0>(grid_key_dx<3>({0,0,0})) = -1.0;
+
+	grid g4;
+	BOOST_REQUIRE_EQUAL(checkpoint_load("test_checkpoint_grid",g4),true);
+	BOOST_REQUIRE_EQUAL(g4.template get<0>(grid_key_dx<3>({0,0,0})),0.0);
+
+	// a checkpoint with a data size that does not match the grid cannot be mapped
+
+	int fd = open("test_checkpoint_grid",O_RDWR);
+	size_t data_size = mp.getHeader().data_size - 8;
+	BOOST_REQUIRE_EQUAL(pwrite(fd,&data_size,sizeof(size_t),offsetof(checkpoint_header,data_size)),(ssize_t)sizeof(size_t));
+	close(fd);
+
+	checkpoint_mapping mp2;
+	BOOST_REQUIRE_EQUAL(mp2.open("test_checkpoint_grid"),true);
+
+	grid_map g5;
+	BOOST_REQUIRE_EQUAL(g5.checkpointMap(mp2),false);
+
+	remove("test_checkpoint_grid");
+}
+
+BOOST_AUTO_TEST_CASE(grid_checkpoint_test)
+{
+	typedef aggregate<float,float[3],double> T;
+
+	test_grid_checkpoint<grid_cpu<3,T>,grid_base<3,T,PtrMemory>>();
+	test_grid_checkpoint<grid_base<3,T,HeapMemory,typename memory_traits_inte<T>::type>,
+						 grid_base<3,T,PtrMemory,typename memory_traits_inte<T>::type>>();
+	test_grid_checkpoint<grid_cpu<3,T,grid_smb<3,4>>,grid_base<3,T,PtrMemory,typename memory_traits_lin<T>::type,grid_smb<3,4>>>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
@@ -220,6 +220,170 @@ BOOST_AUTO_TEST_CASE( grid_iterator_sub_stencil_test )
 
 
 
+BOOST_AUTO_TEST_CASE( grid_iterator_par_test )
+{
+	size_t sz[] = {67,45,39};
+	grid_cpu<3,aggregate<int>> gtest(sz);
+	gtest.setMemory();
+
+	grid_key_dx<3> start({3,0,5});
+	grid_key_dx<3> stop({60,44,20});
+
+	for (size_t t = 0 ; t < 3 ; t++)
+	{
+		auto it_z = gtest.getSubIterator(0);
+		while (it_z.isNext())
+		{
+			gtest.get<0>(it_z.get()) = 0;
+			++it_z;
+		}
+
+		auto it = gtest.getIteratorPar(start,stop);
+
+		// small tiles to have incomplete tiles on the border
+		if (t == 1)
+		{
+			size_t tile[3] = {16,7,3};
+			it.setTileSize(tile);
+		}
+
+		if (t == 2)
+		{
+			it.forEachRow([&](const grid_key_dx<3> & key, size_t n)
+			{
+				int * ptr = &gtest.get<0>(key);
+				for (size_t i = 0 ; i < n ; i++)
+				{ptr[i] += 1;}
+			});
+		}
+		else
+		{
+			it.forEach([&](const grid_key_dx<3> & key)
+			{
+				gtest.get<0>(key) += 1;
+			});
+		}
+
+		bool ret = true;
+		auto it2 = gtest.getSubIterator(0);
+
+		while (it2.isNext())
+		{
+			auto key = it2.get();
+
+			bool inside = true;
+			for (size_t i = 0 ; i < 3 ; i++)
+			{inside &= key.get(i) >= start.get(i) && key.get(i) <= stop.get(i);}
+
+			ret &= gtest.get<0>(key) == ((inside == true)?1:0);
+
+			++it2;
+		}
+
+		BOOST_REQUIRE_EQUAL(ret,true);
+	}
+
+	// full grid
+
+	auto it = gtest.getIteratorPar();
+	it.forEach([&](const grid_key_dx<3> & key)
+	{
+		gtest.get<0>(key) = 5;
+	});
+
+	bool ret = true;
+	auto it2 = gtest.getSubIterator(0);
+
+	while (it2.isNext())
+	{
+		ret &= gtest.get<0>(it2.get()) == 5;
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+}
+
+BOOST_AUTO_TEST_CASE( grid_iterator_par_stencil_test )
+{
+	size_t sz[] = {52,52,52};
+	grid_cpu<3,aggregate<long int>> gtest(sz);
+	gtest.setMemory();
+
+	auto it = gtest.getSubIterator(0);
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		gtest.get<0>(key) = key.get(0) + key.get(1) + key.get(2);
+
+		++it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({(long int)gtest.getGrid().size(0)-2,(long int)gtest.getGrid().size(1)-2,(long int)gtest.getGrid().size(2)-2});
+
+	auto itp = gtest.getIteratorStencilPar(start,stop,star_stencil_3D);
+
+	size_t cnt = 0;
+	size_t n_err = 0;
+
+	itp.forEach([&](const grid_key_dx<3> & key, const stencil_offset_compute<3,7> & stl)
+	{
+		long int sum = 6*gtest.get<0>(stl.getStencil<0>()) -
+					   gtest.get<0>(stl.getStencil<1>()) -
+					   gtest.get<0>(stl.getStencil<2>()) -
+					   gtest.get<0>(stl.getStencil<3>()) -
+					   gtest.get<0>(stl.getStencil<4>()) -
+					   gtest.get<0>(stl.getStencil<5>()) -
+					   gtest.get<0>(stl.getStencil<6>());
+
+		bool ok = (sum == 0) && (gtest.getGrid().LinId(key) == (long int)stl.getStencil<0>());
+
+		#pragma omp atomic
+		cnt++;
+
+		if (ok == false)
+		{
+			#pragma omp atomic
+			n_err++;
+		}
+	});
+
+	BOOST_REQUIRE_EQUAL(cnt,50ul*50ul*50ul);
+	BOOST_REQUIRE_EQUAL(n_err,0ul);
+
+	size_t cnt_row = 0;
+
+	itp.forEachRow([&](const grid_key_dx<3> & key, const stencil_offset_compute<3,7> & stl, size_t n)
+	{
+		long int * c = &gtest.get<0>(stl.getStencil<0>());
+		long int * xm = &gtest.get<0>(stl.getStencil<5>());
+		long int * xp = &gtest.get<0>(stl.getStencil<6>());
+		long int * ym = &gtest.get<0>(stl.getStencil<3>());
+		long int * yp = &gtest.get<0>(stl.getStencil<4>());
+		long int * zm = &gtest.get<0>(stl.getStencil<1>());
+		long int * zp = &gtest.get<0>(stl.getStencil<2>());
+
+		size_t err = 0;
+		for (size_t i = 0 ; i < n ; i++)
+		{err += (6*c[i] - xm[i] - xp[i] - ym[i] - yp[i] - zm[i] - zp[i]) != 0;}
+
+		#pragma omp atomic
+		cnt_row += n;
+
+		if (err != 0)
+		{
+			#pragma omp atomic
+			n_err += err;
+		}
+	});
+
+	BOOST_REQUIRE_EQUAL(cnt_row,50ul*50ul*50ul);
+	BOOST_REQUIRE_EQUAL(n_err,0ul);
+}
+
+
 BOOST_AUTO_TEST_CASE( grid_iterator_sub_bc )
 {
 	{
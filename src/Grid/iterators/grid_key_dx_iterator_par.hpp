@@ -0,0 +1,427 @@
+/*
+ * grid_key_dx_iterator_par.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef OPENFPM_DATA_SRC_GRID_ITERATORS_GRID_KEY_DX_ITERATOR_PAR_HPP_
+#define OPENFPM_DATA_SRC_GRID_ITERATORS_GRID_KEY_DX_ITERATOR_PAR_HPP_
+
+#include <cmath>
+#include "Grid/grid_key.hpp"
+#include "Grid/grid_sm.hpp"
+#include "Grid/Geometry/grid_brick_traits.hpp"
+#include "stencil_type.hpp"
+#include "util/openmp_util.hpp"
+
+//! Default number of points in a tile of grid_key_dx_iterator_par
+constexpr size_t GRID_ITERATOR_PAR_TILE_POINTS = 32768;
+
+/*! \brief Call the user functor of grid_key_dx_iterator_par (stencil version)
+ *
+ * The functor receive the stencil object, stl.getStencil<i>() return the linear
+ * id of the stencil point i
+ *
+ */
+template<typename stencil>
+struct grid_key_dx_iterator_par_call
+{
+	template<typename lambda_t, unsigned int dim>
+	static inline void element(lambda_t & f, const grid_key_dx<dim> & key, stencil & stl)
+	{
+		f(key,stl);
+		stl.increment();
+	}
+
+	template<typename lambda_t, unsigned int dim>
+	static inline void row(lambda_t & f, const grid_key_dx<dim> & key, stencil & stl, size_t n)
+	{
+		f(key,stl,n);
+	}
+};
+
+/*! \brief Call the user functor of grid_key_dx_iterator_par (no stencil)
+ *
+ */
+template<>
+struct grid_key_dx_iterator_par_call<no_stencil>
+{
+	template<typename lambda_t, unsigned int dim>
+	static inline void element(lambda_t & f, const grid_key_dx<dim> & key, no_stencil & stl)
+	{
+		f(key);
+	}
+
+	template<typename lambda_t, unsigned int dim>
+	static inline void row(lambda_t & f, const grid_key_dx<dim> & key, no_stencil & stl, size_t n)
+	{
+		f(key,n);
+	}
+};
+
+/*! \brief Iterate in parallel over the points of a grid (or of a sub-box of a grid)
+ *
+ * The box [start,stop] is divided in tiles of around GRID_ITERATOR_PAR_TILE_POINTS points,
+ * the tiles are distributed between the OpenMP threads. Inside a tile the points are visited row by
+ * row, where a row is a contiguous segment along the dimension 0 (the fastest in memory).
+ *
+ * \code
+ *
+ * auto it = g.getIteratorPar();
+ *
+ * // one call for each point
+ * it.forEach([&](const grid_key_dx<3> & key){g.template get<0>(key) = 1.0;});
+ *
+ * // one call for each row of n points starting at key (the inner loop can be vectorized)
+ * it.forEachRow([&](const grid_key_dx<3> & key, size_t n)
+ * {
+ *    double * ptr = &g.template get<0>(key);
+ *    for (size_t i = 0 ; i < n ; i++) {ptr[i] = 1.0;}
+ * });
+ *
+ * \endcode
+ *
+ * Inside a row the points of a property are contiguous when the grid has the memory_traits_inte layout
+ * (or when the grid has only one property)
+ *
+ * With a bricked linearizer (grid_smb, grid_zmb) the tiles are aligned to the bricks and the rows are
+ * cut at the border of the bricks, so that they remain contiguous in memory. In this case forEachRow
+ * is not available with a stencil (the stencil points of a row are not contiguous), and the stencil offsets
+ * are recalculated for each point
+ *
+ * With a stencil the functors receive also the stencil object, stl.getStencil<i>() return the linear
+ * id of the stencil point i (of the point key for forEach, of the first point of the row for forEachRow)
+ *
+ * \tparam dim dimensionality
+ * \tparam stencil stencil type (no_stencil or stencil_offset_compute)
+ * \tparam linearizer linearizer of the grid
+ *
+ */
+template<unsigned int dim, typename stencil = no_stencil, typename linearizer = grid_sm<dim,void>>
+class grid_key_dx_iterator_par
+{
+	//! edge of the bricks (0 if the grid is not stored in bricks)
+	static const unsigned int brick = grid_brick_edge<linearizer>::value;
+
+	//! divisor used to cut the rows at the border of the bricks
+	static const long int brick_div = (brick == 0)?1:brick;
+
+	//! information of the grid
+	linearizer g;
+
+	//! start point
+	grid_key_dx<dim> start;
+
+	//! stop point (included)
+	grid_key_dx<dim> stop;
+
+	//! origin of the tiles (start, or start aligned to the bricks)
+	grid_key_dx<dim> org;
+
+	//! size of the tile in each direction
+	size_t tile[dim];
+
+	//! number of tiles in each direction
+	size_t n_tiles[dim];
+
+	//! total number of tiles
+	size_t tot_tiles;
+
+	//! stencil points
+	stencil stl_code;
+
+	/*! \brief Calculate the number of tiles
+	 *
+	 */
+	void calc_n_tiles()
+	{
+		tot_tiles = 1;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			org.set_d(i,start.get(i) - start.get(i) % brick_div);
+
+			long int ext = stop.get(i) - org.get(i) + 1;
+
+			if (ext <= 0)
+			{
+				tot_tiles = 0;
+				n_tiles[i] = 0;
+				continue;
+			}
+
+			n_tiles[i] = (ext + tile[i] - 1) / tile[i];
+			tot_tiles *= n_tiles[i];
+		}
+	}
+
+	/*! \brief Choose the tile size
+	 *
+	 * the rows are kept complete (up to the size of the tile), the remaining
+	 * points are distributed equally in the other directions. For bricked grids
+	 * the tile sizes are multiple of the brick edge
+	 *
+	 * \param tile_points target number of points in a tile
+	 *
+	 */
+	void calc_tile(size_t tile_points)
+	{
+		size_t ext0 = (stop.get(0) >= start.get(0))?stop.get(0) - start.get(0) + 1:1;
+		tile[0] = std::max((size_t)1,std::min(ext0,tile_points));
+
+		if (dim > 1)
+		{
+			size_t rows = std::max((size_t)1,tile_points / tile[0]);
+			size_t t = std::max((size_t)1,(size_t)(std::pow((double)rows,1.0 / (dim-1)) + 1e-9));
+
+			for (size_t i = 1 ; i < dim ; i++)
+			{tile[i] = t;}
+		}
+
+		round_tile();
+		calc_n_tiles();
+	}
+
+	/*! \brief Round the tile sizes to a multiple of the brick edge
+	 *
+	 */
+	void round_tile()
+	{
+		for (size_t i = 0 ; i < dim ; i++)
+		{tile[i] = (tile[i] + brick_div - 1) / brick_div * brick_div;}
+	}
+
+	/*! \brief Call f for the row starting at key
+	 *
+	 * \param f functor
+	 * \param key start of the row
+	 * \param stl stencil offsets of key
+	 * \param n number of points in the row
+	 *
+	 */
+	template<typename lambda_t>
+	inline void iterate_row(lambda_t & f, const grid_key_dx<dim> & key, stencil & stl, size_t n, std::true_type)
+	{
+		grid_key_dx_iterator_par_call<stencil>::row(f,key,stl,n);
+	}
+
+	/*! \brief Call f for each point of the row starting at key
+	 *
+	 * \param f functor
+	 * \param key start of the row
+	 * \param stl stencil offsets of key
+	 * \param n number of points in the row
+	 *
+	 */
+	template<typename lambda_t>
+	inline void iterate_row(lambda_t & f, const grid_key_dx<dim> & key, stencil & stl, size_t n, std::false_type)
+	{
+		grid_key_dx<dim> key_e = key;
+
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			key_e.set_d(0,key.get(0) + i);
+
+			// on bricked grids the stencil points of consecutive points are not at distance one
+			if (brick != 0 && i != 0)
+			{stl.calc_offsets(g,key_e);}
+
+			grid_key_dx_iterator_par_call<stencil>::element(f,key_e,stl);
+		}
+	}
+
+	/*! \brief Iterate over the points of a tile
+	 *
+	 * \param t tile id
+	 * \param f functor
+	 *
+	 */
+	template<bool is_row, typename lambda_t>
+	inline void iterate_tile(size_t t, lambda_t & f)
+	{
+		grid_key_dx<dim> t_start;
+		grid_key_dx<dim> t_stop;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			size_t ti = t % n_tiles[i];
+			t /= n_tiles[i];
+
+			long int t_org = org.get(i) + ti*tile[i];
+
+			t_start.set_d(i,std::max((long int)start.get(i),t_org));
+			t_stop.set_d(i,std::min((long int)stop.get(i),t_org + (long int)tile[i] - 1));
+		}
+
+		grid_key_dx<dim> key = t_start;
+		stencil stl = stl_code;
+
+		while (true)
+		{
+			// the row is cut at the border of the bricks
+
+			long int x = t_start.get(0);
+			while (x <= t_stop.get(0))
+			{
+				long int x_end = (brick == 0)?t_stop.get(0):std::min((long int)t_stop.get(0),(x / brick_div + 1)*brick_div - 1);
+
+				key.set_d(0,x);
+				stl.calc_offsets(g,key);
+
+				iterate_row(f,key,stl,x_end - x + 1,std::integral_constant<bool,is_row>());
+
+				x = x_end + 1;
+			}
+
+			key.set_d(0,t_start.get(0));
+
+			// next row
+
+			size_t i = 1;
+			for ( ; i < dim ; i++)
+			{
+				if (key.get(i) < t_stop.get(i))
+				{
+					key.set_d(i,key.get(i) + 1);
+					break;
+				}
+
+				key.set_d(i,t_start.get(i));
+			}
+
+			if (i >= dim)	{break;}
+		}
+	}
+
+	/*! \brief Distribute the tiles between the threads
+	 *
+	 * \param f functor
+	 *
+	 */
+	template<bool is_row, typename lambda_t>
+	void iterate(lambda_t & f)
+	{
+		long int n_t = tot_tiles;
+
+		#pragma omp parallel for schedule(static) if (n_t > 1)
+		for (long int t = 0 ; t < n_t ; t++)
+		{iterate_tile<is_row>(t,f);}
+	}
+
+public:
+
+	/*! \brief Iterate over the box [start,stop] of the grid g
+	 *
+	 * \param g grid information
+	 * \param start start point
+	 * \param stop stop point (included)
+	 *
+	 */
+	grid_key_dx_iterator_par(const linearizer & g, const grid_key_dx<dim> & start, const grid_key_dx<dim> & stop)
+	:g(g),start(start),stop(stop)
+	{
+		calc_tile(GRID_ITERATOR_PAR_TILE_POINTS);
+	}
+
+	/*! \brief Iterate over the box [start,stop] of the grid g with a stencil
+	 *
+	 * \param g grid information
+	 * \param start start point
+	 * \param stop stop point (included)
+	 * \param stencil_pnt stencil points
+	 *
+	 */
+	template<unsigned int Np>
+	grid_key_dx_iterator_par(const linearizer & g,
+							 const grid_key_dx<dim> & start,
+							 const grid_key_dx<dim> & stop,
+							 const grid_key_dx<dim> (& stencil_pnt)[Np])
+	:g(g),start(start),stop(stop)
+	{
+		stl_code.set_stencil(stencil_pnt);
+		calc_tile(GRID_ITERATOR_PAR_TILE_POINTS);
+	}
+
+	/*! \brief Set the tile size
+	 *
+	 * For bricked grids the size is rounded up to a multiple of the brick edge
+	 *
+	 * \param sz size of the tile in each direction
+	 *
+	 */
+	void setTileSize(const size_t (& sz)[dim])
+	{
+		for (size_t i = 0 ; i < dim ; i++)
+		{tile[i] = std::max((size_t)1,sz[i]);}
+
+		round_tile();
+		calc_n_tiles();
+	}
+
+	/*! \brief Set the tile size from the number of points in a tile
+	 *
+	 * \param tile_points number of points in a tile
+	 *
+	 */
+	void setTilePoints(size_t tile_points)
+	{
+		calc_tile(tile_points);
+	}
+
+	/*! \brief Get the size of the tile
+	 *
+	 * \param i direction
+	 *
+	 * \return the size of the tile in direction i
+	 *
+	 */
+	size_t getTileSize(size_t i) const
+	{
+		return tile[i];
+	}
+
+	/*! \brief Get the number of tiles
+	 *
+	 * \return the number of tiles
+	 *
+	 */
+	size_t getNTiles() const
+	{
+		return tot_tiles;
+	}
+
+	/*! \brief Call f for each point
+	 *
+	 * f(const grid_key_dx<dim> & key) or f(const grid_key_dx<dim> & key, const stencil & stl)
+	 * is called in parallel, f must be thread safe
+	 *
+	 * \param f functor
+	 *
+	 */
+	template<typename lambda_t>
+	void forEach(lambda_t f)
+	{
+		iterate<false>(f);
+	}
+
+	/*! \brief Call f for each row of points along the dimension 0
+	 *
+	 * f(const grid_key_dx<dim> & key, size_t n) or f(const grid_key_dx<dim> & key, const stencil & stl, size_t n)
+	 * is called in parallel, the row is composed by the n points starting from key
+	 * in direction 0, f must be thread safe
+	 *
+	 * \param f functor
+	 *
+	 */
+	template<typename lambda_t>
+	void forEachRow(lambda_t f)
+	{
+		static_assert(brick == 0 || std::is_same<stencil,no_stencil>::value,
+				      "forEachRow with a stencil is not available for bricked grids");
+
+		iterate<true>(f);
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_GRID_ITERATORS_GRID_KEY_DX_ITERATOR_PAR_HPP_ */
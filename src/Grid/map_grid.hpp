@@ -47,8 +47,12 @@
 #include "iterators/grid_key_dx_iterator_sub.hpp"
 #include "iterators/grid_key_dx_iterator_sp.hpp"
 #include "iterators/grid_key_dx_iterator_sub_bc.hpp"
+#include "iterators/grid_key_dx_iterator_par.hpp"
 #include "Packer_Unpacker/Packer_util.hpp"
 #include "Packer_Unpacker/has_pack_agg.hpp"
+#include "Packer_Unpacker/Pack_segments.hpp"
+#include "Packer_Unpacker/Checkpoint.hpp"
+#include "util/stat/container_stats.hpp"
 #include "cuda/cuda_grid_gpu_funcs.cuh"
 #include "grid_base_implementation.hpp"
 #include "util/for_each_ref.hpp"
@@ -122,7 +126,7 @@ public:
 
 	//! Object container for T, it is the return type of get_o it return a object type trough
 	// you can access all the properties of T
-	typedef typename grid_base_impl<dim,T,S, memory_traits_lin>::container container;
+	typedef typename grid_base_impl<dim,T,S, memory_traits_lin,linearizer>::container container;
 
 	//! grid_base has no grow policy
 	typedef void grow_policy;
@@ -134,7 +138,7 @@ public:
 	typedef grid_key_dx_iterator_sub<dim> sub_grid_iterator_type;
 
 	//! linearizer type Z-morton Hilbert curve , normal striding
-	typedef typename grid_base_impl<dim,T,S, memory_traits_lin>::linearizer_type linearizer_type;
+	typedef typename grid_base_impl<dim,T,S, memory_traits_lin,linearizer>::linearizer_type linearizer_type;
 
 	//! Default constructor
 	inline grid_base() THROW
@@ -149,7 +153,7 @@ public:
 	 * \param mem memory object (only used for template deduction)
 	 *
 	 */
-	inline grid_base(const grid_base<dim,T,S,typename memory_traits_lin<T>::type> & g) THROW
+	inline grid_base(const grid_base & g) THROW
 	:grid_base_impl<dim,T,S,memory_traits_lin, linearizer>(g)
 	{
 	}
@@ -201,7 +205,7 @@ public:
 	 * \param g grid to copy
 	 *
 	 */
-	__device__ grid_base<dim,T,S> & operator=(const grid_base<dim,T,S> & g)
+	__device__ grid_base & operator=(const grid_base & g)
 	{
 		printf("Error grid_base operator= is not defined in device code\n");
 
@@ -215,9 +219,9 @@ public:
 	 * \param g grid to copy
 	 *
 	 */
-	__host__ grid_base<dim,T,S> & operator=(const grid_base<dim,T,S> & g)
+	__host__ grid_base & operator=(const grid_base & g)
 	{
-		(static_cast<grid_base_impl<dim,T,S, memory_traits_lin> *>(this))->swap(g.duplicate());
+		(static_cast<grid_base_impl<dim,T,S, memory_traits_lin,linearizer> *>(this))->swap(g.duplicate());
 
 		meta_copy<T>::meta_copy_(g.background,background);
 
@@ -229,9 +233,9 @@ public:
 	 * \param g grid to copy
 	 *
 	 */
-	grid_base<dim,T,S,typename memory_traits_lin<T>::type> & operator=(grid_base<dim,T,S,typename memory_traits_lin<T>::type> && g)
+	grid_base & operator=(grid_base && g)
 	{
-		(static_cast<grid_base_impl<dim,T,S, memory_traits_lin> *>(this))->swap(g);
+		(static_cast<grid_base_impl<dim,T,S, memory_traits_lin,linearizer> *>(this))->swap(g);
 
 		meta_copy<T>::meta_copy_(g.background,background);
 
@@ -344,9 +348,9 @@ public:
 	 * \return itself
 	 *
 	 */
-	grid_base<dim,T,S,typename memory_traits_lin<T>::type> & operator=(const grid_base_impl<dim,T,S, memory_traits_lin> & base)
+	grid_base & operator=(const grid_base_impl<dim,T,S, memory_traits_lin,linearizer> & base)
 	{
-		grid_base_impl<dim,T,S, memory_traits_inte>::operator=(base);
+		grid_base_impl<dim,T,S, memory_traits_lin,linearizer>::operator=(base);
 
 		return *this;
 	}
@@ -356,9 +360,9 @@ public:
 	 * \return itself
 	 *
 	 */
-	grid_base<dim,T,S,typename memory_traits_lin<T>::type> & operator=(grid_base_impl<dim,T,S, memory_traits_lin> && base)
+	grid_base & operator=(grid_base_impl<dim,T,S, memory_traits_lin,linearizer> && base)
 	{
-		grid_base_impl<dim,T,S, memory_traits_lin>::operator=((grid_base_impl<dim,T,S, memory_traits_lin> &&)base);
+		grid_base_impl<dim,T,S, memory_traits_lin,linearizer>::operator=((grid_base_impl<dim,T,S, memory_traits_lin,linearizer> &&)base);
 
 		return *this;
 	}
@@ -652,6 +656,34 @@ public:
 		return background;
 	}
 
+	/*! \brief It copy a grid
+	 *
+	 * \param g grid to copy
+	 *
+	 */
+	grid_base & operator=(const grid_base & g)
+	{
+		grid_base_impl<dim,T,S, memory_traits_inte,linearizer>::operator=(g);
+
+		meta_copy<T>::meta_copy_(g.background,background);
+
+		return *this;
+	}
+
+	/*! \brief It move a grid
+	 *
+	 * \param g grid to move
+	 *
+	 */
+	grid_base & operator=(grid_base && g)
+	{
+		grid_base_impl<dim,T,S, memory_traits_inte,linearizer>::operator=((grid_base_impl<dim,T,S, memory_traits_inte,linearizer> &&)g);
+
+		meta_copy<T>::meta_copy_(g.background,background);
+
+		return *this;
+	}
+
 	/*! \brief assign operator
 	 *
 	 * \return itself
@@ -671,7 +703,7 @@ public:
 	 */
 	grid_base<dim,T,S,typename memory_traits_inte<T>::type,linearizer> & operator=(grid_base_impl<dim,T,S, memory_traits_inte,linearizer> && base)
 	{
-		grid_base_impl<dim,T,S, memory_traits_inte,linearizer>::operator=(base);
+		grid_base_impl<dim,T,S, memory_traits_inte,linearizer>::operator=((grid_base_impl<dim,T,S, memory_traits_inte,linearizer> &&)base);
 
 		return *this;
 	}
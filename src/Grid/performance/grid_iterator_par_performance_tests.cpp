@@ -0,0 +1,227 @@
+/*
+ * grid_iterator_par_performance_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "config.h"
+#include "Grid/map_grid.hpp"
+#include "Vector/map_vector.hpp"
+#include "timer.hpp"
+#include "util/stat/common_statistics.hpp"
+#include "util/openmp_util.hpp"
+
+constexpr int N_STAT_GRID_PAR = 4;
+
+//! grid with the properties in separate arrays, so that the rows are contiguous for each property
+typedef grid_base<3,aggregate<float,float>,HeapMemory,typename memory_traits_inte<aggregate<float,float>>::type> grid_soa_par;
+
+static grid_key_dx<3> star_stencil_3D_par[7] = {{0,0,0},
+												{0,0,-1},
+												{0,0,1},
+												{0,-1,0},
+												{0,1,0},
+												{-1,0,0},
+												{1,0,0}};
+
+/*! \brief Print the result of a benchmark
+ *
+ * \param name name of the benchmark
+ * \param times_s times of the serial iterator
+ * \param times_p times of the parallel iterator (per element)
+ * \param times_r times of the parallel iterator (per row)
+ *
+ */
+static void print_grid_par_result(const char * name, std::vector<double> & times_s, std::vector<double> & times_p, std::vector<double> & times_r)
+{
+	double mean_s, dev_s, mean_p, dev_p, mean_r, dev_r;
+	standard_deviation(times_s,mean_s,dev_s);
+	standard_deviation(times_p,mean_p,dev_p);
+	standard_deviation(times_r,mean_r,dev_r);
+
+	std::cout << name << " (" << openfpm::omp::get_max_threads() << " threads)  serial: " << mean_s << " +- " << dev_s
+			  << " s   parallel forEach: " << mean_p << " +- " << dev_p << " s (" << mean_s / mean_p
+			  << "x)   parallel forEachRow: " << mean_r << " +- " << dev_r << " s (" << mean_s / mean_r << "x)" << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE( grid_iterator_par_performance )
+
+BOOST_AUTO_TEST_CASE( grid_iterator_par_axpy_performance )
+{
+	size_t sz[3] = {512,512,512};
+
+	grid_soa_par g(sz);
+	g.setMemory();
+
+	// first touch with the same distribution of the parallel iterator
+	auto itp = g.getIteratorPar();
+	itp.forEachRow([&](const grid_key_dx<3> & key, size_t n)
+	{
+		float * x = &g.template get<0>(key);
+		float * y = &g.template get<1>(key);
+
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			x[i] = key.get(0) + i + key.get(1) + key.get(2);
+			y[i] = 0.0f;
+		}
+	});
+
+	std::vector<double> times_s;
+	std::vector<double> times_p;
+	std::vector<double> times_r;
+
+	for (int s = 0 ; s < N_STAT_GRID_PAR + 1 ; s++)
+	{
+		timer t;
+		t.start();
+
+		auto it = g.getIterator();
+
+		while (it.isNext())
+		{
+			auto key = it.get();
+
+			g.template get<1>(key) += 0.5f*g.template get<0>(key);
+
+			++it;
+		}
+
+		t.stop();
+
+		timer t2;
+		t2.start();
+
+		itp.forEach([&](const grid_key_dx<3> & key)
+		{
+			g.template get<1>(key) += 0.5f*g.template get<0>(key);
+		});
+
+		t2.stop();
+
+		timer t3;
+		t3.start();
+
+		itp.forEachRow([&](const grid_key_dx<3> & key, size_t n)
+		{
+			const float * x = &g.template get<0>(key);
+			float * y = &g.template get<1>(key);
+
+			for (size_t i = 0 ; i < n ; i++)
+			{y[i] += 0.5f*x[i];}
+		});
+
+		t3.stop();
+
+		// the first is warm-up
+		if (s != 0)
+		{
+			times_s.push_back(t.getwct());
+			times_p.push_back(t2.getwct());
+			times_r.push_back(t3.getwct());
+		}
+	}
+
+	grid_key_dx<3> k({511,300,7});
+	float check = 1.5f*(N_STAT_GRID_PAR + 1)*(511 + 300 + 7);
+	BOOST_REQUIRE_CLOSE(g.template get<1>(k),check,0.01);
+
+	print_grid_par_result("Grid 512^3 axpy",times_s,times_p,times_r);
+}
+
+BOOST_AUTO_TEST_CASE( grid_iterator_par_stencil_performance )
+{
+	size_t sz[3] = {512,512,512};
+
+	grid_soa_par g(sz);
+	g.setMemory();
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({510,510,510});
+
+	auto itp_all = g.getIteratorPar();
+	itp_all.forEach([&](const grid_key_dx<3> & key)
+	{
+		g.template get<0>(key) = key.get(0)*key.get(0) + key.get(1) + key.get(2);
+		g.template get<1>(key) = 0.0f;
+	});
+
+	auto itp = g.getIteratorStencilPar(start,stop,star_stencil_3D_par);
+
+	std::vector<double> times_s;
+	std::vector<double> times_p;
+	std::vector<double> times_r;
+
+	for (int s = 0 ; s < N_STAT_GRID_PAR + 1 ; s++)
+	{
+		timer t;
+		t.start();
+
+		grid_key_dx_iterator_sub<3,stencil_offset_compute<3,7>> it(g.getGrid(),start,stop,star_stencil_3D_par);
+
+		while (it.isNext())
+		{
+			g.template get<1>(it.getStencil<0>()) = g.template get<0>(it.getStencil<1>()) + g.template get<0>(it.getStencil<2>()) +
+													g.template get<0>(it.getStencil<3>()) + g.template get<0>(it.getStencil<4>()) +
+													g.template get<0>(it.getStencil<5>()) + g.template get<0>(it.getStencil<6>()) -
+													6.0f*g.template get<0>(it.getStencil<0>());
+
+			++it;
+		}
+
+		t.stop();
+
+		timer t2;
+		t2.start();
+
+		itp.forEach([&](const grid_key_dx<3> & key, const stencil_offset_compute<3,7> & stl)
+		{
+			g.template get<1>(stl.getStencil<0>()) = g.template get<0>(stl.getStencil<1>()) + g.template get<0>(stl.getStencil<2>()) +
+													 g.template get<0>(stl.getStencil<3>()) + g.template get<0>(stl.getStencil<4>()) +
+													 g.template get<0>(stl.getStencil<5>()) + g.template get<0>(stl.getStencil<6>()) -
+													 6.0f*g.template get<0>(stl.getStencil<0>());
+		});
+
+		t2.stop();
+
+		timer t3;
+		t3.start();
+
+		itp.forEachRow([&](const grid_key_dx<3> & key, const stencil_offset_compute<3,7> & stl, size_t n)
+		{
+			float * out = &g.template get<1>(stl.getStencil<0>());
+			const float * c = &g.template get<0>(stl.getStencil<0>());
+			const float * zm = &g.template get<0>(stl.getStencil<1>());
+			const float * zp = &g.template get<0>(stl.getStencil<2>());
+			const float * ym = &g.template get<0>(stl.getStencil<3>());
+			const float * yp = &g.template get<0>(stl.getStencil<4>());
+			const float * xm = &g.template get<0>(stl.getStencil<5>());
+			const float * xp = &g.template get<0>(stl.getStencil<6>());
+
+			for (size_t i = 0 ; i < n ; i++)
+			{out[i] = zm[i] + zp[i] + ym[i] + yp[i] + xm[i] + xp[i] - 6.0f*c[i];}
+		});
+
+		t3.stop();
+
+		// the first is warm-up
+		if (s != 0)
+		{
+			times_s.push_back(t.getwct());
+			times_p.push_back(t2.getwct());
+			times_r.push_back(t3.getwct());
+		}
+	}
+
+	// Laplacian of x^2 + y + z is 2
+
+	grid_key_dx<3> k({200,300,7});
+	BOOST_REQUIRE_CLOSE(g.template get<1>(k),2.0f,0.01);
+
+	print_grid_par_result("Grid 512^3 7-points stencil",times_s,times_p,times_r);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
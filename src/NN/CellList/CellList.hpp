@@ -17,10 +17,12 @@
 #include "Space/Shape/HyperCube.hpp"
 
 #include "util/common.hpp"
+#include "util/openmp_util.hpp"
 
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCSR.hpp"
 #include "NN/CellList/CellDecomposer.hpp"
 #include "NN/CellList/NNc_array.hpp"
 #include "NN/CellList/SFCKeys.hpp"
@@ -32,6 +34,31 @@
 #include "NN/CellList/cuda/CellList_cpu_ker.cuh"
 
 
+/*! \brief Check if a Mem_type can construct all the cells in one step with fill_cells
+ *
+ * ### Example
+ *
+ * \code{.cpp}
+ *
+ * has_fill_cells<Mem_fast<>>::value
+ *
+ * \endcode
+ *
+ * return true if the Mem_type has fill_cells
+ *
+ */
+template<typename T, typename Sfinae = void>
+struct has_fill_cells: std::false_type {};
+
+/*! \brief Check if a Mem_type can construct all the cells in one step with fill_cells
+ *
+ * \tparam T Mem_type
+ *
+ */
+template<typename T>
+struct has_fill_cells<T, typename Void<decltype( std::declval<T>().fill_cells(std::declval<const openfpm::vector<size_t> &>(),0,false) )>::type> : std::true_type
+{};
+
 //! Wrapper of the unordered map
 template<typename key,typename val>
 class wrap_unordered_map: public std::unordered_map<key,val>
@@ -62,6 +89,7 @@ constexpr int CL_NON_SYMMETRIC = 2;
 constexpr int CL_LOCAL_SYMMETRIC = 8;
 constexpr int CL_LINEAR_CELL_KEYS = 16;
 constexpr int CL_HILBERT_CELL_KEYS = 32;
+constexpr int CL_MORTON_CELL_KEYS = 1024;
 constexpr int CL_GPU_REORDER_POSITION = 64;
 constexpr int CL_GPU_REORDER_PROPERTY = 128;
 constexpr int CL_GPU_RESTORE_POSITION = 256;
@@ -522,6 +550,9 @@ private:
 	//! Cell keys that follow space filling curve
 	openfpm::vector<size_t> SFCKeys;
 
+	//! Cell of each particle (temporary buffer used by fill)
+	openfpm::vector<size_t> fillCellIds;
+
 	//! Initialize the structures of the data structure
 	void InitializeStructures(const size_t (& div)[dim], size_t tot_n_cell, size_t slot=STARTING_NSLOT)
 	{
@@ -608,6 +639,25 @@ private:
 		isInitSFC = true;
 	}
 
+	/*! \brief Initialize Space-filling-curve (SFC) with the curve selected in the options
+	 *
+	 * CL_HILBERT_CELL_KEYS, CL_MORTON_CELL_KEYS or (default) CL_LINEAR_CELL_KEYS
+	 *
+	 */
+	inline void initSFC()
+	{
+		if (opt & CL_HILBERT_CELL_KEYS) {
+			SFCKeysHilbert<dim> SFC;
+			initSFC(SFC);
+		} else if (opt & CL_MORTON_CELL_KEYS) {
+			SFCKeysMorton<dim> SFC;
+			initSFC(SFC);
+		} else {
+			SFCKeysLinear<dim> SFC;
+			initSFC(SFC);
+		}
+	}
+
 public:
 
 	//! Type of internal memory structure
@@ -979,7 +1029,7 @@ public:
 	{
 		// calculate the Cell id
 
-		size_t cell_id = this->getCell(pos);
+		size_t cell_id = getCellAddPad(pos);
 
 		// add the element to the cell
 
@@ -1410,15 +1460,7 @@ public:
 	inline CellParticleIterator getCellParticleIterator()
 	{
 		if (isInitSFC == false)
-		{
-			if (opt & CL_HILBERT_CELL_KEYS) {
-				SFCKeysHilbert<dim> SFC;
-				initSFC(SFC);
-			} else {
-				SFCKeysLinear<dim> SFC;
-				initSFC(SFC);
-			}
-		}
+		{initSFC();}
 
 		return CellParticleIterator(*this);
 	}
@@ -1431,15 +1473,7 @@ public:
 	inline const openfpm::vector<size_t> & getCellSFCKeys()
 	{
 		if (isInitSFC == false)
-		{
-			if (opt & CL_HILBERT_CELL_KEYS) {
-				SFCKeysHilbert<dim> SFC;
-				initSFC(SFC);
-			} else {
-				SFCKeysLinear<dim> SFC;
-				initSFC(SFC);
-			}
-		}
+		{initSFC();}
 
 		return this->SFCKeys;
 	}
@@ -1453,6 +1487,160 @@ public:
 		return isInitSFC;
 	}
 
+	/*! \brief Reorder the particles following the space filling curve of the cells
+	 *
+	 * The domain particles [0,ghostMarker) are sorted by cell, with the cells in the order
+	 * of the space filling curve selected with the options (CL_HILBERT_CELL_KEYS, CL_MORTON_CELL_KEYS
+	 * or CL_LINEAR_CELL_KEYS). Inside a cell the particles keep their original order. Ghost particles
+	 * are not moved. Positions and properties are permuted and the cell list is filled again with the
+	 * reordered particles, so that the particles of a cell and of the neighborhood cells are
+	 * contiguous in memory
+	 *
+	 * The particles are sorted with the parallel stable radix sort of openfpm::omp on the rank of their
+	 * cell packed with their id in one 64 bit key, the temporary memory is two keys per particle and
+	 * does not depend on the number of threads. With one thread (or when rank and id do not fit in 64
+	 * bits) a serial counting sort over the cells is used
+	 *
+	 * \param vPos list of particle positions (any openfpm::vector layout)
+	 * \param vPrp list of particle properties (if empty only the positions are permuted)
+	 * \param ghostMarker ghost marker denoting domain and ghost particles in vPos
+	 * \param perm applied permutation, the particle i after the reordering was the particle perm.get(i)
+	 *
+	 */
+	template<typename vector_pos_type2, typename vector_prp_type>
+	void reorderSFC(
+		vector_pos_type2 & vPos,
+		vector_prp_type & vPrp,
+		size_t ghostMarker,
+		openfpm::vector<size_t> & perm)
+	{
+		size_t n_cell = this->getNCells();
+
+		// rank of each cell on the curve, padding cells go after the domain cells in linear order
+
+		const openfpm::vector<size_t> & keys = getCellSFCKeys();
+
+		openfpm::vector<size_t> rank;
+		openfpm::vector<size_t> pad;
+		rank.resize(n_cell);
+		pad.resize(n_cell);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{rank.get(i) = (size_t)-1;}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{rank.get(keys.get(i)) = i;}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{pad.get(i) = (rank.get(i) == (size_t)-1)?1:0;}
+
+		openfpm::omp::exclusive_scan(&pad.get(0),&pad.get(0),n_cell);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			if (rank.get(i) == (size_t)-1)
+			{rank.get(i) = keys.size() + pad.get(i);}
+		}
+
+		perm.resize(vPos.size());
+
+		// the particle id use the low id_bits of the sort key and the rank the high bits
+
+		size_t id_bits = 1;
+		while (id_bits < 64 && (ghostMarker >> id_bits) != 0)
+		{id_bits++;}
+
+		size_t rank_bits = 1;
+		while (rank_bits < 64 && ((n_cell - 1) >> rank_bits) != 0)
+		{rank_bits++;}
+
+		if (openfpm::omp::get_max_threads() != 1 && id_bits + rank_bits <= 64)
+		{
+			// stable parallel radix sort of the domain particles by rank, the memory is
+			// proportional to the number of particles and not to threads x cells
+
+			openfpm::vector<size_t> sortBuf;
+			openfpm::vector<size_t> sortTmp;
+			sortBuf.resize(ghostMarker);
+			sortTmp.resize(ghostMarker);
+
+			#pragma omp parallel for
+			for (size_t i = 0 ; i < ghostMarker ; i++)
+			{sortBuf.get(i) = (rank.get(this->getCell(Point<dim,T>(vPos.get(i)))) << id_bits) | i;}
+
+			if (ghostMarker != 0)
+			{
+				openfpm::omp::radix_sort(&sortBuf.get(0),&sortTmp.get(0),ghostMarker,
+										 [id_bits](size_t a){return a >> id_bits;},
+										 n_cell - 1);
+			}
+
+			size_t id_mask = (id_bits == 64)?(size_t)-1:((size_t)1 << id_bits) - 1;
+
+			#pragma omp parallel for
+			for (size_t i = 0 ; i < ghostMarker ; i++)
+			{perm.get(i) = sortBuf.get(i) & id_mask;}
+		}
+		else
+		{
+			// one thread, counting sort by rank (pad is reused as counter)
+
+			fillCellIds.resize(ghostMarker);
+
+			for (size_t i = 0 ; i < ghostMarker ; i++)
+			{fillCellIds.get(i) = rank.get(this->getCell(Point<dim,T>(vPos.get(i))));}
+
+			for (size_t i = 0 ; i < n_cell ; i++)
+			{pad.get(i) = 0;}
+
+			for (size_t i = 0 ; i < ghostMarker ; i++)
+			{pad.get(fillCellIds.get(i))++;}
+
+			openfpm::omp::exclusive_scan(&pad.get(0),&pad.get(0),n_cell);
+
+			for (size_t i = 0 ; i < ghostMarker ; i++)
+			{perm.get(pad.get(fillCellIds.get(i))++) = i;}
+		}
+
+		// ghost particles stay where they are
+
+		#pragma omp parallel for
+		for (size_t i = ghostMarker ; i < vPos.size() ; i++)
+		{perm.get(i) = i;}
+
+		applyPermutation(vPos,perm);
+
+		if (vPrp.size() != 0)
+		{applyPermutation(vPrp,perm);}
+
+		fill(vPos,vPrp,ghostMarker);
+	}
+
+	/*! \brief Permute a vector, the element i become the element perm.get(i)
+	 *
+	 * It can be used to apply the permutation returned by reorderSFC to other vectors
+	 *
+	 * \param v vector to permute (any openfpm::vector layout)
+	 * \param perm permutation
+	 *
+	 */
+	template<typename vector_type>
+	static void applyPermutation(vector_type & v, const openfpm::vector<size_t> & perm)
+	{
+		vector_type tmp;
+		tmp.resize(perm.size());
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < perm.size() ; i++)
+		{tmp.get(i) = v.get(perm.get(i));}
+
+		v.swap(tmp);
+	}
+
 #ifdef CUDA_GPU
 
 	CellList_cpu_ker<dim,T,typename Mem_type::toKernel_type,transform> toKernel()
@@ -1554,6 +1742,48 @@ public:
 	{
 		this->clear();
 		this->ghostMarker = ghostMarker;
+
+		fill_impl(vPos,ghostMarker,std::integral_constant<bool,has_fill_cells<Mem_type>::value>());
+	}
+
+private:
+
+	/*! \brief Cell used by addPad for a point
+	 *
+	 * \param pos point
+	 *
+	 * \return the cell id
+	 *
+	 */
+	inline size_t getCellAddPad(const Point<dim,T> & pos) const
+	{
+		return this->getCell(pos);
+	}
+
+	/*! \brief Cell used by addPad for a point
+	 *
+	 * \param pos point
+	 *
+	 * \return the cell id
+	 *
+	 */
+	inline size_t getCellAddPad(const T (& pos)[dim]) const
+	{
+		return this->getCellPad(pos);
+	}
+
+	/*! \brief Fill cell list adding the particles one by one
+	 *
+	 * \param vPos list of particle positions
+	 * \param ghostMarker ghost marker denoting domain and ghost particles in vPos
+	 *
+	 */
+	template<typename vector_pos_type2>
+	void fill_impl(
+		vector_pos_type2 & vPos,
+		size_t ghostMarker,
+		std::false_type)
+	{
 		if (opt & CL_SYMMETRIC) {
 
 			for (size_t i = 0; i < ghostMarker; i++)
@@ -1587,6 +1817,48 @@ public:
 		}
 	}
 
+	/*! \brief Fill cell list in parallel, the cell of every particle is calculated and the
+	 *         Mem_type construct all the cells in one step (count, scan, scatter)
+	 *
+	 * The result is the same of fill_impl with std::false_type
+	 *
+	 * \param vPos list of particle positions
+	 * \param ghostMarker ghost marker denoting domain and ghost particles in vPos
+	 *
+	 */
+	template<typename vector_pos_type2>
+	void fill_impl(
+		vector_pos_type2 & vPos,
+		size_t ghostMarker,
+		std::true_type)
+	{
+		if ((opt & (CL_SYMMETRIC | CL_LOCAL_SYMMETRIC | CL_NON_SYMMETRIC)) == 0)
+		{
+			std::cerr << "No mode is selected to fill Cell List!\n";
+			return;
+		}
+
+		fillCellIds.resize(vPos.size());
+
+		if (opt & CL_SYMMETRIC)
+		{
+			#pragma omp parallel for
+			for (size_t i = 0 ; i < vPos.size() ; i++)
+			{fillCellIds.get(i) = (i < ghostMarker)?this->getCellDom(vPos.get(i)):getCellAddPad(vPos.get(i));}
+		}
+		else
+		{
+			// same cell of add(), the position is converted to Point
+			#pragma omp parallel for
+			for (size_t i = 0 ; i < vPos.size() ; i++)
+			{fillCellIds.get(i) = this->getCell(Point<dim,T>(vPos.get(i)));}
+		}
+
+		Mem_type::fill_cells(fillCellIds,ghostMarker,(opt & CL_LOCAL_SYMMETRIC) != 0);
+	}
+
+public:
+
 /////////////////////////////////////
 };
 
@@ -1682,5 +1954,6 @@ static inline void cl_param_calculateSym(const Box<dim,St> & dom,
 template<unsigned int dim, typename St> using CELL_MEMFAST = CellList<dim, St, Mem_fast<>, shift<dim, St>>;
 template<unsigned int dim, typename St> using CELL_MEMBAL = CellList<dim, St, Mem_bal<>, shift<dim, St>>;
 template<unsigned int dim, typename St> using CELL_MEMMW = CellList<dim, St, Mem_mw<>, shift<dim, St>>;
+template<unsigned int dim, typename St> using CELL_MEMCSR = CellList<dim, St, Mem_csr<>, shift<dim, St>>;
 
 #endif /* CELLLIST_HPP_ */
@@ -0,0 +1,628 @@
+/*
+ * CellListSparse.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef CELLLISTSPARSE_HPP_
+#define CELLLISTSPARSE_HPP_
+
+#include <algorithm>
+#include "Vector/map_vector.hpp"
+#include "Space/Shape/Box.hpp"
+#include "util/mathutil.hpp"
+#include "util/openmp_util.hpp"
+#include "hash_map/hopscotch_map.h"
+#include "NN/CellList/CellDecomposer.hpp"
+#include "NN/CellList/NNc_array.hpp"
+#include "NN/CellList/CellNNIterator.hpp"
+#include "NN/CellList/CellNNIteratorSparse.hpp"
+
+#define CELL_LIST_SPARSE 8002lu
+
+/*! \brief Hash of the cell ids of CellListSparse
+ *
+ * The ids of the occupied cells are strided by the sizes of the cell grid, with the identity hash they
+ * collide in the power of two buckets of the hopscotch map, so the bits are mixed (murmur3 finalizer)
+ *
+ */
+struct cl_sparse_hash
+{
+	//! hash of the cell id
+	inline size_t operator()(size_t k) const
+	{
+		k ^= k >> 33;
+		k *= 0xff51afd7ed558ccdul;
+		k ^= k >> 33;
+		k *= 0xc4ceb9fe1a85ec53ul;
+		k ^= k >> 33;
+
+		return k;
+	}
+};
+
+/*! \brief Sparse Cell list for CPU
+ *
+ * The cells are defined like in CellList (same CellDecomposer and same cell ids), but only the
+ * occupied cells are stored. The particles are sorted by cell id, the occupied cells are stored in a
+ * compressed form (sorted cell ids and offsets into the sorted particles) and a hash map give the
+ * occupied cell from the cell id. For each occupied cell the list of the occupied neighborhood
+ * cells is precomputed by fill. The memory is proportional to the number of particles and not to the
+ * number of cells, so it can be used on huge domains that are mostly empty.
+ *
+ * The neighborhood iterators give the same particles in the same order of the iterators of a CellList
+ * filled with add in the particle order
+ *
+ * \code{.cpp}
+ *
+ * CellListSparse<3,double> cl(box,div);
+ * cl.fill(vPos,vPrp,ghostMarker);
+ *
+ * auto NN = cl.getNNIteratorBox(cl.getCell(xp));
+ *
+ * \endcode
+ *
+ * \tparam dim Dimensionality of the space
+ * \tparam T type of the space float, double ...
+ * \tparam local_index type of the particle index
+ * \tparam transform type of transformation (no_transform, shift ...)
+ * \tparam vector_pos_type type of vector that store the particle positions
+ *
+ */
+template<unsigned int dim,
+		 typename T,
+		 typename local_index = size_t,
+		 typename transform = no_transform<dim,T>,
+		 typename vector_pos_type = openfpm::vector<Point<dim,T>>>
+class CellListSparse : public CellDecomposer_sm<dim,T,transform>
+{
+	//! Cell of a particle (used to sort the particles by cell)
+	struct cell_particle
+	{
+		//! cell id
+		size_t cell;
+
+		//! particle id
+		local_index id;
+	};
+
+	//! Ids of the occupied cells (sorted)
+	openfpm::vector<size_t> cellKeys;
+
+	//! For each occupied cell the first particle in cellParticles (one more element for the end)
+	openfpm::vector<size_t> cellStart;
+
+	//! Particles sorted by cell
+	openfpm::vector<local_index> cellParticles;
+
+	//! Map from cell id to occupied cell
+	tsl::hopscotch_map<size_t,size_t,cl_sparse_hash> cellMap;
+
+	//! For each occupied cell the first neighborhood cell in nnCells (one more element for the end)
+	openfpm::vector<size_t> nnStart;
+
+	//! For each occupied cell the first symmetric neighborhood cell in nnCells
+	openfpm::vector<size_t> nnSymStart;
+
+	//! Occupied neighborhood cells of the occupied cells
+	openfpm::vector<size_t> nnCells;
+
+	//! Full neighborhood cells (relative)
+	NNc_array<dim,(unsigned int)openfpm::math::pow(3,dim)> NNc_full;
+
+	//! Symmetric neighborhood cells (relative)
+	NNc_array<dim,(unsigned int)openfpm::math::pow(3,dim)/2+1> NNc_sym;
+
+	//! Particles with their cell, used by fill (kept between two fill to not allocate them again)
+	openfpm::vector<cell_particle> sortBuf;
+
+	//! Temporary buffer for the sort (kept between two fill like sortBuf)
+	openfpm::vector<cell_particle> sortTmp;
+
+	//! ghost marker
+	size_t ghostMarker;
+
+	/*! \brief Return the occupied cell of a cell id
+	 *
+	 * \param cell cell id
+	 * \param c occupied cell
+	 *
+	 * \return true if the cell is occupied
+	 *
+	 */
+	inline bool findCell(size_t cell, size_t & c) const
+	{
+		auto it = cellMap.find(cell);
+
+		if (it == cellMap.end())
+		{return false;}
+
+		c = it->second;
+		return true;
+	}
+
+	/*! \brief Construct the occupied cells from the particles sorted by cell
+	 *
+	 */
+	void constructCells()
+	{
+		size_t n = sortBuf.size();
+
+		cellParticles.resize(n);
+
+		// head of every run of equal cells (nnSymStart is used as temporary buffer)
+
+		openfpm::vector<size_t> & head = nnSymStart;
+		head.resize(n);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			head.get(i) = (i == 0 || sortBuf.get(i).cell != sortBuf.get(i-1).cell)?1:0;
+			cellParticles.get(i) = sortBuf.get(i).id;
+		}
+
+		size_t n_occ = openfpm::omp::exclusive_scan(&head.get(0),&head.get(0),n);
+
+		cellKeys.resize(n_occ);
+		cellStart.resize(n_occ+1);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			if (i == 0 || sortBuf.get(i).cell != sortBuf.get(i-1).cell)
+			{
+				cellKeys.get(head.get(i)) = sortBuf.get(i).cell;
+				cellStart.get(head.get(i)) = i;
+			}
+		}
+
+		cellStart.get(n_occ) = n;
+
+		cellMap.reserve(n_occ);
+
+		for (size_t k = 0 ; k < n_occ ; k++)
+		{cellMap[cellKeys.get(k)] = k;}
+	}
+
+	/*! \brief Find the occupied neighborhood cells of the occupied cells in [start,stop)
+	 *
+	 * The cell ids are sorted, so the ids of the neighborhood cells NNc_full[j] of the occupied cells are sorted
+	 * too. For every j a cursor on cellKeys only move forward (merge of cellKeys with cellKeys + NNc_full[j]),
+	 * no hash lookup is needed and the memory is accessed sequentially
+	 *
+	 * \param start first occupied cell
+	 * \param stop one past the last occupied cell
+	 * \param f functor called as f(k,j,c) for every occupied cell c that is the neighborhood cell j of k
+	 *
+	 */
+	template<typename functor>
+	void mergeNNCells(size_t start, size_t stop, functor f) const
+	{
+		const size_t n_nn = openfpm::math::pow(3,dim);
+		size_t n_occ = cellKeys.size();
+
+		if (start >= stop)
+		{return;}
+
+		const size_t * keys = (const size_t *)cellKeys.getPointer();
+		size_t cur[n_nn];
+
+		for (size_t j = 0 ; j < n_nn ; j++)
+		{
+			long int first = (long int)keys[start] + NNc_full[j];
+			cur[j] = (first <= 0)?0:std::lower_bound(keys,keys + n_occ,(size_t)first) - keys;
+		}
+
+		for (size_t k = start ; k < stop ; k++)
+		{
+			for (size_t j = 0 ; j < n_nn ; j++)
+			{
+				long int nc = (long int)keys[k] + NNc_full[j];
+				size_t m = cur[j];
+
+				while (m < n_occ && (long int)keys[m] < nc)
+				{m++;}
+
+				cur[j] = m;
+
+				if (m < n_occ && (long int)keys[m] == nc)
+				{f(k,j,m);}
+			}
+		}
+	}
+
+	/*! \brief Precompute the occupied neighborhood cells of every occupied cell
+	 *
+	 * Every thread find the neighborhood cells of a contiguous block of occupied cells in a local list,
+	 * the lists are then copied in nnCells. The symmetric neighborhood is the part of the full
+	 * neighborhood that start from the cell itself
+	 *
+	 */
+	void constructNNCells()
+	{
+		size_t n_occ = cellKeys.size();
+
+		nnStart.resize(n_occ+1);
+		nnSymStart.resize(n_occ);
+		nnStart.get(n_occ) = 0;
+
+		if (n_occ == 0)
+		{
+			nnCells.clear();
+			return;
+		}
+
+		int nth = (n_occ < 4096)?1:openfpm::omp::get_max_threads();
+		std::vector<size_t> thread_tot(nth+1,0);
+
+		#pragma omp parallel num_threads(nth)
+		{
+			int tid = openfpm::omp::get_thread_num();
+			int nth_r = openfpm::omp::get_num_threads();
+
+			size_t start;
+			size_t stop;
+			openfpm::omp::thread_range(n_occ,nth_r,tid,start,stop);
+
+			// the neighborhood cells of k are found in the order of NNc_full
+
+			std::vector<size_t> loc;
+			loc.reserve((stop - start)*openfpm::math::pow(3,dim)/2);
+
+			for (size_t k = start ; k < stop ; k++)
+			{nnStart.get(k) = (size_t)-1;}
+
+			mergeNNCells(start,stop,[&](size_t k, size_t j, size_t c)
+			{
+				if (nnStart.get(k) == (size_t)-1)
+				{nnStart.get(k) = loc.size();}
+
+				if (NNc_full[j] == 0)
+				{nnSymStart.get(k) = loc.size();}
+
+				loc.push_back(c);
+			});
+
+			thread_tot[tid+1] = loc.size();
+
+			#pragma omp barrier
+
+			#pragma omp single
+			{
+				for (int i = 1 ; i <= nth_r ; i++)
+				{thread_tot[i] += thread_tot[i-1];}
+
+				nnCells.resize(thread_tot[nth_r]);
+				nnStart.get(n_occ) = thread_tot[nth_r];
+			}
+
+			size_t base = thread_tot[tid];
+
+			// every occupied cell has at least itself as neighborhood cell
+
+			for (size_t k = start ; k < stop ; k++)
+			{
+				nnStart.get(k) += base;
+				nnSymStart.get(k) += base;
+			}
+
+			if (loc.size() != 0)
+			{std::copy(loc.begin(),loc.end(),(size_t *)nnCells.getPointer() + base);}
+		}
+	}
+
+public:
+
+	//! Object type that the structure store
+	typedef local_index value_type;
+
+	//! Type of the coordinate space (double float)
+	typedef T stype;
+
+	//! Type of the vector of positions
+	typedef vector_pos_type internal_vector_pos_type;
+
+	//! Default constructor
+	CellListSparse()
+	:ghostMarker(0)
+	{}
+
+	/*! \brief Cell list constructor
+	 *
+	 * \param box Domain where this cell list is living
+	 * \param div grid size on each dimension
+	 * \param pad padding cell
+	 *
+	 */
+	CellListSparse(const Box<dim,T> & box, const size_t (&div)[dim], const size_t pad = 1)
+	:ghostMarker(0)
+	{
+		Initialize(box,div,pad);
+	}
+
+	/*! Initialize the cell list
+	 *
+	 * \param box Domain where this cell list is living
+	 * \param div grid size on each dimension
+	 * \param pad padding cell
+	 *
+	 */
+	void Initialize(const Box<dim,T> & box, const size_t (&div)[dim], const size_t pad = 1)
+	{
+		Matrix<dim,T> mat;
+
+		CellDecomposer_sm<dim,T,transform>::setDimensions(box,div,mat,pad);
+
+		NNc_full.set_size(this->cellListGrid.getSize());
+		NNc_full.init_full();
+
+		NNc_sym.set_size(this->cellListGrid.getSize());
+		NNc_sym.init_sym();
+
+		clear();
+	}
+
+	/*! \brief Return the underlying grid information of the cell list
+	 *
+	 * \return the grid infos
+	 *
+	 */
+	const grid_sm<dim,void> & getGrid() const
+	{
+		return CellDecomposer_sm<dim,T,transform>::getGrid();
+	}
+
+	/*! \brief Fill the cell list with the particles at positions vPos
+	 *
+	 * The cell of every particle is calculated in parallel, the particles are sorted by cell with
+	 * a stable radix sort and the occupied cells with their neighborhood are constructed
+	 *
+	 * The two sort buffers (2*n*sizeof(cell_particle) bytes) are retained after fill, so that filling
+	 * again the cell list at every time step does not allocate and touch them again. They are released
+	 * with the cell list
+	 *
+	 * \param vPos list of particle positions
+	 * \param vPrp list of particle properties
+	 * \param ghostMarker ghost marker denoting domain and ghost particles in vPos
+	 *
+	 */
+	template<typename vector_pos_type2, typename vector_prp_type>
+	void fill(vector_pos_type2 & vPos, vector_prp_type & vPrp, size_t ghostMarker)
+	{
+		clear();
+		this->ghostMarker = ghostMarker;
+
+		size_t n = vPos.size();
+
+		if (n == 0)
+		{return;}
+
+		sortBuf.resize(n);
+		sortTmp.resize(n);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			sortBuf.get(i).cell = this->getCell(Point<dim,T>(vPos.get(i)));
+			sortBuf.get(i).id = i;
+		}
+
+		openfpm::omp::radix_sort(&sortBuf.get(0),&sortTmp.get(0),n,
+								 [](const cell_particle & a){return a.cell;},
+								 this->getGrid().size());
+
+		constructCells();
+		constructNNCells();
+	}
+
+	/*! \brief Clear the cell list
+	 *
+	 */
+	void clear()
+	{
+		cellKeys.clear();
+		cellStart.clear();
+		cellParticles.clear();
+		cellMap.clear();
+		nnStart.clear();
+		nnSymStart.clear();
+		nnCells.clear();
+	}
+
+	/*! \brief Return the number of elements in the cell
+	 *
+	 * \param cell_id id of the cell
+	 *
+	 * \return number of elements in the cell
+	 *
+	 */
+	inline size_t getNelements(const size_t cell_id) const
+	{
+		size_t c;
+
+		if (findCell(cell_id,c) == false)
+		{return 0;}
+
+		return cellStart.get(c+1) - cellStart.get(c);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * The cell must be occupied and ele smaller than getNelements(cell), it is checked only with SE_CLASS1
+	 *
+	 * \param cell cell id
+	 * \param ele element id
+	 *
+	 * \return The element value
+	 *
+	 */
+	inline const local_index & get(size_t cell, size_t ele) const
+	{
+		size_t c = 0;
+
+#ifdef SE_CLASS1
+		if (findCell(cell,c) == false)
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the cell " << cell << " is empty" << std::endl;
+			ACTION_ON_ERROR(CELL_LIST_SPARSE);
+		}
+		else if (ele >= cellStart.get(c+1) - cellStart.get(c))
+		{
+			std::cerr << "Error: " << __FILE__ << ":" << __LINE__ << " the cell " << cell << " has only " << cellStart.get(c+1) - cellStart.get(c) << " elements" << std::endl;
+			ACTION_ON_ERROR(CELL_LIST_SPARSE);
+		}
+#else
+		findCell(cell,c);
+#endif
+
+		return cellParticles.get(cellStart.get(c) + ele);
+	}
+
+	/*! \brief Return the number of occupied cells
+	 *
+	 * \return the number of occupied cells
+	 *
+	 */
+	inline size_t getNOccupiedCells() const
+	{
+		return cellKeys.size();
+	}
+
+	/*! \brief Return the cell id of an occupied cell
+	 *
+	 * \param c occupied cell
+	 *
+	 * \return the cell id
+	 *
+	 */
+	inline size_t getOccupiedCellId(size_t c) const
+	{
+		return cellKeys.get(c);
+	}
+
+	/*! \brief Return the first element of an occupied cell
+	 *
+	 * \param c occupied cell
+	 *
+	 * \return pointer to the first element
+	 *
+	 */
+	__attribute__((always_inline)) inline const local_index * getStartIdOcc(size_t c) const
+	{
+		return (const local_index *)cellParticles.getPointer() + cellStart.get(c);
+	}
+
+	/*! \brief Return one past the last element of an occupied cell
+	 *
+	 * \param c occupied cell
+	 *
+	 * \return pointer to one past the last element
+	 *
+	 */
+	__attribute__((always_inline)) inline const local_index * getStopIdOcc(size_t c) const
+	{
+		return (const local_index *)cellParticles.getPointer() + cellStart.get(c+1);
+	}
+
+	/*! \brief Return the occupied neighborhood cells of a cell
+	 *
+	 * For an occupied cell the precomputed list is returned, for an empty cell the list is
+	 * calculated in loc
+	 *
+	 * \param cell cell id
+	 * \param sym true for the symmetric neighborhood
+	 * \param loc buffer for the neighborhood of an empty cell (at least pow(3,dim) elements)
+	 * \param ext precomputed neighborhood (NULL for an empty cell)
+	 * \param n number of occupied neighborhood cells
+	 * \param own true if the first neighborhood cell is the cell itself
+	 *
+	 */
+	inline void getNNCells(size_t cell, bool sym, size_t * loc, const size_t * & ext, size_t & n, bool & own) const
+	{
+		size_t c;
+
+		if (findCell(cell,c) == true)
+		{
+			size_t start = (sym == true)?nnSymStart.get(c):nnStart.get(c);
+
+			ext = (const size_t *)nnCells.getPointer() + start;
+			n = nnStart.get(c+1) - start;
+			own = sym;
+			return;
+		}
+
+		ext = NULL;
+		n = 0;
+		own = false;
+
+		if (sym == true)
+		{
+			for (size_t j = 0 ; j < (size_t)openfpm::math::pow(3,dim)/2+1 ; j++)
+			{n += findCell(cell + NNc_sym[j],loc[n]);}
+		}
+		else
+		{
+			for (size_t j = 0 ; j < (size_t)openfpm::math::pow(3,dim) ; j++)
+			{n += findCell(cell + NNc_full[j],loc[n]);}
+		}
+	}
+
+	/*! \brief Get the Neighborhood iterator
+	 *
+	 * It iterate across all the element of the selected cell and the near cells
+	 *
+	 * \param cell cell id
+	 *
+	 * \return An iterator across the neighborhood particles
+	 *
+	 */
+	__attribute__((always_inline)) inline CellNNIteratorSparse<dim,CellListSparse<dim,T,local_index,transform,vector_pos_type>,(int)FULL>
+	getNNIteratorBox(size_t cell) const
+	{
+		CellNNIteratorSparse<dim,CellListSparse<dim,T,local_index,transform,vector_pos_type>,(int)FULL> cln(cell,false,*this);
+		return cln;
+	}
+
+	/*! \brief Get the symmetric Neighborhood iterator
+	 *
+	 * It iterate across all the element of the selected cell and the near cells
+	 *
+	 * \param cell cell id
+	 * \param p particle id
+	 * \param v vector of positions
+	 *
+	 * \return An iterator across the neighborhood particles
+	 *
+	 */
+	__attribute__((always_inline)) inline CellNNIteratorSparseSym<dim,CellListSparse<dim,T,local_index,transform,vector_pos_type>,vector_pos_type,(int)SYM>
+	getNNIteratorBoxSym(size_t cell, size_t p, const vector_pos_type & v) const
+	{
+		CellNNIteratorSparseSym<dim,CellListSparse<dim,T,local_index,transform,vector_pos_type>,vector_pos_type,(int)SYM> cln(cell,p,*this,v);
+		return cln;
+	}
+
+	/*! \brief Return the ghost marker
+	 *
+	 * \return the ghost marker
+	 *
+	 */
+	inline size_t getGhostMarker() const
+	{
+		return ghostMarker;
+	}
+
+	/*! \brief Return the memory used by the structure in byte (excluding the temporary buffers of fill)
+	 *
+	 * \return the memory used
+	 *
+	 */
+	size_t getMemoryUsage() const
+	{
+		return (cellKeys.size() + cellStart.size() + nnStart.size() + nnSymStart.size() + nnCells.size())*sizeof(size_t) +
+			   cellParticles.size()*sizeof(local_index) + cellMap.bucket_count()*2*sizeof(size_t);
+	}
+};
+
+#endif /* CELLLISTSPARSE_HPP_ */
@@ -0,0 +1,223 @@
+/*
+ * CellNNIteratorSparse.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef CELLNNITERATORSPARSE_HPP_
+#define CELLNNITERATORSPARSE_HPP_
+
+/*! \brief Iterator for the neighborhood of the cells of a sparse cell-list
+ *
+ * In general you never create it directly but you get it from CellListSparse
+ *
+ * It iterate across all the elements of the non-empty neighborhood cells. For a non-empty
+ * cell the list of the non-empty neighborhood cells is precomputed by the cell-list, for an empty
+ * cell it is calculated on the fly. The order is the same of CellNNIterator on a dense CellList
+ *
+ * \tparam dim dimensionality of the space where the cell live
+ * \tparam Cell cell type on which the iterator is working
+ * \tparam NNc_size neighborhood size
+ *
+ */
+template<unsigned int dim, typename Cell, int NNc_size>
+class CellNNIteratorSparse
+{
+protected:
+
+	//! actual element id
+	const typename Cell::value_type * start_id;
+
+	//! stop id to read the end of the cell
+	const typename Cell::value_type * stop_id;
+
+	//! Actual neighborhood cell
+	size_t NNc_id;
+
+	//! Number of non-empty neighborhood cells
+	size_t NNc_n;
+
+	//! Precomputed non-empty neighborhood cells (indexes of the occupied cells)
+	const size_t * NNc_ext;
+
+	//! Non-empty neighborhood cells of an empty cell (indexes of the occupied cells)
+	size_t NNc_loc[NNc_size];
+
+	//! true if the first neighborhood cell is the center cell
+	bool own;
+
+	//! Cell list
+	const Cell & cl;
+
+	/*! \brief Return the i-th non-empty neighborhood cell
+	 *
+	 * \param i neighborhood cell
+	 *
+	 * \return the index of the occupied cell
+	 *
+	 */
+	__attribute__((always_inline)) inline size_t NNcell(size_t i) const
+	{
+		return (NNc_ext != NULL)?NNc_ext[i]:NNc_loc[i];
+	}
+
+	/*! \brief Select the first element of the neighborhood cell NNc_id
+	 *
+	 */
+	__attribute__((always_inline)) inline void selectCell()
+	{
+		if (NNc_id >= NNc_n)	{return;}
+
+		size_t c = NNcell(NNc_id);
+
+		start_id = cl.getStartIdOcc(c);
+		stop_id = cl.getStopIdOcc(c);
+	}
+
+	/*! \brief Select non-empty cell
+	 *
+	 */
+	__attribute__((always_inline)) inline void selectValid()
+	{
+		// the neighborhood cells are all non-empty
+		if (start_id == stop_id)
+		{
+			NNc_id++;
+			selectCell();
+		}
+	}
+
+public:
+
+	/*! \brief Cell NN iterator
+	 *
+	 * \param cell Cell id
+	 * \param sym true to iterate only the symmetric half of the neighborhood
+	 * \param cl Cell structure
+	 *
+	 */
+	__attribute__((always_inline)) inline CellNNIteratorSparse(size_t cell, bool sym, const Cell & cl)
+	:start_id(NULL),stop_id(NULL),NNc_id(0),cl(cl)
+	{
+		cl.getNNCells(cell,sym,NNc_loc,NNc_ext,NNc_n,own);
+		selectCell();
+	}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next element
+	 *
+	 */
+	__attribute__((always_inline)) inline bool isNext()
+	{
+		return NNc_id < NNc_n;
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	__attribute__((always_inline)) inline CellNNIteratorSparse & operator++()
+	{
+		start_id++;
+
+		selectValid();
+
+		return *this;
+	}
+
+	/*! \brief Get the value of the cell
+	 *
+	 * \return  the next element object
+	 *
+	 */
+	__attribute__((always_inline)) inline const typename Cell::value_type & get() const
+	{
+		return *start_id;
+	}
+};
+
+/*! \brief Symmetric iterator for the neighborhood of the cells of a sparse cell-list
+ *
+ * In general you never create it directly but you get it from CellListSparse
+ *
+ * \note if we query the neighborhood of p and q is the neighborhood of p
+ *          when we will query the neighborhood of q p is not present. This is
+ *          useful to implement formula like \f$  \sum_{q = neighborhood(p) and p <= q} \f$
+ *
+ * \tparam dim dimensionality of the space where the cell live
+ * \tparam Cell cell type on which the iterator is working
+ * \tparam vector_pos_type vector of positions
+ * \tparam NNc_size neighborhood size
+ *
+ */
+template<unsigned int dim, typename Cell, typename vector_pos_type, int NNc_size>
+class CellNNIteratorSparseSym : public CellNNIteratorSparse<dim,Cell,NNc_size>
+{
+	//! index of the particle p
+	size_t p;
+
+	//! Position of the particle p
+	const vector_pos_type & v;
+
+	/*! Select the next valid element
+	 *
+	 */
+	__attribute__((always_inline)) inline void selectValid()
+	{
+		if (this->NNc_id == 0 && this->own == true)
+		{
+			while (this->start_id < this->stop_id)
+			{
+				size_t q = *this->start_id;
+				for (long int i = dim-1 ; i >= 0 ; i--)
+				{
+					if (v.template get<0>(p)[i] < v.template get<0>(q)[i])
+						return;
+					else if (v.template get<0>(p)[i] > v.template get<0>(q)[i])
+						goto next;
+				}
+				if (q >= p)	return;
+next:
+				this->start_id++;
+			}
+		}
+
+		CellNNIteratorSparse<dim,Cell,NNc_size>::selectValid();
+	}
+
+public:
+
+	/*! \brief Cell NN iterator
+	 *
+	 * \param cell Cell id
+	 * \param p index of the particle from which we are searching the neighborhood particles
+	 * \param cl Cell structure
+	 * \param v vector of positions
+	 *
+	 */
+	__attribute__((always_inline)) inline CellNNIteratorSparseSym(size_t cell, size_t p, const Cell & cl, const vector_pos_type & v)
+	:CellNNIteratorSparse<dim,Cell,NNc_size>(cell,true,cl),p(p),v(v)
+	{
+		if (this->isNext())
+		{selectValid();}
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	__attribute__((always_inline)) inline CellNNIteratorSparseSym<dim,Cell,vector_pos_type,NNc_size> & operator++()
+	{
+		this->start_id++;
+
+		selectValid();
+
+		return *this;
+	}
+};
+
+#endif /* CELLNNITERATORSPARSE_HPP_ */
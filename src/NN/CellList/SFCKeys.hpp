@@ -142,6 +142,84 @@ public:
 	}
 };
 
+/*! \brief Class for a Morton (Z-order) processing of cell keys for CellList implementation
+ *
+ * \tparam dim Dimansionality of the space
+ */
+template<unsigned int dim>
+class SFCKeysMorton
+{
+	//! vector for storing the cell keys
+	openfpm::vector<size_t> keys;
+
+public:
+	/*! \brief Return cellkeys vector
+	 *
+	 * \return vector of cell keys
+	 *
+	 */
+	inline const openfpm::vector<size_t> & getKeys() const
+	{
+		return keys;
+	}
+
+	/*! \brief Get a Morton key from the coordinates and add to the getKeys vector
+	 *
+	 * The key is produced interleaving the bits of the coordinates
+	 *
+	 * \tparam CellList_type Cell list type
+	 *
+	 * \param cellList Cell list object
+	 * \param gridKey grid key
+	 * \param m order of a curve (number of bits for each coordinate)
+	 */
+	template<typename CellList_type> inline void get_hkey(CellList_type & cellList, grid_key_dx<dim> gridKey, size_t m)
+	{
+		size_t mkey = 0;
+
+		for (size_t b = 0 ; b < m ; b++)
+		{
+			for (size_t i = 0 ; i < dim ; i++)
+			{mkey |= (((size_t)gridKey.get(i) >> b) & 1ul) << (b*dim + i);}
+		}
+
+		keys.add(mkey);
+	}
+
+	/*! \brief Get the coordinates from the Morton key, linearize and add to the getKeys vector
+	 *
+	 * \tparam CellList_type Cell list type
+	 *
+	 * \param cellList Cell list object
+	 * \param m order of a curve
+	 */
+	template<typename CellList_type> inline void linearize_hkeys(CellList_type & cellList, size_t m)
+	{
+		size_t coord[dim];
+
+		keys.sort();
+
+		openfpm::vector<size_t> keys_new;
+
+		for(size_t i = 0; i < keys.size(); i++)
+		{
+			for (size_t j = 0 ; j < dim ; j++)	{coord[j] = 0;}
+
+			for (size_t b = 0 ; b < m ; b++)
+			{
+				for (size_t j = 0 ; j < dim ; j++)
+				{coord[j] |= ((keys.get(i) >> (b*dim + j)) & 1ul) << b;}
+			}
+
+			for (size_t j = 0 ; j < dim ; j++)	{coord[j] += cellList.getPadding(j);}
+
+			keys_new.add(cellList.getGrid().LinIdPtr(static_cast<size_t *>(coord)));
+		}
+
+		keys.swap(keys_new);
+	}
+};
+
 /*! \brief Class for an hilbert order processing of cell keys for CellList implementation
  *
  * \tparam dim Dimansionality of the space
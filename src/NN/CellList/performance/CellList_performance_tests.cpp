@@ -0,0 +1,155 @@
+/*
+ * CellList_performance_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "config.h"
+#include "NN/CellList/CellList.hpp"
+#include "timer.hpp"
+#include "util/stat/common_statistics.hpp"
+#include "util/SimpleRNG.hpp"
+
+constexpr int N_STAT_CELLLIST = 8;
+
+/*! \brief Lennard-Jones like force loop over the cell-list neighborhood
+ *
+ * \param cl cell list (filled)
+ * \param vPos particle positions
+ * \param vForce calculated forces
+ * \param r_cut cut-off radius
+ *
+ * \return the time of the loop
+ *
+ */
+template<typename CellS, typename vector_pos_type>
+static double force_loop(CellS & cl, vector_pos_type & vPos, vector_pos_type & vForce, double r_cut)
+{
+	double r_cut2 = r_cut*r_cut;
+
+	timer t;
+	t.start();
+
+	#pragma omp parallel for schedule(static)
+	for (size_t p = 0 ; p < vPos.size() ; p++)
+	{
+		Point<3,double> xp = vPos.get(p);
+		Point<3,double> f = {0.0,0.0,0.0};
+
+		auto NN = cl.getNNIteratorBox(cl.getCell(xp));
+
+		while (NN.isNext())
+		{
+			auto q = NN.get();
+
+			++NN;
+
+			if (q == p)	{continue;}
+
+			Point<3,double> r = xp - Point<3,double>(vPos.get(q));
+			double rn2 = r.get(0)*r.get(0) + r.get(1)*r.get(1) + r.get(2)*r.get(2);
+
+			if (rn2 > r_cut2)	{continue;}
+
+			double ir6 = 1.0 / (rn2*rn2*rn2 + 1e-12);
+			double c = ir6*(ir6 - 0.5);
+
+			for (size_t i = 0 ; i < 3 ; i++)
+			{f.get(i) += c*r.get(i);}
+		}
+
+		for (size_t i = 0 ; i < 3 ; i++)
+		{vForce.template get<0>(p)[i] = f.get(i);}
+	}
+
+	t.stop();
+
+	return t.getwct();
+}
+
+BOOST_AUTO_TEST_SUITE( celllist_performance )
+
+BOOST_AUTO_TEST_CASE( celllist_reorder_sfc_performance )
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {64,64,64};
+	double r_cut = 1.0 / 64.0;
+
+	size_t opt[3] = {CL_LINEAR_CELL_KEYS,CL_MORTON_CELL_KEYS,CL_HILBERT_CELL_KEYS};
+	const char * opt_name[3] = {"linear","morton","hilbert"};
+
+	for (size_t o = 0 ; o < 3 ; o++)
+	{
+		openfpm::vector<Point<3,double>> vPos;
+		openfpm::vector<Point<3,double>> vForce;
+		openfpm::vector<aggregate<double>> vPrp;
+
+		SimpleRNG rng;
+
+		for (size_t i = 0 ; i < 1000000 ; i++)
+		{
+			Point<3,double> p({rng.GetUniform(),rng.GetUniform(),rng.GetUniform()});
+			vPos.add(p);
+		}
+
+		vForce.resize(vPos.size());
+
+		CellList<3,double,Mem_fast<>> cl(box,div,1);
+		cl.setOpt(CL_NON_SYMMETRIC | opt[o]);
+		cl.fill(vPos,vPrp,vPos.size());
+
+		std::vector<double> times_random;
+		std::vector<double> times_sfc;
+
+		for (int s = 0 ; s < N_STAT_CELLLIST + 1 ; s++)
+		{
+			double t = force_loop(cl,vPos,vForce,r_cut);
+
+			// the first is warm-up
+			if (s != 0)	{times_random.push_back(t);}
+		}
+
+		double f_check = 0.0;
+		for (size_t i = 0 ; i < vForce.size() ; i++)
+		{f_check += fabs(vForce.template get<0>(i)[0]);}
+
+		openfpm::vector<size_t> perm;
+
+		timer t_r;
+		t_r.start();
+
+		cl.reorderSFC(vPos,vPrp,vPos.size(),perm);
+
+		t_r.stop();
+
+		for (int s = 0 ; s < N_STAT_CELLLIST + 1 ; s++)
+		{
+			double t = force_loop(cl,vPos,vForce,r_cut);
+
+			// the first is warm-up
+			if (s != 0)	{times_sfc.push_back(t);}
+		}
+
+		double f_check_sfc = 0.0;
+		for (size_t i = 0 ; i < vForce.size() ; i++)
+		{f_check_sfc += fabs(vForce.template get<0>(i)[0]);}
+
+		BOOST_REQUIRE_CLOSE(f_check,f_check_sfc,0.001);
+
+		double mean;
+		double dev;
+		double mean_sfc;
+		double dev_sfc;
+		standard_deviation(times_random,mean,dev);
+		standard_deviation(times_sfc,mean_sfc,dev_sfc);
+
+		std::cout << "Cell list force loop " << vPos.size() << " particles (" << opt_name[o] << ")  random order: " << mean << " +- " << dev
+				  << " s   reordered: " << mean_sfc << " +- " << dev_sfc << " s   speedup: " << mean / mean_sfc
+				  << "   reorder time: " << t_r.getwct() << " s" << std::endl;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
  */
 
 #include "NN/CellList/CellList.hpp"
+#include "NN/CellList/CellListSparse.hpp"
 #include "NN/CellList/multiphase/CellListM.hpp"
 #include "Grid/grid_sm.hpp"
 
@@ -488,6 +489,291 @@ template<unsigned int dim, typename T, typename CellS> void Test_NN_iterator_rad
 	BOOST_REQUIRE(number_of_nn2 < number_of_nn);
 }
 
+/*! \brief Check that the one step fill of a cell list produce the same cells of
+ *         adding the particles one by one
+ *
+ * \tparam CellS cell list to test
+ *
+ * \param opt fill option (CL_SYMMETRIC, CL_LOCAL_SYMMETRIC, CL_NON_SYMMETRIC)
+ *
+ */
+template<typename CellS> void Test_cell_fill(size_t opt)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {16,16,16};
+
+	CellS cl(box,div,1);
+	CellList<3,double,Mem_bal<>> cl_ref(box,div,1);
+
+	cl.setOpt(opt);
+	cl_ref.setOpt(opt);
+
+	// particles inside the domain followed by ghost particles in the padding
+
+	openfpm::vector<Point<3,double>> vPos;
+	openfpm::vector<aggregate<double>> vPrp;
+
+	size_t ghostMarker = 40000;
+
+	for (size_t i = 0 ; i < 50000 ; i++)
+	{
+		Point<3,double> p;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{p.get(j) = (double)rand() / RAND_MAX;}
+
+		if (i >= ghostMarker)
+		{p.get(i % 3) = (i % 2)?1.0 + p.get(i % 3) / 32.0:- p.get(i % 3) / 32.0;}
+
+		vPos.add(p);
+	}
+
+	cl.fill(vPos,vPrp,ghostMarker);
+	cl_ref.fill(vPos,vPrp,ghostMarker);
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < cl.getNCells() ; i++)
+	{
+		match &= cl.getNelements(i) == cl_ref.getNelements(i);
+
+		for (size_t j = 0 ; j < cl.getNelements(i) && match == true ; j++)
+		{match &= cl.get(i,j) == cl_ref.get(i,j);}
+
+		match &= static_cast<typename CellS::Mem_type_type &>(cl).getGhostMarker(i) == static_cast<Mem_bal<> &>(cl_ref).getGhostMarker(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the cell list can be filled again and particles can be added after
+
+	cl.fill(vPos,vPrp,ghostMarker);
+	cl.add(vPos.get(0),50000);
+
+	BOOST_REQUIRE_EQUAL(cl.get(cl.getCell(vPos.get(0)),cl.getNelements(cl.getCell(vPos.get(0)))-1),50000ul);
+}
+
+/*! \brief Check the reordering of the particles along the space filling curve of the cells
+ *
+ * \param sfc_opt curve to use (CL_LINEAR_CELL_KEYS, CL_HILBERT_CELL_KEYS, CL_MORTON_CELL_KEYS)
+ *
+ */
+inline void Test_cell_reorder(size_t sfc_opt)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {16,16,16};
+
+	CellList<3,double,Mem_fast<>> cl(box,div,1);
+	cl.setOpt(CL_NON_SYMMETRIC | sfc_opt);
+
+	openfpm::vector<Point<3,double>> vPos;
+	openfpm::vector_soa<aggregate<double,size_t>> vPrp;
+
+	size_t ghostMarker = 40000;
+
+	for (size_t i = 0 ; i < 50000 ; i++)
+	{
+		Point<3,double> p;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{p.get(j) = (double)rand() / RAND_MAX;}
+
+		if (i >= ghostMarker)
+		{p.get(i % 3) = (i % 2)?1.0 + p.get(i % 3) / 32.0:- p.get(i % 3) / 32.0;}
+
+		vPos.add(p);
+		vPrp.add();
+		vPrp.template get<0>(i) = p.get(0);
+		vPrp.template get<1>(i) = i;
+	}
+
+	auto vPos_old = vPos;
+
+	cl.fill(vPos,vPrp,ghostMarker);
+
+	openfpm::vector<size_t> perm;
+	cl.reorderSFC(vPos,vPrp,ghostMarker,perm);
+
+	BOOST_REQUIRE_EQUAL(perm.size(),vPos.size());
+	BOOST_REQUIRE_EQUAL(vPrp.size(),vPos.size());
+
+	bool match = true;
+
+	for (size_t i = 0 ; i < vPos.size() ; i++)
+	{
+		match &= Point<3,double>(vPos.get(i)) == Point<3,double>(vPos_old.get(perm.get(i)));
+		match &= vPrp.template get<0>(i) == vPos.template get<0>(i)[0];
+		match &= vPrp.template get<1>(i) == perm.get(i);
+
+		if (i >= ghostMarker)
+		{match &= perm.get(i) == i;}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// following the curve the domain particles must be 0,1,2 ...
+
+	const openfpm::vector<size_t> & keys = cl.getCellSFCKeys();
+
+	size_t cnt = 0;
+
+	for (size_t k = 0 ; k < keys.size() ; k++)
+	{
+		for (size_t j = 0 ; j < cl.getNelements(keys.get(k)) ; j++)
+		{
+			match &= cl.get(keys.get(k),j) == cnt;
+			cnt++;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(cnt,ghostMarker);
+}
+
+/*! \brief Check that the sparse cell list give the same neighborhoods of the dense cell list
+ *
+ */
+inline void Test_cell_sparse()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {20,20,20};
+
+	CellList<3,double,Mem_fast<>> cl(box,div,1);
+	CellListSparse<3,double> cls(box,div,1);
+
+	// particles in two clusters, most of the cells are empty
+
+	openfpm::vector<Point<3,double>> vPos;
+	openfpm::vector<aggregate<double>> vPrp;
+
+	for (size_t i = 0 ; i < 10000 ; i++)
+	{
+		double c = (i % 2 == 0)?0.1:0.7;
+		vPos.add(Point<3,double>({c + 0.2*rand() / RAND_MAX,c + 0.2*rand() / RAND_MAX,c + 0.2*rand() / RAND_MAX}));
+	}
+
+	cl.fill(vPos,vPrp,vPos.size());
+	cls.fill(vPos,vPrp,vPos.size());
+
+	BOOST_REQUIRE(cls.getNOccupiedCells() < cl.getGrid().size() / 4);
+
+	bool match = true;
+
+	for (size_t p = 0 ; p < vPos.size() ; p++)
+	{
+		Point<3,double> xp = vPos.get(p);
+		size_t cell = cl.getCell(xp);
+
+		match &= cls.getCell(xp) == cell;
+		match &= cls.getNelements(cell) == cl.getNelements(cell);
+
+		auto NN = cl.getNNIteratorBox(cell);
+		auto NNs = cls.getNNIteratorBox(cell);
+
+		while (NN.isNext() && NNs.isNext())
+		{
+			match &= NN.get() == NNs.get();
+
+			++NN;
+			++NNs;
+		}
+
+		match &= NN.isNext() == NNs.isNext();
+
+		auto NNsym = cl.getNNIteratorBoxSym(cell,p,vPos);
+		auto NNssym = cls.getNNIteratorBoxSym(cell,p,vPos);
+
+		while (NNsym.isNext() && NNssym.isNext())
+		{
+			match &= NNsym.get() == NNssym.get();
+
+			++NNsym;
+			++NNssym;
+		}
+
+		match &= NNsym.isNext() == NNssym.isNext();
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// neighborhood of empty cells
+
+	size_t n_nn = 0;
+
+	for (size_t c = 0 ; c < cl.getGrid().size() ; c++)
+	{
+		if (cl.getNelements(c) != 0)
+		{continue;}
+
+		grid_key_dx<3> key = cl.getGrid().InvLinId(c);
+
+		bool inside = true;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{inside &= key.get(i) >= 1 && key.get(i) < (long int)cl.getGrid().size(i) - 1;}
+
+		if (inside == false)
+		{continue;}
+
+		auto NN = cl.getNNIteratorBox(c);
+		auto NNs = cls.getNNIteratorBox(c);
+
+		while (NN.isNext() && NNs.isNext())
+		{
+			match &= NN.get() == NNs.get();
+
+			++NN;
+			++NNs;
+			n_nn++;
+		}
+
+		match &= NN.isNext() == NNs.isNext();
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(n_nn != 0);
+
+	// a domain with 10^12 cells
+
+	size_t div_big[3] = {10000,10000,10000};
+	CellListSparse<3,double,unsigned int> cl_big(box,div_big,1);
+
+	openfpm::vector<Point<3,double>> vPos_big;
+
+	vPos_big.add(Point<3,double>({0.50001,0.50001,0.50001}));
+	vPos_big.add(Point<3,double>({0.50011,0.50001,0.50001}));
+	vPos_big.add(Point<3,double>({0.50031,0.50001,0.50001}));
+	vPos_big.add(Point<3,double>({0.9,0.1,0.3}));
+
+	cl_big.fill(vPos_big,vPrp,vPos_big.size());
+
+	BOOST_REQUIRE_EQUAL(cl_big.getNOccupiedCells(),4ul);
+
+	openfpm::vector<size_t> nn;
+
+	auto NN = cl_big.getNNIteratorBox(cl_big.getCell(vPos_big.get(0)));
+	while (NN.isNext())
+	{
+		nn.add(NN.get());
+		++NN;
+	}
+
+	BOOST_REQUIRE_EQUAL(nn.size(),2ul);
+	BOOST_REQUIRE_EQUAL(nn.get(0),0ul);
+	BOOST_REQUIRE_EQUAL(nn.get(1),1ul);
+
+	auto NNsym = cl_big.getNNIteratorBoxSym(cl_big.getCell(vPos_big.get(1)),1,vPos_big);
+
+	nn.clear();
+	while (NNsym.isNext())
+	{
+		nn.add(NNsym.get());
+		++NNsym;
+	}
+
+	BOOST_REQUIRE_EQUAL(nn.size(),1ul);
+	BOOST_REQUIRE_EQUAL(nn.get(0),1ul);
+}
+
 BOOST_AUTO_TEST_SUITE( CellList_test )
 
 BOOST_AUTO_TEST_CASE ( NN_radius_check )
@@ -519,12 +805,36 @@ BOOST_AUTO_TEST_CASE( CellList_use)
 
 	Test_cell_s<3,double,CellList<3,double,Mem_bal<>>>(box);
 	Test_cell_s<3,double,CellList<3,double,Mem_mw<>>>(box);
+	Test_cell_s<3,double,CellList<3,double,Mem_csr<>>>(box);
 
 	std::cout << "End cell list" << "\n";
 
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( CellList_fill_one_step )
+{
+	Test_cell_fill<CellList<3,double,Mem_fast<>>>(CL_NON_SYMMETRIC);
+	Test_cell_fill<CellList<3,double,Mem_fast<>>>(CL_SYMMETRIC);
+	Test_cell_fill<CellList<3,double,Mem_fast<>>>(CL_LOCAL_SYMMETRIC);
+
+	Test_cell_fill<CellList<3,double,Mem_csr<>>>(CL_NON_SYMMETRIC);
+	Test_cell_fill<CellList<3,double,Mem_csr<>>>(CL_SYMMETRIC);
+	Test_cell_fill<CellList<3,double,Mem_csr<>>>(CL_LOCAL_SYMMETRIC);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_reorder_sfc )
+{
+	Test_cell_reorder(CL_LINEAR_CELL_KEYS);
+	Test_cell_reorder(CL_HILBERT_CELL_KEYS);
+	Test_cell_reorder(CL_MORTON_CELL_KEYS);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_sparse )
+{
+	Test_cell_sparse();
+}
+
 BOOST_AUTO_TEST_CASE( CellList_consistent )
 {
 	Test_CellDecomposer_consistent<CellList<2,float,Mem_fast<>,shift<2,float>>>();
@@ -0,0 +1,617 @@
+/*
+ * MemCSR.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef MEMCSR_HPP_
+#define MEMCSR_HPP_
+
+#include "config.h"
+#include "Vector/map_vector.hpp"
+#include "util/openmp_util.hpp"
+#include <algorithm>
+
+/*! \brief It is a class that work like a vector of vector stored in a compact (CSR like) layout
+ *
+ * The elements of all the cells are stored in one array, the elements of the cell i start at cl_start(i)
+ * and the cell i has space for cl_start(i+1) - cl_start(i) elements. When the structure is constructed in
+ * one step with fill_cells or fill_cells_with, every cell has exactly the space for its elements, so the
+ * memory is N*sizeof(local_index) + M*(sizeof(size_t) + sizeof(local_index)). If a cell overflow with
+ * addCell, the space of all the cells is doubled (like Mem_fast).
+ * Used as Mem_type of a VerletList (cell = particle, elements = neighborhood) with local_index = unsigned int
+ * the neighborhood are stored as packed 32 bit ids
+ *
+ * * M = number of cells
+ * * N = total number of elements
+ *
+ * \tparam Memory memory for the internal vectors
+ * \tparam local_index type used for the local index
+ *
+ */
+template <typename Memory = HeapMemory, typename local_index = size_t>
+class Mem_csr
+{
+	//! Number of slot for each cell when the structure is initialized with init_to_zero
+	local_index slot;
+
+	//! starting point of each cell (64 bit, the total number of elements can exceed the range of local_index)
+	openfpm::vector<aggregate<size_t>,Memory> cl_start;
+
+	//! number of elements in each cell
+	openfpm::vector<aggregate<local_index>,Memory> cl_n;
+
+	//! base that store the data
+	typedef typename openfpm::vector<aggregate<local_index>,Memory> base;
+
+	//! ghost marker for every cell (non-ghost particles < gm (ghost marker))
+	openfpm::vector<size_t> ghostMarkers;
+
+	//! elements of all the cells
+	base cl_base;
+
+	/*! \brief realloc the data structures doubling the space of all the cells
+	 *
+	 *
+	 */
+	inline void realloc()
+	{
+		openfpm::vector<aggregate<size_t>,Memory> cl_start_;
+		cl_start_.resize(cl_start.size());
+
+		cl_start_.template get<0>(0) = 0;
+		for (size_t i = 0 ; i < cl_n.size() ; i++)
+		{
+			size_t sp = cl_start.template get<0>(i+1) - cl_start.template get<0>(i);
+			cl_start_.template get<0>(i+1) = cl_start_.template get<0>(i) + ((sp == 0)?1:2*sp);
+		}
+
+		// +1 so that getStopId of the last cell is always a valid reference
+		base cl_base_(cl_start_.template get<0>(cl_n.size()) + 1);
+
+		for (size_t i = 0 ; i < cl_n.size() ; i++)
+		{
+			for (local_index j = 0 ; j < cl_n.template get<0>(i) ; j++)
+			{cl_base_.template get<0>(cl_start_.template get<0>(i) + j) = cl_base.template get<0>(cl_start.template get<0>(i) + j);}
+		}
+
+		cl_start.swap(cl_start_);
+		cl_base.swap(cl_base_);
+	}
+
+public:
+
+	typedef void toKernel_type;
+
+	typedef local_index local_index_type;
+
+	//! expose the type of the local index
+	typedef local_index loc_index;
+
+	/*! \brief Constructor
+	 *
+	 * \param slot number of slot for each cell
+	 *
+	 */
+	inline Mem_csr(local_index slot)
+	:slot(slot)
+	{}
+
+	/*! \brief Set the number of slot for each cell used by init_to_zero
+	 *
+	 * \param number of slot
+	 *
+	 */
+	inline void set_slot(local_index slot)
+	{
+		this->slot = slot;
+	}
+
+	/*! \brief return the number of cells
+	 *
+	 * \return the number of cells
+	 *
+	 */
+	inline size_t size() const
+	{
+		return cl_n.size();
+	}
+
+	/*! \brief Destroy the internal memory including the retained one
+	 *
+	 */
+	inline void destroy()
+	{
+		ghostMarkers.swap(openfpm::vector<size_t>());
+		cl_start.swap(openfpm::vector<aggregate<size_t>,Memory>());
+		cl_n.swap(openfpm::vector<aggregate<local_index>,Memory>());
+		cl_base.swap(base());
+	}
+
+	/*! \brief Initialize the data to zero
+	 *
+	 * \param slot number of slot for each cell
+	 * \param tot_n_cell total number of cells
+	 *
+	 */
+	inline void init_to_zero(local_index slot, local_index tot_n_cell)
+	{
+		this->slot = slot;
+
+		cl_n.resize(tot_n_cell);
+		cl_n.template fill<0>(0);
+
+		ghostMarkers.resize(tot_n_cell);
+		ghostMarkers.fill(0);
+
+		cl_start.resize(tot_n_cell+1);
+		for (size_t i = 0 ; i <= tot_n_cell ; i++)
+		{cl_start.template get<0>(i) = i*(size_t)slot;}
+
+		cl_base.resize(tot_n_cell * (size_t)slot + 1);
+	}
+
+	/*! \brief Fill all the cells in one step
+	 *
+	 * The elements of each cell are counted, the starting point of each cell is calculated with a scan
+	 * and the elements are scattered in their cell. All the passes are parallel and no reallocation is
+	 * needed. Inside each cell the elements are sorted, so the result is the same of calling addCell for
+	 * the elements 0,1,2 ... in order
+	 *
+	 * \param cell_ids cell_ids.get(i) is the cell of the element i
+	 * \param gm ghost marker, elements >= gm are ghost
+	 * \param set_gm if true set the ghost marker of each cell (as addCellGhostMarkers called after adding all the elements < gm)
+	 *
+	 */
+	void fill_cells(const openfpm::vector<size_t> & cell_ids, size_t gm, bool set_gm)
+	{
+		size_t n_cell = cl_n.size();
+
+		if (n_cell == 0)
+		{return;}
+
+		local_index * cnt = &cl_n.template get<0>(0);
+
+		// count
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{cnt[i] = 0;}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			#pragma omp atomic
+			cnt[cell_ids.get(i)]++;
+		}
+
+		// scan
+
+		cl_start.resize(n_cell+1);
+		size_t * start = &cl_start.template get<0>(0);
+
+		start[n_cell] = openfpm::omp::exclusive_scan(cnt,start,n_cell);
+
+		// scatter
+
+		cl_base.resize(start[n_cell] + 1);
+		local_index * data = &cl_base.template get<0>(0);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{cnt[i] = 0;}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			size_t c = cell_ids.get(i);
+			local_index pos;
+
+			#pragma omp atomic capture
+			pos = cnt[c]++;
+
+			data[start[c] + pos] = i;
+		}
+
+		// sort inside each cell and set the ghost markers
+
+		ghostMarkers.resize(n_cell);
+
+		#pragma omp parallel for schedule(dynamic,1024)
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			std::sort(data + start[i],data + start[i] + cnt[i]);
+
+			ghostMarkers.get(i) = (set_gm == true)?std::lower_bound(data + start[i],data + start[i] + cnt[i],(local_index)gm) - (data + start[i]):0;
+		}
+	}
+
+	/*! \brief Fill all the cells in one step, the elements of each cell are produced by a functor
+	 *
+	 * The cells are split in contiguous blocks across the threads, each thread produce the elements
+	 * of its cells in a private buffer and count them. The starting point of each cell is calculated
+	 * with a scan and every thread copy its buffer in place (count, scan, fill). The order of the
+	 * elements in a cell is the order in which the functor add them. Every cell has exactly the space
+	 * for its elements
+	 *
+	 * \tparam cell_functor functor with operator()(size_t cell, buffer & buf), the functor add the
+	 *         elements of cell calling buf.addCell(cell,ele)
+	 *
+	 * \param n_cell number of cells
+	 * \param f functor
+	 *
+	 */
+	template<typename cell_functor>
+	void fill_cells_with(size_t n_cell, cell_functor f)
+	{
+		//! Thread buffer, it store the elements of a block of cells
+		struct buffer
+		{
+			//! elements
+			openfpm::vector<local_index> ele;
+
+			//! number of elements of each cell
+			local_index * cnt;
+
+			//! first cell of the block
+			size_t c_start;
+
+			//! Add an element to a cell of the block
+			inline void addCell(size_t cell_id, size_t e)
+			{
+				ele.add(e);
+				cnt[cell_id - c_start]++;
+			}
+		};
+
+		cl_n.resize(n_cell);
+		cl_start.resize(n_cell+1);
+		ghostMarkers.resize(n_cell);
+
+		if (n_cell == 0)
+		{
+			cl_start.template get<0>(0) = 0;
+			cl_base.resize(1);
+			return;
+		}
+
+		local_index * cnt = &cl_n.template get<0>(0);
+		size_t * start = &cl_start.template get<0>(0);
+
+		int nth = openfpm::omp::get_max_threads();
+		std::vector<buffer> buf(nth);
+
+		#pragma omp parallel num_threads(nth)
+		{
+			int tid = openfpm::omp::get_thread_num();
+			int nth_r = openfpm::omp::get_num_threads();
+
+			size_t c_start;
+			size_t c_stop;
+			openfpm::omp::thread_range(n_cell,nth_r,tid,c_start,c_stop);
+
+			buffer & b = buf[tid];
+			b.cnt = cnt + c_start;
+			b.c_start = c_start;
+
+			for (size_t i = c_start ; i < c_stop ; i++)
+			{
+				cnt[i] = 0;
+				ghostMarkers.get(i) = 0;
+			}
+
+			for (size_t i = c_start ; i < c_stop ; i++)
+			{f(i,b);}
+
+			#pragma omp barrier
+
+			#pragma omp single
+			{
+				start[n_cell] = openfpm::omp::exclusive_scan(cnt,start,n_cell);
+				cl_base.resize(start[n_cell] + 1);
+			}
+
+			if (c_start < c_stop)
+			{
+				local_index * data = &cl_base.template get<0>(start[c_start]);
+
+				for (size_t i = 0 ; i < b.ele.size() ; i++)
+				{data[i] = b.ele.get(i);}
+			}
+		}
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	inline void operator=(const Mem_csr<Memory,local_index> & mem)
+	{
+		slot = mem.slot;
+
+		ghostMarkers = mem.ghostMarkers;
+		cl_start = mem.cl_start;
+		cl_n = mem.cl_n;
+		cl_base = mem.cl_base;
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	inline void operator=(Mem_csr<Memory,local_index> && mem)
+	{
+		this->swap(mem);
+	}
+
+	/*! \brief copy an object Mem_csr
+	 *
+	 * \param mem Mem_csr to copy
+	 *
+	 */
+	template<typename Memory2>
+	inline void copy_general(const Mem_csr<Memory2,local_index> & mem)
+	{
+		slot = mem.private_get_slot();
+
+		ghostMarkers = mem.getGhostMarkers();
+		cl_start = mem.private_get_cl_start();
+		cl_n = mem.private_get_cl_n();
+		cl_base = mem.private_get_cl_base();
+	}
+
+	/*! \brief Set the ghost marker of every cell to the number of elements it contain
+	 *
+	 */
+	inline void addCellGhostMarkers()
+	{
+		ghostMarkers.resize(cl_n.size());
+
+		for (size_t i = 0; i < cl_n.size(); ++i)
+		{
+			ghostMarkers.get(i) = cl_n.template get<0>(i);
+		}
+	}
+
+	/*! \brief Get ghost marker of the cell
+	 *
+	 */
+	inline size_t getGhostMarker(local_index cell_id) const
+	{
+		return ghostMarkers.get(cell_id);
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void addCell(local_index cell_id, local_index ele)
+	{
+		local_index nl = getNelements(cell_id);
+
+		if (nl >= cl_start.template get<0>(cell_id+1) - cl_start.template get<0>(cell_id))
+		{
+			realloc();
+		}
+
+		cl_base.template get<0>(cl_start.template get<0>(cell_id) + nl) = ele;
+		cl_n.template get<0>(cell_id)++;
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) -> decltype(cl_base.template get<0>(0)) &
+	{
+		return cl_base.template get<0>(cl_start.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) const -> decltype(cl_base.template get<0>(0)) &
+	{
+		return cl_base.template get<0>(cl_start.template get<0>(cell) + ele);
+	}
+
+	/*! \brief Remove an element in the cell
+	*
+	* \param cell id of the cell
+	* \param ele element id to remove
+	*
+	*/
+	inline void remove(local_index cell_id, local_index ele)
+	{
+		cl_n.template get<0>(cell_id)--;
+
+		size_t st = cl_start.template get<0>(cell_id);
+
+		// shift all remaining elements left
+		for (local_index i = ele+1; i <= cl_n.template get<0>(cell_id); ++i)
+			cl_base.template get<0>(st + i-1) = cl_base.template get<0>(st + i);
+	}
+
+	/*! \brief Get the number of elements in the cell
+	 *
+	 * \param cell_id id of the cell
+	 *
+	 * \return the number of elements in the cell
+	 *
+	 */
+	inline size_t getNelements(const local_index cell_id) const
+	{
+		return cl_n.template get<0>(cell_id);
+	}
+
+	/*! \brief swap to Mem_csr object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_csr<Memory,local_index> & mem)
+	{
+		ghostMarkers.swap(mem.ghostMarkers);
+		cl_start.swap(mem.cl_start);
+		cl_n.swap(mem.cl_n);
+		cl_base.swap(mem.cl_base);
+
+		local_index cl_slot_tmp = mem.slot;
+		mem.slot = slot;
+		slot = cl_slot_tmp;
+	}
+
+	/*! \brief swap to Mem_csr object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_csr<Memory,local_index> && mem)
+	{
+		slot = mem.slot;
+
+		ghostMarkers.swap(mem.ghostMarkers);
+		cl_start.swap(mem.cl_start);
+		cl_n.swap(mem.cl_n);
+		cl_base.swap(mem.cl_base);
+	}
+
+	/*! \brief Delete all the elements in every cell
+	 *
+	 * The space of each cell is retained
+	 *
+	 */
+	inline void clear()
+	{
+		for (size_t i = 0 ; i < cl_n.size() ; i++)
+		{
+			cl_n.template get<0>(i) = 0;
+			ghostMarkers.get(i) = 0;
+		}
+	}
+
+	/*! \brief Delete cell elements in Cell p
+	 *
+	 * \param cell_id cell-id
+	 *
+	 */
+	inline void clear(local_index cell_id)
+	{
+		cl_n.template get<0>(cell_id) = 0;
+	}
+
+	/*! \brief Get the first element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the first element
+	 *
+	 */
+	inline const local_index & getStartId(local_index cell_id) const
+	{
+		return cl_base.template get<0>(cl_start.template get<0>(cell_id));
+	}
+
+	/*! \brief Get the index of the first ghost element
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the first element
+	 *
+	 */
+	inline const local_index & getGhostId(local_index cell_id) const
+	{
+		return cl_base.template get<0>(cl_start.template get<0>(cell_id)+ghostMarkers.get(cell_id));
+	}
+
+	/*! \brief Get the last element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the last element
+	 *
+	 */
+	inline const local_index & getStopId(local_index cell_id) const
+	{
+		return cl_base.template get<0>(cl_start.template get<0>(cell_id)+cl_n.template get<0>(cell_id));
+	}
+
+	/*! \brief Just return the value pointed by part_id
+	 *
+	 * \param part_id
+	 *
+	 * \return the value pointed by part_id
+	 *
+	 */
+	inline const local_index & get_lin(const local_index * part_id) const
+	{
+		return *part_id;
+	}
+
+	/*! \brief Return the private data-structure cl_start
+	 *
+	 * \return cl_start
+	 *
+	 */
+	const openfpm::vector<aggregate<size_t>,Memory> & private_get_cl_start() const
+	{
+		return cl_start;
+	}
+
+	/*! \brief Return the private data-structure cl_n
+	 *
+	 * \return cl_n
+	 *
+	 */
+	const openfpm::vector<aggregate<local_index>,Memory> & private_get_cl_n() const
+	{
+		return cl_n;
+	}
+
+	/*! \brief Return the private data-structure ghostMarkers
+	 *
+	 * \return ghostMarkers
+	 *
+	 */
+	const openfpm::vector<size_t> & getGhostMarkers() const
+	{
+		return ghostMarkers;
+	}
+
+	/*! \brief Return the private slot
+	 *
+	 * \return slot
+	 *
+	 */
+	const local_index & private_get_slot() const
+	{
+		return slot;
+	}
+
+	/*! \brief Return the private data-structure cl_base
+	 *
+	 * \return cl_base
+	 *
+	 */
+	const base & private_get_cl_base() const
+	{
+		return cl_base;
+	}
+};
+
+
+#endif /* MEMCSR_HPP_ */
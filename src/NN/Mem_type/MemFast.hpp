@@ -13,8 +13,10 @@
 #include "util/mathutil.hpp"
 #include "Space/Shape/HyperCube.hpp"
 #include <unordered_map>
+#include <algorithm>
 #include "util/common.hpp"
 #include "Vector/map_vector.hpp"
+#include "util/openmp_util.hpp"
 
 template <typename Memory, template <typename> class layout_base,typename local_index>
 class Mem_fast_ker
@@ -112,6 +114,9 @@ class Mem_fast
 		// slots
 		base cl_base_(2*slot * cl_n.size());
 
+		CONTAINER_STAT_INC(CSTAT_MEM_FAST_REALLOC);
+		CONTAINER_STAT_ADD(CSTAT_MEM_FAST_BYTES,2*slot * cl_n.size() * sizeof(local_index));
+
 		// copy cl_base
 		for (size_t i = 0 ; i < cl_n.size() ; i++)
 		{
@@ -176,6 +181,186 @@ public:
 		cl_base.resize(tot_n_cell * slot);
 	}
 
+	/*! \brief Fill all the cells in one step
+	 *
+	 * The elements of each cell are counted, the number of slot is set to fit the most populated cell
+	 * and the elements are scattered in their cell. All the passes are parallel and no reallocation is
+	 * needed. Inside each cell the elements are sorted, so the result is the same of calling addCell for
+	 * the elements 0,1,2 ... in order
+	 *
+	 * \param cell_ids cell_ids.get(i) is the cell of the element i
+	 * \param gm ghost marker, elements >= gm are ghost
+	 * \param set_gm if true set the ghost marker of each cell (as addCellGhostMarkers called after adding all the elements < gm)
+	 *
+	 */
+	void fill_cells(const openfpm::vector<size_t> & cell_ids, size_t gm, bool set_gm)
+	{
+		size_t n_cell = cl_n.size();
+
+		if (n_cell == 0)
+		{return;}
+
+		local_index * cnt = &cl_n.template get<0>(0);
+
+		// count
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{cnt[i] = 0;}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			#pragma omp atomic
+			cnt[cell_ids.get(i)]++;
+		}
+
+		local_index max_n = 0;
+
+		#pragma omp parallel for reduction(max:max_n)
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{max_n = (cnt[i] > max_n)?cnt[i]:max_n;}
+
+		// the number of slot must be bigger than the elements (see addCell)
+
+		if (max_n + 1 > slot)
+		{
+			slot = max_n + 1;
+			cl_base.resize(n_cell * slot);
+		}
+
+		// scatter
+
+		local_index * data = &cl_base.template get<0>(0);
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{cnt[i] = 0;}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < cell_ids.size() ; i++)
+		{
+			size_t c = cell_ids.get(i);
+			local_index pos;
+
+			#pragma omp atomic capture
+			pos = cnt[c]++;
+
+			data[c*slot + pos] = i;
+		}
+
+		// sort inside each cell and set the ghost markers
+
+		ghostMarkers.resize(n_cell);
+
+		#pragma omp parallel for schedule(dynamic,1024)
+		for (size_t i = 0 ; i < n_cell ; i++)
+		{
+			std::sort(data + i*slot,data + i*slot + cnt[i]);
+
+			ghostMarkers.get(i) = (set_gm == true)?std::lower_bound(data + i*slot,data + i*slot + cnt[i],(local_index)gm) - (data + i*slot):0;
+		}
+	}
+
+	/*! \brief Fill all the cells in one step, the elements of each cell are produced by a functor
+	 *
+	 * The cells are split in contiguous blocks across the threads, each thread produce the elements
+	 * of its cells in a private buffer and count them. The number of slot is set to fit the most
+	 * populated cell and every thread copy its buffer in the slots of its cells. The order of the
+	 * elements in a cell is the order in which the functor add them, so the result is the same of
+	 * calling the functor for the cells 0,1,2 ... in order with addCell
+	 *
+	 * \tparam cell_functor functor with operator()(size_t cell, buffer & buf), the functor add the
+	 *         elements of cell calling buf.addCell(cell,ele)
+	 *
+	 * \param n_cell number of cells
+	 * \param f functor
+	 *
+	 */
+	template<typename cell_functor>
+	void fill_cells_with(size_t n_cell, cell_functor f)
+	{
+		//! Thread buffer, it store the elements of a block of cells
+		struct buffer
+		{
+			//! elements
+			openfpm::vector<local_index> ele;
+
+			//! number of elements of each cell
+			local_index * cnt;
+
+			//! first cell of the block
+			size_t c_start;
+
+			//! Add an element to a cell of the block
+			inline void addCell(size_t cell_id, size_t e)
+			{
+				ele.add(e);
+				cnt[cell_id - c_start]++;
+			}
+		};
+
+		cl_n.resize(n_cell);
+		ghostMarkers.resize(n_cell);
+
+		if (n_cell == 0)
+		{return;}
+
+		local_index * cnt = &cl_n.template get<0>(0);
+
+		int nth = openfpm::omp::get_max_threads();
+		std::vector<buffer> buf(nth);
+		std::vector<local_index> max_n(nth,0);
+
+		#pragma omp parallel num_threads(nth)
+		{
+			int tid = openfpm::omp::get_thread_num();
+			int nth_r = openfpm::omp::get_num_threads();
+
+			size_t c_start;
+			size_t c_stop;
+			openfpm::omp::thread_range(n_cell,nth_r,tid,c_start,c_stop);
+
+			buffer & b = buf[tid];
+			b.cnt = cnt + c_start;
+			b.c_start = c_start;
+
+			for (size_t i = c_start ; i < c_stop ; i++)
+			{
+				cnt[i] = 0;
+				ghostMarkers.get(i) = 0;
+			}
+
+			for (size_t i = c_start ; i < c_stop ; i++)
+			{
+				f(i,b);
+				max_n[tid] = (cnt[i] > max_n[tid])?cnt[i]:max_n[tid];
+			}
+
+			#pragma omp barrier
+
+			// the number of slot must be bigger than the elements (see addCell)
+
+			#pragma omp single
+			{
+				slot = *std::max_element(max_n.begin(),max_n.end()) + 1;
+				cl_base.resize(n_cell * slot);
+			}
+
+			if (c_start < c_stop)
+			{
+				local_index * data = &cl_base.template get<0>(0);
+				size_t k = 0;
+
+				for (size_t i = c_start ; i < c_stop ; i++)
+				{
+					for (local_index j = 0 ; j < cnt[i] ; j++, k++)
+					{data[i*slot + j] = b.ele.get(k);}
+				}
+			}
+		}
+	}
+
 	/*! \brief copy an object Mem_fast
 	 *
 	 * \param mem Mem_fast to copy
@@ -10,6 +10,7 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCSR.hpp"
 
 BOOST_AUTO_TEST_SUITE( Mem_type_test )
 
@@ -38,6 +39,7 @@ BOOST_AUTO_TEST_CASE ( Mem_type_check )
 	test_mem_type<Mem_fast<>>();
 	test_mem_type<Mem_bal<>>();
 	test_mem_type<Mem_mw<>>();
+	test_mem_type<Mem_csr<>>();
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,7 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCSR.hpp"
 
 
 // Verlet list config options
@@ -28,6 +29,31 @@ typedef unsigned int local_index_;
 #endif
 
 
+/*! \brief Check if a Mem_type can construct all the neighborhoods in one step with fill_cells_with
+ *
+ * ### Example
+ *
+ * \code{.cpp}
+ *
+ * has_fill_cells_with<Mem_csr<>>::value
+ *
+ * \endcode
+ *
+ * return true if the Mem_type has fill_cells_with
+ *
+ */
+template<typename T, typename Sfinae = void>
+struct has_fill_cells_with: std::false_type {};
+
+/*! \brief Check if a Mem_type can construct all the neighborhoods in one step with fill_cells_with
+ *
+ * \tparam T Mem_type
+ *
+ */
+template<typename T>
+struct has_fill_cells_with<T, typename Void<decltype( std::declval<T>().fill_cells_with(0,std::declval<void (*)(size_t,int &)>()) )>::type> : std::true_type
+{};
+
 /*! Functor class for Verlet list particle neighborhood iteration on initialization
  * Partial template specializations implement different methods of initialization
  *
@@ -286,6 +312,42 @@ private:
 	//! Internal cell-list
 	CellListImpl cli;
 
+	//! Skin distance, with a skin the Verlet-list is reconstructed only when the particles move more than skin/2
+	T skin = 0;
+
+	//! Fraction of moved particles above which the Verlet-list is completely reconstructed
+	T partialRatio = 0.1;
+
+	//! Positions of the particles at the last complete construction
+	openfpm::vector<Point<dim,T>> refPos;
+
+	//! Ghost marker at the last complete construction
+	size_t refGhostMarker = 0;
+
+	//! Particles that moved more than skin/2 from the reference position
+	openfpm::vector<unsigned char> movedMark;
+
+	//! Particles with a neighborhood reconstructed after the last complete construction
+	openfpm::vector<unsigned char> rebuildMark;
+
+	//! Positions of the particles at the last partial construction
+	openfpm::vector<Point<dim,T>> refPartialPos;
+
+	//! true if the Verlet-list has been partially reconstructed after the last complete construction
+	bool partialDone = false;
+
+	//! Number of complete constructions done by update
+	size_t nFullRebuild = 0;
+
+	//! Number of partial constructions done by update
+	size_t nPartialRebuild = 0;
+
+	//! For each domain cell of the CRS scheme the first particle in domainParticlesCRS (temporary buffer used by fillCRSSymmetric)
+	openfpm::vector<size_t> crsCellStart;
+
+	//! For each particle the domain cell of the CRS scheme that contain it, -1 if none (temporary buffer used by fillCRSSymmetric)
+	openfpm::vector<long int> crsCellOf;
+
 
 	/*! \brief Fill the cell-list with data
 	 *
@@ -309,7 +371,100 @@ private:
 		cellList.fill(vPos, vPropStub, ghostMarker);
 	}
 
+	//! Adapter that give to the thread buffers of Mem_type::fill_cells_with the addPart interface used by iteratePartNeighbor
+	template<typename buffer_type>
+	struct partBuffer
+	{
+		//! thread buffer
+		buffer_type & buf;
+
+		/*! \brief Add a neighborhood particle to a particle
+		 *
+		 * \param part_id part id where to add
+		 * \param ele element to add
+		 *
+		 */
+		inline void addPart(size_t part_id, size_t ele)
+		{
+			buf.addCell(part_id,ele);
+		}
+	};
+
+	/*! \brief Construct the neighborhood of the particles [0,end) in parallel (count, scan, fill)
+	 *
+	 * \param pos vector of positions
+	 * \param end number of particles
+	 * \param addNN functor addNN(p,xp,vl) that add the neighborhood of the particle p calling vl.addPart
+	 *
+	 */
+	template<typename NN_functor>
+	inline void fillParticles(
+		const vPos_type & pos,
+		size_t end,
+		NN_functor addNN,
+		std::true_type)
+	{
+		Mem_type::fill_cells_with(end,[&](size_t p, auto & buf)
+		{
+			Point<dim,T> xp = pos.template get<0>(p);
+
+			partBuffer<typename std::remove_reference<decltype(buf)>::type> pb{buf};
+			addNN(p,xp,pb);
+		});
+	}
+
+	/*! \brief Construct the neighborhood of the particles [0,end) adding the particles one by one
+	 *
+	 * \param pos vector of positions
+	 * \param end number of particles
+	 * \param addNN functor addNN(p,xp,vl) that add the neighborhood of the particle p calling vl.addPart
+	 *
+	 */
+	template<typename NN_functor>
+	inline void fillParticles(
+		const vPos_type & pos,
+		size_t end,
+		NN_functor addNN,
+		std::false_type)
+	{
+		Mem_type::init_to_zero(slot,end);
+
+		// iterate the particles
+		auto it = pos.getIteratorTo(end);
+		while (it.isNext())
+		{
+			typename Mem_type::local_index_type p = it.get();
+			Point<dim,T> xp = pos.template get<0>(p);
+
+			addNN(p,xp,*this);
+			++it;
+		}
+	}
+
+	/*! \brief Add the neighborhood of a particle from the cell-list iterating the neighborhood
+	 *
+	 * \param vl Verlet-list (or thread buffer) where to add
+	 * \param cl Cell-list
+	 * \param p particle
+	 * \param xp position of the particle
+	 * \param pos2 vector of position for the neighborhood
+	 * \param r_cut cut-off radius
+	 *
+	 */
+	template<typename vl_type>
+	inline void addNNBox(vl_type & vl, CellListImpl & cl, size_t p, const Point<dim,T> & xp, const vPos_type & pos2, T r_cut)
+	{
+		auto NN = cl.getNNIteratorBox(cl.getCell(xp));
+		iteratePartNeighbor<opt&VL_NMAX_NEIGHBOR,opt&VL_SKIP_REF_PART>{}(vl, NN, pos2, p, xp, r_cut, neighborMaxNum);
+	}
+
 	/*! \brief Fill CRS Symmetric Verlet list from a given cell-list
+	 *
+	 * The particles of the domain cells are listed in domainParticlesCRS in the order of ParticleItCRS_Cells,
+	 * every particle remember its cell and the neighborhood of the particles are constructed with
+	 * fillParticles (in parallel if the Mem_type support it). Every neighborhood is written only in the row
+	 * of its particle, so the result is the same of the serial iteration with ParticleItCRS_Cells. The cells in
+	 * dom and anom must be different
 	 *
 	 * \param pos vector of positions
 	 * \param pos2 vector of position for the neighborhood
@@ -331,26 +486,68 @@ private:
 		size_t ghostMarker,
 		CellListImpl& cli)
 	{
+		typedef typename Mem_type::local_index_type id_type;
+
 		size_t end = pos.size();
+		size_t n_dom = dom.size();
+		size_t n_cells = dom.size() + anom.size();
 
-		Mem_type::init_to_zero(slot,end);
-		domainParticlesCRS.clear();
+		auto cellOf = [&](size_t i) {return (i < n_dom)?dom.get(i):anom.get(i - n_dom).subsub;};
 
-		// iterate the particles
-		auto it = ParticleItCRS_Cells<dim,CellListImpl,vPos_type>(cli,dom,anom,cli.getNNc_sym());
-		while (it.isNext())
-		{
-			typename Mem_type::local_index_type p = it.get();
-			Point<dim,T> xp = pos.template get<0>(p);
+		// particles of the domain cells in the order of ParticleItCRS_Cells
 
-			domainParticlesCRS.add(p);
+		crsCellStart.resize(n_cells+1);
 
-			// Get the neighborhood of the particle
-			auto NN = it.getNNIteratorCSR(pos2);
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < n_cells ; i++)
+		{crsCellStart.get(i) = cli.getNelements(cellOf(i));}
 
-			iteratePartNeighbor<opt&VL_NMAX_NEIGHBOR,opt&VL_SKIP_REF_PART>{}(*this, NN, pos2, p, xp, r_cut, neighborMaxNum);
-			++it;
+		size_t n_crs = (n_cells == 0)?0:openfpm::omp::exclusive_scan(&crsCellStart.get(0),&crsCellStart.get(0),n_cells);
+		crsCellStart.get(n_cells) = n_crs;
+
+		domainParticlesCRS.resize(n_crs);
+		crsCellOf.resize(end);
+
+		#pragma omp parallel for
+		for (size_t p = 0 ; p < end ; p++)
+		{crsCellOf.get(p) = -1;}
+
+		#pragma omp parallel for schedule(dynamic,64)
+		for (size_t i = 0 ; i < n_cells ; i++)
+		{
+			size_t c = cellOf(i);
+			size_t n = crsCellStart.get(i+1) - crsCellStart.get(i);
+			const id_type * ids = &cli.getStartId(c);
+
+			for (size_t k = 0 ; k < n ; k++)
+			{
+				domainParticlesCRS.get(crsCellStart.get(i) + k) = ids[k];
+				crsCellOf.get(ids[k]) = i;
+			}
 		}
+
+		// neighborhood of the particles
+
+		fillParticles(pos,end,[&](size_t p, const Point<dim,T> & xp, auto & vl)
+		{
+			long int i = crsCellOf.get(p);
+
+			if (i < 0)	{return;}
+
+			if ((size_t)i < n_dom)
+			{
+				typename CellListImpl::SymNNIterator NN(dom.get(i),p,cli.getNNc_sym().getPointer(),openfpm::math::pow(3,dim)/2+1,cli,pos2);
+				iteratePartNeighbor<opt&VL_NMAX_NEIGHBOR,opt&VL_SKIP_REF_PART>{}(vl, NN, pos2, p, xp, r_cut, neighborMaxNum);
+			}
+			else
+			{
+				const subsub_lin<dim> & sub = anom.get(i - n_dom);
+
+				typename CellListImpl::SymNNIterator NN(sub.subsub,p,&sub.NN_subsub.get(0),sub.NN_subsub.size(),cli,pos2);
+				iteratePartNeighbor<opt&VL_NMAX_NEIGHBOR,opt&VL_SKIP_REF_PART>{}(vl, NN, pos2, p, xp, r_cut, neighborMaxNum);
+			}
+		},
+		std::integral_constant<bool,has_fill_cells_with<Mem_type>::value>());
 	}
 
 	/*! \brief Fill Symmetric Verlet list from a given cell-list
@@ -371,24 +568,14 @@ private:
 		size_t ghostMarker,
 		CellListImpl & cli)
 	{
-		size_t end = ghostMarker;
-
-		Mem_type::init_to_zero(slot,end);
 		domainParticlesCRS.clear();
 
-		// iterate the particles
-		auto it = pos.getIteratorTo(end);
-		while (it.isNext())
+		fillParticles(pos,ghostMarker,[&](size_t p, const Point<dim,T> & xp, auto & vl)
 		{
-			typename Mem_type::local_index_type p = it.get();
-			Point<dim,T> xp = pos.template get<0>(p);
-
-			// Get the neighborhood of the particle
 			auto NN = cli.getNNIteratorBoxSym(cli.getCell(xp),p,pos);
-
-			iteratePartNeighbor<opt&VL_NMAX_NEIGHBOR,opt&VL_SKIP_REF_PART>{}(*this, NN, pos2, p, xp, r_cut, neighborMaxNum);
-			++it;
-		}
+			iteratePartNeighbor<opt&VL_NMAX_NEIGHBOR,opt&VL_SKIP_REF_PART>{}(vl, NN, pos2, p, xp, r_cut, neighborMaxNum);
+		},
+		std::integral_constant<bool,has_fill_cells_with<Mem_type>::value>());
 	}
 
 	/*! \brief Fill Non-symmetric Verlet list from a given cell-list
@@ -409,23 +596,9 @@ private:
 		size_t ghostMarker,
 		CellListImpl & cli)
 	{
-		size_t end = ghostMarker;
-
-		Mem_type::init_to_zero(slot,end);
-
-		// iterate the particles
-		auto it = pos.getIteratorTo(end);
-		while (it.isNext())
-		{
-			typename Mem_type::local_index_type p = it.get();
-			Point<dim,T> xp = pos.template get<0>(p);
-
-			// Get the neighborhood of the particle
-			auto NN = cli.getNNIteratorBox(cli.getCell(xp));
-
-			iteratePartNeighbor<opt&VL_NMAX_NEIGHBOR,opt&VL_SKIP_REF_PART>{}(*this, NN, pos2, p, xp, r_cut, neighborMaxNum);
-			++it;
-		}
+		fillParticles(pos,ghostMarker,[&](size_t p, const Point<dim,T> & xp, auto & vl)
+		{addNNBox(vl,cli,p,xp,pos2,r_cut);},
+		std::integral_constant<bool,has_fill_cells_with<Mem_type>::value>());
 	}
 
 	/*! \brief Fill non-symmetric adaptive r-cut Verlet list from a list of cut-off radii
@@ -510,6 +683,187 @@ private:
 		}
 	}
 
+	/*! \brief Store the reference positions of the particles for the skin check
+	 *
+	 * \param pos vector of particle positions
+	 * \param ghostMarker ghost marker
+	 *
+	 */
+	void setReference(const vPos_type & pos, size_t ghostMarker)
+	{
+		refPos.resize(pos.size());
+		movedMark.resize(pos.size());
+		rebuildMark.resize(ghostMarker);
+		refGhostMarker = ghostMarker;
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			refPos.get(i) = pos.template get<0>(i);
+			movedMark.get(i) = 0;
+		}
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < ghostMarker ; i++)
+		{rebuildMark.get(i) = 0;}
+
+		refPartialPos.clear();
+		partialDone = false;
+	}
+
+	/*! \brief Mark the particles that moved more than skin/2 from the reference position
+	 *
+	 * The marks are cumulative, a particle stay marked until the next complete construction.
+	 * After a partial construction it also count the particles that moved more than skin/2 from
+	 * the positions of the last partial construction
+	 *
+	 * \param pos vector of particle positions
+	 * \param nNew number of particles marked by this call
+	 * \param nMovedPartial number of particles that moved more than skin/2 after the last partial construction
+	 *
+	 * \return the number of marked particles
+	 *
+	 */
+	size_t markMoved(const vPos_type & pos, size_t & nNew, size_t & nMovedPartial)
+	{
+		T th2 = skin*skin / 4;
+		size_t nMoved = 0;
+		size_t nNew_ = 0;
+		size_t nMovedPartial_ = 0;
+
+		#pragma omp parallel for reduction(+:nMoved,nNew_,nMovedPartial_)
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			Point<dim,T> xp = pos.template get<0>(i);
+
+			if (movedMark.get(i) == 0 && xp.distance2(refPos.get(i)) > th2)
+			{
+				movedMark.get(i) = 1;
+				nNew_++;
+			}
+
+			if (partialDone == true && xp.distance2(refPartialPos.get(i)) > th2)
+			{nMovedPartial_++;}
+
+			nMoved += movedMark.get(i);
+		}
+
+		nNew = nNew_;
+		nMovedPartial = nMovedPartial_;
+
+		return nMoved;
+	}
+
+	//! Thread buffer of the partial construction, it store the neighborhoods of some particles
+	struct partialBuffer
+	{
+		//! neighborhood particles
+		openfpm::vector<size_t> ele;
+
+		//! reconstructed particles
+		openfpm::vector<size_t> part;
+
+		//! for each reconstructed particle the end of its neighborhood in ele
+		openfpm::vector<size_t> end;
+
+		/*! \brief Add a neighborhood particle to the last particle
+		 *
+		 * \param part_id particle
+		 * \param q neighborhood particle
+		 *
+		 */
+		inline void addPart(size_t part_id, size_t q)
+		{
+			ele.add(q);
+		}
+	};
+
+	/*! \brief Reconstruct the neighborhood of the particles near to the moved particles
+	 *
+	 * The neighborhoods reconstructed after the last complete construction are reconstructed again,
+	 * together with the neighborhoods of the particles near to a moved particle. In this way a
+	 * neighborhood is constructed either with the positions of the last complete construction or with
+	 * the current ones, and the next update check the displacements from both (see markMoved).
+	 * The neighborhoods not reconstructed remain correct: their particles moved less than skin/2,
+	 * and a moved particle that is now nearer than r_cut is in a cell of the neighborhood.
+	 * The neighborhoods are calculated in parallel and written in the Verlet-list serially
+	 *
+	 * \param pos vector of positions
+	 * \param r_cut cut-off radius (including the skin)
+	 * \param ghostMarker ghost marker
+	 *
+	 */
+	void fillNonSymmetricPartial(const vPos_type & pos, T r_cut, size_t ghostMarker)
+	{
+		unsigned char * rebuild = &rebuildMark.get(0);
+
+		#pragma omp parallel for schedule(dynamic,1024)
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			if (movedMark.get(i) == 0)	{continue;}
+
+			Point<dim,T> xp = pos.template get<0>(i);
+			auto NN = cli.getNNIteratorBox(cli.getCell(xp));
+
+			while (NN.isNext())
+			{
+				size_t q = NN.get();
+
+				if (q < ghostMarker)
+				{
+					#pragma omp atomic write
+					rebuild[q] = 1;
+				}
+
+				++NN;
+			}
+		}
+
+		int nth = openfpm::omp::get_max_threads();
+		std::vector<partialBuffer> buf(nth);
+
+		#pragma omp parallel num_threads(nth)
+		{
+			partialBuffer & b = buf[openfpm::omp::get_thread_num()];
+
+			#pragma omp for schedule(dynamic,256)
+			for (size_t p = 0 ; p < ghostMarker ; p++)
+			{
+				if (rebuild[p] == 0)	{continue;}
+
+				Point<dim,T> xp = pos.template get<0>(p);
+
+				addNNBox(b,cli,p,xp,pos,r_cut);
+
+				b.part.add(p);
+				b.end.add(b.ele.size());
+			}
+		}
+
+		for (size_t t = 0 ; t < buf.size() ; t++)
+		{
+			size_t k = 0;
+
+			for (size_t i = 0 ; i < buf[t].part.size() ; i++)
+			{
+				size_t p = buf[t].part.get(i);
+
+				Mem_type::clear(p);
+
+				for ( ; k < buf[t].end.get(i) ; k++)
+				{Mem_type::addCell(p,buf[t].ele.get(k));}
+			}
+		}
+
+		refPartialPos.resize(pos.size());
+
+		#pragma omp parallel for
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{refPartialPos.get(i) = pos.template get<0>(i);}
+
+		partialDone = true;
+	}
+
 public:
 
 	//! type for the local index
@@ -728,6 +1082,8 @@ public:
 	}
 
 	/*! \brief update the Verlet list
+	 *
+	 * \see setSkin to skip the reconstruction when the particles did not move enough
 	 *
 	 * \param r_cut cutoff radius
 	 * \param dom Processor domain
@@ -741,6 +1097,32 @@ public:
 		vPos_type & pos,
 		size_t & ghostMarker)
 	{
+		if (skin != 0)
+		{
+			bool sameParts = refPos.size() == pos.size() && refGhostMarker == ghostMarker;
+			size_t nNew = 0;
+			size_t nMovedPartial = 0;
+			size_t nMoved = (sameParts == true)?markMoved(pos,nNew,nMovedPartial):pos.size();
+
+			// Nothing moved more than skin/2 from the positions used to construct the neighborhoods,
+			// the Verlet-list is still valid
+			if (sameParts == true && nNew == 0 && nMovedPartial == 0)
+				return;
+
+			// Few particles moved, reconstruct only the neighborhood around them
+			if (nMoved <= partialRatio * pos.size() && (opt & (VL_SYMMETRIC | VL_NMAX_NEIGHBOR)) == 0)
+			{
+				initCl(cli,pos,ghostMarker);
+				fillNonSymmetricPartial(pos,r_cut,ghostMarker);
+
+				nPartialRebuild++;
+				return;
+			}
+
+			setReference(pos,ghostMarker);
+			nFullRebuild++;
+		}
+
 		initCl(cli,pos,ghostMarker);
 
 		if (opt & VL_SYMMETRIC)
@@ -749,6 +1131,57 @@ public:
 			fillNonSymmetric(pos,pos,r_cut,ghostMarker,cli);
 	}
 
+	/*! \brief Set the skin distance used by update
+	 *
+	 * With a skin the r_cut given to update must include the skin (r_cut = r_cut_interaction + skin).
+	 * update reconstructs the Verlet-list only if some particles moved more than skin/2 from the
+	 * positions of the last construction. If the moved particles are less than partialRatio*N only the
+	 * neighborhood of the particles near to them is reconstructed (non-symmetric Verlet-list only).
+	 * The first update after setting the skin does a complete construction.
+	 * skin = 0 (default) reconstruct the Verlet-list at every update
+	 *
+	 * \param skin skin distance
+	 * \param partialRatio fraction of moved particles above which the Verlet-list is completely reconstructed
+	 *
+	 */
+	void setSkin(T skin, T partialRatio = 0.1)
+	{
+		this->skin = skin;
+		this->partialRatio = partialRatio;
+
+		refPos.clear();
+	}
+
+	/*! \brief Get the skin distance
+	 *
+	 * \return the skin
+	 *
+	 */
+	T getSkin() const
+	{
+		return skin;
+	}
+
+	/*! \brief Return how many times update reconstructed completely the Verlet-list (only with skin)
+	 *
+	 * \return the number of complete constructions
+	 *
+	 */
+	size_t getNFullRebuild() const
+	{
+		return nFullRebuild;
+	}
+
+	/*! \brief Return how many times update reconstructed partially the Verlet-list (only with skin)
+	 *
+	 * \return the number of partial constructions
+	 *
+	 */
+	size_t getNPartialRebuild() const
+	{
+		return nPartialRebuild;
+	}
+
 	/*! \brief update the Verlet list
 	 *
 	 * \param r_cut cutoff radius
@@ -871,6 +1304,17 @@ public:
 
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		partialRatio = vl.partialRatio;
+		refPos.swap(vl.refPos);
+		refGhostMarker = vl.refGhostMarker;
+		movedMark.swap(vl.movedMark);
+		rebuildMark.swap(vl.rebuildMark);
+		refPartialPos.swap(vl.refPartialPos);
+		partialDone = vl.partialDone;
+		nFullRebuild = vl.nFullRebuild;
+		nPartialRebuild = vl.nPartialRebuild;
+
 		return *this;
 	}
 
@@ -893,6 +1337,17 @@ public:
 		domainParticlesCRS = vl.domainParticlesCRS;
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		partialRatio = vl.partialRatio;
+		refPos = vl.refPos;
+		refGhostMarker = vl.refGhostMarker;
+		movedMark = vl.movedMark;
+		rebuildMark = vl.rebuildMark;
+		refPartialPos = vl.refPartialPos;
+		partialDone = vl.partialDone;
+		nFullRebuild = vl.nFullRebuild;
+		nPartialRebuild = vl.nPartialRebuild;
+
 		return *this;
 	}
 
@@ -940,6 +1395,17 @@ public:
 		size_t n_dec_tmp = vl.n_dec;
 		vl.n_dec = n_dec;
 		n_dec = n_dec_tmp;
+
+		std::swap(skin,vl.skin);
+		std::swap(partialRatio,vl.partialRatio);
+		refPos.swap(vl.refPos);
+		std::swap(refGhostMarker,vl.refGhostMarker);
+		movedMark.swap(vl.movedMark);
+		rebuildMark.swap(vl.rebuildMark);
+		refPartialPos.swap(vl.refPartialPos);
+		std::swap(partialDone,vl.partialDone);
+		std::swap(nFullRebuild,vl.nFullRebuild);
+		std::swap(nPartialRebuild,vl.nPartialRebuild);
 	}
 
 	/*! \brief Get the Neighborhood iterator
@@ -1085,10 +1551,12 @@ public:
 template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMFAST = VerletList<dim,St,opt,Mem_fast<>,shift<dim,St>>;
 template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMBAL = VerletList<dim,St,opt,Mem_bal<>,shift<dim,St>>;
 template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMMW = VerletList<dim,St,opt,Mem_mw<>,shift<dim,St>>;
+template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMCSR = VerletList<dim,St,opt,Mem_csr<>,shift<dim,St>>;
 
 template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMFAST_INT = VerletList<dim,St,opt,Mem_fast<HeapMemory,unsigned int>,shift<dim,St>>;
 template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMBAL_INT = VerletList<dim,St,opt,Mem_bal<unsigned int>,shift<dim,St>>;
 template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMMW_INT = VerletList<dim,St,opt,Mem_mw<unsigned int>,shift<dim,St>>;
+template<unsigned int dim, typename St, unsigned int opt> using VERLET_MEMCSR_INT = VerletList<dim,St,opt,Mem_csr<HeapMemory,unsigned int>,shift<dim,St>>;
 
 
 #endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLIST_HPP_ */
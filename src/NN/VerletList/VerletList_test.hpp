@@ -473,6 +473,535 @@ template<unsigned int dim, typename T, typename VerS> void Verlet_list_sM(Box<di
 }
 
 
+/*! \brief Check that the neighborhood of vl_skin contain all the neighborhood of vl
+ *
+ * \param vl_skin Verlet-list with skin
+ * \param vl Verlet-list constructed from scratch
+ * \param n number of particles
+ *
+ * \return true if the neighborhoods are contained
+ *
+ */
+template<typename VerS> bool Verlet_list_contained(VerS & vl_skin, VerS & vl, size_t n)
+{
+	bool ret = true;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		openfpm::vector<size_t> v1;
+
+		auto NN = vl_skin.getNNIterator(i);
+		while (NN.isNext())
+		{
+			v1.add(NN.get());
+			++NN;
+		}
+
+		v1.sort();
+
+		auto NN2 = vl.getNNIterator(i);
+		while (NN2.isNext())
+		{
+			size_t q = NN2.get();
+
+			ret &= std::binary_search(&v1.get(0),&v1.get(0) + v1.size(),q);
+			++NN2;
+		}
+	}
+
+	return ret;
+}
+
+/*! \brief Check that a Verlet-list with Mem_csr is equal to the one with Mem_fast
+ *
+ * \tparam opt Verlet-list options
+ *
+ */
+template<unsigned int opt> void Verlet_list_csr_s()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	double r_cut = 0.1;
+
+	// particles with a non uniform density
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 8000 ; i++)
+	{
+		double s = (i % 4 == 0)?1.0:0.3;
+		pos.add(Point<3,double>({s*rand()/RAND_MAX,s*rand()/RAND_MAX,s*rand()/RAND_MAX}));
+	}
+
+	size_t ghostMarker = pos.size();
+
+	VerletList<3,double,opt> vl;
+	VerletList<3,double,opt,Mem_csr<HeapMemory,unsigned int>> vl_csr;
+
+	vl.setNeighborMaxNum(10);
+	vl_csr.setNeighborMaxNum(10);
+
+	vl.Initialize(box,r_cut,pos,ghostMarker);
+	vl_csr.Initialize(box,r_cut,pos,ghostMarker);
+
+	BOOST_REQUIRE_EQUAL(vl.size(),vl_csr.size());
+
+	bool ret = true;
+	size_t tot = 0;
+
+	for (size_t i = 0 ; i < ghostMarker ; i++)
+	{
+		ret &= vl.getNNPart(i) == vl_csr.getNNPart(i);
+
+		auto NN = vl.getNNIterator(i);
+		auto NN2 = vl_csr.getNNIterator(i);
+
+		while (NN.isNext() && NN2.isNext())
+		{
+			ret &= NN.get() == NN2.get();
+
+			++NN;
+			++NN2;
+		}
+
+		ret &= NN.isNext() == NN2.isNext();
+		tot += vl_csr.getNNPart(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+
+	// the storage is compact
+
+	BOOST_REQUIRE_EQUAL(vl_csr.private_get_cl_base().size(),tot + 1);
+}
+
+/*! \brief Check the update of a Verlet-list with skin
+ *
+ * \tparam VerS Verlet-list
+ *
+ */
+template<typename VerS> void Verlet_list_skin_s()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	double r_cut = 0.08;
+	double skin = 0.02;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 8000 ; i++)
+	{pos.add(Point<3,double>({0.1 + 0.8*rand()/RAND_MAX,0.1 + 0.8*rand()/RAND_MAX,0.1 + 0.8*rand()/RAND_MAX}));}
+
+	size_t ghostMarker = pos.size();
+
+	VerS vl_skin;
+	vl_skin.Initialize(box,r_cut + skin,pos,ghostMarker);
+	vl_skin.setSkin(skin);
+
+	// the first update construct the Verlet-list
+
+	vl_skin.update(box,r_cut + skin,pos,ghostMarker);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNFullRebuild(),1ul);
+
+	// small displacements, nothing to do
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{pos.template get<0>(i)[0] += 0.4*skin;}
+
+	vl_skin.update(box,r_cut + skin,pos,ghostMarker);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNFullRebuild(),1ul);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNPartialRebuild(),0ul);
+
+	VerS vl;
+	vl.Initialize(box,r_cut,pos,ghostMarker);
+	BOOST_REQUIRE_EQUAL(Verlet_list_contained(vl_skin,vl,ghostMarker),true);
+
+	// few particles move a lot, partial construction
+
+	for (size_t i = 0 ; i < pos.size() ; i += 100)
+	{pos.template get<0>(i)[1] += 3.0*skin;}
+
+	vl_skin.update(box,r_cut + skin,pos,ghostMarker);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNFullRebuild(),1ul);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNPartialRebuild(),1ul);
+
+	vl.Initialize(box,r_cut,pos,ghostMarker);
+	BOOST_REQUIRE_EQUAL(Verlet_list_contained(vl_skin,vl,ghostMarker),true);
+
+	// all the particles move, complete construction
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{pos.template get<0>(i)[2] += 0.6*skin;}
+
+	vl_skin.update(box,r_cut + skin,pos,ghostMarker);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNFullRebuild(),2ul);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNPartialRebuild(),1ul);
+
+	vl.Initialize(box,r_cut,pos,ghostMarker);
+	BOOST_REQUIRE_EQUAL(Verlet_list_contained(vl_skin,vl,ghostMarker),true);
+}
+
+/*! \brief Check the update of a Verlet-list with skin over many steps
+ *
+ * Most of the particles oscillate within skin/2 from their initial position (so they are never marked),
+ * few particles move a lot and cause partial constructions. Between two partial constructions two
+ * oscillating particles can approach each other by almost two skins
+ *
+ * \tparam VerS Verlet-list
+ *
+ */
+template<typename VerS> void Verlet_list_skin_drift_s()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	double r_cut = 0.08;
+	double skin = 0.02;
+
+	openfpm::vector<Point<3,double>> pos;
+	openfpm::vector<Point<3,double>> pos0;
+	openfpm::vector<Point<3,double>> dir;
+
+	for (size_t i = 0 ; i < 8000 ; i++)
+	{
+		pos0.add(Point<3,double>({0.15 + 0.7*rand()/RAND_MAX,0.15 + 0.7*rand()/RAND_MAX,0.15 + 0.7*rand()/RAND_MAX}));
+
+		Point<3,double> d({(double)rand()/RAND_MAX - 0.5,(double)rand()/RAND_MAX - 0.5,(double)rand()/RAND_MAX - 0.5});
+		d /= d.norm();
+		dir.add(d);
+	}
+
+	pos = pos0;
+
+	size_t ghostMarker = pos.size();
+
+	VerS vl_skin;
+	vl_skin.Initialize(box,r_cut + skin,pos,ghostMarker);
+	vl_skin.setSkin(skin,0.2);
+	vl_skin.update(box,r_cut + skin,pos,ghostMarker);
+
+	VerS vl;
+
+	bool ret = true;
+
+	for (size_t step = 1 ; step <= 30 ; step++)
+	{
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			// one particle every 100 move a lot, the others oscillate in opposite phase
+			double amp = (i % 100 == 0)?3.0*skin:0.45*skin;
+			double phase = (i % 2 == 0)?0.0:M_PI;
+
+			for (size_t d = 0 ; d < 3 ; d++)
+			{pos.template get<0>(i)[d] = pos0.template get<0>(i)[d] + amp * sin(1.3*step + phase) * dir.template get<0>(i)[d];}
+		}
+
+		vl_skin.update(box,r_cut + skin,pos,ghostMarker);
+
+		vl.Initialize(box,r_cut,pos,ghostMarker);
+		ret &= Verlet_list_contained(vl_skin,vl,ghostMarker);
+	}
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE_EQUAL(vl_skin.getNFullRebuild(),1ul);
+	BOOST_REQUIRE(vl_skin.getNPartialRebuild() > 1);
+
+	// copy and swap keep the state of the update
+
+	VerS vl_copy;
+	vl_copy = vl_skin;
+
+	BOOST_REQUIRE_EQUAL(vl_copy.getNFullRebuild(),vl_skin.getNFullRebuild());
+	BOOST_REQUIRE_EQUAL(vl_copy.getNPartialRebuild(),vl_skin.getNPartialRebuild());
+
+	vl_copy.update(box,r_cut + skin,pos,ghostMarker);
+
+	BOOST_REQUIRE_EQUAL(vl_copy.getNFullRebuild(),1ul);
+
+	VerS vl_swap;
+	vl_swap.swap(vl_copy);
+
+	BOOST_REQUIRE_EQUAL(vl_swap.getNFullRebuild(),1ul);
+	BOOST_REQUIRE_EQUAL(vl_copy.getNFullRebuild(),0ul);
+}
+
+/*! \brief Check that a neighborhood of a Verlet-list is equal to the neighborhood iterator of the
+ *         cell-list filtered with the cut-off radius (same particles in the same order)
+ *
+ * \param vl Verlet-list
+ * \param p particle
+ * \param NN cell-list neighborhood iterator
+ * \param pos particle positions
+ * \param r_cut cut-off radius
+ *
+ * \return true if they are equal
+ *
+ */
+template<typename VerS, typename NN_type> bool Verlet_list_equal_NN(VerS & vl, size_t p, NN_type & NN, openfpm::vector<Point<3,double>> & pos, double r_cut)
+{
+	bool ret = true;
+	size_t n = 0;
+
+	Point<3,double> xp = pos.get(p);
+
+	while (NN.isNext())
+	{
+		size_t q = NN.get();
+
+		if (xp.distance2(pos.get(q)) < r_cut*r_cut)
+		{
+			ret &= n < vl.getNNPart(p) && vl.get(p,n) == q;
+			n++;
+		}
+
+		++NN;
+	}
+
+	return ret && n == vl.getNNPart(p);
+}
+
+/*! \brief Split the domain cells of a cell-list in normal and anomalous cells for the CRS
+ *         construction, the cells with odd x are anomalous
+ *
+ * \param cl cell-list
+ * \param dom_c normal cells
+ * \param anom_c anomalous cells with their neighborhood
+ *
+ */
+template<typename cl_type> void Verlet_list_crs_cells(cl_type & cl, openfpm::vector<size_t> & dom_c, openfpm::vector<subsub_lin<3>> & anom_c)
+{
+	const grid_sm<3,void> & gs = cl.getGrid();
+
+	grid_key_dx<3> start(0,0,0);
+	grid_key_dx<3> stop(gs.size(0)-2,gs.size(1)-2,gs.size(2)-2);
+	grid_key_dx_iterator_sub<3> it(gs,start,stop);
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		if (key.get(0) % 2 == 0)
+		{dom_c.add(gs.LinId(key));}
+		else
+		{
+			anom_c.add();
+			anom_c.last().subsub = gs.LinId(key);
+
+			for (size_t j = 0 ; j < openfpm::math::pow(3,3)/2+1 ; j++)
+			{anom_c.last().NN_subsub.add(cl.getNNc_sym()[j]);}
+		}
+
+		++it;
+	}
+}
+
+/*! \brief Check that the particle p has the same set of neighbors in two Verlet-lists
+ *
+ * \param vl first Verlet-list
+ * \param vl2 second Verlet-list
+ * \param p particle
+ *
+ * \return true if the neighborhoods are equal
+ *
+ */
+template<typename VerS, typename VerS2> bool Verlet_list_same_NN(VerS & vl, VerS2 & vl2, size_t p)
+{
+	openfpm::vector<size_t> v1;
+	openfpm::vector<size_t> v2;
+
+	auto NN = vl.getNNIterator(p);
+	while (NN.isNext())
+	{
+		v1.add(NN.get());
+		++NN;
+	}
+
+	auto NN2 = vl2.getNNIterator(p);
+	while (NN2.isNext())
+	{
+		v2.add(NN2.get());
+		++NN2;
+	}
+
+	v1.sort();
+	v2.sort();
+
+	if (v1.size() != v2.size())
+	{return false;}
+
+	bool ret = true;
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{ret &= v1.get(i) == v2.get(i);}
+
+	return ret;
+}
+
+/*! \brief Check that the parallel symmetric and CRS constructions give the same Verlet-list of
+ *         the serial iteration of the cell-list
+ *
+ */
+inline void Verlet_list_sym_parallel_s()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	Ghost<3,double> ghost(0.1);
+
+	double r_cut = 0.1;
+
+	// domain particles and ghost particles on the upper faces
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 8000 ; i++)
+	{pos.add(Point<3,double>({(double)rand()/RAND_MAX,(double)rand()/RAND_MAX,(double)rand()/RAND_MAX}));}
+
+	size_t ghostMarker = pos.size();
+
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{
+		Point<3,double> p({(double)rand()/RAND_MAX,(double)rand()/RAND_MAX,(double)rand()/RAND_MAX});
+		p.get(i%3) = 1.0 + 0.09*rand()/RAND_MAX;
+		pos.add(p);
+	}
+
+	VerletList<3,double,VL_SYMMETRIC,Mem_fast<HeapMemory,unsigned int>,shift<3,double>> vl;
+	vl.InitializeSym(box,box,ghost,r_cut,pos,ghostMarker);
+
+	BOOST_REQUIRE_EQUAL(vl.size(),ghostMarker);
+
+	auto & cl_sym = vl.getInternalCellList();
+
+	bool match = true;
+	size_t tot = 0;
+
+	for (size_t p = 0 ; p < ghostMarker ; p++)
+	{
+		auto NN = cl_sym.getNNIteratorBoxSym(cl_sym.getCell(pos.get(p)),p,pos);
+		match &= Verlet_list_equal_NN(vl,p,NN,pos,r_cut);
+		tot += vl.getNNPart(p);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(tot != 0);
+
+	// CRS, the domain cells are split in normal and anomalous cells
+
+	VerletList<3,double,VL_CRS_SYMMETRIC,Mem_fast<HeapMemory,unsigned int>,shift<3,double>> vl_crs;
+	vl_crs.initializeCrs(box,box,ghost,r_cut,pos,ghostMarker);
+
+	auto & cl = vl_crs.getInternalCellList();
+
+	openfpm::vector<size_t> dom_c;
+	openfpm::vector<subsub_lin<3>> anom_c;
+
+	Verlet_list_crs_cells(cl,dom_c,anom_c);
+
+	vl_crs.fillCRSSymmetric(r_cut,ghostMarker,pos,dom_c,anom_c);
+
+	BOOST_REQUIRE_EQUAL(vl_crs.size(),pos.size());
+
+	// the particle sequence and the neighborhoods are the ones of ParticleItCRS_Cells
+
+	typedef typename std::remove_reference<decltype(cl)>::type cl_type;
+
+	auto & seq = vl_crs.getParticleSeq();
+	ParticleItCRS_Cells<3,cl_type,openfpm::vector<Point<3,double>>> it_cl(cl,dom_c,anom_c,cl.getNNc_sym());
+
+	size_t cnt = 0;
+
+	while (it_cl.isNext())
+	{
+		size_t p = it_cl.get();
+		auto NN = it_cl.getNNIteratorCSR(pos);
+
+		match &= cnt < seq.size() && seq.get(cnt) == p;
+		match &= Verlet_list_equal_NN(vl_crs,p,NN,pos,r_cut);
+
+		cnt++;
+		++it_cl;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(cnt,seq.size());
+	BOOST_REQUIRE(seq.size() != 0);
+}
+
+/*! \brief Check that the symmetric and CRS Verlet-lists with Mem_csr have the same neighborhoods
+ *         of the ones with Mem_fast
+ *
+ */
+inline void Verlet_list_csr_sym_s()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	Ghost<3,double> ghost(0.1);
+
+	double r_cut = 0.1;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 8000 ; i++)
+	{pos.add(Point<3,double>({(double)rand()/RAND_MAX,(double)rand()/RAND_MAX,(double)rand()/RAND_MAX}));}
+
+	size_t ghostMarker = pos.size();
+
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{
+		Point<3,double> p({(double)rand()/RAND_MAX,(double)rand()/RAND_MAX,(double)rand()/RAND_MAX});
+		p.get(i%3) = 1.0 + 0.09*rand()/RAND_MAX;
+		pos.add(p);
+	}
+
+	VerletList<3,double,VL_SYMMETRIC,Mem_fast<HeapMemory,unsigned int>,shift<3,double>> vl;
+	VerletList<3,double,VL_SYMMETRIC,Mem_csr<HeapMemory,unsigned int>,shift<3,double>> vl_csr;
+
+	vl.InitializeSym(box,box,ghost,r_cut,pos,ghostMarker);
+	vl_csr.InitializeSym(box,box,ghost,r_cut,pos,ghostMarker);
+
+	BOOST_REQUIRE_EQUAL(vl.size(),vl_csr.size());
+
+	bool match = true;
+	size_t tot = 0;
+
+	for (size_t p = 0 ; p < vl.size() ; p++)
+	{
+		match &= vl.getNNPart(p) == vl_csr.getNNPart(p);
+		match &= Verlet_list_same_NN(vl,vl_csr,p);
+		tot += vl_csr.getNNPart(p);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(tot != 0);
+
+	// CRS
+
+	VerletList<3,double,VL_CRS_SYMMETRIC,Mem_fast<HeapMemory,unsigned int>,shift<3,double>> vl_crs;
+	VerletList<3,double,VL_CRS_SYMMETRIC,Mem_csr<HeapMemory,unsigned int>,shift<3,double>> vl_crs_csr;
+
+	vl_crs.initializeCrs(box,box,ghost,r_cut,pos,ghostMarker);
+	vl_crs_csr.initializeCrs(box,box,ghost,r_cut,pos,ghostMarker);
+
+	openfpm::vector<size_t> dom_c;
+	openfpm::vector<subsub_lin<3>> anom_c;
+
+	Verlet_list_crs_cells(vl_crs.getInternalCellList(),dom_c,anom_c);
+
+	vl_crs.fillCRSSymmetric(r_cut,ghostMarker,pos,dom_c,anom_c);
+	vl_crs_csr.fillCRSSymmetric(r_cut,ghostMarker,pos,dom_c,anom_c);
+
+	BOOST_REQUIRE_EQUAL(vl_crs.size(),vl_crs_csr.size());
+
+	tot = 0;
+
+	for (size_t p = 0 ; p < vl_crs.size() ; p++)
+	{
+		match &= vl_crs.getNNPart(p) == vl_crs_csr.getNNPart(p);
+		match &= Verlet_list_same_NN(vl_crs,vl_crs_csr,p);
+		tot += vl_crs_csr.getNNPart(p);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE(tot != 0);
+}
+
 BOOST_AUTO_TEST_SUITE( VerletList_test )
 
 BOOST_AUTO_TEST_CASE( VerletList_use)
@@ -491,6 +1020,29 @@ BOOST_AUTO_TEST_CASE( VerletList_use)
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( VerletList_skin_update )
+{
+	Verlet_list_skin_s<VerletList<3,double,VL_NON_SYMMETRIC>>();
+	Verlet_list_skin_s<VerletList<3,double,VL_NON_SYMMETRIC,Mem_csr<HeapMemory,unsigned int>>>();
+
+	Verlet_list_skin_drift_s<VerletList<3,double,VL_NON_SYMMETRIC>>();
+	Verlet_list_skin_drift_s<VerletList<3,double,VL_NON_SYMMETRIC,Mem_csr<HeapMemory,unsigned int>>>();
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_csr )
+{
+	Verlet_list_csr_s<VL_NON_SYMMETRIC>();
+	Verlet_list_csr_s<VL_NON_SYMMETRIC | VL_SKIP_REF_PART>();
+	Verlet_list_csr_s<VL_NON_SYMMETRIC | VL_NMAX_NEIGHBOR>();
+
+	Verlet_list_csr_sym_s();
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_sym_parallel )
+{
+	Verlet_list_sym_parallel_s();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -0,0 +1,701 @@
+/*
+ * Checkpoint.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_CHECKPOINT_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_CHECKPOINT_HPP_
+
+#include <string>
+#include <cstring>
+#include <iostream>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <typeinfo>
+#include <boost/mpl/range_c.hpp>
+#include "util/for_each_ref.hpp"
+#include "Packer_Unpacker/Pack_segments.hpp"
+
+//! version of the checkpoint format
+#define CHECKPOINT_VERSION 2
+
+//! the data of the object start at this offset of the file (memory mapping require page alignment)
+#define CHECKPOINT_DATA_OFFSET 4096
+
+//! maximum dimensionality of a checkpointed grid
+#define CHECKPOINT_MAX_DIM 8
+
+//! maximum size of a single read/write on the file descriptor
+#define CHECKPOINT_CHUNK 67108864
+
+//! type of object in a checkpoint
+enum checkpoint_kind
+{
+	CHECKPOINT_VECTOR = 1,
+	CHECKPOINT_GRID = 2,
+	CHECKPOINT_SPARSE_GRID = 3
+};
+
+//! initial value of the FNV-1a hash of the checkpoint descriptors
+#define CHECKPOINT_HASH_INIT 14695981039346656037ul
+
+/*! \brief Add the bytes of a value to a FNV-1a hash
+ *
+ * \param h hash
+ * \param v value
+ *
+ * \return the new hash
+ *
+ */
+inline size_t checkpoint_hash(size_t h, size_t v)
+{
+	for (size_t i = 0 ; i < sizeof(size_t) ; i++)
+	{
+		h ^= (v >> (8*i)) & 0xff;
+		h *= 1099511628211ul;
+	}
+
+	return h;
+}
+
+/*! \brief Add a string to a FNV-1a hash
+ *
+ * \param h hash
+ * \param str null terminated string
+ *
+ * \return the new hash
+ *
+ */
+inline size_t checkpoint_hash(size_t h, const char * str)
+{
+	for ( ; *str != 0 ; str++)
+	{
+		h ^= (unsigned char)*str;
+		h *= 1099511628211ul;
+	}
+
+	return h;
+}
+
+/*! \brief Add the description of each property of an aggregate to a hash
+ *
+ * For each property the size, the size of the scalar (array properties) and if the scalar
+ * is a floating point or a signed type are added
+ *
+ * \tparam T aggregate
+ *
+ */
+template<typename T>
+struct checkpoint_prp_descriptor
+{
+	//! hash
+	size_t & h;
+
+	//! sum of the size of the properties
+	size_t & size;
+
+	//! constructor
+	inline checkpoint_prp_descriptor(size_t & h, size_t & size)
+	:h(h),size(size)
+	{};
+
+	//! It add the description of the property
+	template<typename prp_type>
+	inline void operator()(prp_type & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,prp_type>::type ele_type;
+		typedef typename std::remove_all_extents<ele_type>::type scalar_type;
+
+		h = checkpoint_hash(h,sizeof(ele_type));
+		h = checkpoint_hash(h,sizeof(scalar_type));
+		h = checkpoint_hash(h,2*std::is_floating_point<scalar_type>::value + std::is_signed<scalar_type>::value);
+
+		size += sizeof(ele_type);
+	}
+};
+
+/*! \brief Get a descriptor of the layout of an aggregate for the header of a checkpoint
+ *
+ * Unlike typeid(T).hash_code() it depend only on the number and the sizes (and signed/floating point kind)
+ * of the properties, so it is the same for every compiler and every run
+ *
+ * \tparam T aggregate
+ *
+ * \return the descriptor
+ *
+ */
+template<typename T>
+size_t checkpoint_type_hash()
+{
+	size_t h = CHECKPOINT_HASH_INIT;
+	size_t size = 0;
+
+	h = checkpoint_hash(h,T::max_prop);
+	h = checkpoint_hash(h,sizeof(T));
+
+	checkpoint_prp_descriptor<T> cd(h,size);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(cd);
+
+	return h;
+}
+
+/*! \brief Get the sum of the size of the properties of an aggregate
+ *
+ * \tparam T aggregate
+ *
+ * \return the size in byte of one element with memory_traits_inte
+ *
+ */
+template<typename T>
+size_t checkpoint_prp_size()
+{
+	size_t h = CHECKPOINT_HASH_INIT;
+	size_t size = 0;
+
+	checkpoint_prp_descriptor<T> cd(h,size);
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(cd);
+
+	return size;
+}
+
+/*! \brief Get a descriptor of a linearizer (or of the chunking of a sparse grid) for the header of a checkpoint
+ *
+ * It is the hash of typeid(lin).name(), that is the same in every run of programs compiled with the same compiler
+ *
+ * \tparam lin linearizer
+ *
+ * \return the descriptor
+ *
+ */
+template<typename lin>
+size_t checkpoint_name_hash()
+{
+	return checkpoint_hash(CHECKPOINT_HASH_INIT,typeid(lin).name());
+}
+
+/*! \brief Header of a checkpoint file
+ *
+ * A checkpoint is a binary file composed by this header, padded to CHECKPOINT_DATA_OFFSET, followed by the
+ * segments of memory of the object (see checkpointSegments of openfpm::vector, grid_base_impl and sgrid_cpu).
+ * The segments are written and read directly from the memory of the object, the only memory used is the
+ * memory of the object itself. The format is the native binary representation of the data, a checkpoint can
+ * be reloaded only by a program compiled for the same architecture with the same data types
+ *
+ */
+struct checkpoint_header
+{
+	//! "OFPMCKP"
+	char magic[8];
+
+	//! version of the format
+	unsigned int version;
+
+	//! type of the object (checkpoint_kind)
+	unsigned int kind;
+
+	//! descriptor of the type of the elements of the object (checkpoint_type_hash)
+	size_t type_hash;
+
+	//! descriptor of the linearizer of a grid, or of the chunking of a sparse grid (checkpoint_name_hash)
+	size_t lin_hash;
+
+	//! 1 if the object use memory_traits_inte
+	unsigned int is_inte;
+
+	//! dimensionality
+	unsigned int dim;
+
+	//! size of the grid
+	size_t sz[CHECKPOINT_MAX_DIM];
+
+	//! number of elements of a vector, or number of chunks of a sparse grid
+	size_t n_ele;
+
+	//! sum of the size of the segments in byte
+	size_t data_size;
+
+	//! Initialize an empty header
+	void init()
+	{
+		memset(this,0,sizeof(checkpoint_header));
+		strncpy(magic,"OFPMCKP",sizeof(magic));
+		version = CHECKPOINT_VERSION;
+	}
+
+	/*! \brief Check that the header has been produced by a compatible checkpoint
+	 *
+	 * \return true if the magic number and the version match
+	 *
+	 */
+	bool isValid() const
+	{
+		return strncmp(magic,"OFPMCKP",sizeof(magic)) == 0 && version == CHECKPOINT_VERSION;
+	}
+
+	/*! \brief Check that the header describe an object of the given kind and type
+	 *
+	 * \param kind_ type of the object (checkpoint_kind)
+	 * \param type_hash_ descriptor of the type of the elements
+	 * \param lin_hash_ descriptor of the linearizer
+	 * \param is_inte_ memory layout
+	 * \param dim_ dimensionality
+	 *
+	 * \return true if match
+	 *
+	 */
+	bool match(unsigned int kind_, size_t type_hash_, size_t lin_hash_, unsigned int is_inte_, unsigned int dim_) const
+	{
+		if (kind != kind_ || type_hash != type_hash_ || lin_hash != lin_hash_ || is_inte != is_inte_ || dim != dim_)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error, the checkpoint does not match the type of the object" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+};
+
+/*! \brief Write a checkpoint on a file descriptor
+ *
+ * The data are written directly from the memory of the object in pieces of at most chunk bytes
+ *
+ */
+class checkpoint_writer
+{
+	//! file descriptor
+	int fd;
+
+	//! bytes written
+	size_t off;
+
+	//! maximum size of a single write
+	size_t chunk;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param fd file descriptor open for writing
+	 * \param chunk maximum size of a single write
+	 *
+	 */
+	checkpoint_writer(int fd, size_t chunk = CHECKPOINT_CHUNK)
+	:fd(fd),off(0),chunk(chunk)
+	{}
+
+	/*! \brief Write a buffer
+	 *
+	 * \param ptr buffer
+	 * \param sz size in byte
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool write(const void * ptr, size_t sz)
+	{
+		const char * p = (const char *)ptr;
+
+		while (sz != 0)
+		{
+			ssize_t ret = ::write(fd,p,std::min(sz,chunk));
+
+			if (ret < 0)
+			{
+				if (errno == EINTR)	{continue;}
+
+				std::cerr << __FILE__ << ":" << __LINE__ << " error writing the checkpoint: " << strerror(errno) << std::endl;
+				return false;
+			}
+
+			p += ret;
+			sz -= ret;
+			off += ret;
+		}
+
+		return true;
+	}
+
+	/*! \brief Write zeros up to the offset
+	 *
+	 * \param offset offset to reach
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool pad(size_t offset)
+	{
+		char zero[512] = {};
+
+		while (off < offset)
+		{
+			if (write(zero,std::min(offset - off,sizeof(zero))) == false)
+			{return false;}
+		}
+
+		return true;
+	}
+
+	/*! \brief Write the segments in order
+	 *
+	 * \param segs segments
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool write(const pack_segment_list & segs)
+	{
+		for (size_t i = 0 ; i < segs.size() ; i++)
+		{
+			if (write(segs.get(i).ptr,segs.get(i).size) == false)
+			{return false;}
+		}
+
+		return true;
+	}
+};
+
+/*! \brief Read a checkpoint from a file descriptor
+ *
+ * The data are read directly in the memory of the object in pieces of at most chunk bytes
+ *
+ */
+class checkpoint_reader
+{
+	//! file descriptor
+	int fd;
+
+	//! bytes read
+	size_t off;
+
+	//! maximum size of a single read
+	size_t chunk;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param fd file descriptor open for reading
+	 * \param chunk maximum size of a single read
+	 *
+	 */
+	checkpoint_reader(int fd, size_t chunk = CHECKPOINT_CHUNK)
+	:fd(fd),off(0),chunk(chunk)
+	{}
+
+	/*! \brief Read a buffer
+	 *
+	 * \param ptr buffer
+	 * \param sz size in byte
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool read(void * ptr, size_t sz)
+	{
+		char * p = (char *)ptr;
+
+		while (sz != 0)
+		{
+			ssize_t ret = ::read(fd,p,std::min(sz,chunk));
+
+			if (ret < 0 && errno == EINTR)	{continue;}
+
+			if (ret <= 0)
+			{
+				std::cerr << __FILE__ << ":" << __LINE__ << " error reading the checkpoint: " << ((ret == 0)?"unexpected end of file":strerror(errno)) << std::endl;
+				return false;
+			}
+
+			p += ret;
+			sz -= ret;
+			off += ret;
+		}
+
+		return true;
+	}
+
+	/*! \brief Skip the data up to the offset
+	 *
+	 * \param offset offset to reach
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool skip(size_t offset)
+	{
+		char tmp[512];
+
+		while (off < offset)
+		{
+			if (read(tmp,std::min(offset - off,sizeof(tmp))) == false)
+			{return false;}
+		}
+
+		return true;
+	}
+
+	/*! \brief Read the segments in order
+	 *
+	 * \param segs segments
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool read(const pack_segment_list & segs)
+	{
+		for (size_t i = 0 ; i < segs.size() ; i++)
+		{
+			if (read(segs.get(i).ptr,segs.get(i).size) == false)
+			{return false;}
+		}
+
+		return true;
+	}
+};
+
+/*! \brief A checkpoint file mapped in memory
+ *
+ * The file is mapped private (copy on write), the objects created over the mapping (see checkpointMap
+ * of openfpm::vector and grid_base_impl) can be modified without changing the file, the pages are loaded
+ * from the file when accessed. The mapping must live longer than the objects created over it
+ *
+ * \code
+ *
+ * checkpoint_mapping mp;
+ * mp.open("state.ckp");
+ *
+ * openfpm::vector<aggregate<float,float[3]>,PtrMemory,memory_traits_lin,openfpm::grow_policy_identity> v;
+ * v.checkpointMap(mp);
+ *
+ * \endcode
+ *
+ */
+class checkpoint_mapping
+{
+	//! pointer to the mapped file
+	void * base;
+
+	//! size of the mapping
+	size_t sz;
+
+	//! header
+	checkpoint_header h;
+
+public:
+
+	//! Constructor
+	checkpoint_mapping()
+	:base(NULL),sz(0)
+	{
+		h.init();
+	}
+
+	//! Destructor
+	~checkpoint_mapping()
+	{
+		close();
+	}
+
+	/*! \brief Map a checkpoint file
+	 *
+	 * \param file file name
+	 *
+	 * \return true if succeed
+	 *
+	 */
+	bool open(const std::string & file)
+	{
+		close();
+
+		int fd = ::open(file.c_str(),O_RDONLY);
+		if (fd < 0)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error, opening file: " << file << std::endl;
+			return false;
+		}
+
+		struct stat st;
+		if (fstat(fd,&st) != 0 || (size_t)st.st_size < CHECKPOINT_DATA_OFFSET)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error, " << file << " is not a checkpoint" << std::endl;
+			::close(fd);
+			return false;
+		}
+
+		sz = st.st_size;
+		base = mmap(NULL,sz,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0);
+		::close(fd);
+
+		if (base == MAP_FAILED)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error, mapping file: " << file << " " << strerror(errno) << std::endl;
+			base = NULL;
+			sz = 0;
+			return false;
+		}
+
+		memcpy(&h,base,sizeof(checkpoint_header));
+
+		if (h.isValid() == false || CHECKPOINT_DATA_OFFSET + h.data_size > sz)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error, " << file << " is not a valid checkpoint" << std::endl;
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	//! Unmap the file
+	void close()
+	{
+		if (base != NULL)
+		{munmap(base,sz);}
+
+		base = NULL;
+		sz = 0;
+	}
+
+	/*! \brief Get the header of the checkpoint
+	 *
+	 * \return the header
+	 *
+	 */
+	const checkpoint_header & getHeader() const
+	{
+		return h;
+	}
+
+	/*! \brief Get the pointer to the data of the object
+	 *
+	 * \return the pointer to the first segment (page aligned)
+	 *
+	 */
+	void * getData()
+	{
+		return (char *)base + CHECKPOINT_DATA_OFFSET;
+	}
+};
+
+/*! \brief Write a checkpoint of an object (openfpm::vector, grid_base_impl or sgrid_cpu) on a file descriptor
+ *
+ * \param fd file descriptor open for writing
+ * \param obj object to checkpoint
+ * \param chunk maximum size of a single write
+ *
+ * \return true if succeed
+ *
+ */
+template<typename object_type>
+bool checkpoint_save(int fd, const object_type & obj, size_t chunk = CHECKPOINT_CHUNK)
+{
+	checkpoint_header h;
+	h.init();
+	obj.checkpointHeader(h);
+
+	pack_segment_list segs;
+	obj.checkpointSegments(segs);
+	h.data_size = segs.getTotalSize();
+
+	checkpoint_writer wr(fd,chunk);
+
+	return wr.write(&h,sizeof(checkpoint_header)) &&
+		   wr.pad(CHECKPOINT_DATA_OFFSET) &&
+		   wr.write(segs);
+}
+
+/*! \brief Write a checkpoint of an object (openfpm::vector, grid_base_impl or sgrid_cpu) on a file
+ *
+ * \param file file name
+ * \param obj object to checkpoint
+ *
+ * \return true if succeed
+ *
+ */
+template<typename object_type>
+bool checkpoint_save(const std::string & file, const object_type & obj)
+{
+	int fd = ::open(file.c_str(),O_WRONLY | O_CREAT | O_TRUNC,0644);
+	if (fd < 0)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error, opening file: " << file << std::endl;
+		return false;
+	}
+
+	bool ret = checkpoint_save(fd,obj);
+
+	return (::close(fd) == 0) && ret;
+}
+
+/*! \brief Load a checkpoint of an object (openfpm::vector, grid_base_impl or sgrid_cpu) from a file descriptor
+ *
+ * The object is resized and the data are read directly in its memory
+ *
+ * \param fd file descriptor open for reading
+ * \param obj object to load
+ * \param chunk maximum size of a single read
+ *
+ * \return true if succeed
+ *
+ */
+template<typename object_type>
+bool checkpoint_load(int fd, object_type & obj, size_t chunk = CHECKPOINT_CHUNK)
+{
+	checkpoint_reader rd(fd,chunk);
+
+	checkpoint_header h;
+	if (rd.read(&h,sizeof(checkpoint_header)) == false)
+	{return false;}
+
+	if (h.isValid() == false)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error, the file is not a valid checkpoint" << std::endl;
+		return false;
+	}
+
+	if (obj.checkpointPrepare(h) == false)
+	{return false;}
+
+	pack_segment_list segs;
+	obj.checkpointSegments(segs);
+
+	if (segs.getTotalSize() != h.data_size)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error, the size of the checkpoint does not match the object" << std::endl;
+		return false;
+	}
+
+	return rd.skip(CHECKPOINT_DATA_OFFSET) && rd.read(segs) && obj.checkpointFinalize();
+}
+
+/*! \brief Load a checkpoint of an object (openfpm::vector, grid_base_impl or sgrid_cpu) from a file
+ *
+ * \param file file name
+ * \param obj object to load
+ *
+ * \return true if succeed
+ *
+ */
+template<typename object_type>
+bool checkpoint_load(const std::string & file, object_type & obj)
+{
+	int fd = ::open(file.c_str(),O_RDONLY);
+	if (fd < 0)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error, opening file: " << file << std::endl;
+		return false;
+	}
+
+	bool ret = checkpoint_load(fd,obj);
+
+	::close(fd);
+
+	return ret;
+}
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_CHECKPOINT_HPP_ */
@@ -0,0 +1,235 @@
+/*
+ * Pack_segments.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_SEGMENTS_HPP_
+#define OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_SEGMENTS_HPP_
+
+#include <vector>
+#include <cstring>
+#include <type_traits>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/int.hpp>
+
+/*! \brief Segment of a message (as an iovec)
+ *
+ */
+struct pack_segment
+{
+	//! pointer to the first byte of the segment
+	void * ptr;
+
+	//! size of the segment in byte
+	size_t size;
+};
+
+/*! \brief List of segments that compose a message
+ *
+ * packSegments produce a list of segments, concatenating the segments in order give exactly the bytes
+ * produced by pack. When the selected properties are stored contiguously the segments point
+ * directly to the memory of the data-structure (no copy), otherwise the data are packed in the
+ * preallocated buffer and the segment point to the buffer.
+ *
+ * unpackSegments produce the list of segments where the bytes of a message must be received (scatter),
+ * the segments point directly to the memory of the data-structure
+ *
+ * \code
+ *
+ * pack_segment_list segs;
+ * g.template packSegments<0>(mem,sub_it,segs,sts);
+ *
+ * for (size_t i = 0 ; i < segs.size() ; i++)
+ * {send(segs.get(i).ptr,segs.get(i).size);}
+ *
+ * \endcode
+ *
+ */
+class pack_segment_list
+{
+	//! list of segments
+	std::vector<pack_segment> segs;
+
+	//! total size of the message
+	size_t tot = 0;
+
+	//! bytes copied in a buffer
+	size_t copied = 0;
+
+public:
+
+	/*! \brief Add a segment, if it follow the last segment in memory the two segments are merged
+	 *
+	 * \param ptr pointer to the segment
+	 * \param sz size of the segment in byte
+	 *
+	 */
+	inline void add(void * ptr, size_t sz)
+	{
+		if (sz == 0)	{return;}
+
+		tot += sz;
+
+		if (segs.size() != 0 && (char *)segs.back().ptr + segs.back().size == (char *)ptr)
+		{
+			segs.back().size += sz;
+			return;
+		}
+
+		segs.push_back({ptr,sz});
+	}
+
+	/*! \brief Add a segment that has been copied in a buffer
+	 *
+	 * \param ptr pointer to the segment in the buffer
+	 * \param sz size of the segment in byte
+	 *
+	 */
+	inline void addCopy(void * ptr, size_t sz)
+	{
+		add(ptr,sz);
+		copied += sz;
+	}
+
+	/*! \brief Number of segments
+	 *
+	 * \return the number of segments
+	 *
+	 */
+	inline size_t size() const
+	{
+		return segs.size();
+	}
+
+	/*! \brief Get a segment
+	 *
+	 * \param i segment
+	 *
+	 * \return the segment i
+	 *
+	 */
+	inline const pack_segment & get(size_t i) const
+	{
+		return segs[i];
+	}
+
+	/*! \brief Total size of the message
+	 *
+	 * \return the sum of the size of the segments in byte
+	 *
+	 */
+	inline size_t getTotalSize() const
+	{
+		return tot;
+	}
+
+	/*! \brief Bytes of the message that has been copied in a buffer
+	 *
+	 * \return the bytes copied
+	 *
+	 */
+	inline size_t getCopiedSize() const
+	{
+		return copied;
+	}
+
+	/*! \brief Remove all the segments
+	 *
+	 */
+	inline void clear()
+	{
+		segs.clear();
+		tot = 0;
+		copied = 0;
+	}
+
+	/*! \brief Copy the segments in a contiguous buffer
+	 *
+	 * \param dst buffer of at least getTotalSize() bytes
+	 *
+	 */
+	void gather(void * dst) const
+	{
+		char * d = (char *)dst;
+
+		for (size_t i = 0 ; i < segs.size() ; i++)
+		{
+			memcpy(d,segs[i].ptr,segs[i].size);
+			d += segs[i].size;
+		}
+	}
+
+	/*! \brief Copy a contiguous buffer into the segments
+	 *
+	 * \param src buffer of at least getTotalSize() bytes
+	 *
+	 */
+	void scatter(const void * src) const
+	{
+		const char * s = (const char *)src;
+
+		for (size_t i = 0 ; i < segs.size() ; i++)
+		{
+			memcpy(segs[i].ptr,s,segs[i].size);
+			s += segs[i].size;
+		}
+	}
+};
+
+/*! \brief Check if the properties are 0,1,2 ... in order
+ *
+ * \tparam i expected first property
+ * \tparam prp properties
+ *
+ */
+template<int i, int ... prp>
+struct pack_prp_sequence
+{
+	static const bool value = true;
+};
+
+template<int i, int p, int ... prp>
+struct pack_prp_sequence<i,p,prp...>
+{
+	static const bool value = (i == p) && pack_prp_sequence<i+1,prp...>::value;
+};
+
+/*! \brief Check if the selected properties are all the properties of the object in order
+ *
+ * In this case the packed object has the same layout of the object
+ *
+ * \tparam max_prop number of properties of the object
+ * \tparam prp selected properties (no properties mean all)
+ *
+ */
+template<unsigned int max_prop, int ... prp>
+struct pack_prp_all
+{
+	static const bool value = sizeof...(prp) == 0 || (sizeof...(prp) == max_prop && pack_prp_sequence<0,prp...>::value);
+};
+
+/*! \brief Check if the selected properties are not arrays
+ *
+ * With memory_traits_inte the components of an array property are not stored contiguously
+ * for each element
+ *
+ * \tparam T_type boost::fusion::vector of the properties
+ * \tparam prp selected properties
+ *
+ */
+template<typename T_type, int ... prp>
+struct pack_prp_scalar
+{
+	static const bool value = true;
+};
+
+template<typename T_type, int p, int ... prp>
+struct pack_prp_scalar<T_type,p,prp...>
+{
+	static const bool value = std::rank<typename boost::mpl::at<T_type,boost::mpl::int_<p>>::type>::value == 0 &&
+							  pack_prp_scalar<T_type,prp...>::value;
+};
+
+#endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACK_SEGMENTS_HPP_ */
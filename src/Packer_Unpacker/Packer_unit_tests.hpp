@@ -17,6 +17,191 @@
 #include "Vector/vector_test_util.hpp"
 #include "data_type/aggregate.hpp"
 
+/*! \brief Pack a sub-grid with pack and packSegments and compare the messages
+ *
+ * The segments gathered must be the message of pack byte by byte, the sub-grid received with
+ * unpackSegments must be the sub-grid received with unpack
+ *
+ * \param g grid to pack
+ * \param g2 grid where to receive the sub-grid with unpackSegments
+ * \param start start of the sub-grid
+ * \param stop stop of the sub-grid
+ * \param zero_copy true if the sub-grid must not be copied
+ * \param n_seg expected number of segments (0 to skip the check)
+ * \param check check(gd,key) check a point of the grid gd after the sub-grid has been received
+ *
+ */
+template<typename grid_type, int ... prp, typename check_type>
+void test_pack_segments_grid(grid_type & g, grid_type & g2, const grid_key_dx<3> & start, const grid_key_dx<3> & stop, bool zero_copy, size_t n_seg, check_type check)
+{
+	size_t sz[3];
+	for (size_t i = 0 ; i < 3 ; i++)
+	{sz[i] = g.getGrid().size(i);}
+
+	grid_sm<3,void> ginfo(sz);
+	grid_key_dx_iterator_sub<3> sub(ginfo,start,stop);
+
+	size_t req = 0;
+	g.template packRequest<prp...>(sub,req);
+
+	// pack with a copy
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	g.template pack<prp...>(mem,sub,sts);
+	size_t sz_msg = mem.getOffsetEnd();
+
+	// pack with segments
+	HeapMemory pmem2;
+	ExtPreAlloc<HeapMemory> & mem2 = *(new ExtPreAlloc<HeapMemory>(req,pmem2));
+	mem2.incRef();
+
+	Pack_stat sts2;
+	pack_segment_list segs;
+	sub.reset();
+	g.template packSegments<prp...>(mem2,sub,segs,sts2);
+
+	BOOST_REQUIRE_EQUAL(segs.getTotalSize(),sz_msg);
+	BOOST_REQUIRE_EQUAL(segs.getCopiedSize(),(zero_copy == true)?0:sz_msg);
+	BOOST_REQUIRE_EQUAL(sts2.reqPack(),sts.reqPack());
+
+	if (n_seg != 0)
+	{BOOST_REQUIRE_EQUAL(segs.size(),n_seg);}
+
+	std::vector<char> msg(sz_msg);
+	segs.gather(msg.data());
+
+	BOOST_REQUIRE_EQUAL(memcmp(msg.data(),mem.getPointerBase(),sz_msg),0);
+
+	// receive the message of pack with unpack in the grid g3
+
+	grid_type g3(sz);
+	g3.setMemory();
+
+	Unpack_stat ps;
+	int gpuContext;
+	sub.reset();
+	g3.template unpack<prp...>(mem,sub,ps,gpuContext,rem_copy_opt::NONE_OPT);
+
+	BOOST_REQUIRE_EQUAL(ps.getOffset(),sz_msg);
+
+	bool match = true;
+	sub.reset();
+	while (sub.isNext())
+	{
+		match &= check(g3,sub.get());
+		++sub;
+	}
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// receive the gathered segments directly in the grid g2
+	pack_segment_list segs_r;
+	sub.reset();
+	if (g2.template unpackSegments<(unsigned int)prp...>(sub,segs_r) == true)
+	{
+		BOOST_REQUIRE_EQUAL(segs_r.getTotalSize(),sz_msg);
+		segs_r.scatter(msg.data());
+
+		sub.reset();
+		while (sub.isNext())
+		{
+			match &= check(g2,sub.get());
+			++sub;
+		}
+		BOOST_REQUIRE_EQUAL(match,true);
+	}
+
+	mem.decRef();
+	delete &mem;
+	mem2.decRef();
+	delete &mem2;
+}
+
+/*! \brief Pack a vector with pack and packSegments and compare the messages
+ *
+ * The segments gathered must be the message of pack byte by byte, the vector received with
+ * unpackSegments must be the vector received with unpack
+ *
+ * \param v vector to pack
+ * \param v2 vector where to receive the message with unpackSegments
+ * \param zero_copy true if the vector must not be copied (only the size is copied)
+ * \param n_seg expected number of segments (0 to skip the check)
+ * \param check check(vd,i) check an element of the vector vd after the vector has been received
+ *
+ */
+template<typename vector_type, int ... prp, typename check_type>
+void test_pack_segments_vector(vector_type & v, vector_type & v2, bool zero_copy, size_t n_seg, check_type check)
+{
+	size_t req = 0;
+	v.template packRequest<prp...>(req);
+
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	v.template pack<prp...>(mem,sts);
+	size_t sz_msg = mem.getOffsetEnd();
+
+	HeapMemory pmem2;
+	ExtPreAlloc<HeapMemory> & mem2 = *(new ExtPreAlloc<HeapMemory>(req,pmem2));
+	mem2.incRef();
+
+	Pack_stat sts2;
+	pack_segment_list segs;
+	v.template packSegments<prp...>(mem2,segs,sts2);
+
+	BOOST_REQUIRE_EQUAL(segs.getTotalSize(),sz_msg);
+	BOOST_REQUIRE_EQUAL(segs.getCopiedSize(),(zero_copy == true)?sizeof(size_t):sz_msg);
+
+	if (n_seg != 0)
+	{BOOST_REQUIRE_EQUAL(segs.size(),n_seg);}
+
+	std::vector<char> msg(sz_msg);
+	segs.gather(msg.data());
+
+	BOOST_REQUIRE_EQUAL(memcmp(msg.data(),mem.getPointerBase(),sz_msg),0);
+
+	// receive the message of pack with unpack in the vector v3
+
+	vector_type v3;
+	Unpack_stat ps;
+	v3.template unpack<prp...>(mem,ps);
+
+	BOOST_REQUIRE_EQUAL(ps.getOffset(),sz_msg);
+	BOOST_REQUIRE_EQUAL(v3.size(),v.size());
+
+	bool match = true;
+	for (size_t i = 0 ; i < v3.size() ; i++)
+	{match &= check(v3,i);}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// receive the gathered segments directly in the vector v2
+	size_t sz = v.size();
+	pack_segment_list segs_r;
+	if (v2.template unpackSegments<(unsigned int)prp...>(sz,segs_r) == true)
+	{
+		BOOST_REQUIRE_EQUAL(segs_r.getTotalSize(),sz_msg);
+		segs_r.scatter(msg.data());
+
+		BOOST_REQUIRE_EQUAL(sz,v.size());
+		BOOST_REQUIRE_EQUAL(v2.size(),v.size());
+
+		for (size_t i = 0 ; i < v2.size() ; i++)
+		{match &= check(v2,i);}
+
+		BOOST_REQUIRE_EQUAL(match,true);
+	}
+
+	mem.decRef();
+	delete &mem;
+	mem2.decRef();
+	delete &mem2;
+}
+
 BOOST_AUTO_TEST_SUITE( packer_unpacker )
 
 BOOST_AUTO_TEST_CASE ( packer_unpacker_test )
@@ -356,6 +541,283 @@ BOOST_AUTO_TEST_CASE ( packer_selector_test )
 	BOOST_REQUIRE_EQUAL(Pack_selector<b_test>::value,PACKER_OBJECTS_WITH_POINTER_CHECK);
 }
 
+BOOST_AUTO_TEST_CASE ( packer_unpacker_segments_test )
+{
+	// no padding in the struct, the packed messages can be compared byte by byte
+	typedef aggregate<float,int,double> agg;
+	typedef grid_base<3,agg,HeapMemory,typename memory_traits_inte<agg>::type> grid_soa;
+
+	size_t sz[3] = {16,16,16};
+
+	grid_cpu<3,agg> g(sz);
+	grid_cpu<3,agg> g2(sz);
+	grid_soa gs(sz);
+	grid_soa gs2(sz);
+	grid_cpu<3,agg,grid_smb<3,4>> gb(sz);
+	grid_cpu<3,agg,grid_smb<3,4>> gb2(sz);
+	g.setMemory();
+	g2.setMemory();
+	gs.setMemory();
+	gs2.setMemory();
+	gb.setMemory();
+	gb2.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 0.5f;
+		g.template get<1>(key) = key.get(1);
+		g.template get<2>(key) = key.get(2) + 0.25;
+
+		gs.template get<0>(key) = g.template get<0>(key);
+		gs.template get<1>(key) = g.template get<1>(key);
+		gs.template get<2>(key) = g.template get<2>(key);
+
+		gb.get_o(key) = g.get_o(key);
+
+		++it;
+	}
+
+	auto check_all = [&](auto & gd, const grid_key_dx<3> & key)
+	{
+		return gd.template get<0>(key) == g.template get<0>(key) &&
+			   gd.template get<1>(key) == g.template get<1>(key) &&
+			   gd.template get<2>(key) == g.template get<2>(key);
+	};
+
+	auto check_01 = [&](auto & gd, const grid_key_dx<3> & key)
+	{
+		return gd.template get<0>(key) == g.template get<0>(key) &&
+			   gd.template get<1>(key) == g.template get<1>(key);
+	};
+
+	auto check_1 = [&](auto & gd, const grid_key_dx<3> & key)
+	{
+		return gd.template get<1>(key) == g.template get<1>(key);
+	};
+
+	grid_key_dx<3> start({1,2,3});
+	grid_key_dx<3> stop({5,6,7});
+
+	// memory_traits_lin, all the properties: one segment for each row of the sub-grid
+	test_pack_segments_grid<grid_cpu<3,agg>,0,1,2>(g,g2,start,stop,true,25,check_all);
+
+	// the rows of a full slice are merged in one segment
+	test_pack_segments_grid<grid_cpu<3,agg>,0,1,2>(g,g2,{0,0,2},{15,15,5},true,1,check_all);
+
+	// memory_traits_lin, some properties: copy
+	test_pack_segments_grid<grid_cpu<3,agg>,0,1>(g,g2,start,stop,false,1,check_01);
+
+	// memory_traits_inte, one property: one segment for each row, it can be received directly
+	test_pack_segments_grid<grid_soa,1>(gs,gs2,start,stop,true,25,check_1);
+
+	// memory_traits_inte, more properties: the sub-grid is packed as an array of objects, copy
+	test_pack_segments_grid<grid_soa,0,1>(gs,gs2,start,stop,false,1,check_01);
+
+	// bricked grid, the rows are cut at the border of the bricks
+	test_pack_segments_grid<grid_cpu<3,agg,grid_smb<3,4>>,0,1,2>(gb,gb2,start,stop,true,50,check_all);
+
+	// vectors
+
+	openfpm::vector<agg> v;
+	openfpm::vector<agg> v2;
+	openfpm::vector_soa<agg> vs;
+	openfpm::vector_soa<agg> vs2;
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		v.add();
+		v.template get<0>(i) = i + 0.5f;
+		v.template get<1>(i) = i;
+		v.template get<2>(i) = i + 0.25;
+
+		vs.add();
+		vs.template get<0>(i) = v.template get<0>(i);
+		vs.template get<1>(i) = v.template get<1>(i);
+		vs.template get<2>(i) = v.template get<2>(i);
+	}
+
+	auto check_v = [&](auto & vd, size_t i)
+	{
+		return vd.template get<0>(i) == v.template get<0>(i) &&
+			   vd.template get<1>(i) == v.template get<1>(i) &&
+			   vd.template get<2>(i) == v.template get<2>(i);
+	};
+
+	auto check_v01 = [&](auto & vd, size_t i)
+	{
+		return vd.template get<0>(i) == v.template get<0>(i) &&
+			   vd.template get<1>(i) == v.template get<1>(i);
+	};
+
+	auto check_v2 = [&](auto & vd, size_t i)
+	{
+		return vd.template get<2>(i) == v.template get<2>(i);
+	};
+
+	test_pack_segments_vector<openfpm::vector<agg>>(v,v2,true,2,check_v);
+	test_pack_segments_vector<openfpm::vector<agg>,0,1,2>(v,v2,true,2,check_v);
+	test_pack_segments_vector<openfpm::vector<agg>,0,1>(v,v2,false,1,check_v01);
+
+	// memory_traits_inte, one property: one segment after the size, it can be received directly
+	test_pack_segments_vector<openfpm::vector_soa<agg>,2>(vs,vs2,true,2,check_v2);
+
+	// memory_traits_inte, more properties: the vector is packed as an array of objects, copy
+	test_pack_segments_vector<openfpm::vector_soa<agg>,0,1>(vs,vs2,false,1,check_v01);
+}
+
+/*! \brief Pack several sub-grids with pack and packMulti, compare the messages and unpack them with unpackMulti
+ *
+ * \param g grid to pack
+ * \param g2 grid where to unpack
+ * \param boxes sub-grids (start,stop)
+ * \param check check a point of g2 after the sub-grids has been unpacked
+ *
+ */
+template<int ... prp, typename grid_type, typename grid_type2, typename check_type>
+void test_pack_multi_grid(grid_type & g, grid_type2 & g2, const std::vector<std::pair<grid_key_dx<3>,grid_key_dx<3>>> & boxes, check_type check)
+{
+	size_t sz[3];
+	for (size_t i = 0 ; i < 3 ; i++)
+	{sz[i] = g.getGrid().size(i);}
+
+	grid_sm<3,void> ginfo(sz);
+	openfpm::vector<grid_key_dx_iterator_sub<3>> subs;
+
+	size_t req = 0;
+	for (size_t i = 0 ; i < boxes.size() ; i++)
+	{
+		subs.add(grid_key_dx_iterator_sub<3>(ginfo,boxes[i].first,boxes[i].second));
+		g.template packRequest<prp...>(subs.last(),req);
+	}
+
+	// pack one sub-grid after the other
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	for (size_t i = 0 ; i < subs.size() ; i++)
+	{g.template pack<prp...>(mem,subs.get(i),sts);}
+
+	// pack concurrently
+	HeapMemory pmem2;
+	ExtPreAlloc<HeapMemory> & mem2 = *(new ExtPreAlloc<HeapMemory>(req,pmem2));
+	mem2.incRef();
+
+	Pack_stat sts2;
+	g.template packMulti<prp...>(mem2,subs,sts2);
+
+	BOOST_REQUIRE_EQUAL(mem2.getOffsetEnd(),mem.getOffsetEnd());
+	BOOST_REQUIRE_EQUAL(sts2.reqPack(),sts.reqPack());
+	BOOST_REQUIRE_EQUAL(memcmp(mem2.getPointerBase(),mem.getPointerBase(),mem.getOffsetEnd()),0);
+
+	// unpack concurrently
+	Unpack_stat ps;
+	g2.template unpackMulti<(unsigned int)prp...>(mem2,subs,ps);
+
+	BOOST_REQUIRE_EQUAL(ps.getOffset(),mem.getOffsetEnd());
+
+	bool match = true;
+	for (size_t i = 0 ; i < subs.size() ; i++)
+	{
+		auto & sub = subs.get(i);
+		sub.reset();
+		while (sub.isNext())
+		{
+			match &= check(sub.get());
+			++sub;
+		}
+	}
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	mem.decRef();
+	delete &mem;
+	mem2.decRef();
+	delete &mem2;
+}
+
+BOOST_AUTO_TEST_CASE ( packer_unpacker_multi_sub_grid_test )
+{
+	// no padding in the struct, the packed messages can be compared byte by byte
+	typedef aggregate<float,int,double> agg;
+	typedef grid_base<3,agg,HeapMemory,typename memory_traits_inte<agg>::type> grid_soa;
+
+	size_t sz[3] = {32,32,32};
+
+	grid_cpu<3,agg> g(sz);
+	grid_cpu<3,agg> g2(sz);
+	grid_soa gs2(sz);
+	grid_cpu<3,agg,grid_smb<3,4>> gb(sz);
+	grid_cpu<3,agg,grid_smb<3,4>> gb2(sz);
+	g.setMemory();
+	g2.setMemory();
+	gs2.setMemory();
+	gb.setMemory();
+	gb2.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + 0.5f;
+		g.template get<1>(key) = key.get(1) + 32*key.get(2);
+		g.template get<2>(key) = key.get(2) + 0.25;
+
+		gb.get_o(key) = g.get_o(key);
+
+		++it;
+	}
+
+	// ghost like sub-grids: faces, an edge and a point
+	std::vector<std::pair<grid_key_dx<3>,grid_key_dx<3>>> boxes;
+	boxes.push_back({grid_key_dx<3>({0,0,0}),grid_key_dx<3>({31,31,1})});
+	boxes.push_back({grid_key_dx<3>({0,0,30}),grid_key_dx<3>({31,31,31})});
+	boxes.push_back({grid_key_dx<3>({0,2,2}),grid_key_dx<3>({1,29,29})});
+	boxes.push_back({grid_key_dx<3>({3,30,3}),grid_key_dx<3>({28,31,28})});
+	boxes.push_back({grid_key_dx<3>({5,5,5}),grid_key_dx<3>({5,5,20})});
+	boxes.push_back({grid_key_dx<3>({7,7,7}),grid_key_dx<3>({7,7,7})});
+
+	auto check_all = [&](const grid_key_dx<3> & key)
+	{
+		return g2.template get<0>(key) == g.template get<0>(key) &&
+			   g2.template get<1>(key) == g.template get<1>(key) &&
+			   g2.template get<2>(key) == g.template get<2>(key);
+	};
+
+	// memory_traits_lin all the properties (memcpy of the rows)
+	test_pack_multi_grid<0,1,2>(g,g2,boxes,check_all);
+
+	// some properties (point by point), {float,int} has no padding
+	auto it2 = g2.getIterator();
+	while (it2.isNext())
+	{
+		g2.template get<2>(it2.get()) = 0;
+		++it2;
+	}
+
+	test_pack_multi_grid<0,1>(g,g2,boxes,[&](const grid_key_dx<3> & key)
+	{
+		return g2.template get<0>(key) == g.template get<0>(key) &&
+			   g2.template get<1>(key) == g.template get<1>(key) &&
+			   g2.template get<2>(key) == 0;
+	});
+
+	// memory_traits_inte one property (memcpy of the rows)
+	test_pack_multi_grid<1>(g,gs2,boxes,[&](const grid_key_dx<3> & key){return gs2.template get<1>(key) == g.template get<1>(key);});
+
+	// grid stored in bricks, the rows are cut at the border of the bricks
+	test_pack_multi_grid<0,1,2>(gb,gb2,boxes,[&](const grid_key_dx<3> & key)
+	{
+		return gb2.template get<0>(key) == g.template get<0>(key) &&
+			   gb2.template get<1>(key) == g.template get<1>(key) &&
+			   gb2.template get<2>(key) == g.template get<2>(key);
+	});
+}
+
 BOOST_AUTO_TEST_CASE ( packer_memory_traits_inte )
 {
 
@@ -180,6 +180,147 @@ BOOST_AUTO_TEST_CASE( bm_test )
 
 }
 
+/*! \brief Throughput of pack/unpack of the ghost sub-grids of a grid
+ *
+ * \tparam prp properties to pack
+ *
+ * \param g grid
+ * \param subs sub-grids
+ * \param name name of the benchmark
+ *
+ */
+template<unsigned int ... prp, typename grid_type>
+void bm_grid_sub_pack(grid_type & g, openfpm::vector<grid_key_dx_iterator_sub<3>> & subs, const std::string & name)
+{
+	size_t req = 0;
+	for (size_t i = 0 ; i < subs.size() ; i++)
+	{g.template packRequest<prp...>(subs.get(i),req);}
+
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	size_t n_rep = 20;
+	double MB = (double)req/1024/1024;
+	int ctx = 0;
+
+	// warm up (first touch of mem)
+	Pack_stat sts_w;
+	for (size_t i = 0 ; i < subs.size() ; i++)
+	{g.template pack<prp...>(mem,subs.get(i),sts_w);}
+
+	// best time of n_rep repetitions
+	double t_pack = std::numeric_limits<double>::max();
+	double t_unpack = std::numeric_limits<double>::max();
+	double t_pack_m = std::numeric_limits<double>::max();
+	double t_unpack_m = std::numeric_limits<double>::max();
+
+	for (size_t r = 0 ; r < n_rep ; r++)
+	{
+		timer t;
+
+		// one sub-grid after the other (each sub-grid is packed in parallel)
+		t.start();
+		{
+		mem.reset();
+		Pack_stat sts;
+		for (size_t i = 0 ; i < subs.size() ; i++)
+		{g.template pack<prp...>(mem,subs.get(i),sts);}
+		}
+		t.stop();
+		t_pack = std::min(t_pack,t.getwct());
+
+		t.start();
+		{
+		Unpack_stat ps;
+		for (size_t i = 0 ; i < subs.size() ; i++)
+		{g.template unpack<prp...>(mem,subs.get(i),ps,ctx,rem_copy_opt::NONE_OPT);}
+		}
+		t.stop();
+		t_unpack = std::min(t_unpack,t.getwct());
+
+		// the sub-grids concurrently
+		t.start();
+		{
+		mem.reset();
+		Pack_stat sts;
+		g.template packMulti<prp...>(mem,subs,sts);
+		}
+		t.stop();
+		t_pack_m = std::min(t_pack_m,t.getwct());
+
+		t.start();
+		{
+		Unpack_stat ps;
+		g.template unpackMulti<prp...>(mem,subs,ps);
+		}
+		t.stop();
+		t_unpack_m = std::min(t_unpack_m,t.getwct());
+	}
+
+	std::cout << name << " " << subs.size() << " sub-grids " << (double)req/1024/1024 << " MB  pack: " << MB/t_pack << " MB/s  unpack: " << MB/t_unpack
+			  << " MB/s  packMulti: " << MB/t_pack_m << " MB/s  unpackMulti: " << MB/t_unpack_m << " MB/s" << "\n";
+
+	mem.decRef();
+	delete &mem;
+}
+
+BOOST_AUTO_TEST_CASE( bm_grid_sub_pack_test )
+{
+	size_t sz[3] = {128,128,128};
+	long int gh = 3;
+
+	grid_cpu<3,aggregate<float,float[3],double>> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0);
+		g.template get<1>(key)[0] = key.get(1);
+		g.template get<1>(key)[1] = key.get(2);
+		g.template get<1>(key)[2] = key.get(0);
+		g.template get<2>(key) = key.get(2);
+
+		++it;
+	}
+
+	// the 26 ghost sub-grids (faces, edges and corners) of the internal domain [gh,sz-gh)
+	grid_sm<3,void> ginfo(sz);
+	openfpm::vector<grid_key_dx_iterator_sub<3>> subs;
+
+	for (long int i = -1 ; i <= 1 ; i++)
+	{
+		for (long int j = -1 ; j <= 1 ; j++)
+		{
+			for (long int k = -1 ; k <= 1 ; k++)
+			{
+				if (i == 0 && j == 0 && k == 0)	{continue;}
+
+				long int dir[3] = {i,j,k};
+				grid_key_dx<3> start;
+				grid_key_dx<3> stop;
+
+				for (size_t d = 0 ; d < 3 ; d++)
+				{
+					start.set_d(d,(dir[d] == -1)?gh:((dir[d] == 0)?gh:sz[d] - 2*gh));
+					stop.set_d(d,(dir[d] == -1)?2*gh-1:((dir[d] == 0)?sz[d]-gh-1:sz[d]-gh-1));
+				}
+
+				subs.add(grid_key_dx_iterator_sub<3>(ginfo,start,stop));
+			}
+		}
+	}
+
+	// all the properties (the rows are copied with memcpy)
+	bm_grid_sub_pack<0,1,2>(g,subs,"Grid ghost pack all properties");
+
+	// some properties (point by point)
+	bm_grid_sub_pack<0,2>(g,subs,"Grid ghost pack properties 0,2");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* OPENFPM_DATA_SRC_PACKER_UNPACKER_PACKER_UNPACKER_BENCHMARK_TEST_HPP_ */
@@ -20,6 +20,9 @@
 #include "SparseGrid_iterator.hpp"
 #include "SparseGrid_iterator_block.hpp"
 #include "SparseGrid_conv_opt.hpp"
+#include "SparseGrid_accessor.hpp"
+#include "SparseGrid_chunk_index.hpp"
+#include "util/openmp_util.hpp"
 //#include "util/debug.hpp"
 // We do not want parallel writer
 
@@ -377,7 +380,13 @@ struct set_bck
 	template<unsigned int p, typename chunks_type>
 	static void set(const T & val, chunks_type & chunks, unsigned int i)
 	{
-		meta_copy<typename boost::mpl::at<typename aggr::type,boost::mpl::int_<p>>::type>::meta_copy_(val,chunks.get(0).template get<p>()[i]);
+		set_cnk<p>(val,chunks,0,i);
+	}
+
+	template<unsigned int p, typename chunks_type>
+	static void set_cnk(const T & val, chunks_type & chunks, size_t cnk, unsigned int i)
+	{
+		meta_copy<typename boost::mpl::at<typename aggr::type,boost::mpl::int_<p>>::type>::meta_copy_(val,chunks.get(cnk).template get<p>()[i]);
 	}
 };
 
@@ -386,9 +395,15 @@ struct set_bck<T[N1],aggr>
 {
 	template<unsigned int p, typename chunks_type>
 	static void set(const T (& val)[N1], chunks_type & chunks, unsigned int i)
+	{
+		set_cnk<p>(val,chunks,0,i);
+	}
+
+	template<unsigned int p, typename chunks_type>
+	static void set_cnk(const T (& val)[N1], chunks_type & chunks, size_t cnk, unsigned int i)
 	{
 		for (int i1 = 0 ; i1 < N1; i1++)
-		{meta_copy<T>::meta_copy_(val[i1],chunks.get(0).template get<p>()[i1][i]);}
+		{meta_copy<T>::meta_copy_(val[i1],chunks.get(cnk).template get<p>()[i1][i]);}
 	}
 };
 
@@ -397,24 +412,79 @@ struct set_bck<T[N1][N2],aggr>
 {
 	template<unsigned int p, typename chunks_type>
 	static void set(const T (& val)[N1][N2], chunks_type & chunks, unsigned int i)
+	{
+		set_cnk<p>(val,chunks,0,i);
+	}
+
+	template<unsigned int p, typename chunks_type>
+	static void set_cnk(const T (& val)[N1][N2], chunks_type & chunks, size_t cnk, unsigned int i)
 	{
 		for (int i1 = 0 ; i1 < N1; i1++)
 		{
 			for (int i2 = 0 ; i2 < N2; i2++)
 			{
-				meta_copy<T>::meta_copy_(val[i1][i2],chunks.get(0).template get<p>()[i1][i2][i]);
+				meta_copy<T>::meta_copy_(val[i1][i2],chunks.get(cnk).template get<p>()[i1][i2][i]);
 			}
 		}
 	}
 };
 
+/*! \brief this class is a functor for "for_each" algorithm
+ *
+ * It copy the selected properties of an element of a vector into an element of a chunk
+ *
+ * \tparam T aggregate type
+ * \tparam vector_type vector of values
+ * \tparam chunks_type vector of chunks
+ * \tparam prp properties to copy
+ *
+ */
+template<typename T, typename vector_type, typename chunks_type, unsigned int ... prp>
+class copy_vector_to_chunk
+{
+	//! vector of the values
+	const vector_type & v;
+
+	//! element of the vector to copy
+	size_t id;
+
+	//! chunks
+	chunks_type & chunks;
+
+	//! destination chunk
+	size_t cnk;
+
+	//! position inside the chunk
+	unsigned int sub_id;
+
+	//! Convert the packed properties into an MPL vector
+	typedef typename to_boost_vmpl<prp...>::type v_prp;
+
+public:
+
+	copy_vector_to_chunk(const vector_type & v, size_t id, chunks_type & chunks, size_t cnk, unsigned int sub_id)
+	:v(v),id(id),chunks(chunks),cnk(cnk),sub_id(sub_id)
+	{}
+
+	//! It call the copy function for each property
+	template<typename Tp>
+	inline void operator()(Tp& t) const
+	{
+		typedef typename boost::mpl::at<v_prp,boost::mpl::int_<Tp::value>>::type idx_type;
+		typedef typename boost::mpl::at<typename T::type,idx_type>::type prp_type;
+
+		set_bck<prp_type,T>::template set_cnk<idx_type::value>(v.template get<idx_type::value>(id),chunks,cnk,sub_id);
+	}
+};
+
 template<unsigned int dim,
 		 typename T,
 		 typename S,
 		 typename grid_lin,
 		 typename layout,
 		 template<typename> class layout_base,
-		 typename chunking>
+		 typename chunking,
+		 typename chunk_index>
 class sgrid_cpu
 {
 	//! cache pointer
@@ -427,7 +497,7 @@ class sgrid_cpu
 	mutable long int cached_id[SGRID_CACHE];
 
 	//! Map to convert from grid coordinates to chunk
-	tsl::hopscotch_map<size_t, size_t> map;
+	chunk_index map;
 
 	//! indicate which element in the chunk are really filled
 	openfpm::vector<cheader<dim>,S> header_inf;
@@ -440,7 +510,7 @@ class sgrid_cpu
 	//! background values
 	//aggregate_bfv<chunk_def> background;
 
-	typedef sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking> self;
+	typedef sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking,chunk_index> self;
 
 	//! vector of chunks
 	openfpm::vector<aggregate_bfv<chunk_def>,S,layout_base > chunks;
@@ -511,6 +581,7 @@ class sgrid_cpu
 		// reconstruct map
 
 		map.clear();
+		map.reserve(header_inf.size());
 		for (size_t i = 1 ; i < header_inf.size() ; i++)
 		{
 			grid_key_dx<dim> kh = header_inf.get(i).pos;
@@ -521,8 +592,9 @@ class sgrid_cpu
 
 			long int lin_id = g_sm_shift.LinId(kh);
 
-			map[lin_id] = i;
+			map.bulk_add(kh,lin_id,i);
 		}
+		map.bulk_end();
 	}
 
 	/*! \brief Eliminate empty chunks
@@ -613,6 +685,7 @@ class sgrid_cpu
 		{sz_i[i] = cs.get(i) + 1;}
 
 		g_sm_shift.setDimensions(sz_i);
+		map.set_chunk_grid(sz_i);
 	}
 
 	/*! \brief initialize
@@ -684,6 +757,27 @@ class sgrid_cpu
 	 *
 	 */
 	inline void find_active_chunk(const grid_key_dx<dim> & kh,size_t & active_cnk,bool & exist) const
+	{
+		find_active_chunk(kh,active_cnk,exist,cache,cached_id,cache_pnt);
+	}
+
+	/*! \brief Given a key return the chunk than contain that key, in case that chunk does not exist return the key of the
+	 *         background chunk. The chunk cache to use is passed as argument
+	 *
+	 * \param kh shifted key to search
+	 * \param active_cnk return active_chunk
+	 * \param exist return true if the chunk exist
+	 * \param cache chunk cache
+	 * \param cached_id chunk id of the cache entries
+	 * \param cache_pnt cache pointer
+	 *
+	 */
+	inline void find_active_chunk(const grid_key_dx<dim> & kh,
+			                      size_t & active_cnk,
+			                      bool & exist,
+			                      long int (& cache)[SGRID_CACHE],
+			                      long int (& cached_id)[SGRID_CACHE],
+			                      size_t & cache_pnt) const
 	{
 		long int lin_id = g_sm_shift.LinId(kh);
 
@@ -693,17 +787,19 @@ class sgrid_cpu
 
 		if (id == 0)
 		{
+			CONTAINER_STAT_INC(CSTAT_SGRID_CACHE_MISS);
+
 			// we do not have it in cache we check if we have it in the map
 
-			auto fnd = map.find(lin_id);
-			if (fnd == map.end())
+			long int fnd = map.find(kh,lin_id);
+			if (fnd == -1)
 			{
 				exist = false;
 				active_cnk = 0;
 				return;
 			}
 			else
-			{active_cnk = fnd->second;}
+			{active_cnk = fnd;}
 
 			// Add on cache the chunk
 			cache[cache_pnt] = lin_id;
@@ -713,6 +809,8 @@ class sgrid_cpu
 		}
 		else
 		{
+			CONTAINER_STAT_INC(CSTAT_SGRID_CACHE_HIT);
+
 			active_cnk = cached_id[id-1];
 			cache_pnt = id;
 			cache_pnt = (cache_pnt == SGRID_CACHE)?0:cache_pnt;
@@ -729,6 +827,28 @@ class sgrid_cpu
 	 *
 	 */
 	inline void pre_get(const grid_key_dx<dim> & v1, size_t & active_cnk, size_t & sub_id, bool & exist) const
+	{
+		pre_get(v1,active_cnk,sub_id,exist,cache,cached_id,cache_pnt);
+	}
+
+	/*! Given a key v1 in coordinates it calculate the chunk position and the  position in the chunk
+	 *  using the chunk cache passed as argument
+	 *
+	 * \param v1 coordinates
+	 * \param chunk position
+	 * \param sub_id element id
+	 * \param cache chunk cache
+	 * \param cached_id chunk id of the cache entries
+	 * \param cache_pnt cache pointer
+	 *
+	 */
+	inline void pre_get(const grid_key_dx<dim> & v1,
+			            size_t & active_cnk,
+			            size_t & sub_id,
+			            bool & exist,
+			            long int (& cache)[SGRID_CACHE],
+			            long int (& cached_id)[SGRID_CACHE],
+			            size_t & cache_pnt) const
 	{
 		grid_key_dx<dim> kh = v1;
 		grid_key_dx<dim> kl;
@@ -736,7 +856,7 @@ class sgrid_cpu
 		// shift the key
 		key_shift<dim,chunking>::shift(kh,kl);
 
-		find_active_chunk(kh,active_cnk,exist);
+		find_active_chunk(kh,active_cnk,exist,cache,cached_id,cache_pnt);
 
 		sub_id = sublin<dim,typename chunking::shift_c>::lin(kl);
 	}
@@ -767,14 +887,19 @@ class sgrid_cpu
 
 		if (id == 0)
 		{
+			CONTAINER_STAT_INC(CSTAT_SGRID_CACHE_MISS);
+
 			// we do not have it in cache we check if we have it in the map
 
-			auto fnd = map.find(lin_id);
-			if (fnd == map.end())
+			long int fnd = map.find(kh,lin_id);
+			if (fnd == -1)
 			{
 				// we do not have it in the map create a chunk
 
-				map[lin_id] = chunks.size();
+				CONTAINER_STAT_INC(CSTAT_SGRID_CHUNK_ALLOC);
+				CONTAINER_STAT_ADD(CSTAT_SGRID_CHUNK_BYTES,sizeof(aggregate_bfv<chunk_def>) + sizeof(cheader<dim>) + sizeof(mheader<chunking::size::value>));
+
+				map.insert(kh,lin_id,chunks.size());
 				chunks.add();
 				header_inf.add();
 				header_inf.last().pos = kh;
@@ -795,7 +920,7 @@ class sgrid_cpu
 			{
 				// we have it in the map
 
-				active_cnk = fnd->second;
+				active_cnk = fnd;
 			}
 
 			// Add on cache the chunk
@@ -806,6 +931,8 @@ class sgrid_cpu
 		}
 		else
 		{
+			CONTAINER_STAT_INC(CSTAT_SGRID_CACHE_HIT);
+
 			active_cnk = cached_id[id-1];
 			cache_pnt = id;
 			cache_pnt = (cache_pnt == SGRID_CACHE)?0:cache_pnt;
@@ -1050,6 +1177,182 @@ public:
 		return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get<p>(chunks,active_cnk,sub_id);
 	}
 
+	/*! \brief Insert a set of points in one shot
+	 *
+	 * It is equivalent to call insert for each point, but the points are grouped by chunk with a
+	 * parallel sort, all the new chunks are allocated in one step, masks and data are filled in
+	 * parallel (one chunk is filled by one thread) and the map is reconstructed only once at the end.
+	 * If a point appear more than once the value with the highest index in keys is stored
+	 *
+	 * \tparam prp properties to copy from values
+	 *
+	 * \param keys points to insert
+	 * \param values values to insert, values.get(i) is inserted in keys.get(i)
+	 *
+	 */
+	template<unsigned int ... prp, typename vector_keys_type, typename vector_values_type>
+	void insertBatch(const vector_keys_type & keys, const vector_values_type & values)
+	{
+		struct key_chunk
+		{
+			//! linearized id of the chunk
+			size_t lin_id;
+
+			//! id of the key
+			size_t id;
+
+			bool operator<(const key_chunk & tmp) const
+			{
+				return (lin_id < tmp.lin_id) || (lin_id == tmp.lin_id && id < tmp.id);
+			}
+		};
+
+		size_t n = keys.size();
+
+		if (n == 0)
+		{return;}
+
+		// calculate the chunk of each point and group the points by chunk
+
+		openfpm::vector<key_chunk> srt;
+		srt.resize(n);
+
+		#pragma omp parallel for
+		for (long int i = 0 ; i < (long int)n ; i++)
+		{
+			grid_key_dx<dim> kh = keys.get(i);
+			grid_key_dx<dim> kl;
+
+			// shift the key
+			key_shift<dim,chunking>::shift(kh,kl);
+
+			srt.get(i).lin_id = g_sm_shift.LinId(kh);
+			srt.get(i).id = i;
+		}
+
+		openfpm::omp::sort(&srt.get(0),&srt.get(0) + n);
+
+		// find the segments, one for each chunk
+
+		openfpm::vector<size_t> seg_id;
+		seg_id.resize(n);
+
+		#pragma omp parallel for
+		for (long int i = 0 ; i < (long int)n ; i++)
+		{seg_id.get(i) = (i == 0 || srt.get(i).lin_id != srt.get(i-1).lin_id);}
+
+		size_t n_seg = openfpm::omp::exclusive_scan(&seg_id.get(0),&seg_id.get(0),n);
+
+		openfpm::vector<size_t> seg_start;
+		seg_start.resize(n_seg+1);
+		seg_start.get(n_seg) = n;
+
+		#pragma omp parallel for
+		for (long int i = 0 ; i < (long int)n ; i++)
+		{
+			if (i == 0 || srt.get(i).lin_id != srt.get(i-1).lin_id)
+			{seg_start.get(seg_id.get(i)) = i;}
+		}
+
+		// search the chunks that already exist and count the new one
+
+		openfpm::vector<size_t> seg_cnk;
+		openfpm::vector<size_t> seg_new;
+		openfpm::vector<size_t> seg_new_id;
+		seg_cnk.resize(n_seg);
+		seg_new.resize(n_seg);
+		seg_new_id.resize(n_seg);
+
+		#pragma omp parallel for
+		for (long int s = 0 ; s < (long int)n_seg ; s++)
+		{
+			grid_key_dx<dim> kh = keys.get(srt.get(seg_start.get(s)).id);
+			grid_key_dx<dim> kl;
+
+			// shift the key
+			key_shift<dim,chunking>::shift(kh,kl);
+
+			long int fnd = map.find(kh,srt.get(seg_start.get(s)).lin_id);
+
+			seg_new.get(s) = (fnd == -1);
+			seg_cnk.get(s) = (fnd == -1)?0:fnd;
+		}
+
+		size_t n_new = openfpm::omp::exclusive_scan(&seg_new.get(0),&seg_new_id.get(0),n_seg);
+
+		// allocate all the new chunks in one step
+
+		size_t old_size = chunks.size();
+
+		chunks.resize(old_size + n_new);
+		header_inf.resize(old_size + n_new);
+		header_mask.resize(old_size + n_new);
+
+		// fill the chunks, each chunk is filled by one thread
+
+		#pragma omp parallel for schedule(dynamic,64)
+		for (long int s = 0 ; s < (long int)n_seg ; s++)
+		{
+			size_t start = seg_start.get(s);
+			size_t stop = seg_start.get(s+1);
+
+			size_t active_cnk = seg_cnk.get(s);
+
+			if (seg_new.get(s) == true)
+			{
+				active_cnk = old_size + seg_new_id.get(s);
+
+				grid_key_dx<dim> kh = keys.get(srt.get(start).id);
+				grid_key_dx<dim> kl;
+
+				// shift the key
+				key_shift<dim,chunking>::shift(kh,kl);
+
+				header_inf.get(active_cnk).pos = kh;
+				header_inf.get(active_cnk).nele = 0;
+				key_shift<dim,chunking>::cpos(header_inf.get(active_cnk).pos);
+
+				// set the mask to null
+				auto & h = header_mask.get(active_cnk).mask;
+
+				for (size_t i = 0 ; i < chunking::size::value ; i++)
+				{h[i] = 0;}
+			}
+
+			auto & hc = header_inf.get(active_cnk);
+			auto & hm = header_mask.get(active_cnk);
+
+			for (size_t j = start ; j < stop ; j++)
+			{
+				size_t id = srt.get(j).id;
+
+				grid_key_dx<dim> kh = keys.get(id);
+				grid_key_dx<dim> kl;
+
+				// shift the key
+				key_shift<dim,chunking>::shift(kh,kl);
+
+				size_t sub_id = sublin<dim,typename chunking::shift_c>::lin(kl);
+
+				hc.nele = (hm.mask[sub_id] & 1)?hc.nele:hc.nele + 1;
+				hm.mask[sub_id] |= 1;
+
+				copy_vector_to_chunk<T,vector_values_type,decltype(chunks),prp ...> cvc(values,id,chunks,active_cnk,sub_id);
+				boost::mpl::for_each_ref< boost::mpl::range_c<int,0,sizeof...(prp)> >(cvc);
+			}
+		}
+
+		// reconstruct the map once
+
+		if (n_new != 0)
+		{
+			reconstruct_map();
+			findNN = false;
+		}
+
+		clear_cache();
+	}
+
 	/*! \brief Get the reference of the selected element
 	 *
 	 * \param v1 grid_key that identify the element in the grid
@@ -1142,6 +1445,86 @@ public:
 		return true;
 	}
 
+	/*! \brief Get the reference of the selected element using an external chunk cache
+	 *
+	 * It does not touch the internal cache of the grid, so it can be called concurrently
+	 * by several threads as long as each thread use its own cache (see getAccessor)
+	 *
+	 * \param v1 grid_key that identify the element in the grid
+	 * \param cache chunk cache
+	 * \param cached_id chunk id of the cache entries
+	 * \param cache_pnt cache pointer
+	 *
+	 * \return the reference of the element
+	 *
+	 */
+	template <unsigned int p>
+	inline auto get_with_cache(const grid_key_dx<dim> & v1,
+			                   long int (& cache)[SGRID_CACHE],
+			                   long int (& cached_id)[SGRID_CACHE],
+			                   size_t & cache_pnt) const
+	-> decltype(get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,0))
+	{
+		bool exist;
+		size_t active_cnk;
+		size_t sub_id;
+
+		pre_get(v1,active_cnk,sub_id,exist,cache,cached_id,cache_pnt);
+
+		if (exist == false)
+		{return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,sub_id);}
+
+		// we check the mask
+		auto & hm = header_mask.get(active_cnk);
+
+		if ((hm.mask[sub_id] & 1) == 0)
+		{return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,0,sub_id);}
+
+		return get_selector< typename boost::mpl::at<typename T::type,boost::mpl::int_<p>>::type >::template get_const<p>(chunks,active_cnk,sub_id);
+	}
+
+	/*! \brief Check if the point exist using an external chunk cache
+	 *
+	 * \param v1 grid_key that identify the element in the grid
+	 * \param cache chunk cache
+	 * \param cached_id chunk id of the cache entries
+	 * \param cache_pnt cache pointer
+	 *
+	 * \return the true if the point exist
+	 *
+	 */
+	inline bool existPoint_with_cache(const grid_key_dx<dim> & v1,
+			                          long int (& cache)[SGRID_CACHE],
+			                          long int (& cached_id)[SGRID_CACHE],
+			                          size_t & cache_pnt) const
+	{
+		bool exist;
+		size_t active_cnk;
+		size_t sub_id;
+
+		pre_get(v1,active_cnk,sub_id,exist,cache,cached_id,cache_pnt);
+
+		if (exist == false)
+		{return false;}
+
+		// we check the mask
+		auto & hm = header_mask.get(active_cnk);
+
+		return (hm.mask[sub_id] & 1) != 0;
+	}
+
+	/*! \brief Return a read-only accessor with its own chunk cache
+	 *
+	 * Each thread must create its own accessor, reading with different accessors is thread-safe
+	 *
+	 * \return the accessor
+	 *
+	 */
+	sgrid_cpu_accessor<self> getAccessor() const
+	{
+		return sgrid_cpu_accessor<self>(*this);
+	}
+
 	/*! \brief Get the reference of the selected element
 	 *
 	 * \param v1 grid_key that identify the element in the grid
@@ -1270,6 +1653,8 @@ public:
 	 */
 	void flush_remove()
 	{
+		CONTAINER_STAT_SCOPE(CSTAT_TIME_FLUSH);
+
 		remove_empty();
 	}
 
@@ -1617,6 +2002,8 @@ public:
 									grid_key_sparse_dx_iterator_sub<dims,chunking::size::value> & sub_it,
 									Pack_stat & sts)
 	{
+		CONTAINER_STAT_SCOPE(CSTAT_TIME_PACK);
+
 		grid_sm<dim,void> gs_cnk(sz_cnk);
 
 		// Here we allocate a size_t that indicate the number of chunk we are packing,
@@ -1812,6 +2199,8 @@ public:
 	template<int ... prp> void pack(ExtPreAlloc<S> & mem,
 									Pack_stat & sts) const
 	{
+		CONTAINER_STAT_SCOPE(CSTAT_TIME_PACK);
+
 		grid_sm<dim,void> gs_cnk(sz_cnk);
 
 		// Here we allocate a size_t that indicate the number of chunk we are packing,
@@ -2039,6 +2428,26 @@ public:
 		return act_cnk;
 	}
 
+	/*! \brief Given a chunk it return the neighborhood chunk in direction d. In case the neighborhood chunk does not
+	 *         exist it return the background chunk
+	 *
+	 * \param cid chunk id
+	 * \param d direction
+	 * \param s verse (+1 or -1)
+	 * \param exist return true if the chunk exist
+	 *
+	 * \return the neighborhood chunk
+	 *
+	 */
+	size_t getChunkNN(size_t cid, unsigned int d, int s, bool & exist)
+	{
+		long int r = map.find_nn(getChunkPos(cid),d,s,g_sm_shift);
+
+		exist = (r != -1);
+
+		return (exist)?r:0;
+	}
+
 	/*! \brief Get the position of a chunk
 	 *
 	 * \param chunk_id
@@ -2432,9 +2841,17 @@ public:
 	 */
 	void reorder()
 	{
-		openfpm::vector<cheader<dim>,S> header_inf_tmp;
-		openfpm::vector<mheader<chunking::size::value>,S> header_mask_tmp;
-		openfpm::vector<aggregate_bfv<chunk_def>,S,layout_base > chunks_tmp;
+		CONTAINER_STAT_SCOPE(CSTAT_TIME_REORDER);
+
+		// the temporaries take the old memory of the grid, inside a memory_pool_scope
+		// it is reused by the next reorder
+		openfpm::pool_tmp<openfpm::vector<cheader<dim>,S>> header_inf_tmp_p;
+		openfpm::pool_tmp<openfpm::vector<mheader<chunking::size::value>,S>> header_mask_tmp_p;
+		openfpm::pool_tmp<openfpm::vector<aggregate_bfv<chunk_def>,S,layout_base >> chunks_tmp_p;
+
+		auto & header_inf_tmp = header_inf_tmp_p.get();
+		auto & header_mask_tmp = header_mask_tmp_p.get();
+		auto & chunks_tmp = chunks_tmp_p.get();
 
 		header_inf_tmp.resize(header_inf.size());
 		header_mask_tmp.resize(header_mask.size());
@@ -2552,6 +2969,89 @@ public:
 		reconstruct_map();
 	}
 
+	/*! \brief Fill the header of a checkpoint of this sparse grid
+	 *
+	 * \param h header
+	 *
+	 */
+	void checkpointHeader(checkpoint_header & h) const
+	{
+		static_assert(dim <= CHECKPOINT_MAX_DIM,"grid dimensionality bigger than CHECKPOINT_MAX_DIM");
+
+		h.kind = CHECKPOINT_SPARSE_GRID;
+		h.type_hash = checkpoint_type_hash<T>();
+		h.lin_hash = checkpoint_name_hash<chunking>();
+		h.is_inte = is_layout_inte<layout_base<aggregate_bfv<chunk_def>>>::value;
+		h.dim = dim;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{h.sz[i] = g_sm.size(i);}
+
+		h.n_ele = header_inf.size();
+	}
+
+	/*! \brief Allocate the chunks to receive the checkpoint
+	 *
+	 * \param h header of the checkpoint
+	 *
+	 * \return false if the checkpoint does not contain a sparse grid of this type
+	 *
+	 */
+	bool checkpointPrepare(const checkpoint_header & h)
+	{
+		if (h.match(CHECKPOINT_SPARSE_GRID,checkpoint_type_hash<T>(),checkpoint_name_hash<chunking>(),
+				    is_layout_inte<layout_base<aggregate_bfv<chunk_def>>>::value,dim) == false)
+		{return false;}
+
+		size_t sz[dim];
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{sz[i] = h.sz[i];}
+
+		g_sm.setDimensions(sz);
+		set_g_shift_from_size(sz,g_sm_shift);
+
+		header_inf.resize(h.n_ele);
+		header_mask.resize(h.n_ele);
+		chunks.resize(h.n_ele);
+
+		return true;
+	}
+
+	/*! \brief Reconstruct the map of the chunks after the segments of the checkpoint has been read
+	 *
+	 * \return true
+	 *
+	 */
+	bool checkpointFinalize()
+	{
+		reconstruct_map();
+		clear_cache();
+
+		empty_v.clear();
+		NNlist.clear();
+		findNN = false;
+
+		return true;
+	}
+
+	/*! \brief Get the segments of memory that a checkpoint of this sparse grid contain
+	 *
+	 * The segments are the headers of the chunks, the masks and the chunks (background chunk included)
+	 * as they are stored in memory
+	 *
+	 * \param segs list of segments where to add the segments of the sparse grid
+	 *
+	 */
+	void checkpointSegments(pack_segment_list & segs) const
+	{
+		self & g = const_cast<self &>(*this);
+
+		segs.add(g.header_inf.getPointer(),header_inf.size()*sizeof(cheader<dim>));
+		segs.add(g.header_mask.getPointer(),header_mask.size()*sizeof(mheader<chunking::size::value>));
+		chunks.checkpointSegments(segs);
+	}
+
 	/*! \brief This is an internal function to clear the cache
 	 *
 	 *
@@ -2738,8 +3238,9 @@ template<unsigned int dim,
 		 typename grid_lin = grid_zm<dim,void>,
 		 typename layout = typename memory_traits_inte<T>::type,
 		 template<typename> class layout_base = memory_traits_inte,
-		 typename chunking = default_chunking<dim>>
-using sgrid_soa = sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking>;
+		 typename chunking = default_chunking<dim>,
+		 typename chunk_index = sgrid_hash_index<dim>>
+using sgrid_soa = sgrid_cpu<dim,T,S,grid_lin,layout,layout_base,chunking,chunk_index>;
 
 
 #endif /* OPENFPM_DATA_SRC_SPARSEGRID_SPARSEGRID_HPP_ */
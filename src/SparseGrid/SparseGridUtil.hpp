@@ -278,13 +278,17 @@ struct default_chunking<8>
 	typedef boost::mpl::int_<1024> size;
 };
 
+template<unsigned int dim>
+class sgrid_hash_index;
+
 template<unsigned int dim,
          typename T,
 		 typename S,
 		 typename grid_lin = grid_sm<dim,void>,
 		 typename layout=typename memory_traits_lin<T>::type,
 		 template<typename> class layout_base = memory_traits_lin,
-		 typename chunking = default_chunking<dim>>
+		 typename chunking = default_chunking<dim>,
+		 typename chunk_index = sgrid_hash_index<dim>>
 class sgrid_cpu;
 
 
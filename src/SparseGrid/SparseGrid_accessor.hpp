@@ -0,0 +1,109 @@
+/*
+ * SparseGrid_accessor.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef SPARSEGRID_ACCESSOR_HPP_
+#define SPARSEGRID_ACCESSOR_HPP_
+
+/*! \brief Read-only accessor of an sgrid_cpu with its own chunk cache
+ *
+ * The get and existPoint of sgrid_cpu are const but update the internal chunk cache,
+ * so they cannot be called concurrently. Every accessor carry a private copy
+ * of the cache, creating one accessor for each thread make the reading thread-safe
+ * without locking and without copying the grid
+ *
+ * \warning the accessor is invalidated by every operation that change the chunk structure
+ *          of the grid (insert of new chunks, remove, reorder, clear, resize ...)
+ *
+ * ### Concurrent read of a sparse grid
+ * \snippet SparseGrid_unit_tests.cpp sparse grid concurrent read
+ *
+ * \tparam sparse_grid_type sparse grid type
+ *
+ */
+template<typename sparse_grid_type>
+class sgrid_cpu_accessor
+{
+	//! dimensionality of the sparse grid
+	static constexpr unsigned int dim = sparse_grid_type::dims;
+
+	//! sparse grid we read
+	const sparse_grid_type & sg;
+
+	//! cache pointer
+	size_t cache_pnt;
+
+	//! cache
+	long int cache[SGRID_CACHE];
+
+	//! cached id
+	long int cached_id[SGRID_CACHE];
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param sg sparse grid to read
+	 *
+	 */
+	sgrid_cpu_accessor(const sparse_grid_type & sg)
+	:sg(sg),cache_pnt(0)
+	{
+		clear_cache();
+	}
+
+	/*! \brief Reset the chunk cache of the accessor
+	 *
+	 * It must be called if the chunk structure of the grid changed
+	 *
+	 */
+	inline void clear_cache()
+	{
+		cache_pnt = 0;
+		for (size_t i = 0 ; i < SGRID_CACHE ; i++)
+		{
+			cache[i] = -1;
+			cached_id[i] = 0;
+		}
+	}
+
+	/*! \brief Get the reference of the selected element
+	 *
+	 * \param v1 grid_key that identify the element in the grid
+	 *
+	 * \return the reference of the element (or the background if does not exist)
+	 *
+	 */
+	template <unsigned int p>
+	inline auto get(const grid_key_dx<dim> & v1) -> decltype(sg.template get<p>(v1))
+	{
+		return sg.template get_with_cache<p>(v1,cache,cached_id,cache_pnt);
+	}
+
+	/*! \brief Check if the point exist
+	 *
+	 * \param v1 grid_key that identify the element in the grid
+	 *
+	 * \return the true if the point exist
+	 *
+	 */
+	inline bool existPoint(const grid_key_dx<dim> & v1)
+	{
+		return sg.existPoint_with_cache(v1,cache,cached_id,cache_pnt);
+	}
+
+	/*! \brief Return the sparse grid this accessor read
+	 *
+	 * \return the sparse grid
+	 *
+	 */
+	const sparse_grid_type & getGrid() const
+	{
+		return sg;
+	}
+};
+
+#endif /* SPARSEGRID_ACCESSOR_HPP_ */
@@ -8,6 +8,8 @@
 #ifndef SPARSEGRID_CONV_OPT_HPP_
 #define SPARSEGRID_CONV_OPT_HPP_
 
+#include "Grid/grid_base_conv_opt.hpp"
+
 template<unsigned int l>
 union data_il
 {
@@ -200,17 +202,6 @@ void load_crs_v(vect_type & cs1, chunk_type & chunk,  ids_type & ids)
 }
 
 
-template<typename prop_type>
-struct cross_stencil_v
-{
-	Vc::Vector<prop_type> xm;
-	Vc::Vector<prop_type> xp;
-	Vc::Vector<prop_type> ym;
-	Vc::Vector<prop_type> yp;
-	Vc::Vector<prop_type> zm;
-	Vc::Vector<prop_type> zp;
-};
-
 template<>
 struct conv_impl<3>
 {
@@ -373,28 +364,22 @@ struct conv_impl<3>
 			auto & mask = headers.get(cid);
 
 			bool exist;
-			grid_key_dx<3> p = grid.getChunkPos(cid) + grid_key_dx<3>({-1,0,0});
-			long int r = grid.getChunk(p,exist);
+			long int r = grid.getChunkNN(cid,0,-1,exist);
 			offset_jump[0] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({1,0,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,0,1,exist);
 			offset_jump[1] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,-1,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,1,-1,exist);
 			offset_jump[2] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,1,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,1,1,exist);
 			offset_jump[3] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,-1});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,2,-1,exist);
 			offset_jump[4] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,1});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,2,1,exist);
 			offset_jump[5] = (r-cid)*decltype(it)::sizeBlock;
 
 			// Load offset jumps
@@ -673,28 +658,22 @@ struct conv_impl<3>
 			auto & mask = headers.get(cid);
 
 			bool exist;
-			grid_key_dx<3> p = grid.getChunkPos(cid) + grid_key_dx<3>({-1,0,0});
-			long int r = grid.getChunk(p,exist);
+			long int r = grid.getChunkNN(cid,0,-1,exist);
 			offset_jump[0] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({1,0,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,0,1,exist);
 			offset_jump[1] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,-1,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,1,-1,exist);
 			offset_jump[2] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,1,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,1,1,exist);
 			offset_jump[3] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,-1});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,2,-1,exist);
 			offset_jump[4] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,1});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,2,1,exist);
 			offset_jump[5] = (r-cid)*decltype(it)::sizeBlock;
 
 			// Load offset jumps
@@ -849,28 +828,22 @@ struct conv_impl<3>
 			auto & mask = headers.get(cid);
 
 			bool exist;
-			grid_key_dx<3> p = grid.getChunkPos(cid) + grid_key_dx<3>({-1,0,0});
-			long int r = grid.getChunk(p,exist);
+			long int r = grid.getChunkNN(cid,0,-1,exist);
 			offset_jump[0] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({1,0,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,0,1,exist);
 			offset_jump[1] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,-1,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,1,-1,exist);
 			offset_jump[2] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,1,0});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,1,1,exist);
 			offset_jump[3] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,-1});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,2,-1,exist);
 			offset_jump[4] = (r-cid)*decltype(it)::sizeBlock;
 
-			p = grid.getChunkPos(cid) + grid_key_dx<3>({0,0,1});
-			r = grid.getChunk(p,exist);
+			r = grid.getChunkNN(cid,2,1,exist);
 			offset_jump[5] = (r-cid)*decltype(it)::sizeBlock;
 
 			// Load offset jumps
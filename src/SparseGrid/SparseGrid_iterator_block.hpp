@@ -335,14 +335,11 @@ struct loadBlock_impl<prop,stencil_size,3,vector_blocks_exts,vector_ext>
 		typedef typename boost::mpl::at<typename vector_blocks_exts::type,boost::mpl::int_<1>>::type sz1;
 		typedef typename boost::mpl::at<typename vector_blocks_exts::type,boost::mpl::int_<2>>::type sz2;
 
-		grid_key_dx<3> p;
-
 		bool exist;
 		long int r;
 		if (findNN == false)
 		{
-			p = sgt.getChunkPos(chunk_id) + grid_key_dx<3>({0,0,1});
-			r = sgt.getChunk(p,exist);
+			r = sgt.getChunkNN(chunk_id,2,1,exist);
 			NNlist.template get<0>(chunk_id*NNType::nNN) = (exist)?r:-1;
 		}
 		else
@@ -361,8 +358,7 @@ struct loadBlock_impl<prop,stencil_size,3,vector_blocks_exts,vector_ext>
 		}
 		if (findNN == false)
 		{
-			p = sgt.getChunkPos(chunk_id) + grid_key_dx<3>({0,0,-1});
-			r = sgt.getChunk(p,exist);
+			r = sgt.getChunkNN(chunk_id,2,-1,exist);
 			NNlist.template get<0>(chunk_id*NNType::nNN+1) = (exist)?r:-1;
 		}
 		else
@@ -382,8 +378,7 @@ struct loadBlock_impl<prop,stencil_size,3,vector_blocks_exts,vector_ext>
 
 		if (findNN == false)
 		{
-			p = sgt.getChunkPos(chunk_id) + grid_key_dx<3>({0,1,0});
-			r = sgt.getChunk(p,exist);
+			r = sgt.getChunkNN(chunk_id,1,1,exist);
 			NNlist.template get<0>(chunk_id*NNType::nNN+2) = (exist)?r:-1;
 		}
 		else
@@ -402,8 +397,7 @@ struct loadBlock_impl<prop,stencil_size,3,vector_blocks_exts,vector_ext>
 		}
 		if (findNN == false)
 		{
-			p = sgt.getChunkPos(chunk_id) + grid_key_dx<3>({0,-1,0});
-			r = sgt.getChunk(p,exist);
+			r = sgt.getChunkNN(chunk_id,1,-1,exist);
 			NNlist.template get<0>(chunk_id*NNType::nNN+3) = (exist)?r:-1;
 		}
 		else
@@ -423,8 +417,7 @@ struct loadBlock_impl<prop,stencil_size,3,vector_blocks_exts,vector_ext>
 
 		if (findNN == false)
 		{
-			p = sgt.getChunkPos(chunk_id) + grid_key_dx<3>({1,0,0});
-			r = sgt.getChunk(p,exist);
+			r = sgt.getChunkNN(chunk_id,0,1,exist);
 			NNlist.template get<0>(chunk_id*NNType::nNN+4) = (exist)?r:-1;
 		}
 		else
@@ -443,8 +436,7 @@ struct loadBlock_impl<prop,stencil_size,3,vector_blocks_exts,vector_ext>
 		}
 		if (findNN == false)
 		{
-			p = sgt.getChunkPos(chunk_id) + grid_key_dx<3>({-1,0,0});
-			r = sgt.getChunk(p,exist);
+			r = sgt.getChunkNN(chunk_id,0,-1,exist);
 			NNlist.template get<0>(chunk_id*NNType::nNN+5) = (exist)?r:-1;
 		}
 		else
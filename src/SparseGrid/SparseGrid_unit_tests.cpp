@@ -11,6 +11,7 @@
 #include <boost/test/unit_test.hpp>
 #include "SparseGrid/SparseGrid.hpp"
 #include "NN/CellList/CellDecomposer.hpp"
+#include "util/SimpleRNG.hpp"
 #include <math.h>
 //#include "util/debug.hpp"
 
@@ -2434,5 +2435,422 @@ BOOST_AUTO_TEST_CASE( sparse_testing_clear )
 	BOOST_REQUIRE_EQUAL(grid.template get<0>(keyzero),555.0);
 }
 
+BOOST_AUTO_TEST_CASE( sparse_grid_concurrent_read_test )
+{
+	size_t sz[3] = {171,171,171};
+
+	sgrid_cpu<3,aggregate<float>,HeapMemory> grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = -1.0;
+
+	grid_sm<3,void> g_sm(sz);
+
+	grid_key_dx_iterator<3> kit(g_sm);
+
+	// fill only the points with even x
+
+	while (kit.isNext())
+	{
+		auto key = kit.get();
+
+		if (key.get(0) % 2 == 0)
+		{grid.template insert<0>(key) = g_sm.LinId(key);}
+
+		++kit;
+	}
+
+	//! [sparse grid concurrent read]
+
+	int n_err = 0;
+
+	#pragma omp parallel reduction(+:n_err)
+	{
+		// each thread has its own accessor
+		auto acc = grid.getAccessor();
+
+		#pragma omp for
+		for (long int i = 0 ; i < (long int)g_sm.size() ; i++)
+		{
+			grid_key_dx<3> key = g_sm.InvLinId(i);
+
+			bool exist = acc.existPoint(key);
+			float val = acc.template get<0>(key);
+
+			if (key.get(0) % 2 == 0)
+			{n_err += (exist == false || val != (float)i);}
+			else
+			{n_err += (exist == true || val != -1.0);}
+		}
+	}
+
+	//! [sparse grid concurrent read]
+
+	BOOST_REQUIRE_EQUAL(n_err,0);
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_insert_batch_test )
+{
+	size_t sz[3] = {500,500,500};
+
+	sgrid_cpu<3,aggregate<double,int>,HeapMemory> grid(sz);
+	sgrid_cpu<3,aggregate<double,int>,HeapMemory> grid_ref(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+	grid_ref.getBackgroundValue().template get<0>() = 0.0;
+
+	// some points already exist
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		grid_key_dx<3> key({(long int)i,(long int)i,(long int)i});
+
+		grid.template insert<0>(key) = -1.0;
+		grid.template insert<1>(key) = -1;
+		grid_ref.template insert<0>(key) = -1.0;
+		grid_ref.template insert<1>(key) = -1;
+	}
+
+	openfpm::vector<grid_key_dx<3>> keys;
+	openfpm::vector<aggregate<double,int>> values;
+
+	SimpleRNG rng;
+
+	for (size_t i = 0 ; i < 100000 ; i++)
+	{
+		// points with repetitions
+		grid_key_dx<3> key({(long int)(rng.GetUniform()*200),(long int)(rng.GetUniform()*200),(long int)(rng.GetUniform()*200)});
+
+		keys.add(key);
+		values.add();
+		values.last().template get<0>() = i;
+		values.last().template get<1>() = i;
+
+		grid_ref.template insert<0>(key) = i;
+		grid_ref.template insert<1>(key) = i;
+	}
+
+	grid.template insertBatch<0,1>(keys,values);
+
+	BOOST_REQUIRE_EQUAL(grid.size(),grid_ref.size());
+
+	bool match = true;
+	auto it = grid_ref.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		match &= grid.existPoint(key);
+		match &= grid.template get<0>(key) == grid_ref.template get<0>(key);
+		match &= grid.template get<1>(key) == grid_ref.template get<1>(key);
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	grid.consistency();
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_morton_index_test )
+{
+	size_t sz[3] = {201,201,201};
+
+	typedef sgrid_soa<3,aggregate<double,double,int>,HeapMemory> sg_hash;
+	typedef sgrid_soa<3,aggregate<double,double,int>,HeapMemory,grid_zm<3,void>,
+			          typename memory_traits_inte<aggregate<double,double,int>>::type,memory_traits_inte,
+			          default_chunking<3>,sgrid_morton_index<3>> sg_morton;
+
+	sg_hash grid(sz);
+	sg_morton grid_m(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+	grid_m.getBackgroundValue().template get<0>() = 0.0;
+
+	// fill a spherical shell
+
+	grid_sm<3,void> g_sm(sz);
+	grid_key_dx_iterator<3> kit(g_sm);
+
+	while (kit.isNext())
+	{
+		auto key = kit.get();
+
+		double r = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r += (key.get(i) - 100.0)*(key.get(i) - 100.0);}
+
+		r = sqrt(r);
+
+		if (r >= 60.0 && r < 80.0)
+		{
+			double v = key.get(0)*key.get(0) + key.get(1)*key.get(1) + key.get(2)*key.get(2);
+
+			grid.template insert<0>(key) = v;
+			grid.template insert<1>(key) = 0;
+			grid_m.template insert<0>(key) = v;
+			grid_m.template insert<1>(key) = 0;
+		}
+
+		++kit;
+	}
+
+	BOOST_REQUIRE_EQUAL(grid.size(),grid_m.size());
+
+	// the neighborhood chunks must be the same
+
+	bool match = true;
+	for (size_t i = 1 ; i < grid_m.private_get_header_inf().size() ; i++)
+	{
+		bool exist_h;
+		bool exist_m;
+
+		grid_key_dx<3> pos = grid_m.getChunkPos(i);
+		size_t cid = grid.getChunk(pos,exist_h);
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{
+			for (int s = -1 ; s <= 1 ; s += 2)
+			{
+				size_t nn_h = grid.getChunkNN(cid,d,s,exist_h);
+				size_t nn_m = grid_m.getChunkNN(i,d,s,exist_m);
+
+				match &= (exist_h == exist_m);
+
+				if (exist_h == true && exist_m == true)
+				{match &= (grid.getChunkPos(nn_h) == grid_m.getChunkPos(nn_m));}
+			}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({199,199,199});
+
+	auto lap = []( Vc::double_v & cmd, cross_stencil_v<double> & s,
+            	   unsigned char * mask_sum){
+
+				Vc::double_v Lap = s.xm + s.xp +
+								   s.ym + s.yp +
+								   s.zm + s.zp - 6.0*cmd;
+
+				Vc::Mask<double> surround;
+
+				for (int i = 0 ; i < Vc::double_v::Size ; i++)
+				{surround[i] = (mask_sum[i] == 6);}
+
+				Lap = Vc::iif(surround,Lap,Vc::double_v(1.0));
+
+				return Lap;
+			};
+
+	grid.conv_cross<0,1,1>(start,stop,lap);
+	grid_m.conv_cross<0,1,1>(start,stop,lap);
+
+	auto it = grid.getIterator(start,stop);
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		match &= grid_m.existPoint(p);
+		match &= (grid.template get<1>(p) == grid_m.template get<1>(p));
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// remove half of the shell, the index is reconstructed
+
+	grid_key_dx<3> rm_start({0,0,0});
+	grid_key_dx<3> rm_stop({100,200,200});
+	Box<3,long int> bx(rm_start,rm_stop);
+
+	grid.remove(bx);
+	grid_m.remove(bx);
+
+	BOOST_REQUIRE_EQUAL(grid.size(),grid_m.size());
+
+	auto it2 = grid.getIterator();
+	while (it2.isNext())
+	{
+		auto p = it2.get();
+
+		match &= grid_m.existPoint(p);
+		match &= (grid.template get<0>(p) == grid_m.template get<0>(p));
+
+		++it2;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	grid_m.consistency();
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_morton_index_big_test )
+{
+	// 2^21 + 2 chunks along x, more than the 21 bits of the Morton key, the index use the linearized id
+
+	size_t sz[3] = {((size_t)1 << 24) + 16,16,16};
+
+	typedef sgrid_soa<3,aggregate<double>,HeapMemory> sg_hash;
+	typedef sgrid_soa<3,aggregate<double>,HeapMemory,grid_zm<3,void>,
+			          typename memory_traits_inte<aggregate<double>>::type,memory_traits_inte,
+			          default_chunking<3>,sgrid_morton_index<3>> sg_morton;
+
+	sg_hash grid(sz);
+	sg_morton grid_m(sz);
+
+	// two slabs of chunks, one at the beginning and one at the end of the grid
+
+	long int x_start[2] = {0,((long int)1 << 24) - 16};
+
+	for (size_t s = 0 ; s < 2 ; s++)
+	{
+		for (long int i = x_start[s] ; i < x_start[s] + 32 ; i++)
+		{
+			for (long int j = 0 ; j < 16 ; j++)
+			{
+				for (long int k = 0 ; k < 16 ; k++)
+				{
+					grid_key_dx<3> key({i,j,k});
+
+					grid.template insert<0>(key) = i + 100*j + 10000*k;
+					grid_m.template insert<0>(key) = i + 100*j + 10000*k;
+				}
+			}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(grid.size(),grid_m.size());
+
+	// points with x differing by 2^24 (2^21 chunks) have the same Morton key, they must not alias
+
+	bool match = true;
+
+	match &= grid_m.template get<0>(grid_key_dx<3>({3,5,7})) == 3 + 500 + 70000;
+	match &= grid_m.template get<0>(grid_key_dx<3>({((long int)1 << 24) + 3,5,7})) == ((long int)1 << 24) + 3 + 500 + 70000;
+
+	// the neighborhood chunks must be the same
+
+	for (size_t i = 1 ; i < grid_m.private_get_header_inf().size() ; i++)
+	{
+		bool exist_h;
+		bool exist_m;
+
+		grid_key_dx<3> pos = grid_m.getChunkPos(i);
+		size_t cid = grid.getChunk(pos,exist_h);
+
+		for (size_t d = 0 ; d < 3 ; d++)
+		{
+			for (int s = -1 ; s <= 1 ; s += 2)
+			{
+				size_t nn_h = grid.getChunkNN(cid,d,s,exist_h);
+				size_t nn_m = grid_m.getChunkNN(i,d,s,exist_m);
+
+				match &= (exist_h == exist_m);
+
+				if (exist_h == true && exist_m == true)
+				{match &= (grid.getChunkPos(nn_h) == grid_m.getChunkPos(nn_m));}
+			}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	auto it = grid.getIterator();
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		match &= grid_m.existPoint(p);
+		match &= (grid.template get<0>(p) == grid_m.template get<0>(p));
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	grid_m.consistency();
+}
+
+template<typename sgrid_type>
+void test_sparse_grid_checkpoint()
+{
+	size_t sz[3] = {171,171,171};
+
+	sgrid_type grid(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	// fill a spherical shell
+
+	grid_sm<3,void> g_sm(sz);
+	grid_key_dx_iterator<3> kit(g_sm);
+
+	while (kit.isNext())
+	{
+		auto key = kit.get();
+
+		double r = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r += (key.get(i) - 85.0)*(key.get(i) - 85.0);}
+		r = sqrt(r);
+
+		if (r > 60.0 && r < 70.0)
+		{
+			grid.template insert<0>(key) = key.get(0);
+			grid.template insert<1>(key) = key.get(1);
+			grid.template insert<2>(key) = key.get(2);
+		}
+
+		++kit;
+	}
+
+	BOOST_REQUIRE_EQUAL(checkpoint_save("test_checkpoint_sgrid",grid),true);
+
+	size_t sz2[3] = {10,10,10};
+	sgrid_type grid2(sz2);
+	grid2.template insert<0>(grid_key_dx<3>({1,1,1})) = 5.0;
+
+	BOOST_REQUIRE_EQUAL(checkpoint_load("test_checkpoint_sgrid",grid2),true);
+
+	BOOST_REQUIRE_EQUAL(grid.size(),grid2.size());
+	BOOST_REQUIRE_EQUAL(grid2.getGrid().size(0),sz[0]);
+
+	bool match = true;
+	auto it = grid.getIterator();
+	while (it.isNext())
+	{
+		auto p = it.get();
+
+		match &= grid2.existPoint(p);
+		match &= grid.template get<0>(p) == grid2.template get<0>(p);
+		match &= grid.template get<1>(p) == grid2.template get<1>(p);
+		match &= grid.template get<2>(p) == grid2.template get<2>(p);
+
+		++it;
+	}
+
+	match &= grid2.existPoint(grid_key_dx<3>({1,1,1})) == false;
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// the map of the chunks has been reconstructed, insert work
+
+	grid2.template insert<0>(grid_key_dx<3>({85,85,85})) = 7.0;
+	BOOST_REQUIRE_EQUAL(grid2.template get<0>(grid_key_dx<3>({85,85,85})),7.0);
+	BOOST_REQUIRE_EQUAL(grid2.size(),grid.size() + 1);
+
+	remove("test_checkpoint_sgrid");
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_checkpoint_test )
+{
+	test_sparse_grid_checkpoint<sgrid_cpu<3,aggregate<double,double,int>,HeapMemory>>();
+	test_sparse_grid_checkpoint<sgrid_soa<3,aggregate<double,double,int>,HeapMemory>>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
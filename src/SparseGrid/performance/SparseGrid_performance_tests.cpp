@@ -0,0 +1,325 @@
+/*
+ * SparseGrid_performance_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#define DISABLE_MPI_WRITTERS
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "config.h"
+#include "SparseGrid/SparseGrid.hpp"
+#include "timer.hpp"
+#include "util/stat/common_statistics.hpp"
+#include "util/SimpleRNG.hpp"
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+constexpr int N_STAT_SGRID = 8;
+
+/*! \brief Fill a spherical shell of the sparse grid
+ *
+ * \param grid sparse grid to fill
+ * \param r1 internal radius (in grid points)
+ * \param r2 external radius (in grid points)
+ *
+ */
+template<typename grid_type>
+static void fill_shell(grid_type & grid, double r1, double r2)
+{
+	size_t sz[3] = {grid.getGrid().size(0),grid.getGrid().size(1),grid.getGrid().size(2)};
+	grid_sm<3,void> g_sm(sz);
+	grid_key_dx_iterator<3> kit(g_sm);
+
+	double c[3] = {g_sm.size(0) / 2.0, g_sm.size(1) / 2.0, g_sm.size(2) / 2.0};
+
+	while (kit.isNext())
+	{
+		auto key = kit.get();
+
+		double r = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r += (key.get(i) - c[i])*(key.get(i) - c[i]);}
+
+		r = sqrt(r);
+
+		if (r >= r1 && r < r2)
+		{grid.template insert<0>(key) = 1.0;}
+
+		++kit;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( sparse_grid_performance )
+
+BOOST_AUTO_TEST_CASE( sparse_grid_concurrent_read_performance )
+{
+	size_t sz[3] = {256,256,256};
+
+	sgrid_cpu<3,aggregate<double>,HeapMemory> grid(sz);
+	grid.getBackgroundValue().template get<0>() = 0.0;
+
+	fill_shell(grid,64.0,100.0);
+
+	// list of the points to read
+
+	openfpm::vector<grid_key_dx<3>> keys;
+
+	auto it = grid.getIterator();
+	while (it.isNext())
+	{
+		keys.add(it.get());
+		++it;
+	}
+
+	int max_threads = 1;
+#ifdef HAVE_OPENMP
+	max_threads = omp_get_max_threads();
+#endif
+
+	double t_ref = 0.0;
+
+	for (int nt = 1 ; nt <= max_threads ; nt *= 2)
+	{
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(nt);
+#endif
+
+		std::vector<double> times;
+		double check = 0.0;
+
+		for (int s = 0 ; s < N_STAT_SGRID + 1 ; s++)
+		{
+			double sum = 0.0;
+
+			timer t;
+			t.start();
+
+			#pragma omp parallel reduction(+:sum)
+			{
+				auto acc = grid.getAccessor();
+
+				#pragma omp for
+				for (long int i = 0 ; i < (long int)keys.size() ; i++)
+				{
+					// 7 point stencil read
+
+					grid_key_dx<3> k = keys.get(i);
+
+					double v = -6.0*acc.template get<0>(k);
+
+					for (size_t d = 0 ; d < 3 ; d++)
+					{
+						v += acc.template get<0>(k.move(d,1));
+						v += acc.template get<0>(k.move(d,-1));
+					}
+
+					sum += v;
+				}
+			}
+
+			t.stop();
+
+			// the first is warm-up
+			if (s != 0)
+			{times.push_back(t.getwct());}
+
+			check = sum;
+		}
+
+		double mean;
+		double dev;
+		standard_deviation(times,mean,dev);
+
+		if (nt == 1)
+		{t_ref = mean;}
+
+		std::cout << "Sparse grid concurrent read " << keys.size() << " points, threads: " << nt
+				  << " time: " << mean << " +- " << dev << " s   speedup: " << t_ref / mean
+				  << "   (check: " << check << ")" << std::endl;
+	}
+
+#ifdef HAVE_OPENMP
+	omp_set_num_threads(max_threads);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_insert_batch_performance )
+{
+	size_t sz[3] = {256,256,256};
+
+	// random points inside a sphere
+
+	openfpm::vector<grid_key_dx<3>> keys;
+	openfpm::vector<aggregate<double>> values;
+
+	SimpleRNG rng;
+
+	while (keys.size() < 4000000)
+	{
+		grid_key_dx<3> key({(long int)(rng.GetUniform()*sz[0]),(long int)(rng.GetUniform()*sz[1]),(long int)(rng.GetUniform()*sz[2])});
+
+		double r = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r += (key.get(i) - sz[i]/2.0)*(key.get(i) - sz[i]/2.0);}
+
+		if (sqrt(r) > sz[0]/2.0)	{continue;}
+
+		keys.add(key);
+		values.add();
+		values.last().template get<0>() = keys.size();
+	}
+
+	std::vector<double> times_insert;
+	std::vector<double> times_batch;
+
+	for (int s = 0 ; s < N_STAT_SGRID + 1 ; s++)
+	{
+		sgrid_cpu<3,aggregate<double>,HeapMemory> grid(sz);
+		sgrid_cpu<3,aggregate<double>,HeapMemory> grid_batch(sz);
+
+		timer t;
+		t.start();
+
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{grid.template insert<0>(keys.get(i)) = values.template get<0>(i);}
+
+		t.stop();
+
+		timer t2;
+		t2.start();
+
+		grid_batch.template insertBatch<0>(keys,values);
+
+		t2.stop();
+
+		BOOST_REQUIRE_EQUAL(grid.size(),grid_batch.size());
+
+		// the first is warm-up
+		if (s != 0)
+		{
+			times_insert.push_back(t.getwct());
+			times_batch.push_back(t2.getwct());
+		}
+	}
+
+	double mean;
+	double dev;
+	double mean_batch;
+	double dev_batch;
+	standard_deviation(times_insert,mean,dev);
+	standard_deviation(times_batch,mean_batch,dev_batch);
+
+	std::cout << "Sparse grid insert " << keys.size() << " points: " << mean << " +- " << dev << " s   insertBatch: "
+			  << mean_batch << " +- " << dev_batch << " s   speedup: " << mean / mean_batch << std::endl;
+}
+
+/*! \brief Measure the time of conv_cross and of random reads on a sparse grid
+ *
+ * \param grid sparse grid (filled)
+ * \param keys points to read
+ * \param t_conv time of conv_cross
+ * \param t_read time of the reads
+ * \param check sum of the values read
+ *
+ */
+template<typename grid_type>
+static void chunk_index_timing(grid_type & grid, openfpm::vector<grid_key_dx<3>> & keys, double & t_conv, double & t_read, double & check)
+{
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({(long int)grid.getGrid().size(0)-2,(long int)grid.getGrid().size(1)-2,(long int)grid.getGrid().size(2)-2});
+
+	std::vector<double> times_conv;
+	std::vector<double> times_read;
+
+	for (int s = 0 ; s < N_STAT_SGRID + 1 ; s++)
+	{
+		timer t;
+		t.start();
+
+		grid.template conv_cross<0,1,1>(start,stop,[]( Vc::double_v & cmd, cross_stencil_v<double> & s,
+				                                       unsigned char * mask_sum){
+
+																Vc::double_v Lap = s.xm + s.xp +
+																				   s.ym + s.yp +
+																				   s.zm + s.zp - 6.0*cmd;
+
+																return Lap;
+															});
+
+		t.stop();
+
+		timer t2;
+		t2.start();
+
+		double sum = 0.0;
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{sum += grid.template get<0>(keys.get(i));}
+
+		t2.stop();
+
+		// the first is warm-up
+		if (s != 0)
+		{
+			times_conv.push_back(t.getwct());
+			times_read.push_back(t2.getwct());
+		}
+
+		check = sum;
+	}
+
+	double dev;
+	standard_deviation(times_conv,t_conv,dev);
+	standard_deviation(times_read,t_read,dev);
+}
+
+BOOST_AUTO_TEST_CASE( sparse_grid_chunk_index_performance )
+{
+	size_t sz[3] = {384,384,384};
+
+	typedef sgrid_soa<3,aggregate<double,double>,HeapMemory> sg_hash;
+	typedef sgrid_soa<3,aggregate<double,double>,HeapMemory,grid_zm<3,void>,
+			          typename memory_traits_inte<aggregate<double,double>>::type,memory_traits_inte,
+			          default_chunking<3>,sgrid_morton_index<3>> sg_morton;
+
+	sg_hash grid(sz);
+	sg_morton grid_m(sz);
+
+	grid.getBackgroundValue().template get<0>() = 0.0;
+	grid_m.getBackgroundValue().template get<0>() = 0.0;
+
+	fill_shell(grid,96.0,150.0);
+	fill_shell(grid_m,96.0,150.0);
+
+	// random reads, existing and not existing points
+
+	openfpm::vector<grid_key_dx<3>> keys;
+
+	SimpleRNG rng;
+
+	for (size_t i = 0 ; i < 4000000 ; i++)
+	{
+		grid_key_dx<3> key({(long int)(rng.GetUniform()*sz[0]),(long int)(rng.GetUniform()*sz[1]),(long int)(rng.GetUniform()*sz[2])});
+		keys.add(key);
+	}
+
+	double t_conv;
+	double t_read;
+	double t_conv_m;
+	double t_read_m;
+	double check;
+	double check_m;
+
+	chunk_index_timing(grid,keys,t_conv,t_read,check);
+	chunk_index_timing(grid_m,keys,t_conv_m,t_read_m,check_m);
+
+	BOOST_REQUIRE_EQUAL(check,check_m);
+
+	std::cout << "Sparse grid chunk index " << grid.size() << " points, conv_cross hash: " << t_conv << " s  morton: " << t_conv_m
+			  << " s   random read hash: " << t_read << " s  morton: " << t_read_m << " s" << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
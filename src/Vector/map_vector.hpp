@@ -21,6 +21,8 @@
 #include "util/Pack_stat.hpp"
 #include "Grid/map_grid.hpp"
 #include "memory/HeapMemory.hpp"
+#include "memory_ly/PoolMemory.hpp"
+#include "memory_ly/NumaMemory.hpp"
 #include "vect_isel.hpp"
 #include "util/object_s_di.hpp"
 #include "util.hpp"
@@ -32,6 +34,9 @@
 #include <fstream>
 #include "Packer_Unpacker/Packer_util.hpp"
 #include "Packer_Unpacker/has_pack_agg.hpp"
+#include "Packer_Unpacker/Pack_segments.hpp"
+#include "Packer_Unpacker/Checkpoint.hpp"
+#include "util/stat/container_stats.hpp"
 #include "timer.hpp"
 #include "map_vector_std_util.hpp"
 #include "data_type/aggregate.hpp"
@@ -39,6 +44,8 @@
 #include "util/cuda_util.hpp"
 #include "cuda/map_vector_cuda_ker.cuh"
 #include "map_vector_printers.hpp"
+#include "map_vector_compact.hpp"
+#include "util/openmp_util.hpp"
 
 namespace openfpm
 {
@@ -263,6 +270,160 @@ namespace openfpm
 			{sz[0] = arg;}
 		}
 
+		/*! \brief Move n elements from src to dst (dst < src) element by element
+		 *
+		 * Used when the properties cannot be moved with memmove
+		 *
+		 * \param dst destination element
+		 * \param src source element
+		 * \param n number of elements
+		 *
+		 */
+		template<typename is_inte>
+		void move_elements_impl(size_t dst, size_t src, size_t n, std::false_type, is_inte)
+		{
+			for (size_t i = 0 ; i < n ; i++)
+			{set(dst+i,get(src+i));}
+		}
+
+		/*! \brief Move n elements from src to dst with memmove (memory_traits_lin)
+		 *
+		 * \param dst destination element
+		 * \param src source element
+		 * \param n number of elements
+		 *
+		 */
+		void move_elements_impl(size_t dst, size_t src, size_t n, std::true_type, std::false_type)
+		{
+			char * ptr = (char *)getPointer();
+			memmove(ptr + dst*sizeof(T),ptr + src*sizeof(T),n*sizeof(T));
+		}
+
+		/*! \brief Move n elements from src to dst with memmove, one memmove for each property component (memory_traits_inte)
+		 *
+		 * \param dst destination element
+		 * \param src source element
+		 * \param n number of elements
+		 *
+		 */
+		void move_elements_impl(size_t dst, size_t src, size_t n, std::true_type, std::true_type)
+		{
+			vector_compact_move_prp<self_type> mv(*this,dst,src,n);
+
+			boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(mv);
+		}
+
+		/*! \brief Move n elements from src to dst, the two ranges can overlap if dst < src
+		 *
+		 * \param dst destination element
+		 * \param src source element
+		 * \param n number of elements
+		 *
+		 */
+		void move_elements(size_t dst, size_t src, size_t n)
+		{
+			move_elements_impl(dst,src,n,
+							   std::integral_constant<bool,prp_trivially_copyable<typename T::type>::value>(),
+							   typename is_layout_inte<layout_base<T>>::type());
+		}
+
+		/*! \brief Compact the vector from the element first, keeping the elements produced by runs
+		 *
+		 * The range [first,size()) is split in contiguous blocks. In parallel each block move its runs of
+		 * kept elements at the beginning of the block, the number of kept elements of each block is scanned
+		 * to get the destination of the block, and the compacted blocks are moved in order. The moves
+		 * use memmove when the properties are trivially copyable, otherwise the elements are copied one by one
+		 * by a single thread
+		 *
+		 * \param first first element that can be removed
+		 * \param runs functor runs(start,stop,f) that call f(a,b) for each run [a,b) of kept elements
+		 *        inside [start,stop), in increasing order
+		 *
+		 * \return the number of elements kept
+		 *
+		 */
+		template<typename runs_type>
+		size_t remove_compact(size_t first, runs_type runs)
+		{
+			if (first >= size())
+			{return size();}
+
+			size_t n = size() - first;
+			int nth = (prp_trivially_copyable<typename T::type>::value == false || n < 16384)?1:openfpm::omp::get_max_threads();
+
+			std::vector<size_t> start(nth);
+			std::vector<size_t> stop(nth);
+			std::vector<size_t> cnt(nth);
+
+			for (int b = 0 ; b < nth ; b++)
+			{
+				openfpm::omp::thread_range(n,nth,b,start[b],stop[b]);
+				start[b] += first;
+				stop[b] += first;
+			}
+
+			#pragma omp parallel for num_threads(nth) schedule(static,1)
+			for (int b = 0 ; b < nth ; b++)
+			{
+				size_t w = start[b];
+
+				runs(start[b],stop[b],[&](size_t a, size_t c)
+				{
+					if (w != a)	{move_elements(w,a,c-a);}
+					w += c - a;
+				});
+
+				cnt[b] = w - start[b];
+			}
+
+			size_t d = first;
+
+			for (int b = 0 ; b < nth ; b++)
+			{
+				if (d != start[b] && cnt[b] != 0)	{move_elements(d,start[b],cnt[b]);}
+				d += cnt[b];
+			}
+
+			return d;
+		}
+
+		/*! \brief Compact the vector removing a sorted list of keys
+		 *
+		 * \param key functor that return the key i
+		 * \param start first key
+		 * \param nk number of keys
+		 *
+		 */
+		template<typename key_type>
+		void remove_sorted(key_type key, size_t start, size_t nk)
+		{
+			remove_compact(key(start),[&](size_t s, size_t e, auto f)
+			{
+				// first key inside the block
+				size_t lo = start;
+				size_t hi = nk;
+				while (lo < hi)
+				{
+					size_t mid = (lo + hi) / 2;
+					if (key(mid) < s)	{lo = mid + 1;}
+					else				{hi = mid;}
+				}
+
+				size_t a = s;
+				for (size_t k = lo ; k < nk && key(k) < e ; k++)
+				{
+					if (key(k) > a)	{f(a,key(k));}
+					a = key(k) + 1;
+				}
+
+				if (a < e)	{f(a,e);}
+			});
+
+			// re-calculate the vector size
+
+			v_size -= nk - start;
+		}
+
 #ifdef SE_CLASS1
 
 		/*! \brief Check that id is not bigger than the vector size
@@ -366,7 +527,10 @@ namespace openfpm
 			{
 				//! Resize the memory
 				size_t sz[1] = {sp};
+				CONTAINER_STAT_MUTE_GRID;
 				base.resize(sz);
+				CONTAINER_STAT_INC(CSTAT_VECTOR_GROW);
+				CONTAINER_STAT_ADD(CSTAT_VECTOR_BYTES,sz[0]*sizeof(T));
 			}
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
@@ -394,6 +558,7 @@ namespace openfpm
 		void shrink_to_fit()
 		{
 			size_t sz[1] = {size()};
+			CONTAINER_STAT_MUTE_GRID;
 			base.resize(sz);
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
@@ -432,7 +597,10 @@ namespace openfpm
 				//! Resize the memory
 				size_t sz[1] = {gr};
 
+				CONTAINER_STAT_MUTE_GRID;
 				base.resize(sz,opt,blockSize);
+				CONTAINER_STAT_INC(CSTAT_VECTOR_GROW);
+				CONTAINER_STAT_ADD(CSTAT_VECTOR_BYTES,sz[0]*sizeof(T));
 			}
 
 			// update the vector size
@@ -464,7 +632,10 @@ namespace openfpm
 
 				//! Resize the memory
 				size_t sz[1] = {gr};
+				CONTAINER_STAT_MUTE_GRID;
 				base.resize_no_device(sz);
+				CONTAINER_STAT_INC(CSTAT_VECTOR_GROW);
+				CONTAINER_STAT_ADD(CSTAT_VECTOR_BYTES,sz[0]*sizeof(T));
 			}
 
 			// update the vector size
@@ -495,7 +666,10 @@ namespace openfpm
 				//! Resize the memory, double up the actual memory allocated for the vector
 				size_t sz[1];
 				non_zero_one(sz,2*base.size());
+				CONTAINER_STAT_MUTE_GRID;
 				base.resize(sz);
+				CONTAINER_STAT_INC(CSTAT_VECTOR_GROW);
+				CONTAINER_STAT_ADD(CSTAT_VECTOR_BYTES,sz[0]*sizeof(T));
 			}
 
 			//! increase the vector size
@@ -523,7 +697,10 @@ namespace openfpm
 				//! Resize the memory, double up the actual memory allocated for the vector
 				size_t sz[1];
 				non_zero_one(sz,2*base.size());
+				CONTAINER_STAT_MUTE_GRID;
 				base.resize_no_device(sz);
+				CONTAINER_STAT_INC(CSTAT_VECTOR_GROW);
+				CONTAINER_STAT_ADD(CSTAT_VECTOR_BYTES,sz[0]*sizeof(T));
 			}
 
 			//! increase the vector size
@@ -553,7 +730,10 @@ namespace openfpm
 				//! Resize the memory, double up the actual memory allocated for the vector
 				size_t sz[1];
 				non_zero_one(sz,2*base.size());
+				CONTAINER_STAT_MUTE_GRID;
 				base.resize(sz);
+				CONTAINER_STAT_INC(CSTAT_VECTOR_GROW);
+				CONTAINER_STAT_ADD(CSTAT_VECTOR_BYTES,sz[0]*sizeof(T));
 			}
 
 			//! copy the element
@@ -587,7 +767,10 @@ namespace openfpm
 				//! Resize the memory, double up the actual memory allocated for the vector
 				size_t sz[1];
 				non_zero_one(sz,2*base.size());
+				CONTAINER_STAT_MUTE_GRID;
 				base.resize(sz);
+				CONTAINER_STAT_INC(CSTAT_VECTOR_GROW);
+				CONTAINER_STAT_ADD(CSTAT_VECTOR_BYTES,sz[0]*sizeof(T));
 			}
 
 			//! copy the added element
@@ -1138,16 +1321,8 @@ namespace openfpm
 		 */
 		void remove(size_t key)
 		{
-			size_t d_k = key;
-			size_t s_k = key + 1;
-
-			// keys
-			while (s_k < size())
-			{
-				set(d_k,get(s_k));
-				d_k++;
-				s_k++;
-			}
+			if (key + 1 < size())
+			{move_elements(key,key+1,size()-key-1);}
 
 			// re-calculate the vector size
 
@@ -1158,6 +1333,9 @@ namespace openfpm
 		 *
 		 * \warning the keys in the vector MUST be sorted
 		 *
+		 * The runs of elements between the keys are moved in parallel with memmove when the properties are
+		 * trivially copyable (see remove_if)
+		 *
 		 * \param keys objects id to remove
 		 * \param start key starting point
 		 *
@@ -1168,32 +1346,7 @@ namespace openfpm
 			if (keys.size() <= start )
 				return;
 
-			size_t a_key = start;
-			size_t d_k = keys.get(a_key);
-			size_t s_k = keys.get(a_key) + 1;
-
-			// keys
-			while (s_k < size())
-			{
-				// s_k should always point to a key that is not going to be deleted
-				while (a_key+1 < keys.size() && s_k == keys.get(a_key+1))
-				{
-					a_key++;
-					s_k = keys.get(a_key) + 1;
-				}
-
-				// In case of overflow
-				if (s_k >= size())
-					break;
-
-				set(d_k,get(s_k));
-				d_k++;
-				s_k++;
-			}
-
-			// re-calculate the vector size
-
-			v_size -= keys.size() - start;
+			remove_sorted([&](size_t i) -> size_t {return keys.get(i);},start,keys.size());
 		}
 
 		/*! \brief Remove several entries from the vector
@@ -1210,32 +1363,59 @@ namespace openfpm
 			if (keys.size() <= start )
 				return;
 
-			size_t a_key = start;
-			size_t d_k = keys.template get<0>(a_key);
-			size_t s_k = keys.template get<0>(a_key) + 1;
+			remove_sorted([&](size_t i) -> size_t {return keys.template get<0>(i);},start,keys.size());
+		}
 
-			// keys
-			while (s_k < size())
+		/*! \brief Remove all the elements for which the predicate return true, keeping the order of the others
+		 *
+		 * The vector is compacted in parallel: each thread compact a contiguous block moving the runs of kept
+		 * elements with memmove (one memmove for each property component with memory_traits_inte), the
+		 * blocks are then moved at their final position. With properties that are not trivially copyable
+		 * the compaction is done by one thread copying the elements one by one
+		 *
+		 * \warning the predicate is called in parallel, and pred(i) must only read the element i
+		 *
+		 * \code
+		 *
+		 * // remove the particles with negative weight
+		 * v.remove_if([&](size_t i){return v.template get<0>(i) < 0.0;});
+		 *
+		 * \endcode
+		 *
+		 * \param pred predicate pred(i), true if the element i must be removed
+		 *
+		 */
+		template<typename pred_type>
+		void remove_if(pred_type pred)
+		{
+			v_size = remove_compact(0,[&](size_t s, size_t e, auto f)
 			{
-				// s_k should always point to a key that is not going to be deleted
-				while (a_key+1 < keys.size() && s_k == keys.template get<0>(a_key+1))
+				size_t i = s;
+
+				while (i < e)
 				{
-					a_key++;
-					s_k = keys.template get<0>(a_key) + 1;
-				}
+					while (i < e && pred(i) == true)	{i++;}
 
-				// In case of overflow
-				if (s_k >= size())
-					break;
+					size_t a = i;
 
-				set(d_k,get(s_k));
-				d_k++;
-				s_k++;
-			}
+					while (i < e && pred(i) == false)	{i++;}
 
-			// re-calculate the vector size
+					if (a < i)	{f(a,i);}
+				}
+			});
+		}
 
-			v_size -= keys.size() - start;
+		/*! \brief Remove all the elements with a mask different from zero, keeping the order of the others
+		 *
+		 * \tparam prp property of the mask vector that contain the mask
+		 *
+		 * \param mask mask vector (at least as big as this vector)
+		 *
+		 */
+		template<unsigned int prp = 0, typename vector_mask_type>
+		void remove_mask(vector_mask_type & mask)
+		{
+			remove_if([&](size_t i){return mask.template get<prp>(i) != 0;});
 		}
 
 		/*! \brief Get an element of the vector
@@ -1479,6 +1659,7 @@ namespace openfpm
 			vector<T, Memory,layout_base,grow_p,OPENFPM_NATIVE> dup;
 
 			dup.v_size = v_size;
+			CONTAINER_STAT_MUTE_GRID;
 			dup.base.swap(base.duplicate());
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
@@ -1517,6 +1698,7 @@ namespace openfpm
 		vector(const vector<T, Memory,layout_base,grow_p,OPENFPM_NATIVE> & v) THROW
 		:v_size(0)
 		{
+			CONTAINER_STAT_MUTE_GRID;
 			swap(v.duplicate());
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
@@ -1530,6 +1712,7 @@ namespace openfpm
 		vector() THROW
 		:v_size(0),base(0)
 		{
+			CONTAINER_STAT_MUTE_GRID;
 			base.setMemory();
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
@@ -1543,6 +1726,7 @@ namespace openfpm
 		vector(size_t sz) THROW
 		:v_size(sz),base(sz)
 		{
+			CONTAINER_STAT_MUTE_GRID;
 			base.setMemory();
 
 #if defined(CUDIFY_USE_SEQUENTIAL) || defined(CUDIFY_USE_OPENMP)
@@ -1662,6 +1846,7 @@ namespace openfpm
 			v_size = mv.v_size;
 			size_t rsz[1] = {v_size};
 			if(rsz[0]>base.size()) {
+                CONTAINER_STAT_MUTE_GRID;
                 base.resize(rsz);
             }
 			// copy the object on cpu
@@ -1718,6 +1903,7 @@ namespace openfpm
 		{
 			v_size = mv.getInternal_v_size();
 			size_t rsz[1] = {v_size};
+			CONTAINER_STAT_MUTE_GRID;
 			base.resize(rsz);
 
 			// copy the object
@@ -1779,6 +1965,7 @@ namespace openfpm
 		{
 			v_size = mv.getInternal_v_size();
 			size_t rsz[1] = {v_size};
+			CONTAINER_STAT_MUTE_GRID;
 			base.resize(rsz);
 
 			// copy the object
@@ -0,0 +1,63 @@
+/*
+ * map_vector_compact.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef MAP_VECTOR_COMPACT_HPP_
+#define MAP_VECTOR_COMPACT_HPP_
+
+#include <string.h>
+#include <type_traits>
+#include "util/prp_trivially_copyable.hpp"
+#include <boost/mpl/at.hpp>
+
+/*! \brief Move n consecutive elements of each property of a vector with memory_traits_inte
+ *
+ * The components of an array property are stored with a stride equal to the capacity of the vector
+ *
+ * \tparam vector_type vector
+ *
+ */
+template<typename vector_type>
+struct vector_compact_move_prp
+{
+	//! vector
+	vector_type & v;
+
+	//! destination element
+	size_t dst;
+
+	//! source element
+	size_t src;
+
+	//! number of elements
+	size_t n;
+
+	//! constructor
+	inline vector_compact_move_prp(vector_type & v, size_t dst, size_t src, size_t n)
+	:v(v),dst(dst),src(src),n(n)
+	{};
+
+	//! Move the elements of the property
+	template<typename prp_type>
+	inline void operator()(prp_type & t)
+	{
+		typedef typename boost::mpl::at<typename vector_type::value_type::type,prp_type>::type ele_type;
+		typedef typename std::remove_all_extents<ele_type>::type scalar_type;
+
+		size_t n_comp = sizeof(ele_type) / sizeof(scalar_type);
+		size_t cap = v.capacity();
+		char * base = (char *)v.template getPointer<prp_type::value>();
+
+		for (size_t c = 0 ; c < n_comp ; c++)
+		{
+			memmove(base + (c*cap + dst)*sizeof(scalar_type),
+					base + (c*cap + src)*sizeof(scalar_type),
+					n*sizeof(scalar_type));
+		}
+	}
+};
+
+#endif /* MAP_VECTOR_COMPACT_HPP_ */
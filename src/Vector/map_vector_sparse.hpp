@@ -12,8 +12,10 @@
 #include "Vector/cuda/map_vector_sparse_cuda_ker.cuh"
 #include "Vector/cuda/map_vector_sparse_cuda_kernels.cuh"
 #include "util/ofp_context.hpp"
+#include "util/openmp_util.hpp"
 #include <iostream>
 #include <limits>
+#include <type_traits>
 
 #if defined(__NVCC__)
  #include "util/cuda/kernels.cuh"
@@ -327,31 +329,28 @@ namespace openfpm
 	template<typename reduction_type, typename vector_reduction, typename T,unsigned int impl, typename red_type>
 	struct sparse_vector_reduction_cpu_impl
 	{
-		template<typename vector_data_type, typename vector_index_type,typename vector_index_type_reo>
-		static inline void red(size_t & i, vector_data_type & vector_data_red,
-				   vector_data_type & vector_data,
-				   vector_index_type & vector_index,
-				   vector_index_type_reo & reorder_add_index_cpu)
+		/*! \brief Reduce the segment [start,stop) of vector_data into the element s of vector_data_red
+		 *
+		 * \param s output element
+		 * \param start first element of the segment
+		 * \param stop one past the last element of the segment
+		 * \param vector_data_red reduced data
+		 * \param vector_data data sorted by index
+		 *
+		 */
+		template<typename vector_data_type>
+		static inline void red(size_t s, size_t start, size_t stop,
+				   vector_data_type & vector_data_red,
+				   vector_data_type & vector_data)
 		{
-			size_t start = reorder_add_index_cpu.get(i).id;
-			red_type red = vector_data.template get<reduction_type::prop::value>(i);
+			red_type red = vector_data.template get<reduction_type::prop::value>(start);
 
-			size_t j = 1;
-			for ( ; i+j < reorder_add_index_cpu.size() && reorder_add_index_cpu.get(i+j).id == start ; j++)
+			for (size_t j = start + 1 ; j < stop ; j++)
 			{
-				cpu_block_process<reduction_type,impl>::process(vector_data.template get<reduction_type::prop::value>(i+j),red);
-				//reduction_type::red(red,vector_data.template get<reduction_type::prop::value>(i+j));
+				cpu_block_process<reduction_type,impl>::process(vector_data.template get<reduction_type::prop::value>(j),red);
 			}
-			vector_data_red.add();
-			vector_data_red.template get<reduction_type::prop::value>(vector_data_red.size()-1) = red;
 
-			if (T::value == 0)
-			{
-				vector_index.add();
-				vector_index.template get<0>(vector_index.size() - 1) = reorder_add_index_cpu.get(i).id;
-			}
-
-			i += j;
+			vector_data_red.template get<reduction_type::prop::value>(s) = red;
 		}
 	};
 
@@ -359,58 +358,53 @@ namespace openfpm
 	template<typename reduction_type, typename vector_reduction, typename T,unsigned int impl, typename red_type, unsigned int N1>
 	struct sparse_vector_reduction_cpu_impl<reduction_type,vector_reduction,T,impl,red_type[N1]>
 	{
-		template<typename vector_data_type, typename vector_index_type,typename vector_index_type_reo>
-		static inline void red(size_t & i, vector_data_type & vector_data_red,
-				   vector_data_type & vector_data,
-				   vector_index_type & vector_index,
-				   vector_index_type_reo & reorder_add_index_cpu)
+		/*! \brief Reduce the segment [start,stop) of vector_data into the element s of vector_data_red
+		 *
+		 * \param s output element
+		 * \param start first element of the segment
+		 * \param stop one past the last element of the segment
+		 * \param vector_data_red reduced data
+		 * \param vector_data data sorted by index
+		 *
+		 */
+		template<typename vector_data_type>
+		static inline void red(size_t s, size_t start, size_t stop,
+				   vector_data_type & vector_data_red,
+				   vector_data_type & vector_data)
 		{
-			size_t start = reorder_add_index_cpu.get(i).id;
 			red_type red[N1];
 
 			for (size_t k = 0 ; k < N1 ; k++)
 			{
-				red[k] = vector_data.template get<reduction_type::prop::value>(i)[k];
+				red[k] = vector_data.template get<reduction_type::prop::value>(start)[k];
 			}
 
-			size_t j = 1;
-			for ( ; i+j < reorder_add_index_cpu.size() && reorder_add_index_cpu.get(i+j).id == start ; j++)
+			for (size_t j = start + 1 ; j < stop ; j++)
 			{
-				auto ev = vector_data.template get<reduction_type::prop::value>(i+j);
+				auto ev = vector_data.template get<reduction_type::prop::value>(j);
 				cpu_block_process<reduction_type,impl+1>::process(ev,red);
-				//reduction_type::red(red,vector_data.template get<reduction_type::prop::value>(i+j));
 			}
 
-			vector_data_red.add();
-
 			for (size_t k = 0 ; k < N1 ; k++)
 			{
-				vector_data_red.template get<reduction_type::prop::value>(vector_data_red.size()-1)[k] = red[k];
-			}
-
-			if (T::value == 0)
-			{
-				vector_index.add();
-				vector_index.template get<0>(vector_index.size() - 1) = reorder_add_index_cpu.get(i).id;
+				vector_data_red.template get<reduction_type::prop::value>(s)[k] = red[k];
 			}
-
-			i += j;
 		}
 	};
 
 	/*! \brief this class is a functor for "for_each" algorithm
 	 *
-	 * This class is a functor for "for_each" algorithm. For each
-	 * element of the boost::vector the operator() is called.
-	 * Is mainly used to copy one encap into another encap object
+	 * For each reduction it reduce in parallel the segments of elements with the same index,
+	 * the segment s is reduced into the element s of vector_data_red (that must be already resized)
 	 *
-	 * \tparam encap source
-	 * \tparam encap dst
+	 * \tparam vector_data_type data vector
+	 * \tparam vector_seg_type vector with the start of the segments
+	 * \tparam vector_reduction reductions
+	 * \tparam impl implementation
 	 *
 	 */
 	template<typename vector_data_type,
-			typename vector_index_type,
-	        typename vector_index_type_reo,
+	        typename vector_seg_type,
 	        typename vector_reduction,
 	        unsigned int impl>
 	struct sparse_vector_reduction_cpu
@@ -421,23 +415,20 @@ namespace openfpm
 		//! Vector in which to the reduction
 		vector_data_type & vector_data;
 
-		//! reorder vector index
-		vector_index_type_reo & reorder_add_index_cpu;
-
-		//! Index type vector
-		vector_index_type & vector_index;
+		//! start of the segments (the last element is the end of the last segment)
+		vector_seg_type & seg_start;
 
 		/*! \brief constructor
 		 *
-		 * \param src source encapsulated object
-		 * \param dst source encapsulated object
+		 * \param vector_data_red reduced data
+		 * \param vector_data data sorted by index
+		 * \param seg_start start of the segments
 		 *
 		 */
 		inline sparse_vector_reduction_cpu(vector_data_type & vector_data_red,
 									   vector_data_type & vector_data,
-									   vector_index_type & vector_index,
-									   vector_index_type_reo & reorder_add_index_cpu)
-		:vector_data_red(vector_data_red),vector_data(vector_data),vector_index(vector_index),reorder_add_index_cpu(reorder_add_index_cpu)
+									   vector_seg_type & seg_start)
+		:vector_data_red(vector_data_red),vector_data(vector_data),seg_start(seg_start)
 		{};
 
 		//! It call the copy function for each property
@@ -449,29 +440,16 @@ namespace openfpm
 
             if (reduction_type::is_special() == false)
 			{
-    			for (size_t i = 0 ; i < reorder_add_index_cpu.size() ; )
+            	size_t n_seg = seg_start.size() - 1;
+
+				#pragma omp parallel for schedule(static)
+    			for (size_t s = 0 ; s < n_seg ; s++)
     			{
-    				sparse_vector_reduction_cpu_impl<reduction_type,vector_reduction,T,impl,red_type>::red(i,vector_data_red,vector_data,vector_index,reorder_add_index_cpu);
-
-/*    				size_t start = reorder_add_index_cpu.get(i).id;
-    				red_type red = vector_data.template get<reduction_type::prop::value>(i);
-
-    				size_t j = 1;
-    				for ( ; i+j < reorder_add_index_cpu.size() && reorder_add_index_cpu.get(i+j).id == start ; j++)
-    				{
-    					cpu_block_process<reduction_type,impl>::process(vector_data.template get<reduction_type::prop::value>(i+j),red);
-    					//reduction_type::red(red,vector_data.template get<reduction_type::prop::value>(i+j));
-    				}
-    				vector_data_red.add();
-    				vector_data_red.template get<reduction_type::prop::value>(vector_data_red.size()-1) = red;
-
-    				if (T::value == 0)
-    				{
-    					vector_index.add();
-    					vector_index.template get<0>(vector_index.size() - 1) = reorder_add_index_cpu.get(i).id;
-    				}
-
-    				i += j;*/
+    				sparse_vector_reduction_cpu_impl<reduction_type,vector_reduction,T,impl,red_type>::red(s,
+    						seg_start.template get<0>(s),
+    						seg_start.template get<0>(s+1),
+    						vector_data_red,
+    						vector_data);
     			}
 			}
 		}
@@ -1372,105 +1350,261 @@ namespace openfpm
 			flush_on_gpu_insert<v_reduce ... >(vct_add_index_cont_0,vct_add_index_cont_1,vct_add_data_reord,gpuContext);
 		}
 
+		/*! \brief Find the split of the merge of the sorted indexes a and b at the diagonal d
+		 *
+		 * In the merge the elements of a come before the equal elements of b. If the split
+		 * separate two equal indexes the one of b is moved in the first part, so that the
+		 * conflict is solved by one part only
+		 *
+		 * \param a first sorted index vector
+		 * \param na size of a
+		 * \param b second sorted index vector
+		 * \param nb size of b
+		 * \param d diagonal (number of merged elements before the split)
+		 * \param ia number of elements of a before the split
+		 * \param ib number of elements of b before the split
+		 *
+		 */
+		template<typename vector_index_a, typename vector_index_b>
+		static void merge_path_split(vector_index_a & a, size_t na, vector_index_b & b, size_t nb, size_t d, size_t & ia, size_t & ib)
+		{
+			size_t lo = (d > nb)?d - nb:0;
+			size_t hi = (d < na)?d:na;
+
+			while (lo < hi)
+			{
+				size_t mid = (lo + hi) / 2;
+
+				if (a.template get<0>(mid) <= b.template get<0>(d - mid - 1))
+				{lo = mid + 1;}
+				else
+				{hi = mid;}
+			}
+
+			ia = lo;
+			ib = d - lo;
+
+			if (ia > 0 && ib < nb && a.template get<0>(ia-1) == b.template get<0>(ib))
+			{ib++;}
+		}
+
+		/*! \brief Merge the added elements on CPU
+		 *
+		 * The insert buffer is sorted in parallel (equal indexes keep the insertion order), the
+		 * segments of equal indexes are reduced in parallel, and the reduced elements are merged with
+		 * the old ones with a merge path: the merge is split in contiguous parts, every thread count
+		 * the output of its part and, after a scan, write it in the preallocated output
+		 *
+		 */
 		template<typename ... v_reduce>
 		void flush_on_cpu()
 		{
 			if (vct_add_index.size() == 0)
 			{return;}
 
+			size_t n_add = vct_add_index.size();
+
 			// First copy the added index to reorder
-			reorder_add_index_cpu.resize(vct_add_index.size());
-			vct_add_data_cont.resize(vct_add_index.size());
+			reorder_add_index_cpu.resize(n_add);
+			vct_add_data_cont.resize(n_add);
+
+			Ti id_min = std::numeric_limits<Ti>::max();
+			Ti id_max = std::numeric_limits<Ti>::lowest();
 
-			for (size_t i = 0 ; i < reorder_add_index_cpu.size() ; i++)
+			#pragma omp parallel for schedule(static) reduction(min:id_min) reduction(max:id_max)
+			for (size_t i = 0 ; i < n_add ; i++)
 			{
-				reorder_add_index_cpu.get(i).id = vct_add_index.template get<0>(i);
+				Ti id = vct_add_index.template get<0>(i);
+
+				reorder_add_index_cpu.get(i).id = id;
 				reorder_add_index_cpu.get(i).id2 = i;
+
+				id_min = (id < id_min)?id:id_min;
+				id_max = (id > id_max)?id:id_max;
 			}
 
-			reorder_add_index_cpu.sort();
+			// the sort is stable, so equal indexes are reduced in insertion order. The key is the
+			// offset from the minimum index, valid also for negative indexes and with fewer passes.
+			// The difference is computed on the unsigned type, that wraps instead of overflowing
+
+			typedef std::make_unsigned_t<Ti> uTi;
+
+			pool_tmp<openfpm::vector<reorder<Ti>>> reorder_tmp_p;
+			auto & reorder_tmp = reorder_tmp_p.get();
+			reorder_tmp.resize(n_add);
+
+			openfpm::omp::radix_sort(&reorder_add_index_cpu.get(0),&reorder_tmp.get(0),n_add,
+									 [id_min](const reorder<Ti> & a){return (size_t)((uTi)a.id - (uTi)id_min);},
+									 (size_t)((uTi)id_max - (uTi)id_min));
 
 			// Copy the data
-			for (size_t i = 0 ; i < reorder_add_index_cpu.size() ; i++)
+			#pragma omp parallel for schedule(static)
+			for (size_t i = 0 ; i < n_add ; i++)
 			{
 				vct_add_data_cont.get(i) = vct_add_data.get(reorder_add_index_cpu.get(i).id2);
 			}
 
+			// Find the segments of equal indexes
+
+			pool_tmp<openfpm::vector<aggregate<size_t>>> seg_flag_p;
+			pool_tmp<openfpm::vector<aggregate<size_t>>> seg_start_p;
+			auto & seg_flag = seg_flag_p.get();
+			auto & seg_start = seg_start_p.get();
+
+			seg_flag.resize(n_add + 1);
+
+			#pragma omp parallel for schedule(static)
+			for (size_t i = 0 ; i < n_add ; i++)
+			{
+				seg_flag.template get<0>(i) = (i == 0 || reorder_add_index_cpu.get(i).id != reorder_add_index_cpu.get(i-1).id);
+			}
+
+			size_t n_unique = openfpm::omp::exclusive_scan(&seg_flag.template get<0>(0),&seg_flag.template get<0>(0),n_add);
+
+			seg_start.resize(n_unique + 1);
+			vct_add_index_unique.resize(n_unique);
+			vct_add_data_unique.resize(n_unique);
+
+			#pragma omp parallel for schedule(static)
+			for (size_t i = 0 ; i < n_add ; i++)
+			{
+				size_t s = seg_flag.template get<0>(i);
+
+				if (i == 0 || reorder_add_index_cpu.get(i).id != reorder_add_index_cpu.get(i-1).id)
+				{
+					seg_start.template get<0>(s) = i;
+					vct_add_index_unique.template get<0>(s) = reorder_add_index_cpu.get(i).id;
+				}
+			}
+
+			seg_start.template get<0>(n_unique) = n_add;
+
 			typedef boost::mpl::vector<v_reduce...> vv_reduce;
 
 			sparse_vector_reduction_cpu<decltype(vct_add_data),
-										decltype(vct_add_index_unique),
-										decltype(reorder_add_index_cpu),
+										decltype(seg_start),
 										vv_reduce,
 										impl2>
 			        svr(vct_add_data_unique,
 			        	vct_add_data_cont,
-			        	vct_add_index_unique,
-			        	reorder_add_index_cpu);
+			        	seg_start);
 
 			boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(svr);
 
 			// merge the the data
 
-			vector<T,Memory,layout_base,grow_p,impl> vct_data_tmp;
-			vector<aggregate<Ti>,Memory,layout_base,grow_p> vct_index_tmp;
+			// the temporaries take the old memory of vct_data and vct_index, inside a memory_pool_scope
+			// it is reused by the next flush
+			pool_tmp<vector<T,Memory,layout_base,grow_p,impl>> vct_data_tmp_p;
+			pool_tmp<vector<aggregate<Ti>,Memory,layout_base,grow_p>> vct_index_tmp_p;
 
-			vct_data_tmp.resize(vct_data.size() + vct_add_data_unique.size());
-			vct_index_tmp.resize(vct_index.size() + vct_add_index_unique.size());
+			auto & vct_data_tmp = vct_data_tmp_p.get();
+			auto & vct_index_tmp = vct_index_tmp_p.get();
+
+			size_t na = vct_index.size();
+			size_t nb = n_unique;
+
+			// split the merge in parts
+
+			int np = (na + nb < 16384)?1:openfpm::omp::get_max_threads();
+
+			std::vector<size_t> pa(np+1);
+			std::vector<size_t> pb(np+1);
+			std::vector<size_t> p_off(np+1);
 
-			Ti di = 0;
-			Ti ai = 0;
-			size_t i = 0;
+			#pragma omp parallel for schedule(static)
+			for (int t = 0 ; t <= np ; t++)
+			{
+				size_t d = (na + nb) * t / np;
+				merge_path_split(vct_index,na,vct_add_index_unique,nb,d,pa[t],pb[t]);
+			}
+
+			// count the output of every part
 
-			for ( ; i < vct_data_tmp.size() ; i++)
+			#pragma omp parallel for schedule(static)
+			for (int t = 0 ; t < np ; t++)
 			{
-				Ti id_a = (ai < vct_add_index_unique.size())?vct_add_index_unique.template get<0>(ai):std::numeric_limits<Ti>::max();
-				Ti id_d = (di < vct_index.size())?vct_index.template get<0>(di):std::numeric_limits<Ti>::max();
+				size_t i = pa[t];
+				size_t j = pb[t];
+				size_t cnt = 0;
 
-				if (  id_a <= id_d )
+				while (i < pa[t+1] || j < pb[t+1])
 				{
-					vct_index_tmp.template get<0>(i) = id_a;
+					if (j >= pb[t+1] || (i < pa[t+1] && vct_index.template get<0>(i) < vct_add_index_unique.template get<0>(j)))
+					{i++;}
+					else if (i >= pa[t+1] || vct_add_index_unique.template get<0>(j) < vct_index.template get<0>(i))
+					{j++;}
+					else
+					{i++;j++;}
+
+					cnt++;
+				}
 
-					if (id_a == id_d)
+				p_off[t] = cnt;
+			}
+
+			size_t n_out = openfpm::omp::exclusive_scan(&p_off[0],&p_off[0],np);
+			p_off[np] = n_out;
+
+			vct_data_tmp.resize(n_out);
+			vct_index_tmp.resize(n_out);
+
+			// merge every part in its output
+
+			#pragma omp parallel for schedule(static)
+			for (int t = 0 ; t < np ; t++)
+			{
+				size_t i = pa[t];
+				size_t j = pb[t];
+				size_t k = p_off[t];
+
+				while (i < pa[t+1] || j < pb[t+1])
+				{
+					if (j >= pb[t+1] || (i < pa[t+1] && vct_index.template get<0>(i) < vct_add_index_unique.template get<0>(j)))
+					{
+						vct_index_tmp.template get<0>(k) = vct_index.template get<0>(i);
+						vct_data_tmp.get(k) = vct_data.get(i);
+						i++;
+					}
+					else if (i >= pa[t+1] || vct_add_index_unique.template get<0>(j) < vct_index.template get<0>(i))
+					{
+						vct_index_tmp.template get<0>(k) = vct_add_index_unique.template get<0>(j);
+						vct_data_tmp.get(k) = vct_add_data_unique.get(j);
+						j++;
+					}
+					else
 					{
-						auto dst = vct_data_tmp.get(i);
-						auto src = vct_add_data_unique.get(ai);
+						// conflict, the reduced properties are reduced with the old element
+						// the others keep the old value
+
+						vct_index_tmp.template get<0>(k) = vct_index.template get<0>(i);
+
+						auto dst = vct_data_tmp.get(k);
+						dst = vct_data.get(i);
 
-						sparse_vector_reduction_solve_conflict_assign_cpu<decltype(vct_data_tmp.get(i)),
-																		  decltype(vct_add_data.get(ai)),
+						auto src = vct_add_data_unique.get(j);
+
+						sparse_vector_reduction_solve_conflict_assign_cpu<decltype(src),
+																		  decltype(dst),
 																		  vv_reduce>
 						sva(src,dst);
 
 						boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(sva);
-						ai++;
 
-						dst = vct_data_tmp.get(i);
-						src = vct_data.get(di);
+						auto old = vct_data.get(i);
 
-						sparse_vector_reduction_solve_conflict_reduce_cpu<decltype(vct_data_tmp.get(i)),
-								  	  	  	  	  	  	  	  	  	  	  decltype(vct_data.get(di)),
+						sparse_vector_reduction_solve_conflict_reduce_cpu<decltype(old),
+								  	  	  	  	  	  	  	  	  	  	  decltype(dst),
 								  	  	  	  	  	  	  	  	  	  	  vv_reduce,
 								  	  	  	  	  	  	  	  	  	  	  impl2>
-						svr(src,dst);
+						svr(old,dst);
 						boost::mpl::for_each_ref<boost::mpl::range_c<int,0,sizeof...(v_reduce)>>(svr);
 
-						di++;
-
-						vct_data_tmp.resize(vct_data_tmp.size()-1);
-						vct_index_tmp.resize(vct_index_tmp.size()-1);
-					}
-					else
-					{
-						vct_index_tmp.template get<0>(i) = vct_add_index_unique.template get<0>(ai);
-						vct_data_tmp.get(i) = vct_add_data_unique.get(ai);
-						ai++;
+						i++;
+						j++;
 					}
-				}
-				else
-				{
-					vct_index_tmp.template get<0>(i) = vct_index.template get<0>(di);
-					vct_data_tmp.get(i) = vct_data.get(di);
-					di++;
+
+					k++;
 				}
 			}
 
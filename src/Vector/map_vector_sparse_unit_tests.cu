@@ -2,6 +2,8 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 #include "map_vector_sparse.hpp"
+#include "util/SimpleRNG.hpp"
+#include <map>
 
 BOOST_AUTO_TEST_SUITE( sparse_vector_test )
 
@@ -89,4 +91,96 @@ BOOST_AUTO_TEST_CASE ( test_sparse_vector_use )
 	BOOST_REQUIRE_EQUAL(vs.get<0>(1),2050);
 }
 
+BOOST_AUTO_TEST_CASE ( test_sparse_vector_pool_memory )
+{
+	openfpm::memory_pool_scope scope;
+
+	openfpm::vector_sparse<aggregate<size_t>,int,PoolMemory> vs;
+	openfpm::vector_sparse<aggregate<size_t>> vs_heap;
+
+	vs.template setBackground<0>(0);
+	vs_heap.template setBackground<0>(0);
+
+	gpu::ofp_context_t gpuContext;
+
+	for (size_t s = 0 ; s < 10 ; s++)
+	{
+		for (size_t i = 0 ; i < 1000 ; i++)
+		{
+			vs.template insert<0>((i*7+s*13)%5000) = i;
+			vs_heap.template insert<0>((i*7+s*13)%5000) = i;
+		}
+
+		vs.template flush<sadd_<0>>(gpuContext);
+		vs_heap.template flush<sadd_<0>>(gpuContext);
+	}
+
+	BOOST_REQUIRE(openfpm::memory_pool::get_pool().getNReuse() != 0);
+
+	bool match = true;
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{match &= vs.template get<0>(i) == vs_heap.template get<0>(i);}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(vs.size(),vs_heap.size());
+}
+
+BOOST_AUTO_TEST_CASE ( test_sparse_vector_flush_cpu_large )
+{
+	openfpm::vector_sparse<aggregate<size_t,size_t,size_t>> vs;
+
+	vs.template setBackground<0>(0);
+	vs.template setBackground<1>(0);
+	vs.template setBackground<2>(0);
+
+	gpu::ofp_context_t gpuContext;
+
+	std::map<size_t,size_t> ref_add;
+	std::map<size_t,size_t> ref_max;
+	std::map<size_t,size_t> ref_min;
+
+	SimpleRNG rng;
+
+	// large enough to split sort, reduction and merge across threads
+	for (size_t s = 0 ; s < 4 ; s++)
+	{
+		for (size_t i = 0 ; i < 100000 ; i++)
+		{
+			size_t id = rng.GetUniform() * 200000;
+			size_t val = rng.GetUniform() * 1000;
+
+			auto ee = vs.insert(id);
+			ee.template get<0>() = val;
+			ee.template get<1>() = val;
+			ee.template get<2>() = val;
+
+			ref_add[id] += val;
+			ref_max[id] = std::max(ref_max[id],val);
+			ref_min[id] = (ref_min.find(id) == ref_min.end())?val:std::min(ref_min[id],val);
+		}
+
+		vs.template flush<sadd_<0>,smax_<1>,smin_<2>>(gpuContext);
+
+		BOOST_REQUIRE_EQUAL(vs.size(),ref_add.size());
+
+		bool match = true;
+		for (auto & e : ref_add)
+		{
+			match &= vs.template get<0>(e.first) == e.second;
+			match &= vs.template get<1>(e.first) == ref_max[e.first];
+			match &= vs.template get<2>(e.first) == ref_min[e.first];
+		}
+
+		BOOST_REQUIRE_EQUAL(match,true);
+	}
+
+	// indexes are sorted
+
+	bool sorted = true;
+	for (size_t i = 1 ; i < vs.size() ; i++)
+	{sorted &= vs.private_get_vct_index().template get<0>(i-1) < vs.private_get_vct_index().template get<0>(i);}
+
+	BOOST_REQUIRE_EQUAL(sorted,true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
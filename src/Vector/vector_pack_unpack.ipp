@@ -104,11 +104,11 @@ struct pack_simple_cond
 		//Pack the size of a vector
 		Packer<size_t, Memory2>::pack(mem,obj.size(),sts);
 		
-		// Sending property object
+		// Sending property object (for every layout an array of objects with the selected properties)
 		typedef openfpm::vector<T,Memory,layout_base,grow_p> vctr;
 		typedef object<typename object_creator<typename vctr::value_type::type,prp...>::type> prp_object;
 	
-		typedef openfpm::vector<prp_object,ExtPreAlloc<Memory2>, layout_base ,openfpm::grow_policy_identity> dtype;
+		typedef openfpm::vector<prp_object,ExtPreAlloc<Memory2>, memory_traits_lin ,openfpm::grow_policy_identity> dtype;
 
 		// Create an object over the preallocated memory (No allocation is produced)
 		dtype dest;
@@ -195,7 +195,7 @@ struct unpack_simple_cond
 		size_t id = 0;
 		
 		// Sending property object
-		typedef openfpm::vector<T> vctr;
+		typedef openfpm::vector<T,Memory,layout_base,grow_p> vctr;
 		typedef object<typename object_creator<typename vctr::value_type::type,prp...>::type> prp_object;
 		typedef openfpm::vector<prp_object,PtrMemory, memory_traits_lin,openfpm::grow_policy_identity> stype;
 
@@ -319,6 +319,8 @@ template<int ... prp> inline void packRequest(size_t & req) const
  */
 template<int ... prp> inline void pack(ExtPreAlloc<HeapMemory> & mem, Pack_stat & sts) const
 {
+	CONTAINER_STAT_SCOPE(CSTAT_TIME_PACK);
+
 	//If all of the aggregate properties are simple (don't have "pack()" member)
 	if (has_pack_agg<T,prp...>::result::value == false)
 	//if (has_aggregatePack<T,prp ... >::has_pack() == false)
@@ -372,3 +374,326 @@ template<int ... prp, typename MemType> inline void unpack(ExtPreAlloc<MemType>
 	}
 }
 
+
+//! It add the segment of the memory of each property of the vector
+template<typename vector_type>
+struct vector_segments_prp
+{
+	//! vector
+	vector_type & v;
+
+	//! list of segments
+	pack_segment_list & segs;
+
+	//! constructor
+	inline vector_segments_prp(vector_type & v, pack_segment_list & segs)
+	:v(v),segs(segs)
+	{};
+
+	//! It add the segment of the property
+	template<typename prp_type>
+	inline void operator()(prp_type & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,prp_type>::type ele_type;
+
+		segs.add(v.template getPointer<prp_type::value>(),v.size()*sizeof(ele_type));
+	}
+};
+
+/*! \brief Add the segment of the vector (memory_traits_lin, all the properties)
+ *
+ */
+template<int ... prp>
+inline void vector_segments_layout(pack_segment_list & segs, std::false_type)
+{
+	segs.add(this->getPointer(),this->size()*sizeof(T));
+}
+
+/*! \brief Add the segment of the vector (memory_traits_inte, the array of the property)
+ *
+ */
+template<int ... prp>
+inline void vector_segments_layout(pack_segment_list & segs, std::true_type)
+{
+	vector_segments_prp<decltype(*this)> vs(*this,segs);
+
+	boost::mpl::for_each_ref<typename to_boost_vmpl<prp...>::type>(vs);
+}
+
+/*! \brief Check if the packed vector has the same layout of the memory of the vector
+ *
+ * pack and unpack store the vector as an array of objects with the selected properties, it match
+ * the memory of the vector with memory_traits_inte and one scalar property, or with memory_traits_lin
+ * and all the properties
+ *
+ * \tparam prp properties to pack
+ *
+ */
+template<int ... prp>
+struct pack_zero_copy
+{
+	static const bool value = has_pack_agg<T,prp...>::result::value == false &&
+							  ((is_layout_inte<layout_base<T>>::value && sizeof...(prp) == 1 && pack_prp_scalar<typename T::type,prp...>::value) ||
+							   (is_layout_inte<layout_base<T>>::value == false && pack_prp_all<T::max_prop,prp...>::value));
+};
+
+/*! \brief Pack the vector as a list of segments (the layout match, only the size is copied)
+ *
+ */
+template<int ... prp>
+inline void packSegments_impl(ExtPreAlloc<HeapMemory> & mem, pack_segment_list & segs, Pack_stat & sts, std::true_type)
+{
+	size_t off = mem.getOffsetEnd();
+
+	//Pack the size of a vector
+	Packer<size_t, HeapMemory>::pack(mem,this->size(),sts);
+	segs.addCopy((char *)mem.getPointerBase() + off,sizeof(size_t));
+
+	vector_segments_layout<prp...>(segs,typename is_layout_inte<layout_base<T>>::type());
+
+	// Update statistic
+	sts.incReq();
+}
+
+/*! \brief Pack the vector as a list of segments (the layout does not match, the vector is packed in mem)
+ *
+ */
+template<int ... prp>
+inline void packSegments_impl(ExtPreAlloc<HeapMemory> & mem, pack_segment_list & segs, Pack_stat & sts, std::false_type)
+{
+	size_t off = mem.getOffsetEnd();
+
+	pack<prp...>(mem,sts);
+
+	segs.addCopy((char *)mem.getPointerBase() + off,mem.getOffsetEnd() - off);
+}
+
+/*! \brief Pack the vector as a list of segments (scatter/gather)
+ *
+ * Concatenating the segments give exactly the bytes produced by pack(mem,sts). When the packed
+ * vector has the same layout of the vector (memory_traits_inte with one scalar property, or memory_traits_lin
+ * with all the properties) only the size is copied in mem and the other segments point to the memory
+ * of the vector, otherwise the vector is packed in mem. The segments pointing to the vector are valid
+ * until the vector is modified
+ *
+ * \tparam prp properties to pack
+ *
+ * \param mem preallocated memory where to pack the size (and the vector when it must be copied)
+ * \param segs list of segments where to add the segments of the vector
+ * \param sts pack statistic
+ *
+ */
+template<int ... prp> void packSegments(ExtPreAlloc<HeapMemory> & mem, pack_segment_list & segs, Pack_stat & sts)
+{
+	packSegments_impl<prp...>(mem,segs,sts,std::integral_constant<bool,pack_zero_copy<prp...>::value>());
+}
+
+/*! \brief Resize the vector and get the segments where a packed vector can be received directly
+ *
+ * When the layout of the message produced by pack(mem,sts) match the memory of the vector
+ * (memory_traits_inte with one scalar property, or memory_traits_lin with all the properties) the
+ * vector is resized to sz and the message can be received (or copied with pack_segment_list::scatter)
+ * directly into the segments, the first segment is sz itself. Otherwise the function return false and the
+ * message must be unpacked with unpack
+ *
+ * \tparam prp properties to unpack
+ *
+ * \param sz number of elements of the message (overwritten with the size in the message)
+ * \param segs list of segments where to add the segments of the vector
+ *
+ * \return true if the segments has been added
+ *
+ */
+template<unsigned int ... prp> bool unpackSegments(size_t & sz, pack_segment_list & segs)
+{
+	if (pack_zero_copy<prp...>::value == false)
+	{return false;}
+
+	this->resize(sz);
+
+	segs.add(&sz,sizeof(size_t));
+	vector_segments_layout<prp...>(segs,typename is_layout_inte<layout_base<T>>::type());
+
+	return true;
+}
+
+//! It add the segments of the memory of each property of the vector for a checkpoint
+template<typename vector_type>
+struct vector_checkpoint_prp
+{
+	//! vector
+	vector_type & v;
+
+	//! list of segments
+	pack_segment_list & segs;
+
+	//! constructor
+	inline vector_checkpoint_prp(vector_type & v, pack_segment_list & segs)
+	:v(v),segs(segs)
+	{};
+
+	//! It add the segments of the property, one segment for each component of an array property
+	template<typename prp_type>
+	inline void operator()(prp_type & t)
+	{
+		typedef typename boost::mpl::at<typename T::type,prp_type>::type ele_type;
+		typedef typename std::remove_all_extents<ele_type>::type scalar_type;
+
+		size_t n_comp = sizeof(ele_type) / sizeof(scalar_type);
+		char * base = (char *)v.template getPointer<prp_type::value>();
+
+		// the components of an array property are stored with a stride equal to the capacity
+		for (size_t c = 0 ; c < n_comp ; c++)
+		{segs.add(base + c*v.capacity()*sizeof(scalar_type),v.size()*sizeof(scalar_type));}
+	}
+};
+
+/*! \brief Add the segments of the memory of the vector for a checkpoint (memory_traits_lin)
+ *
+ */
+inline void checkpointSegments_impl(pack_segment_list & segs, std::false_type)
+{
+	segs.add(this->getPointer(),this->size()*sizeof(T));
+}
+
+/*! \brief Add the segments of the memory of the vector for a checkpoint (memory_traits_inte)
+ *
+ */
+inline void checkpointSegments_impl(pack_segment_list & segs, std::true_type)
+{
+	vector_checkpoint_prp<decltype(*this)> vs(*this,segs);
+
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,T::max_prop>>(vs);
+}
+
+/*! \brief Fill the header of a checkpoint of this vector
+ *
+ * \param h header
+ *
+ */
+void checkpointHeader(checkpoint_header & h) const
+{
+	h.kind = CHECKPOINT_VECTOR;
+	h.type_hash = checkpoint_type_hash<T>();
+	h.lin_hash = 0;
+	h.is_inte = is_layout_inte<layout_base<T>>::value;
+	h.dim = 1;
+	h.sz[0] = size();
+	h.n_ele = size();
+}
+
+/*! \brief Resize the vector to receive the checkpoint
+ *
+ * \param h header of the checkpoint
+ *
+ * \return false if the checkpoint does not contain a vector of this type
+ *
+ */
+bool checkpointPrepare(const checkpoint_header & h)
+{
+	if (h.match(CHECKPOINT_VECTOR,checkpoint_type_hash<T>(),0,is_layout_inte<layout_base<T>>::value,1) == false)
+	{return false;}
+
+	resize(h.n_ele);
+
+	return true;
+}
+
+/*! \brief Called after the segments of the checkpoint has been read
+ *
+ * \return true
+ *
+ */
+bool checkpointFinalize()
+{
+	return true;
+}
+
+/*! \brief Get the segments of memory that a checkpoint of this vector contain
+ *
+ * The segments point directly to the memory of the vector, with memory_traits_inte each component of
+ * each property is a segment. The vector must not contain objects with pointers (nested vectors ...)
+ *
+ * \param segs list of segments where to add the segments of the vector
+ *
+ */
+void checkpointSegments(pack_segment_list & segs) const
+{
+	static_assert(has_pack_agg<T>::result::value == false,"a checkpoint require a vector of objects without pointers");
+
+	const_cast<self_type *>(this)->checkpointSegments_impl(segs,typename is_layout_inte<layout_base<T>>::type());
+}
+
+//! It set the memory of each property of the vector over a mapped checkpoint
+template<typename vector_type>
+struct vector_checkpoint_map
+{
+	//! vector
+	vector_type & v;
+
+	//! pointer to the data of the property
+	char * ptr;
+
+	//! number of elements
+	size_t n;
+
+	//! constructor
+	inline vector_checkpoint_map(vector_type & v, char * ptr, size_t n)
+	:v(v),ptr(ptr),n(n)
+	{};
+
+	//! It set the memory of the property
+	template<typename prp_type>
+	inline void operator()(prp_type & t)
+	{
+		// with memory_traits_lin there is a single memory with all the properties
+		typedef typename std::conditional<is_layout_inte<layout_base<T>>::value,
+										  typename boost::mpl::at<typename T::type,prp_type>::type,
+										  T>::type ele_type;
+
+		PtrMemory & mem = *(new PtrMemory(ptr,n*sizeof(ele_type)));
+		v.template setMemory<prp_type::value>(mem);
+
+		ptr += n*sizeof(ele_type);
+	}
+};
+
+/*! \brief Create the vector over a mapped checkpoint (no copy)
+ *
+ * The vector use the memory of the mapping, it must be an openfpm::vector<T,PtrMemory,...,grow_policy_identity>.
+ * A checkpoint of a vector with memory_traits_inte has each property stored as the vector with capacity
+ * equal to the size, so it can be mapped in the same way
+ *
+ * \param mp mapped checkpoint
+ *
+ * \return false if the checkpoint does not contain a vector of this type
+ *
+ */
+bool checkpointMap(checkpoint_mapping & mp)
+{
+	static_assert(std::is_same<Memory,PtrMemory>::value,"checkpointMap require a vector with PtrMemory");
+	static_assert(has_pack_agg<T>::result::value == false,"a checkpoint require a vector of objects without pointers");
+
+	const checkpoint_header & h = mp.getHeader();
+
+	if (h.match(CHECKPOINT_VECTOR,checkpoint_type_hash<T>(),0,is_layout_inte<layout_base<T>>::value,1) == false)
+	{return false;}
+
+	// the vector must cover exactly the data of the checkpoint
+	size_t ele_size = (is_layout_inte<layout_base<T>>::value)?checkpoint_prp_size<T>():sizeof(T);
+
+	if (h.n_ele*ele_size != h.data_size)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error, the size of the checkpoint does not match the vector" << std::endl;
+		return false;
+	}
+
+	// The vector allocate at least one element
+	vector_checkpoint_map<decltype(*this)> vm(*this,(char *)mp.getData(),(h.n_ele == 0)?1:h.n_ele);
+
+	boost::mpl::for_each_ref<boost::mpl::range_c<int,0,(is_layout_inte<layout_base<T>>::value)?T::max_prop:1>>(vm);
+
+	resize(h.n_ele);
+
+	return true;
+}
@@ -230,6 +230,83 @@ template <typename vector> void test_vector_remove_aggregate()
 	}
 }
 
+template <typename vector> void test_vector_remove_if()
+{
+	typedef Point_test<float> p;
+
+	// big enough to be compacted in parallel
+	size_t n = 100000;
+
+	vector v1;
+	v1.resize(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		v1.template get<p::x>(i) = i;
+		v1.template get<p::v>(i)[1] = 2*i;
+		v1.template get<p::t>(i)[2][1] = 3*i;
+	}
+
+	// remove runs of different length
+	auto rem = [](size_t i) {return (i % 7) == 0 || (i % 100) > 90;};
+
+	openfpm::vector<size_t> kept;
+	openfpm::vector<aggregate<int>> mask;
+	mask.resize(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		mask.template get<0>(i) = rem(i);
+		if (rem(i) == false)	{kept.add(i);}
+	}
+
+	vector v2;
+	v2.resize(n);
+	for (size_t i = 0 ; i < n ; i++)
+	{v2.set(i,v1.get(i));}
+
+	v1.remove_if([&](size_t i){return rem((size_t)v1.template get<p::x>(i));});
+	v2.template remove_mask<0>(mask);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),kept.size());
+	BOOST_REQUIRE_EQUAL(v2.size(),kept.size());
+
+	bool match = true;
+	for (size_t i = 0 ; i < kept.size() ; i++)
+	{
+		match &= v1.template get<p::x>(i) == kept.get(i);
+		match &= v1.template get<p::v>(i)[1] == 2*kept.get(i);
+		match &= v1.template get<p::t>(i)[2][1] == 3*kept.get(i);
+
+		match &= v2.template get<p::x>(i) == kept.get(i);
+		match &= v2.template get<p::t>(i)[2][1] == 3*kept.get(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// sorted keys, remove every element with x multiple of 3
+
+	openfpm::vector<size_t> keys;
+	openfpm::vector<size_t> kept2;
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{
+		if (kept.get(i) % 3 == 0)	{keys.add(i);}
+		else						{kept2.add(kept.get(i));}
+	}
+
+	v1.remove(keys);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),kept2.size());
+
+	for (size_t i = 0 ; i < kept2.size() ; i++)
+	{
+		match &= v1.template get<p::x>(i) == kept2.get(i);
+		match &= v1.template get<p::t>(i)[2][1] == 3*kept2.get(i);
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+}
+
 template <typename vector> void test_vector_insert()
 {
 	typedef Point_test<float> p;
@@ -526,6 +603,32 @@ BOOST_AUTO_TEST_CASE(vector_remove_aggregate )
 	test_vector_remove_aggregate< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
 }
 
+BOOST_AUTO_TEST_CASE(vector_remove_if )
+{
+	test_vector_remove_if<openfpm::vector<Point_test<float>>>();
+	test_vector_remove_if< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
+
+	// properties that cannot be moved with memmove
+	openfpm::vector<aggregate<float,openfpm::vector<float>>> v;
+	v.resize(1000);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<1>(i).add(i);
+	}
+
+	v.remove_if([&](size_t i){return i % 2 == 0;});
+
+	BOOST_REQUIRE_EQUAL(v.size(),500ul);
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v.template get<0>(i),2*i+1);
+		BOOST_REQUIRE_EQUAL(v.template get<1>(i).get(0),2*i+1);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(vector_insert )
 {
 	test_vector_insert<openfpm::vector<Point_test<float>>>();
@@ -556,6 +659,109 @@ BOOST_AUTO_TEST_CASE( vector_load_and_save_check )
 	test_vector_load_and_save_check< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte> >();
 }
 
+template <typename vector, typename vector_map> void test_vector_checkpoint()
+{
+	vector v1;
+
+	for (size_t i = 0; i < 1000; i++)
+	{
+		v1.add();
+		v1.template get<P::x>(i) = i;
+		v1.template get<P::y>(i) = i + 1;
+		v1.template get<P::z>(i) = i + 2;
+		v1.template get<P::s>(i) = i + 3;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			v1.template get<P::v>(i)[j] = i + 4 + j;
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{v1.template get<P::t>(i)[j][k] = i + 7 + 3*j + k;}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(checkpoint_save("test_checkpoint_vector",v1),true);
+
+	// load with a small chunk
+
+	vector v2;
+	v2.add();
+
+	int fd = open("test_checkpoint_vector",O_RDONLY);
+	BOOST_REQUIRE_EQUAL(checkpoint_load(fd,v2,4000),true);
+	close(fd);
+
+	// map the file
+
+	checkpoint_mapping mp;
+	BOOST_REQUIRE_EQUAL(mp.open("test_checkpoint_vector"),true);
+
+	vector_map v3;
+	BOOST_REQUIRE_EQUAL(v3.checkpointMap(mp),true);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),v2.size());
+	BOOST_REQUIRE_EQUAL(v1.size(),v3.size());
+
+	bool match = true;
+	for (size_t i = 0; i < v1.size(); i++)
+	{
+		match &= v2.template get<P::x>(i) == v1.template get<P::x>(i) && v3.template get<P::x>(i) == v1.template get<P::x>(i);
+		match &= v2.template get<P::y>(i) == v1.template get<P::y>(i) && v3.template get<P::y>(i) == v1.template get<P::y>(i);
+		match &= v2.template get<P::z>(i) == v1.template get<P::z>(i) && v3.template get<P::z>(i) == v1.template get<P::z>(i);
+		match &= v2.template get<P::s>(i) == v1.template get<P::s>(i) && v3.template get<P::s>(i) == v1.template get<P::s>(i);
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			match &= v2.template get<P::v>(i)[j] == v1.template get<P::v>(i)[j] && v3.template get<P::v>(i)[j] == v1.template get<P::v>(i)[j];
+
+			for (size_t k = 0 ; k < 3 ; k++)
+			{match &= v2.template get<P::t>(i)[j][k] == v1.template get<P::t>(i)[j][k] && v3.template get<P::t>(i)[j][k] == v1.template get<P::t>(i)[j][k];}
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	// a checkpoint of a different type is refused
+
+	openfpm::vector<aggregate<float,float>> v4;
+	BOOST_REQUIRE_EQUAL(checkpoint_load("test_checkpoint_vector",v4),false);
+
+	// the type descriptor depend only on the layout of the properties
+
+	typedef aggregate<float,float[3]> agg_a;
+	typedef aggregate<float,int> agg_fi;
+	typedef aggregate<int,float> agg_if;
+	typedef aggregate<float,double> agg_fd;
+	typedef aggregate<double,float> agg_df;
+
+	BOOST_REQUIRE_EQUAL(checkpoint_type_hash<agg_a>(),checkpoint_type_hash<agg_a>());
+	BOOST_REQUIRE(checkpoint_type_hash<agg_fi>() != checkpoint_type_hash<agg_if>());
+	BOOST_REQUIRE(checkpoint_type_hash<agg_fd>() != checkpoint_type_hash<agg_df>());
+
+	// a checkpoint with a data size that does not match the vector cannot be mapped
+
+	int fd2 = open("test_checkpoint_vector",O_RDWR);
+	size_t data_size = mp.getHeader().data_size - 8;
+	BOOST_REQUIRE_EQUAL(pwrite(fd2,&data_size,sizeof(size_t),offsetof(checkpoint_header,data_size)),(ssize_t)sizeof(size_t));
+	close(fd2);
+
+	checkpoint_mapping mp2;
+	BOOST_REQUIRE_EQUAL(mp2.open("test_checkpoint_vector"),true);
+
+	vector_map v5;
+	BOOST_REQUIRE_EQUAL(v5.checkpointMap(mp2),false);
+
+	remove("test_checkpoint_vector");
+}
+
+BOOST_AUTO_TEST_CASE( vector_checkpoint_test )
+{
+	test_vector_checkpoint< openfpm::vector<Point_test<float>>,
+							openfpm::vector<Point_test<float>,PtrMemory,memory_traits_lin,openfpm::grow_policy_identity> >();
+	test_vector_checkpoint< openfpm::vector<Point_test<float>,HeapMemory, memory_traits_inte>,
+							openfpm::vector<Point_test<float>,PtrMemory,memory_traits_inte,openfpm::grow_policy_identity> >();
+}
+
 ////////// Test function ///////////
 /////////////////////////////////////
 
@@ -0,0 +1,170 @@
+/*
+ * benchmark_cell_list.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "util/performance/benchmark_harness.hpp"
+#include "NN/CellList/CellList.hpp"
+#include "NN/CellList/CellListSparse.hpp"
+#include "NN/VerletList/VerletList.hpp"
+#include "util/SimpleRNG.hpp"
+
+/*! \brief Random particles in the unit cube
+ *
+ * \param n number of particles
+ * \param vPos positions
+ *
+ */
+static void benchmark_particles(size_t n, openfpm::vector<Point<3,double>> & vPos)
+{
+	SimpleRNG rng;
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		Point<3,double> p({rng.GetUniform(),rng.GetUniform(),rng.GetUniform()});
+		vPos.add(p);
+	}
+}
+
+OPENFPM_BENCHMARK(cell_list,fill)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {64,64,64};
+
+	openfpm::vector<Point<3,double>> vPos;
+	openfpm::vector<aggregate<double>> vPrp;
+	benchmark_particles(br.size(1000000),vPos);
+
+	br.measure([&]()
+	{
+		CellList<3,double,Mem_fast<>> cl(box,div,1);
+		cl.fill(vPos,vPrp,vPos.size());
+	});
+
+	br.setWork(vPos.size(),"particles");
+}
+
+OPENFPM_BENCHMARK(cell_list,fill_sparse)
+{
+	// 1024^3 cells, the particles occupy 1/4096 of the domain
+
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {1024,1024,1024};
+
+	openfpm::vector<Point<3,double>> vPos;
+	openfpm::vector<aggregate<double>> vPrp;
+	benchmark_particles(br.size(1000000),vPos);
+
+	for (size_t i = 0 ; i < vPos.size() ; i++)
+	{
+		for (size_t j = 0 ; j < 3 ; j++)
+		{vPos.template get<0>(i)[j] /= 16.0;}
+	}
+
+	br.measure([&]()
+	{
+		CellListSparse<3,double,unsigned int> cl(box,div,1);
+		cl.fill(vPos,vPrp,vPos.size());
+	});
+
+	br.setWork(vPos.size(),"particles");
+}
+
+OPENFPM_BENCHMARK(cell_list,nn_loop)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {64,64,64};
+	double r_cut2 = 1.0 / 64.0 / 64.0;
+
+	openfpm::vector<Point<3,double>> vPos;
+	openfpm::vector<aggregate<double>> vPrp;
+	benchmark_particles(br.size(1000000),vPos);
+
+	CellList<3,double,Mem_fast<>> cl(box,div,1);
+	cl.fill(vPos,vPrp,vPos.size());
+
+	size_t n_nn = 0;
+
+	br.measure([&]()
+	{
+		n_nn = 0;
+
+		for (size_t p = 0 ; p < vPos.size() ; p++)
+		{
+			Point<3,double> xp = vPos.get(p);
+
+			auto NN = cl.getNNIteratorBox(cl.getCell(xp));
+
+			while (NN.isNext())
+			{
+				auto q = NN.get();
+
+				n_nn += (xp.distance2(vPos.get(q)) < r_cut2);
+
+				++NN;
+			}
+		}
+	});
+
+	br.setWork(vPos.size(),"particles");
+}
+
+OPENFPM_BENCHMARK(cell_list,reorder_sfc)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {64,64,64};
+
+	openfpm::vector<Point<3,double>> vPos;
+	openfpm::vector<aggregate<double>> vPrp;
+	benchmark_particles(br.size(1000000),vPos);
+
+	CellList<3,double,Mem_fast<>> cl(box,div,1);
+	cl.setOpt(CL_NON_SYMMETRIC | CL_HILBERT_CELL_KEYS);
+	cl.fill(vPos,vPrp,vPos.size());
+
+	openfpm::vector<size_t> perm;
+
+	br.measure([&]()
+	{
+		cl.reorderSFC(vPos,vPrp,vPos.size(),perm);
+	});
+
+	br.setWork(vPos.size(),"particles");
+}
+
+OPENFPM_BENCHMARK(verlet_list,build)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 1.0 / 20.0;
+
+	openfpm::vector<Point<3,double>> vPos;
+	benchmark_particles(br.size(100000),vPos);
+
+	br.measure([&]()
+	{
+		VerletList<3,double> vl;
+		vl.Initialize(box,r_cut,vPos,vPos.size());
+	});
+
+	br.setWork(vPos.size(),"particles");
+}
+
+OPENFPM_BENCHMARK(verlet_list,build_symmetric)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 1.0 / 20.0;
+
+	openfpm::vector<Point<3,double>> vPos;
+	benchmark_particles(br.size(100000),vPos);
+
+	br.measure([&]()
+	{
+		VerletList<3,double,VL_SYMMETRIC> vl;
+		vl.Initialize(box,r_cut,vPos,vPos.size());
+	});
+
+	br.setWork(vPos.size(),"particles");
+}
@@ -0,0 +1,102 @@
+/*
+ * benchmark_graph.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "util/performance/benchmark_harness.hpp"
+#include "Graph/map_graph.hpp"
+
+OPENFPM_BENCHMARK(graph,build_cartesian)
+{
+	size_t n = br.size(512);
+	size_t gs[2] = {n,n};
+	grid_sm<2,void> g2(gs);
+
+	br.measure([&]()
+	{
+		Graph_CSR<aggregate<float>,aggregate<float>> g;
+
+		for (size_t i = 0 ; i < g2.size() ; i++)
+		{g.addVertex();}
+
+		// 4-connected grid graph
+		grid_key_dx_iterator<2> it(g2);
+
+		while (it.isNext())
+		{
+			auto key = it.get();
+
+			for (size_t d = 0 ; d < 2 ; d++)
+			{
+				for (long int s = -1 ; s <= 1 ; s += 2)
+				{
+					long int k = key.get(d) + s;
+
+					if (k < 0 || k >= (long int)n)	{continue;}
+
+					grid_key_dx<2> nk = key;
+					nk.set_d(d,k);
+
+					g.addEdge(g2.LinId(key),g2.LinId(nk));
+				}
+			}
+
+			++it;
+		}
+	});
+
+	br.setWork(g2.size(),"vertices");
+}
+
+OPENFPM_BENCHMARK(graph,build_compact)
+{
+	size_t n = br.size(512);
+	size_t gs[2] = {n,n};
+	grid_sm<2,void> g2(gs);
+
+	typedef Graph_CSR<aggregate<float>,aggregate<float>> graph;
+
+	br.measure([&]()
+	{
+		graph g;
+
+		// 4-connected grid graph, constructed in compact form in parallel
+		auto n_edges = [&](size_t v)
+		{
+			grid_key_dx<2> key = g2.InvLinId(v);
+
+			size_t n_adj = 0;
+			for (size_t d = 0 ; d < 2 ; d++)
+			{n_adj += (key.get(d) != 0) + (key.get(d) != (long int)n - 1);}
+
+			return n_adj;
+		};
+
+		auto fill = [&](size_t v, graph::adjacency_writer & aw)
+		{
+			grid_key_dx<2> key = g2.InvLinId(v);
+
+			for (size_t d = 0 ; d < 2 ; d++)
+			{
+				for (long int s = -1 ; s <= 1 ; s += 2)
+				{
+					long int k = key.get(d) + s;
+
+					if (k < 0 || k >= (long int)n)	{continue;}
+
+					grid_key_dx<2> nk = key;
+					nk.set_d(d,k);
+
+					aw.addEdge(g2.LinId(nk));
+				}
+			}
+		};
+
+		g.buildCompact(g2.size(),n_edges,fill);
+	});
+
+	br.setWork(g2.size(),"vertices");
+}
@@ -0,0 +1,84 @@
+/*
+ * benchmark_grid.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "util/performance/benchmark_harness.hpp"
+#include "Grid/map_grid.hpp"
+
+OPENFPM_BENCHMARK(grid,copy_box)
+{
+	size_t n = br.size(128);
+	size_t sz[3] = {n,n,n};
+
+	grid_cpu<3,aggregate<float,float[3]>> g_src(sz);
+	grid_cpu<3,aggregate<float,float[3]>> g_dst(sz);
+	g_src.setMemory();
+	g_dst.setMemory();
+
+	auto it = g_src.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g_src.template get<0>(key) = key.get(0);
+		g_dst.template get<0>(key) = 0.0f;
+
+		++it;
+	}
+
+	Box<3,long int> box_src({1,1,1},{(long int)n-2,(long int)n-2,(long int)n-2});
+	Box<3,long int> box_dst({0,0,0},{(long int)n-3,(long int)n-3,(long int)n-3});
+
+	br.measure([&]()
+	{
+		g_dst.copy_to(g_src,box_src,box_dst);
+	});
+
+	br.setWork((n-2)*(n-2)*(n-2)*sizeof(aggregate<float,float[3]>),"B");
+}
+
+OPENFPM_BENCHMARK(grid,stencil_7p)
+{
+	size_t n = br.size(128);
+	size_t sz[3] = {n,n,n};
+
+	grid_cpu<3,aggregate<float,float>> g(sz);
+	g.setMemory();
+
+	auto it = g.getIterator();
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g.template get<0>(key) = key.get(0) + key.get(1) + key.get(2);
+		g.template get<1>(key) = 0.0f;
+
+		++it;
+	}
+
+	grid_key_dx<3> start({1,1,1});
+	grid_key_dx<3> stop({(long int)n-2,(long int)n-2,(long int)n-2});
+
+	br.measure([&]()
+	{
+		auto it = g.getSubIterator(start,stop);
+
+		while (it.isNext())
+		{
+			auto key = it.get();
+
+			g.template get<1>(key) = g.template get<0>(key.move(0,1)) + g.template get<0>(key.move(0,-1)) +
+									 g.template get<0>(key.move(1,1)) + g.template get<0>(key.move(1,-1)) +
+									 g.template get<0>(key.move(2,1)) + g.template get<0>(key.move(2,-1)) -
+									 6.0f*g.template get<0>(key);
+
+			++it;
+		}
+	});
+
+	br.setWork((n-2)*(n-2)*(n-2),"points");
+}
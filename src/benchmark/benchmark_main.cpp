@@ -0,0 +1,38 @@
+/*
+ * benchmark_main.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "util/performance/benchmark_harness.hpp"
+
+/*! \brief CPU micro-benchmarks of openfpm_data
+ *
+ * Each benchmark is registered with OPENFPM_BENCHMARK in one of the files of this directory.
+ * The executable return 1 if at least one benchmark regress with respect to the baseline
+ *
+ * \code
+ *
+ * ./ofpm_benchmark --csv baseline.csv
+ * ./ofpm_benchmark --baseline baseline.csv --json result.json
+ *
+ * \endcode
+ *
+ * The timings depend on the machine, so no baseline is stored in the repository. The baseline is
+ * produced with --csv by a build of the reference commit on the machine that runs the check (the
+ * targets benchmark_baseline and benchmark_check of the build directory do the two steps)
+ *
+ */
+int main(int argc, char * argv[])
+{
+	benchmark_options opt;
+
+	if (benchmark_parse_options(argc,argv,opt) == false)
+	{return 1;}
+
+	int ret = benchmark_run_all(opt);
+
+	return (ret == 0)?0:1;
+}
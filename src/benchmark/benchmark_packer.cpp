@@ -0,0 +1,108 @@
+/*
+ * benchmark_packer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "util/performance/benchmark_harness.hpp"
+#include "Grid/map_grid.hpp"
+#include "Packer_Unpacker/Packer.hpp"
+#include "Packer_Unpacker/Unpacker.hpp"
+
+OPENFPM_BENCHMARK(packer,vector_pack)
+{
+	typedef openfpm::vector<aggregate<float,float[3],double>> vtype;
+
+	vtype v;
+	v.resize(br.size(2000000));
+
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<2>(i) = i;
+	}
+
+	size_t req = 0;
+	Packer<vtype,HeapMemory>::packRequest<0,2>(v,req);
+
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	br.measure([&]()
+	{
+		Pack_stat sts;
+		Packer<vtype,HeapMemory>::pack<0,2>(mem,v,sts);
+	},
+	[&]()
+	{
+		mem.reset();
+	});
+
+	br.setWork(req,"B");
+
+	mem.decRef();
+	delete &mem;
+}
+
+OPENFPM_BENCHMARK(packer,grid_ghost_pack)
+{
+	size_t n = br.size(128);
+	size_t sz[3] = {n,n,n};
+	long int gh = 3;
+
+	grid_cpu<3,aggregate<float,float[3],double>> g(sz);
+	g.setMemory();
+
+	// the 26 ghost sub-grids (faces, edges and corners) of the internal domain [gh,sz-gh)
+	grid_sm<3,void> ginfo(sz);
+	openfpm::vector<grid_key_dx_iterator_sub<3>> subs;
+
+	for (long int i = -1 ; i <= 1 ; i++)
+	{
+		for (long int j = -1 ; j <= 1 ; j++)
+		{
+			for (long int k = -1 ; k <= 1 ; k++)
+			{
+				if (i == 0 && j == 0 && k == 0)	{continue;}
+
+				long int d[3] = {i,j,k};
+				grid_key_dx<3> start;
+				grid_key_dx<3> stop;
+
+				for (size_t s = 0 ; s < 3 ; s++)
+				{
+					start.set_d(s,(d[s] == -1)?gh:((d[s] == 0)?gh:(long int)n-2*gh));
+					stop.set_d(s,(d[s] == -1)?2*gh-1:((d[s] == 0)?(long int)n-gh-1:(long int)n-gh-1));
+				}
+
+				subs.add(grid_key_dx_iterator_sub<3>(ginfo,start,stop));
+			}
+		}
+	}
+
+	size_t req = 0;
+	for (size_t i = 0 ; i < subs.size() ; i++)
+	{g.template packRequest<0,1,2>(subs.get(i),req);}
+
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	br.measure([&]()
+	{
+		Pack_stat sts;
+		g.template packMulti<0,1,2>(mem,subs,sts);
+	},
+	[&]()
+	{
+		mem.reset();
+	});
+
+	br.setWork(req,"B");
+
+	mem.decRef();
+	delete &mem;
+}
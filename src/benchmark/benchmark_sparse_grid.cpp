@@ -0,0 +1,86 @@
+/*
+ * benchmark_sparse_grid.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "util/performance/benchmark_harness.hpp"
+#include "SparseGrid/SparseGrid.hpp"
+
+/*! \brief Points of a spherical shell in a cube of side n
+ *
+ * \param n side of the cube
+ * \param keys points of the shell
+ *
+ */
+static void benchmark_shell(size_t n, openfpm::vector<grid_key_dx<3>> & keys)
+{
+	size_t sz[3] = {n,n,n};
+	grid_sm<3,void> g_sm(sz);
+	grid_key_dx_iterator<3> it(g_sm);
+
+	double c = n / 2.0;
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		double r = 0.0;
+		for (size_t i = 0 ; i < 3 ; i++)
+		{r += (key.get(i) - c)*(key.get(i) - c);}
+		r = sqrt(r);
+
+		if (r > 0.35*n && r < 0.45*n)
+		{keys.add(key);}
+
+		++it;
+	}
+}
+
+OPENFPM_BENCHMARK(sparse_grid,insert)
+{
+	size_t n = br.size(256);
+	size_t sz[3] = {n,n,n};
+
+	openfpm::vector<grid_key_dx<3>> keys;
+	benchmark_shell(n,keys);
+
+	br.measure([&]()
+	{
+		sgrid_cpu<3,aggregate<float>,HeapMemory> sg(sz);
+
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{sg.template insert<0>(keys.get(i)) = i;}
+	});
+
+	br.setWork(keys.size(),"points");
+}
+
+OPENFPM_BENCHMARK(sparse_grid,get)
+{
+	size_t n = br.size(256);
+	size_t sz[3] = {n,n,n};
+
+	openfpm::vector<grid_key_dx<3>> keys;
+	benchmark_shell(n,keys);
+
+	sgrid_cpu<3,aggregate<float>,HeapMemory> sg(sz);
+
+	for (size_t i = 0 ; i < keys.size() ; i++)
+	{sg.template insert<0>(keys.get(i)) = i;}
+
+	double sum = 0.0;
+
+	br.measure([&]()
+	{
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{sum += sg.template get<0>(keys.get(i));}
+	});
+
+	br.setWork(keys.size(),"points");
+
+	// use the result
+	if (sum < 0.0)	{std::cout << sum << std::endl;}
+}
@@ -0,0 +1,72 @@
+/*
+ * benchmark_vector.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "config.h"
+#include "util/performance/benchmark_harness.hpp"
+
+OPENFPM_BENCHMARK(vector,add)
+{
+	size_t n = br.size(4000000);
+
+	br.measure([&]()
+	{
+		openfpm::vector<aggregate<float,float[3]>> v;
+
+		for (size_t i = 0 ; i < n ; i++)
+		{
+			v.add();
+			v.template get<0>(i) = i;
+		}
+	});
+
+	br.setWork(n,"elements");
+}
+
+OPENFPM_BENCHMARK(vector,axpy_soa)
+{
+	size_t n = br.size(8000000);
+
+	openfpm::vector_soa<aggregate<float,float>> v;
+	v.resize(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		v.template get<0>(i) = i;
+		v.template get<1>(i) = 0.0f;
+	}
+
+	br.measure([&]()
+	{
+		for (size_t i = 0 ; i < n ; i++)
+		{v.template get<1>(i) += 0.5f*v.template get<0>(i);}
+	});
+
+	br.setWork(3*n*sizeof(float),"B");
+}
+
+OPENFPM_BENCHMARK(vector,remove)
+{
+	size_t n = br.size(2000000);
+
+	openfpm::vector<aggregate<float,float[3]>> v;
+	openfpm::vector<size_t> keys;
+
+	// remove 10% of the elements
+	for (size_t i = 0 ; i < n ; i += 10)
+	{keys.add(i);}
+
+	br.measure([&]()
+	{
+		v.remove(keys);
+	},
+	[&]()
+	{
+		v.resize(n);
+	});
+
+	br.setWork(n,"elements");
+}
@@ -0,0 +1,728 @@
+/*
+ * NumaMemory.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef NUMAMEMORY_HPP_
+#define NUMAMEMORY_HPP_
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#include "memory/memory.hpp"
+#include "util/openmp_util.hpp"
+
+/*! \brief Size of the pages requested by alloc_policy
+ *
+ */
+enum alloc_page_policy
+{
+	//! pages of the system
+	ALLOC_PAGE_DEFAULT,
+	//! transparent huge pages (madvise(MADV_HUGEPAGE))
+	ALLOC_PAGE_HUGE_TRANSPARENT,
+	//! explicit huge pages (MAP_HUGETLB), if the system has no huge pages reserved fall back to transparent huge pages
+	ALLOC_PAGE_HUGE_EXPLICIT
+};
+
+/*! \brief Allocation policy of NumaMemory
+ *
+ * Buffers bigger than min_size are mapped directly from the system, they can use huge pages, and their
+ * pages are placed on the NUMA nodes by touching them in parallel (first touch) with the same static
+ * partition used by openfpm::omp::thread_range, or interleaved across the nodes
+ *
+ * The first touch partition the bytes of the buffer, it match the elements processed by each thread only
+ * when the elements are contiguous (memory_traits_lin). With memory_traits_inte every property is a separate
+ * array in the buffer, the elements of a thread are spread over all the arrays and most of their pages are
+ * placed on the node of other threads, for these containers interleave is the better choice
+ *
+ * The global policy is used by NumaMemory<> and can be changed at run time
+ *
+ * \code
+ *
+ * alloc_policy::global().pages = ALLOC_PAGE_HUGE_TRANSPARENT;
+ * alloc_policy::global().interleave = true;
+ *
+ * openfpm::vector<aggregate<double,double[3]>,NumaMemory<>> v;
+ *
+ * \endcode
+ *
+ */
+struct alloc_policy
+{
+	//! size of the pages
+	alloc_page_policy pages = ALLOC_PAGE_HUGE_TRANSPARENT;
+
+	//! touch the pages in parallel, each thread touch the part of the buffer that it process in a static partition
+	bool parallel_first_touch = true;
+
+	//! interleave the pages across the NUMA nodes (first touch is not done)
+	bool interleave = false;
+
+	//! buffers smaller than this are allocated without the policy
+	size_t min_size = 4*1024*1024;
+
+	/*! \brief Return the global policy
+	 *
+	 * \return the global policy
+	 *
+	 */
+	static alloc_policy & global()
+	{
+		static alloc_policy p;
+
+		return p;
+	}
+};
+
+/*! \brief Select the global allocation policy
+ *
+ * A container type can have its own policy with a struct that define a static get() that return an alloc_policy
+ *
+ * \code
+ *
+ * struct interleave_policy
+ * {
+ *	static alloc_policy get()
+ *	{
+ *		alloc_policy p;
+ *		p.interleave = true;
+ *		return p;
+ *	}
+ * };
+ *
+ * openfpm::vector<aggregate<double>,NumaMemory<interleave_policy>> v;
+ *
+ * \endcode
+ *
+ */
+struct alloc_policy_global
+{
+	/*! \brief Return the policy
+	 *
+	 * \return the global policy
+	 *
+	 */
+	static alloc_policy get()
+	{
+		return alloc_policy::global();
+	}
+};
+
+namespace openfpm
+{
+	namespace numa
+	{
+		//! size of the huge pages
+		constexpr size_t huge_page_size = 2*1024*1024;
+
+		/*! \brief Return the bit mask of the online NUMA nodes
+		 *
+		 * \return the mask (bit i set if the node i is online), 1 if the information is not available
+		 *
+		 */
+		static inline unsigned long online_nodes()
+		{
+			static unsigned long mask = 0;
+
+			if (mask != 0)
+			{return mask;}
+
+			// the format is a list of ranges like 0-1,3
+			FILE * f = fopen("/sys/devices/system/node/online","r");
+
+			if (f != NULL)
+			{
+				int a;
+				int b;
+				char c;
+
+				while (fscanf(f,"%d",&a) == 1)
+				{
+					b = a;
+					c = (char)fgetc(f);
+
+					if (c == '-')
+					{
+						if (fscanf(f,"%d",&b) != 1)	{break;}
+						c = (char)fgetc(f);
+					}
+
+					for (int i = a ; i <= b && i < (int)(8*sizeof(unsigned long)) ; i++)
+					{mask |= 1ul << i;}
+
+					if (c != ',')	{break;}
+				}
+
+				fclose(f);
+			}
+
+			if (mask == 0)
+			{mask = 1;}
+
+			return mask;
+		}
+
+		/*! \brief Interleave the pages of a range across the online NUMA nodes
+		 *
+		 * \param ptr begin of the range (page aligned)
+		 * \param sz size of the range
+		 *
+		 * \return true if the policy has been applied
+		 *
+		 */
+		static inline bool interleave(void * ptr, size_t sz)
+		{
+#if defined(__linux__) && defined(SYS_mbind)
+			unsigned long mask = online_nodes();
+
+			// one node, nothing to interleave
+			if ((mask & (mask - 1)) == 0)
+			{return false;}
+
+			// MPOL_INTERLEAVE
+			const int mpol_interleave = 3;
+
+			return syscall(SYS_mbind,ptr,sz,mpol_interleave,&mask,8*sizeof(unsigned long),0) == 0;
+#else
+			return false;
+#endif
+		}
+
+		/*! \brief Touch the pages of a buffer in parallel
+		 *
+		 * The buffer is divided in contiguous parts with openfpm::omp::thread_range, the same partition that
+		 * a static parallel loop over the elements of the buffer use, so every page is placed on the node of
+		 * the thread that will process it. Only the pages in [begin,sz) are touched, every thread touch the
+		 * intersection of its part of the whole buffer with [begin,sz), so the pages added by a resize are
+		 * placed as if the full buffer had been touched at once
+		 *
+		 * \param ptr begin of the buffer
+		 * \param sz size of the buffer
+		 * \param begin first byte to touch (the bytes before are already placed)
+		 *
+		 */
+		static inline void first_touch(void * ptr, size_t sz, size_t begin = 0)
+		{
+			const size_t page = 4096;
+			unsigned char * p = (unsigned char *)ptr;
+
+			int nth = openfpm::omp::get_max_threads();
+
+			#pragma omp parallel num_threads(nth)
+			{
+				size_t start;
+				size_t stop;
+				openfpm::omp::thread_range(sz,openfpm::omp::get_num_threads(),openfpm::omp::get_thread_num(),start,stop);
+
+				if (start < begin)
+				{start = (stop < begin)?stop:begin;}
+
+				// first byte of the pages that start in [start,stop)
+				for (size_t i = (start + page - 1) / page * page ; i < stop ; i += page)
+				{p[i] = 0;}
+
+				// the first page of the range
+				if (start == begin && stop > start)
+				{p[start] = 0;}
+			}
+		}
+
+		/*! \brief Map memory from the system following the policy
+		 *
+		 * \param sz size to map (multiple of the page size)
+		 * \param pol policy
+		 *
+		 * \return the pointer, nullptr on failure
+		 *
+		 */
+		static inline void * map(size_t sz, const alloc_policy & pol)
+		{
+			void * ptr = MAP_FAILED;
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+			if (pol.pages == ALLOC_PAGE_HUGE_EXPLICIT)
+			{ptr = mmap(NULL,sz,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,-1,0);}
+#endif
+
+			bool explicit_huge = ptr != MAP_FAILED;
+
+			if (ptr == MAP_FAILED)
+			{ptr = mmap(NULL,sz,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);}
+
+			if (ptr == MAP_FAILED)
+			{return nullptr;}
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+			if (pol.pages != ALLOC_PAGE_DEFAULT && explicit_huge == false)
+			{madvise(ptr,sz,MADV_HUGEPAGE);}
+#endif
+
+			if (pol.interleave == true)
+			{interleave(ptr,sz);}
+
+			return ptr;
+		}
+
+		/*! \brief Size of a mapping
+		 *
+		 * \param sz requested size
+		 * \param pol policy
+		 *
+		 * \return the size rounded to the huge page size (or the system page size)
+		 *
+		 */
+		static inline size_t map_size(size_t sz, const alloc_policy & pol)
+		{
+			size_t page = (pol.pages == ALLOC_PAGE_DEFAULT)?(size_t)sysconf(_SC_PAGESIZE):huge_page_size;
+
+			return (sz + page - 1) / page * page;
+		}
+	}
+}
+
+/*! \brief Memory with a huge page and NUMA placement policy
+ *
+ * It can be used as Memory template parameter in place of HeapMemory. Big buffers are mapped from the
+ * system following the policy (huge pages, parallel first touch or interleaving), small buffers
+ * are allocated with posix_memalign
+ *
+ * \tparam policy_type struct with a static get() that return the alloc_policy (alloc_policy_global
+ *         follow alloc_policy::global())
+ *
+ * \see alloc_policy
+ *
+ */
+template<typename policy_type = alloc_policy_global>
+class NumaMemory : public memory
+{
+	//! size of the memory
+	size_t sz;
+
+	//! size of the mapping (0 if the memory is not mapped)
+	size_t map_sz;
+
+	//! pointer to the memory
+	unsigned char * dm;
+
+	//! reference counter
+	long int ref_cnt;
+
+	//! Release the memory
+	void release()
+	{
+		if (dm != nullptr)
+		{
+			if (map_sz != 0)
+			{munmap(dm,map_sz);}
+			else
+			{free(dm);}
+		}
+
+		dm = nullptr;
+		sz = 0;
+		map_sz = 0;
+	}
+
+	/*! \brief Allocate a new buffer
+	 *
+	 * \param sz size
+	 * \param map_sz size of the mapping (0 if not mapped)
+	 *
+	 * \return the buffer, nullptr on failure
+	 *
+	 */
+	static unsigned char * get_buffer(size_t sz, size_t & map_sz)
+	{
+		alloc_policy pol = policy_type::get();
+
+		if (sz < pol.min_size)
+		{
+			map_sz = 0;
+
+			void * ptr = nullptr;
+			if (posix_memalign(&ptr,64,(sz == 0)?64:sz) != 0)
+			{return nullptr;}
+
+			return (unsigned char *)ptr;
+		}
+
+		map_sz = openfpm::numa::map_size(sz,pol);
+
+		unsigned char * ptr = (unsigned char *)openfpm::numa::map(map_sz,pol);
+
+		if (ptr == nullptr)
+		{
+			map_sz = 0;
+			return nullptr;
+		}
+
+		if (pol.interleave == false && pol.parallel_first_touch == true)
+		{openfpm::numa::first_touch(ptr,sz);}
+
+		return ptr;
+	}
+
+public:
+
+	//! flush the memory
+	bool flush() {return true;}
+
+	/*! \brief allocate memory
+	 *
+	 * \param sz size of the memory
+	 *
+	 * \return true if it succeed
+	 *
+	 */
+	virtual bool allocate(size_t sz)
+	{
+		release();
+
+		dm = get_buffer(sz,map_sz);
+		this->sz = (dm != nullptr)?sz:0;
+
+		if (dm == nullptr)
+		{std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " cannot allocate " << sz << " bytes" << std::endl;}
+
+		return dm != nullptr;
+	}
+
+	//! destroy memory
+	virtual void destroy()
+	{
+		release();
+	}
+
+	/*! \brief copy the data from a memory
+	 *
+	 * \param m memory from where to copy
+	 *
+	 * \return true if it succeed
+	 *
+	 */
+	virtual bool copy(const memory & m)
+	{
+		if (m.size() > sz)
+		{
+			std::cerr << "Error " << __LINE__ << __FILE__ << ": source buffer is too big to copy";
+			return false;
+		}
+
+		memcpy(dm,m.getPointer(),m.size());
+		return true;
+	}
+
+	/*! \brief the the size of the allocated memory
+	 *
+	 * \return the size of the memory
+	 *
+	 */
+	virtual size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief resize the memory, the content is preserved
+	 *
+	 * A mapped buffer that fit in its mapping does not move. A mapped buffer that must grow is remapped
+	 * by the system (mremap) without copying the data, and only the new pages are touched, each by the
+	 * thread that own them in the partition of the new size (the pages already mapped are not moved)
+	 *
+	 * \param sz new size
+	 *
+	 * \return true if it succeed
+	 *
+	 */
+	virtual bool resize(size_t sz)
+	{
+		if (sz <= this->sz)
+		{return true;}
+
+		if (dm != nullptr && sz <= map_sz)
+		{
+			this->sz = sz;
+			return true;
+		}
+
+		alloc_policy pol = policy_type::get();
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+		if (dm != nullptr && map_sz != 0)
+		{
+			size_t map_sz_new = openfpm::numa::map_size(sz,pol);
+			void * ptr = mremap(dm,map_sz,map_sz_new,MREMAP_MAYMOVE);
+
+			if (ptr != MAP_FAILED)
+			{
+				unsigned char * tail = (unsigned char *)ptr + map_sz;
+
+#ifdef MADV_HUGEPAGE
+				if (pol.pages != ALLOC_PAGE_DEFAULT)
+				{madvise(tail,map_sz_new - map_sz,MADV_HUGEPAGE);}
+#endif
+
+				if (pol.interleave == true)
+				{openfpm::numa::interleave(tail,map_sz_new - map_sz);}
+				else if (pol.parallel_first_touch == true)
+				{openfpm::numa::first_touch(ptr,sz,map_sz);}
+
+				dm = (unsigned char *)ptr;
+				map_sz = map_sz_new;
+				this->sz = sz;
+
+				return true;
+			}
+		}
+#endif
+
+		size_t map_sz_new;
+		unsigned char * dm_new = get_buffer(sz,map_sz_new);
+
+		if (dm_new == nullptr)
+		{return false;}
+
+		if (dm != nullptr)
+		{memcpy(dm_new,dm,this->sz);}
+
+		release();
+
+		dm = dm_new;
+		map_sz = map_sz_new;
+		this->sz = sz;
+
+		return true;
+	}
+
+	/*! \brief get a readable pointer with the data
+	 *
+	 * \return a readable pointer with the data
+	 *
+	 */
+	virtual void * getPointer()
+	{
+		return dm;
+	}
+
+	/*! \brief get a readable pointer with the data
+	 *
+	 * \return a readable pointer with the data
+	 *
+	 */
+	virtual const void * getPointer() const
+	{
+		return dm;
+	}
+
+	/*! \brief get a device pointer (it is the host pointer)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getDevicePointer()
+	{
+		return dm;
+	}
+
+	//! Do nothing
+	virtual void deviceToHost(){};
+
+	//! Do nothing
+	virtual void deviceToHost(size_t start, size_t stop) {};
+
+	//! Do nothing
+	void deviceToHost(NumaMemory & mem) {};
+
+	//! Do nothing
+	virtual void hostToDevice(){};
+
+	//! Do nothing
+	virtual void hostToDevice(size_t start, size_t stop) {};
+
+	//! Do nothing
+	void hostToDevice(NumaMemory & mem) {};
+
+	/*! \brief fill the memory with a byte
+	 *
+	 * \param c byte
+	 *
+	 */
+	virtual void fill(unsigned char c)
+	{
+		memset(dm,c,sz);
+	}
+
+	//! Increment the reference counter
+	virtual void incRef()
+	{ref_cnt++;}
+
+	//! Decrement the reference counter
+	virtual void decRef()
+	{ref_cnt--;}
+
+	/*! \brief Return the reference counter
+	 *
+	 * \return the reference counter
+	 *
+	 */
+	virtual long int ref()
+	{
+		return ref_cnt;
+	}
+
+	/*! \brief Allocated memory is not initialized
+	 *
+	 * \return false
+	 *
+	 */
+	virtual bool isInitialized()
+	{
+		return false;
+	}
+
+	/*! \brief Return true if the memory has been mapped from the system with the policy
+	 *
+	 * \return true if the memory is mapped
+	 *
+	 */
+	bool isMapped() const
+	{
+		return map_sz != 0;
+	}
+
+	/*! \brief copy memory
+	 *
+	 * \param mem memory to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	NumaMemory & operator=(const NumaMemory & mem)
+	{
+		allocate(mem.size());
+		copy(mem);
+		return *this;
+	}
+
+	/*! \brief move memory
+	 *
+	 * \param mem memory to move
+	 *
+	 * \return itself
+	 *
+	 */
+	NumaMemory & operator=(NumaMemory && mem) noexcept
+	{
+		swap(mem);
+		return *this;
+	}
+
+	//! Copy constructor
+	NumaMemory(const NumaMemory & mem)
+	:NumaMemory()
+	{
+		allocate(mem.size());
+		copy(mem);
+	}
+
+	//! Move constructor
+	NumaMemory(NumaMemory && mem) noexcept
+	:NumaMemory()
+	{
+		swap(mem);
+	}
+
+	//! Constructor
+	NumaMemory()
+	:sz(0),map_sz(0),dm(nullptr),ref_cnt(0)
+	{}
+
+	~NumaMemory() noexcept
+	{
+		if (ref_cnt == 0)
+		{release();}
+		else
+		{std::cerr << "Error: " << __FILE__ << " " << __LINE__ << " destroying a live object" << "\n";}
+	}
+
+	/*! \brief swap the memory
+	 *
+	 * \param mem memory to swap
+	 *
+	 */
+	void swap(NumaMemory & mem)
+	{
+		std::swap(sz,mem.sz);
+		std::swap(map_sz,mem.map_sz);
+		std::swap(dm,mem.dm);
+		std::swap(ref_cnt,mem.ref_cnt);
+	}
+
+	/*! \brief Return true if the device and the host memory are the same
+	 *
+	 * \return true
+	 *
+	 */
+	static constexpr bool isDeviceHostSame()
+	{
+		return true;
+	}
+
+	/*! \brief The buffers are always aligned to 64 byte
+	 *
+	 * \param align alignment (ignored)
+	 *
+	 */
+	void setAlignment(size_t align)
+	{}
+
+	/*! \brief Return true if the memory is continuous
+	 *
+	 * \return true
+	 *
+	 */
+	static bool isContinuous()
+	{
+		return true;
+	}
+
+	/*! \brief Return the pointer of the last allocation
+	 *
+	 * \return the pointer to the pointer of the data
+	 *
+	 */
+	void * getPointerBase()
+	{
+		return &dm;
+	}
+
+	/*! \brief Return the device pointer of the last allocation
+	 *
+	 * \return the pointer to the pointer of the data
+	 *
+	 */
+	void * getDevicePointerBase()
+	{
+		return &dm;
+	}
+
+	/*! \brief get the device pointer without copy
+	 *
+	 * \return the pointer
+	 *
+	 */
+	void * getDevicePointerNoCopy()
+	{
+		return dm;
+	}
+};
+
+#endif /* NUMAMEMORY_HPP_ */
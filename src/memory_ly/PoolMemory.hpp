@@ -0,0 +1,732 @@
+/*
+ * PoolMemory.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef POOLMEMORY_HPP_
+#define POOLMEMORY_HPP_
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include "memory/memory.hpp"
+
+namespace openfpm
+{
+	/*! \brief Thread local pool of memory blocks organized in size classes
+	 *
+	 * Every power of two is divided in 4 size classes (the waste is at most 25%), the smallest block
+	 * is min_block bytes. Released blocks are kept in the free list of their class (up to max_cached
+	 * bytes for each thread) and given back by the next request of the same class, so algorithms that
+	 * create temporaries of similar size at every call do not go to the system allocator.
+	 *
+	 * Every thread has its own pool, a block can be released by a thread different from the one
+	 * that requested it.
+	 *
+	 * \see PoolMemory memory_pool_scope
+	 *
+	 */
+	class memory_pool
+	{
+		//! smallest block
+		static constexpr size_t min_block = 256;
+
+		//! alignment of the blocks
+		static constexpr size_t alignment = 64;
+
+		//! number of size classes
+		static constexpr size_t n_class = 256;
+
+		//! free blocks for each size class
+		std::vector<void *> free_list[n_class];
+
+		//! bytes in the free lists
+		size_t cached = 0;
+
+		//! maximum number of bytes in the free lists
+		size_t max_cached = 256*1024*1024;
+
+		//! number of blocks requested to the system
+		size_t n_sys_alloc = 0;
+
+		//! number of requests served from the free lists
+		size_t n_reuse = 0;
+
+		//! number of memory_pool_scope alive
+		int n_scope = 0;
+
+		//! function to call to release the temporaries cached inside a scope
+		std::vector<std::function<void()>> scope_release;
+
+		/*! \brief Return the size class of a request and the size of the block
+		 *
+		 * \param sz requested size in byte
+		 * \param cap size of the block of the class
+		 *
+		 * \return the size class
+		 *
+		 */
+		static size_t size_class(size_t sz, size_t & cap)
+		{
+			if (sz <= min_block)
+			{
+				cap = min_block;
+				return 0;
+			}
+
+			// exponent and the two bits after the most significant one
+			size_t e = 8*sizeof(unsigned long) - 1 - __builtin_clzl(sz-1);
+			size_t q = (sz-1) >> (e-2);
+
+			cap = (q+1) << (e-2);
+			return 1 + (e - 8)*4 + (q - 4);
+		}
+
+	public:
+
+		/*! \brief Get a block of at least sz bytes
+		 *
+		 * \param sz requested size in byte
+		 * \param cap size of the block returned
+		 *
+		 * \return the pointer to the block (aligned to 64 byte)
+		 *
+		 */
+		void * get(size_t sz, size_t & cap)
+		{
+			size_t c = size_class(sz,cap);
+
+			if (free_list[c].size() != 0)
+			{
+				void * ptr = free_list[c].back();
+				free_list[c].pop_back();
+				cached -= cap;
+				n_reuse++;
+				return ptr;
+			}
+
+			void * ptr = nullptr;
+			if (posix_memalign(&ptr,alignment,cap) != 0)
+			{
+				std::cerr << __FILE__ << ":" << __LINE__ << " error, cannot allocate " << cap << " bytes" << std::endl;
+				return nullptr;
+			}
+
+			n_sys_alloc++;
+			return ptr;
+		}
+
+		/*! \brief Give back a block
+		 *
+		 * \param ptr block
+		 * \param cap size of the block (as returned by get)
+		 *
+		 */
+		void release(void * ptr, size_t cap)
+		{
+			if (ptr == nullptr)
+			{return;}
+
+			if (cached + cap > max_cached)
+			{
+				free(ptr);
+				return;
+			}
+
+			size_t c = size_class(cap,cap);
+			free_list[c].push_back(ptr);
+			cached += cap;
+		}
+
+		/*! \brief Give back to the system all the blocks in the free lists
+		 *
+		 */
+		void trim()
+		{
+			for (size_t c = 0 ; c < n_class ; c++)
+			{
+				for (size_t i = 0 ; i < free_list[c].size() ; i++)
+				{free(free_list[c][i]);}
+
+				free_list[c].clear();
+			}
+
+			cached = 0;
+		}
+
+		/*! \brief Set the maximum number of bytes the pool of this thread keeps in its free lists
+		 *
+		 * \param max maximum number of bytes
+		 *
+		 */
+		void setMaxCached(size_t max)
+		{
+			max_cached = max;
+			if (cached > max_cached)
+			{trim();}
+		}
+
+		/*! \brief Return the number of bytes in the free lists
+		 *
+		 * \return the number of bytes
+		 *
+		 */
+		size_t getCached() const
+		{
+			return cached;
+		}
+
+		/*! \brief Return the number of blocks requested to the system
+		 *
+		 * \return the number of blocks
+		 *
+		 */
+		size_t getNSysAlloc() const
+		{
+			return n_sys_alloc;
+		}
+
+		/*! \brief Return the number of requests served reusing a block
+		 *
+		 * \return the number of requests
+		 *
+		 */
+		size_t getNReuse() const
+		{
+			return n_reuse;
+		}
+
+		/*! \brief Return true if the thread is inside a memory_pool_scope
+		 *
+		 * \return true if a scope is alive
+		 *
+		 */
+		bool inScope() const
+		{
+			return n_scope != 0;
+		}
+
+		/*! \brief Register a function that release the objects cached inside the scope
+		 *
+		 * \param f function called when the outer scope is closed
+		 *
+		 */
+		void addScopeRelease(const std::function<void()> & f)
+		{
+			scope_release.push_back(f);
+		}
+
+		//! Open a scope
+		void enterScope()
+		{
+			n_scope++;
+		}
+
+		//! Close a scope, when the outer scope is closed all the cached memory is released
+		void leaveScope()
+		{
+			n_scope--;
+
+			if (n_scope == 0)
+			{
+				for (size_t i = 0 ; i < scope_release.size() ; i++)
+				{scope_release[i]();}
+
+				scope_release.clear();
+				trim();
+			}
+		}
+
+		~memory_pool()
+		{
+			trim();
+		}
+
+		/*! \brief Return the pool of the calling thread
+		 *
+		 * \return the pool
+		 *
+		 */
+		static memory_pool & get_pool()
+		{
+			static thread_local memory_pool pool;
+
+			return pool;
+		}
+	};
+
+	/*! \brief Scope of the memory pool of the calling thread
+	 *
+	 * While a scope is alive the temporaries of the algorithms (see pool_tmp) are cached and reused
+	 * across calls. When the outer scope is destroyed the cached temporaries and the free blocks of
+	 * the pool are released. A typical use is around the time loop of a simulation
+	 *
+	 * \code
+	 *
+	 * openfpm::memory_pool_scope scope;
+	 *
+	 * for (size_t t = 0 ; t < n_step ; t++)
+	 * {
+	 *    ...
+	 *    vs.flush<sadd_<0>>(ctx,flush_type::FLUSH_ON_HOST);
+	 * }
+	 *
+	 * \endcode
+	 *
+	 */
+	class memory_pool_scope
+	{
+	public:
+
+		memory_pool_scope()
+		{
+			memory_pool::get_pool().enterScope();
+		}
+
+		memory_pool_scope(const memory_pool_scope &) = delete;
+		memory_pool_scope & operator=(const memory_pool_scope &) = delete;
+
+		~memory_pool_scope()
+		{
+			memory_pool::get_pool().leaveScope();
+		}
+	};
+
+	/*! \brief Temporary object of an algorithm that can be reused across calls
+	 *
+	 * Outside a memory_pool_scope it is a normal temporary. Inside a scope the object is taken
+	 * from (and at destruction given back to) a cache of the calling thread, the object is cleared
+	 * but it keeps its memory, so the next call with a similar size does not allocate. This is
+	 * useful for temporaries that are swapped with the data of a container, because the memory that
+	 * is given back is the old memory of the container.
+	 *
+	 * \tparam T type of the temporary (it must have clear())
+	 *
+	 */
+	template<typename T>
+	class pool_tmp
+	{
+		//! temporary
+		T obj;
+
+		//! true if the object must be given back to the cache
+		bool cached;
+
+		//! cache of the thread
+		static std::vector<T> & cache()
+		{
+			static thread_local std::vector<T> c;
+
+			return c;
+		}
+
+		//! true if the release of the cache has been registered in the current scope
+		static bool & registered()
+		{
+			static thread_local bool r = false;
+
+			return r;
+		}
+
+	public:
+
+		pool_tmp()
+		:cached(memory_pool::get_pool().inScope())
+		{
+			if (cached == false)
+			{return;}
+
+			if (registered() == false)
+			{
+				// first use in this scope, register the release of the cache
+				memory_pool::get_pool().addScopeRelease([](){std::vector<T>().swap(cache()); registered() = false;});
+				registered() = true;
+			}
+
+			std::vector<T> & c = cache();
+
+			if (c.size() != 0)
+			{
+				obj.swap(c.back());
+				c.pop_back();
+			}
+		}
+
+		pool_tmp(const pool_tmp &) = delete;
+		pool_tmp & operator=(const pool_tmp &) = delete;
+
+		/*! \brief Return the temporary
+		 *
+		 * \return the temporary
+		 *
+		 */
+		T & get()
+		{
+			return obj;
+		}
+
+		~pool_tmp()
+		{
+			if (cached == true && memory_pool::get_pool().inScope())
+			{
+				obj.clear();
+				cache().emplace_back();
+				cache().back().swap(obj);
+			}
+		}
+	};
+}
+
+/*! \brief Memory that take its blocks from the thread memory pool
+ *
+ * It can be used as Memory template parameter in place of HeapMemory. The buffers released are
+ * kept in a size-class pool of the thread and reused by the next allocations of similar size.
+ * Resize inside the block does not move the data
+ *
+ * \see openfpm::memory_pool
+ *
+ */
+class PoolMemory : public memory
+{
+	//! size of the memory
+	size_t sz;
+
+	//! size of the block
+	size_t cap;
+
+	//! pointer to the block
+	unsigned char * dm;
+
+	//! reference counter
+	long int ref_cnt;
+
+	//! Give back the block to the pool
+	void release()
+	{
+		openfpm::memory_pool::get_pool().release(dm,cap);
+		dm = nullptr;
+		sz = 0;
+		cap = 0;
+	}
+
+public:
+
+	//! flush the memory
+	bool flush() {return true;}
+
+	/*! \brief allocate memory
+	 *
+	 * \param sz size of the memory
+	 *
+	 * \return true if it succeed
+	 *
+	 */
+	virtual bool allocate(size_t sz)
+	{
+		if (dm != nullptr && sz <= cap)
+		{
+			this->sz = sz;
+			return true;
+		}
+
+		if (dm != nullptr)
+		{release();}
+
+		dm = (unsigned char *)openfpm::memory_pool::get_pool().get(sz,cap);
+		this->sz = sz;
+
+		return dm != nullptr;
+	}
+
+	//! destroy memory
+	virtual void destroy()
+	{
+		release();
+	}
+
+	/*! \brief copy the data from a memory
+	 *
+	 * \param m memory from where to copy
+	 *
+	 * \return true if it succeed
+	 *
+	 */
+	virtual bool copy(const memory & m)
+	{
+		if (m.size() > sz)
+		{
+			std::cerr << "Error " << __LINE__ << __FILE__ << ": source buffer is too big to copy";
+			return false;
+		}
+
+		memcpy(dm,m.getPointer(),m.size());
+		return true;
+	}
+
+	/*! \brief the the size of the allocated memory
+	 *
+	 * \return the size of the memory
+	 *
+	 */
+	virtual size_t size() const
+	{
+		return sz;
+	}
+
+	/*! \brief resize the memory, the content is preserved
+	 *
+	 * If the new size fit in the block the data are not moved
+	 *
+	 * \param sz new size
+	 *
+	 * \return true if it succeed
+	 *
+	 */
+	virtual bool resize(size_t sz)
+	{
+		if (sz <= this->sz)
+		{return true;}
+
+		if (dm != nullptr && sz <= cap)
+		{
+			this->sz = sz;
+			return true;
+		}
+
+		size_t cap_new;
+		unsigned char * dm_new = (unsigned char *)openfpm::memory_pool::get_pool().get(sz,cap_new);
+
+		if (dm_new == nullptr)
+		{return false;}
+
+		if (dm != nullptr)
+		{
+			memcpy(dm_new,dm,this->sz);
+			openfpm::memory_pool::get_pool().release(dm,cap);
+		}
+
+		dm = dm_new;
+		cap = cap_new;
+		this->sz = sz;
+
+		return true;
+	}
+
+	/*! \brief get a readable pointer with the data
+	 *
+	 * \return a readable pointer with the data
+	 *
+	 */
+	virtual void * getPointer()
+	{
+		return dm;
+	}
+
+	/*! \brief get a readable pointer with the data
+	 *
+	 * \return a readable pointer with the data
+	 *
+	 */
+	virtual const void * getPointer() const
+	{
+		return dm;
+	}
+
+	/*! \brief get a device pointer (it is the host pointer)
+	 *
+	 * \return the pointer
+	 *
+	 */
+	virtual void * getDevicePointer()
+	{
+		return dm;
+	}
+
+	//! Do nothing
+	virtual void deviceToHost(){};
+
+	//! Do nothing
+	virtual void deviceToHost(size_t start, size_t stop) {};
+
+	//! Do nothing
+	void deviceToHost(PoolMemory & mem) {};
+
+	//! Do nothing
+	virtual void hostToDevice(){};
+
+	//! Do nothing
+	virtual void hostToDevice(size_t start, size_t stop) {};
+
+	//! Do nothing
+	void hostToDevice(PoolMemory & mem) {};
+
+	/*! \brief fill the memory with a byte
+	 *
+	 * \param c byte
+	 *
+	 */
+	virtual void fill(unsigned char c)
+	{
+		memset(dm,c,sz);
+	}
+
+	//! Increment the reference counter
+	virtual void incRef()
+	{ref_cnt++;}
+
+	//! Decrement the reference counter
+	virtual void decRef()
+	{ref_cnt--;}
+
+	/*! \brief Return the reference counter
+	 *
+	 * \return the reference counter
+	 *
+	 */
+	virtual long int ref()
+	{
+		return ref_cnt;
+	}
+
+	/*! \brief Allocated memory is not initialized
+	 *
+	 * \return false
+	 *
+	 */
+	virtual bool isInitialized()
+	{
+		return false;
+	}
+
+	/*! \brief copy memory
+	 *
+	 * \param mem memory to copy
+	 *
+	 * \return itself
+	 *
+	 */
+	PoolMemory & operator=(const PoolMemory & mem)
+	{
+		allocate(mem.size());
+		copy(mem);
+		return *this;
+	}
+
+	/*! \brief move memory
+	 *
+	 * \param mem memory to move
+	 *
+	 * \return itself
+	 *
+	 */
+	PoolMemory & operator=(PoolMemory && mem) noexcept
+	{
+		swap(mem);
+		return *this;
+	}
+
+	//! Copy constructor
+	PoolMemory(const PoolMemory & mem)
+	:PoolMemory()
+	{
+		allocate(mem.size());
+		copy(mem);
+	}
+
+	//! Move constructor
+	PoolMemory(PoolMemory && mem) noexcept
+	:PoolMemory()
+	{
+		swap(mem);
+	}
+
+	//! Constructor
+	PoolMemory()
+	:sz(0),cap(0),dm(nullptr),ref_cnt(0)
+	{}
+
+	~PoolMemory() noexcept
+	{
+		if (ref_cnt == 0)
+		{release();}
+		else
+		{std::cerr << "Error: " << __FILE__ << " " << __LINE__ << " destroying a live object" << "\n";}
+	}
+
+	/*! \brief swap the memory
+	 *
+	 * \param mem memory to swap
+	 *
+	 */
+	void swap(PoolMemory & mem)
+	{
+		std::swap(sz,mem.sz);
+		std::swap(cap,mem.cap);
+		std::swap(dm,mem.dm);
+		std::swap(ref_cnt,mem.ref_cnt);
+	}
+
+	/*! \brief Return true if the device and the host memory are the same
+	 *
+	 * \return true
+	 *
+	 */
+	static constexpr bool isDeviceHostSame()
+	{
+		return true;
+	}
+
+	/*! \brief The blocks are always aligned to 64 byte
+	 *
+	 * \param align alignment (ignored)
+	 *
+	 */
+	void setAlignment(size_t align)
+	{}
+
+	/*! \brief Return true if the memory is continuous
+	 *
+	 * \return true
+	 *
+	 */
+	static bool isContinuous()
+	{
+		return true;
+	}
+
+	/*! \brief Return the pointer of the last allocation
+	 *
+	 * \return the pointer to the pointer of the data
+	 *
+	 */
+	void * getPointerBase()
+	{
+		return &dm;
+	}
+
+	/*! \brief Return the device pointer of the last allocation
+	 *
+	 * \return the pointer to the pointer of the data
+	 *
+	 */
+	void * getDevicePointerBase()
+	{
+		return &dm;
+	}
+
+	/*! \brief get the device pointer without copy
+	 *
+	 * \return the pointer
+	 *
+	 */
+	void * getDevicePointerNoCopy()
+	{
+		return dm;
+	}
+};
+
+#endif /* POOLMEMORY_HPP_ */
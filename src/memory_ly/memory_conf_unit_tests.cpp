@@ -26,3 +26,200 @@ BOOST_AUTO_TEST_CASE( memory_conf_use )
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( pool_memory_test )
+
+BOOST_AUTO_TEST_CASE( pool_memory_use )
+{
+	openfpm::memory_pool & pool = openfpm::memory_pool::get_pool();
+
+	PoolMemory mem;
+	mem.allocate(1000);
+	mem.fill(7);
+
+	void * ptr = mem.getPointer();
+	BOOST_REQUIRE_EQUAL((size_t)ptr % 64,0ul);
+
+	// resize inside the block does not move the data
+	mem.resize(1020);
+	BOOST_REQUIRE_EQUAL(mem.getPointer(),ptr);
+	BOOST_REQUIRE_EQUAL(mem.size(),1020ul);
+	BOOST_REQUIRE_EQUAL(((unsigned char *)mem.getPointer())[999],7);
+
+	// resize outside the block preserve the content
+	mem.resize(5000);
+	BOOST_REQUIRE_EQUAL(((unsigned char *)mem.getPointer())[0],7);
+	BOOST_REQUIRE_EQUAL(((unsigned char *)mem.getPointer())[999],7);
+
+	// the block released by the resize is reused
+	size_t n_reuse = pool.getNReuse();
+
+	PoolMemory mem2;
+	mem2.allocate(1010);
+
+	BOOST_REQUIRE_EQUAL(pool.getNReuse(),n_reuse+1);
+	BOOST_REQUIRE_EQUAL(mem2.getPointer(),ptr);
+}
+
+BOOST_AUTO_TEST_CASE( pool_memory_vector )
+{
+	openfpm::memory_pool & pool = openfpm::memory_pool::get_pool();
+
+	size_t n_sys = 0;
+
+	for (size_t s = 0 ; s < 4 ; s++)
+	{
+		openfpm::vector<aggregate<float,double[3]>,PoolMemory> v;
+
+		for (size_t i = 0 ; i < 10000 ; i++)
+		{
+			v.add();
+			v.template get<0>(i) = i;
+			v.template get<1>(i)[0] = i;
+			v.template get<1>(i)[1] = 2*i;
+			v.template get<1>(i)[2] = 3*i;
+		}
+
+		bool match = true;
+		for (size_t i = 0 ; i < v.size() ; i++)
+		{
+			match &= v.template get<0>(i) == i;
+			match &= v.template get<1>(i)[0] == i;
+			match &= v.template get<1>(i)[1] == 2*i;
+			match &= v.template get<1>(i)[2] == 3*i;
+		}
+
+		BOOST_REQUIRE_EQUAL(match,true);
+
+		// after the first iteration all the growth are served by the pool
+		if (s == 0)
+		{n_sys = pool.getNSysAlloc();}
+		else
+		{BOOST_REQUIRE_EQUAL(pool.getNSysAlloc(),n_sys);}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pool_memory_scope )
+{
+	openfpm::memory_pool & pool = openfpm::memory_pool::get_pool();
+
+	{
+		openfpm::memory_pool_scope scope;
+
+		void * ptr;
+
+		{
+			openfpm::pool_tmp<openfpm::vector<aggregate<float>>> tmp;
+			tmp.get().resize(1000);
+			ptr = tmp.get().getPointer();
+		}
+
+		{
+			// inside the scope the temporary keep the memory of the previous one
+			openfpm::pool_tmp<openfpm::vector<aggregate<float>>> tmp;
+			BOOST_REQUIRE_EQUAL(tmp.get().size(),0ul);
+			tmp.get().resize(1000);
+			BOOST_REQUIRE_EQUAL(tmp.get().getPointer(),ptr);
+		}
+
+		PoolMemory mem;
+		mem.allocate(4096);
+	}
+
+	// closing the scope release everything
+	BOOST_REQUIRE_EQUAL(pool.getCached(),0ul);
+
+	openfpm::pool_tmp<openfpm::vector<aggregate<float>>> tmp;
+	BOOST_REQUIRE_EQUAL(tmp.get().size(),0ul);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( numa_memory_test )
+
+//! policy of the tests, small buffers are mapped too
+struct numa_test_policy
+{
+	static alloc_policy get()
+	{
+		alloc_policy p;
+		p.min_size = 64*1024;
+		return p;
+	}
+};
+
+BOOST_AUTO_TEST_CASE( numa_memory_use )
+{
+	NumaMemory<numa_test_policy> mem;
+
+	// small buffer, not mapped
+	mem.allocate(1000);
+	BOOST_REQUIRE_EQUAL(mem.isMapped(),false);
+	BOOST_REQUIRE_EQUAL((size_t)mem.getPointer() % 64,0ul);
+	mem.fill(7);
+
+	// growing over min_size the buffer is mapped and the content preserved
+	mem.resize(100*1024);
+	BOOST_REQUIRE_EQUAL(mem.isMapped(),true);
+	BOOST_REQUIRE_EQUAL(((unsigned char *)mem.getPointer())[999],7);
+
+	memset(mem.getPointer(),3,mem.size());
+
+	// growing a mapped buffer remap it
+	mem.resize(16*1024*1024);
+	BOOST_REQUIRE_EQUAL(mem.size(),16ul*1024*1024);
+	BOOST_REQUIRE_EQUAL(((unsigned char *)mem.getPointer())[100*1024-1],3);
+	BOOST_REQUIRE_EQUAL(((unsigned char *)mem.getPointer())[16*1024*1024-1],0);
+
+	NumaMemory<numa_test_policy> mem2(mem);
+	BOOST_REQUIRE_EQUAL(((unsigned char *)mem2.getPointer())[0],3);
+
+	// the first touch of a tail does not write the bytes before it
+	std::vector<unsigned char> buf(1024*1024,5);
+	openfpm::numa::first_touch(buf.data(),buf.size(),300*1024 + 10);
+
+	bool match = true;
+	for (size_t i = 0 ; i < 300*1024 + 10 ; i++)
+	{match &= buf[i] == 5;}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+	BOOST_REQUIRE_EQUAL(buf[300*1024 + 10],0);
+	BOOST_REQUIRE_EQUAL(buf[1024*1024 - 4096],0);
+}
+
+BOOST_AUTO_TEST_CASE( numa_memory_vector )
+{
+	alloc_policy old = alloc_policy::global();
+
+	alloc_policy::global().min_size = 1024*1024;
+	alloc_policy::global().interleave = true;
+
+	openfpm::vector<aggregate<float,double[3]>,NumaMemory<>> v;
+	openfpm::vector<aggregate<float,double[3]>,NumaMemory<>,memory_traits_inte> v2;
+
+	for (size_t i = 0 ; i < 100000 ; i++)
+	{
+		v.add();
+		v.template get<0>(i) = i;
+		v.template get<1>(i)[2] = 3*i;
+
+		v2.add();
+		v2.template get<0>(i) = i;
+		v2.template get<1>(i)[2] = 3*i;
+	}
+
+	bool match = true;
+	for (size_t i = 0 ; i < v.size() ; i++)
+	{
+		match &= v.template get<0>(i) == i;
+		match &= v.template get<1>(i)[2] == 3*i;
+		match &= v2.template get<0>(i) == i;
+		match &= v2.template get<1>(i)[2] == 3*i;
+	}
+
+	BOOST_REQUIRE_EQUAL(match,true);
+
+	alloc_policy::global() = old;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,10 @@
  #include "Vector/map_vector.hpp"
  #include "util/cuda_util.hpp"
  
+ #ifdef CUDA_ON_CPU
+    #include "util/openmp_util.hpp"
+ #endif
+
  #ifndef CUDA_ON_CPU
      // Here we have for sure CUDA >= 11
      #ifdef __HIP__
@@ -31,6 +35,43 @@
 
  namespace openfpm
  {
+ #ifdef CUDA_ON_CPU
+
+    /*! \brief Find how many elements of a are in the first d elements of the merge of a and b
+     *
+     * On equal keys the elements of a come first (merge path split)
+     *
+     * \param a_keys keys of a
+     * \param a_count number of elements in a
+     * \param b_keys keys of b
+     * \param b_count number of elements in b
+     * \param d diagonal (number of merged elements)
+     * \param comp comparison functor
+     *
+     * \return the number of elements of a
+     *
+     */
+    template<typename a_keys_it, typename b_keys_it, typename comp_t>
+    int merge_path_split(a_keys_it a_keys, int a_count, b_keys_it b_keys, int b_count, int d, comp_t comp)
+    {
+        int lo = (d > b_count)?d - b_count:0;
+        int hi = (d < a_count)?d:a_count;
+
+        while (lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+
+            if (!comp(b_keys[d - mid - 1],a_keys[mid]))
+            {lo = mid + 1;}
+            else
+            {hi = mid;}
+        }
+
+        return lo;
+    }
+
+ #endif
+
     template<typename a_keys_it, typename a_vals_it,
              typename b_keys_it, typename b_vals_it,
              typename c_keys_it, typename c_vals_it,
@@ -40,23 +81,45 @@
             c_keys_it c_keys, c_vals_it c_vals, comp_t comp, context_t& gpuContext)
     {
  #ifdef CUDA_ON_CPU
- 
-        int a_it = 0;
-        int b_it = 0;
-        int c_it = 0;
 
-        while (a_it < a_count || b_it < b_count)
+        // merge path: the output is divided in equal parts, the split of every part
+        // between a and b is found with a binary search along the diagonal and every
+        // part is merged independently
+        int total = a_count + b_count;
+        int n_part = (total < 16384)?1:openfpm::omp::get_max_threads();
+
+        #pragma omp parallel for num_threads(n_part)
+        for (int t = 0 ; t < n_part ; t++)
         {
-            if (a_it < a_count)
+            int d_start = (int)((size_t)total * t / n_part);
+            int d_stop = (int)((size_t)total * (t+1) / n_part);
+
+            int a_it = merge_path_split(a_keys,a_count,b_keys,b_count,d_start,comp);
+            int b_it = d_start - a_it;
+            int a_stop = merge_path_split(a_keys,a_count,b_keys,b_count,d_stop,comp);
+            int b_stop = d_stop - a_stop;
+            int c_it = d_start;
+
+            while (a_it < a_stop || b_it < b_stop)
             {
-                if (b_it < b_count)
+                if (a_it < a_stop)
                 {
-                    if (comp(b_keys[b_it],a_keys[a_it]))
+                    if (b_it < b_stop)
                     {
-                        c_keys[c_it] = b_keys[b_it];
-                        c_vals[c_it] = b_vals[b_it];
-                        c_it++;
-                        b_it++;
+                        if (comp(b_keys[b_it],a_keys[a_it]))
+                        {
+                            c_keys[c_it] = b_keys[b_it];
+                            c_vals[c_it] = b_vals[b_it];
+                            c_it++;
+                            b_it++;
+                        }
+                        else
+                        {
+                            c_keys[c_it] = a_keys[a_it];
+                            c_vals[c_it] = a_vals[a_it];
+                            c_it++;
+                            a_it++;
+                        }
                     }
                     else
                     {
@@ -68,19 +131,12 @@
                 }
                 else
                 {
-                    c_keys[c_it] = a_keys[a_it];
-                    c_vals[c_it] = a_vals[a_it];
+                    c_keys[c_it] = b_keys[b_it];
+                    c_vals[c_it] = b_vals[b_it];
                     c_it++;
-                    a_it++;
+                    b_it++;
                 }
             }
-            else
-            {
-                c_keys[c_it] = b_keys[b_it];
-                c_vals[c_it] = b_vals[b_it];
-                c_it++;
-                b_it++;
-            }
         }
  
  #else
@@ -13,6 +13,11 @@
 #include "util/cuda_util.hpp"
 #include "util/ofp_context.hpp"
 
+#ifdef CUDA_ON_CPU
+	#include "util/openmp_util.hpp"
+	#include <vector>
+#endif
+
 #if CUDART_VERSION >= 11000
 	// Here we have for sure CUDA >= 11
 	#ifndef CUDA_ON_CPU
@@ -34,10 +39,39 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
+	typedef typename std::remove_cv<typename std::remove_reference<decltype(output[0])>::type>::type red_type;
+
+	int nth = (count < 16384)?1:openfpm::omp::get_max_threads();
+
+	// every thread reduce a contiguous block, the partial results are
+	// reduced in block order (op must be associative as for CUB)
+	std::vector<red_type> partial(nth);
+	std::vector<char> filled(nth,false);
+
+	#pragma omp parallel num_threads(nth)
+	{
+		int tid = openfpm::omp::get_thread_num();
+
+		size_t start;
+		size_t stop;
+		openfpm::omp::thread_range(count,openfpm::omp::get_num_threads(),tid,start,stop);
+
+		if (start < stop)
+		{
+			red_type red = input[start];
+			for (size_t i = start + 1 ; i < stop ; i++)
+			{red = op(red,input[i]);}
+
+			partial[tid] = red;
+			filled[tid] = true;
+		}
+	}
+
 	output[0] = 0;
-	for (int i = 0 ; i < count ; i++)
+	for (int t = 0 ; t < nth ; t++)
 	{
-		output[0] = op(output[0],input[i]);
+		if (filled[t] == true)
+		{output[0] = op(output[0],partial[t]);}
 	}
 
 #else
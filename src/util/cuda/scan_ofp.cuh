@@ -13,6 +13,10 @@
 #include "util/cuda_util.hpp"
 #include "util/ofp_context.hpp"
 
+#ifdef CUDA_ON_CPU
+	#include "util/openmp_util.hpp"
+#endif
+
 #if CUDART_VERSION >= 11000
 	// Here we have for sure CUDA >= 11
 	#ifndef CUDA_ON_CPU
@@ -34,16 +38,11 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	if (count == 0)	{return;}
+	if (count <= 0)	{return;}
 
-	auto prec = input[0];
-	output[0] = 0;
-	for (int i = 1 ; i < count ; i++)
-	{
-		auto next = prec + output[i-1];
-		prec = input[i];
-		output[i] = next;
-	}
+	// blocked scan: every thread reduce its block, the block sums are scanned
+	// and every thread scan its block starting from its offset
+	openfpm::omp::exclusive_scan(input,output,count);
 
 #else
 	if (count == 0)	return;
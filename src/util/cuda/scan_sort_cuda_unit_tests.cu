@@ -7,6 +7,7 @@
 #include "sort_ofp.cuh"
 #include "scan_ofp.cuh"
 #include "segreduce_ofp.cuh"
+#include "merge_ofp.cuh"
 
 BOOST_AUTO_TEST_SUITE( scan_tests )
 
@@ -103,6 +104,93 @@ BOOST_AUTO_TEST_CASE( test_sort_cub_wrapper )
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( test_sort_stable_merge_wrapper )
+{
+	std::cout << "Test sort stable and merge" << "\n";
+
+	openfpm::vector_gpu<aggregate<int>> input;
+	openfpm::vector_gpu<aggregate<int>> input_id;
+
+	input.resize(100000);
+	input_id.resize(100000);
+
+	for (size_t i = 0 ; i < 100000; i++)
+	{
+		input.template get<0>(i) = (int)(1000.0*(float)rand() / RAND_MAX) - 500;
+		input_id.template get<0>(i) = i;
+	}
+
+	input.template hostToDevice<0>();
+	input_id.template hostToDevice<0>();
+
+	gpu::ofp_context_t gpuContext;
+
+	openfpm::sort((int *)input.template getDeviceBuffer<0>(),
+				  (int *)input_id.template getDeviceBuffer<0>(),
+			      input.size(),gpu::template less_t<int>(),gpuContext);
+
+	input.template deviceToHost<0>();
+	input_id.template deviceToHost<0>();
+
+	// equal keys must keep their order
+
+	for (size_t i = 0 ; i < input.size() - 1 ; i++)
+	{
+		BOOST_REQUIRE(input.template get<0>(i) <= input.template get<0>(i+1));
+
+		if (input.template get<0>(i) == input.template get<0>(i+1))
+		{BOOST_REQUIRE(input_id.template get<0>(i) < input_id.template get<0>(i+1));}
+	}
+
+	// merge the sorted keys with a second sorted sequence
+
+	openfpm::vector_gpu<aggregate<int>> b;
+	openfpm::vector_gpu<aggregate<int>> b_id;
+
+	b.resize(30000);
+	b_id.resize(30000);
+
+	for (size_t i = 0 ; i < b.size(); i++)
+	{
+		b.template get<0>(i) = 2*i / 60 - 500;
+		b_id.template get<0>(i) = -1;
+	}
+
+	b.template hostToDevice<0>();
+	b_id.template hostToDevice<0>();
+
+	openfpm::vector_gpu<aggregate<int>> c;
+	openfpm::vector_gpu<aggregate<int>> c_id;
+
+	c.resize(input.size() + b.size());
+	c_id.resize(input.size() + b.size());
+
+	openfpm::merge((int *)input.template getDeviceBuffer<0>(),(int *)input_id.template getDeviceBuffer<0>(),input.size(),
+				   (int *)b.template getDeviceBuffer<0>(),(int *)b_id.template getDeviceBuffer<0>(),b.size(),
+				   (int *)c.template getDeviceBuffer<0>(),(int *)c_id.template getDeviceBuffer<0>(),
+				   gpu::template less_t<int>(),gpuContext);
+
+	c.template deviceToHost<0>();
+	c_id.template deviceToHost<0>();
+
+	size_t n_b = 0;
+	for (size_t i = 0 ; i < c.size() - 1 ; i++)
+	{
+		BOOST_REQUIRE(c.template get<0>(i) <= c.template get<0>(i+1));
+
+		// on equal keys the elements of the first sequence come first
+		if (c.template get<0>(i) == c.template get<0>(i+1))
+		{BOOST_REQUIRE(c_id.template get<0>(i) != -1 || c_id.template get<0>(i+1) == -1);}
+
+		n_b += (c_id.template get<0>(i) == -1);
+	}
+	n_b += (c_id.template get<0>(c.size()-1) == -1);
+
+	BOOST_REQUIRE_EQUAL(n_b,b.size());
+
+	std::cout << "End sort stable and merge" << "\n";
+}
+
 BOOST_AUTO_TEST_CASE( test_seg_reduce_wrapper )
 {
 	std::cout << "Test gpu segmented reduce" << "\n";
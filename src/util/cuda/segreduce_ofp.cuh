@@ -13,6 +13,10 @@
  #include "util/cuda_util.hpp"
  #include "util/ofp_context.hpp"
  
+ #ifdef CUDA_ON_CPU
+    #include "util/openmp_util.hpp"
+ #endif
+
  #if CUDART_VERSION >= 11000
     // Here we have for sure CUDA >= 11
     #ifndef CUDA_ON_CPU
@@ -37,30 +41,30 @@
      {
  #ifdef CUDA_ON_CPU
  
-        int i = 0;
-        for ( ; i < num_segments - 1; i++)
+        typedef typename std::remove_cv<typename std::remove_reference<decltype(output[0])>::type>::type red_type;
+
+        // segments are independent, the last one end at count. Segments can have
+        // very different sizes so they are distributed dynamically
+        #pragma omp parallel for schedule(dynamic,64) if (num_segments >= 1024)
+        for (int i = 0 ; i < num_segments ; i++)
         {
             int j = segments[i];
-            output[i] = init;
-            if (j == segments[i+1]) {continue;}
-            output[i] = input[j];
-            ++j;
-            for ( ; j < segments[i+1] ; j++)
+            int stop = (i == num_segments - 1)?count:segments[i+1];
+
+            if (j >= stop)
             {
-                output[i] = op(output[i],input[j]);
+                output[i] = init;
+                continue;
             }
-        }
 
-        // Last segment
-        int j = segments[i];
-        if (j != count)
-        {
-            output[i] = input[j];
+            red_type red = input[j];
             ++j;
-            for ( ; j < count ; j++)
+            for ( ; j < stop ; j++)
             {
-                output[i] = op(output[i],input[j]);
+                red = op(red,input[j]);
             }
+
+            output[i] = red;
         }
  
  #else
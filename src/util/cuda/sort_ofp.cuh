@@ -14,6 +14,11 @@
 #include "util/cuda_util.hpp"
 #include "util/ofp_context.hpp"
 
+#ifdef CUDA_ON_CPU
+	#include "util/openmp_util.hpp"
+	#include <vector>
+#endif
+
 #if CUDART_VERSION >= 11000
 	// Here we have for sure CUDA >= 11
 	#ifndef CUDA_ON_CPU
@@ -256,6 +261,120 @@ namespace std
 }
 
 
+#ifdef CUDA_ON_CPU
+
+/*! \brief Element sorted by the CPU implementation of openfpm::sort
+ *
+ * key is the key of the element, id its original position
+ *
+ */
+template<typename key_t>
+struct key_id
+{
+	key_t key;
+	size_t id;
+};
+
+/*! \brief Reorder keys and values following the sorted elements
+ *
+ * \param keys_input keys
+ * \param vals_input values
+ * \param srt sorted elements (id is the original position)
+ * \param count number of elements
+ *
+ */
+template<typename key_t, typename val_t, typename kid_type>
+void sort_cpu_gather(key_t* keys_input, val_t* vals_input, const kid_type * srt, int count)
+{
+	std::vector<key_t> keys_tmp(keys_input,keys_input+count);
+	std::vector<val_t> vals_tmp(vals_input,vals_input+count);
+
+	#pragma omp parallel for if (count >= 16384)
+	for (int i = 0 ; i < count ; i++)
+	{
+		keys_input[i] = keys_tmp[srt[i].id];
+		vals_input[i] = vals_tmp[srt[i].id];
+	}
+}
+
+/*! \brief CPU implementation of openfpm::sort for a generic comparator
+ *
+ * The elements are sorted in parallel by key, on equal keys by original
+ * position
+ *
+ */
+template<typename key_t, typename val_t, typename comp_t, bool is_radix>
+struct sort_cpu_impl
+{
+	static void sort(key_t* keys_input, val_t* vals_input, int count, comp_t & comp)
+	{
+		std::vector<key_id<key_t>> srt(count);
+
+		#pragma omp parallel for if (count >= 16384)
+		for (int i = 0 ; i < count ; i++)
+		{
+			srt[i].key = keys_input[i];
+			srt[i].id = i;
+		}
+
+		openfpm::omp::sort(srt.begin(),srt.end(),[&comp](const key_id<key_t> & a, const key_id<key_t> & b)
+		{
+			if (comp(a.key,b.key))	{return true;}
+			if (comp(b.key,a.key))	{return false;}
+			return a.id < b.id;
+		});
+
+		sort_cpu_gather(keys_input,vals_input,srt.data(),count);
+	}
+};
+
+/*! \brief CPU implementation of openfpm::sort for integer keys with less_t or greater_t
+ *
+ * Stable parallel LSD radix sort (like DeviceRadixSort). Keys are mapped to
+ * unsigned distances from the minimum (ascending) or from the maximum (descending)
+ * so that only the significant digits are sorted
+ *
+ */
+template<typename key_t, typename val_t, typename comp_t>
+struct sort_cpu_impl<key_t,val_t,comp_t,true>
+{
+	static void sort(key_t* keys_input, val_t* vals_input, int count, comp_t & comp)
+	{
+		typedef typename std::make_unsigned<key_t>::type ukey_t;
+
+		const bool descending = std::is_same<gpu::template greater_t<key_t>,comp_t>::value;
+		const ukey_t sign_bit = (std::is_signed<key_t>::value)?((ukey_t)1 << (8*sizeof(key_t) - 1)):0;
+
+		ukey_t u_min = (ukey_t)-1;
+		ukey_t u_max = 0;
+
+		#pragma omp parallel for reduction(min:u_min) reduction(max:u_max) if (count >= 16384)
+		for (int i = 0 ; i < count ; i++)
+		{
+			ukey_t u = (ukey_t)keys_input[i] ^ sign_bit;
+			u_min = (u < u_min)?u:u_min;
+			u_max = (u > u_max)?u:u_max;
+		}
+
+		std::vector<key_id<size_t>> srt(count);
+		std::vector<key_id<size_t>> tmp(count);
+
+		#pragma omp parallel for if (count >= 16384)
+		for (int i = 0 ; i < count ; i++)
+		{
+			ukey_t u = (ukey_t)keys_input[i] ^ sign_bit;
+			srt[i].key = (descending == true)?(size_t)(u_max - u):(size_t)(u - u_min);
+			srt[i].id = i;
+		}
+
+		openfpm::omp::radix_sort(srt.data(),tmp.data(),count,[](const key_id<size_t> & e){return e.key;},(size_t)(u_max - u_min));
+
+		sort_cpu_gather(keys_input,vals_input,srt.data(),count);
+	}
+};
+
+#endif
+
 namespace openfpm
 {
 	template<typename key_t, typename val_t,
@@ -265,9 +384,11 @@ namespace openfpm
 	{
 #ifdef CUDA_ON_CPU
 
-	key_val_it<key_t,val_t> kv(keys_input,vals_input);
+	if (count <= 1)	{return;}
 
-	std::sort(kv,kv+count,comp);
+	sort_cpu_impl<key_t,val_t,comp_t,std::is_integral<key_t>::value && !std::is_same<key_t,bool>::value && sizeof(key_t) <= sizeof(size_t) &&
+	                                 (std::is_same<gpu::template less_t<key_t>,comp_t>::value ||
+	                                  std::is_same<gpu::template greater_t<key_t>,comp_t>::value)>::sort(keys_input,vals_input,count,comp);
 
 #else
 	#ifdef __HIP__
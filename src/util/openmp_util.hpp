@@ -0,0 +1,291 @@
+/*
+ * openmp_util.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef OPENMP_UTIL_HPP_
+#define OPENMP_UTIL_HPP_
+
+#include "config.h"
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace openfpm
+{
+	namespace omp
+	{
+		/*! \brief Return the maximum number of threads that a parallel region can use
+		 *
+		 * \return the number of threads (1 if OpenMP is not active)
+		 *
+		 */
+		static inline int get_max_threads()
+		{
+#ifdef HAVE_OPENMP
+			return omp_get_max_threads();
+#else
+			return 1;
+#endif
+		}
+
+		/*! \brief Return the number of threads in the current parallel region
+		 *
+		 * \return the number of threads (1 if OpenMP is not active)
+		 *
+		 */
+		static inline int get_num_threads()
+		{
+#ifdef HAVE_OPENMP
+			return omp_get_num_threads();
+#else
+			return 1;
+#endif
+		}
+
+		/*! \brief Return the id of the calling thread in the current parallel region
+		 *
+		 * \return the thread id (0 if OpenMP is not active)
+		 *
+		 */
+		static inline int get_thread_num()
+		{
+#ifdef HAVE_OPENMP
+			return omp_get_thread_num();
+#else
+			return 0;
+#endif
+		}
+
+		/*! \brief Split the range [0,n) in nth contiguous parts and return the part tid
+		 *
+		 * \param n size of the range
+		 * \param nth number of parts
+		 * \param tid part requested
+		 * \param start first element of the part
+		 * \param stop one past the last element of the part
+		 *
+		 */
+		static inline void thread_range(size_t n, int nth, int tid, size_t & start, size_t & stop)
+		{
+			size_t chunk = n / nth;
+			size_t rest = n % nth;
+
+			start = tid * chunk + std::min((size_t)tid,rest);
+			stop = start + chunk + (((size_t)tid < rest)?1:0);
+		}
+
+		/*! \brief Exclusive scan out[i] = in[0] + ... + in[i-1]
+		 *
+		 * The scan is done in two passes, each thread reduce its contiguous block, the block sums are
+		 * scanned serially and each thread scan its block starting from the offset of the block.
+		 * in and out can be the same buffer
+		 *
+		 * \param in input (random access iterator)
+		 * \param out output (random access iterator)
+		 * \param n number of elements
+		 *
+		 * \return the sum of all the elements
+		 *
+		 */
+		template<typename in_it, typename out_it>
+		typename std::remove_cv<typename std::remove_reference<decltype(*std::declval<out_it>())>::type>::type
+		exclusive_scan(in_it in, out_it out, size_t n)
+		{
+			typedef typename std::remove_cv<typename std::remove_reference<decltype(*std::declval<out_it>())>::type>::type T_out;
+
+			int nth = get_max_threads();
+
+			// For small arrays threads does not pay off
+			if (n < 4096 || nth == 1)
+			{
+				T_out sum = 0;
+				for (size_t i = 0 ; i < n ; i++)
+				{
+					T_out tmp = in[i];
+					out[i] = sum;
+					sum += tmp;
+				}
+				return sum;
+			}
+
+			std::vector<T_out> block_sum(nth+1,0);
+			int nth_used = nth;
+
+			#pragma omp parallel num_threads(nth)
+			{
+				int tid = get_thread_num();
+				int nth_r = get_num_threads();
+
+				size_t start;
+				size_t stop;
+				thread_range(n,nth_r,tid,start,stop);
+
+				T_out sum = 0;
+				for (size_t i = start ; i < stop ; i++)
+				{sum += in[i];}
+
+				block_sum[tid+1] = sum;
+
+				#pragma omp barrier
+
+				#pragma omp single
+				{
+					nth_used = nth_r;
+					for (int i = 1 ; i <= nth_r ; i++)
+					{block_sum[i] += block_sum[i-1];}
+				}
+
+				sum = block_sum[tid];
+				for (size_t i = start ; i < stop ; i++)
+				{
+					T_out tmp = in[i];
+					out[i] = sum;
+					sum += tmp;
+				}
+			}
+
+			return block_sum[nth_used];
+		}
+
+		/*! \brief Stable sort in parallel by an unsigned integer key (least significant digit radix sort)
+		 *
+		 * Every pass sort by 8 bits of the key: each thread count the digits of its contiguous block,
+		 * the counters are scanned in (digit,thread) order and each thread scatter its block. Only
+		 * the passes needed to cover max_key are done. Elements with the same key keep their order
+		 *
+		 * \param data elements to sort (the result is in data)
+		 * \param tmp buffer with space for n elements
+		 * \param n number of elements
+		 * \param key functor that return the key of an element
+		 * \param max_key maximum key
+		 *
+		 */
+		template<typename T, typename key_type>
+		void radix_sort(T * data, T * tmp, size_t n, key_type key, size_t max_key)
+		{
+			const int n_bins = 256;
+			int nth = (n < 16384)?1:get_max_threads();
+
+			std::vector<size_t> cnt(nth*n_bins);
+
+			T * src = data;
+			T * dst = tmp;
+
+			for (size_t shift = 0 ; shift < 8*sizeof(size_t) && (max_key >> shift) != 0 ; shift += 8)
+			{
+				#pragma omp parallel num_threads(nth)
+				{
+					int tid = get_thread_num();
+					int nth_r = get_num_threads();
+
+					size_t start;
+					size_t stop;
+					thread_range(n,nth_r,tid,start,stop);
+
+					size_t * c = &cnt[tid*n_bins];
+					std::fill(c,c+n_bins,0);
+
+					for (size_t i = start ; i < stop ; i++)
+					{c[(key(src[i]) >> shift) & (n_bins-1)]++;}
+
+					#pragma omp barrier
+
+					#pragma omp single
+					{
+						size_t sum = 0;
+						for (int b = 0 ; b < n_bins ; b++)
+						{
+							for (int t = 0 ; t < nth_r ; t++)
+							{
+								size_t tmp_c = cnt[t*n_bins + b];
+								cnt[t*n_bins + b] = sum;
+								sum += tmp_c;
+							}
+						}
+					}
+
+					for (size_t i = start ; i < stop ; i++)
+					{dst[c[(key(src[i]) >> shift) & (n_bins-1)]++] = src[i];}
+				}
+
+				std::swap(src,dst);
+			}
+
+			if (src != data)
+			{
+				#pragma omp parallel for num_threads(nth)
+				for (size_t i = 0 ; i < n ; i++)
+				{data[i] = src[i];}
+			}
+		}
+
+		/*! \brief Sort in parallel the range [first,last)
+		 *
+		 * Each thread sort a contiguous block with std::sort, the sorted blocks are merged
+		 * pairwise in parallel. The sort is not stable
+		 *
+		 * \param first begin of the range (random access iterator)
+		 * \param last end of the range
+		 * \param comp comparison functor
+		 *
+		 */
+		template<typename it_type, typename comp_type>
+		void sort(it_type first, it_type last, comp_type comp)
+		{
+			size_t n = last - first;
+			int nth = get_max_threads();
+
+			if (n < 16384 || nth == 1)
+			{
+				std::sort(first,last,comp);
+				return;
+			}
+
+			std::vector<size_t> bounds(nth+1);
+			for (int i = 0 ; i < nth ; i++)
+			{thread_range(n,nth,i,bounds[i],bounds[i+1]);}
+
+			#pragma omp parallel for num_threads(nth)
+			for (int i = 0 ; i < nth ; i++)
+			{std::sort(first + bounds[i],first + bounds[i+1],comp);}
+
+			// merge the blocks two by two
+
+			for (int step = 1 ; step < nth ; step *= 2)
+			{
+				#pragma omp parallel for num_threads(nth)
+				for (int i = 0 ; i < nth ; i += 2*step)
+				{
+					if (i + step >= nth)	{continue;}
+					int e = std::min(i + 2*step,nth);
+					std::inplace_merge(first + bounds[i],first + bounds[i+step],first + bounds[e],comp);
+				}
+			}
+		}
+
+		/*! \brief Sort in parallel the range [first,last) using operator<
+		 *
+		 * \param first begin of the range (random access iterator)
+		 * \param last end of the range
+		 *
+		 */
+		template<typename it_type>
+		void sort(it_type first, it_type last)
+		{
+			typedef typename std::iterator_traits<it_type>::value_type value_type;
+
+			openfpm::omp::sort(first,last,[](const value_type & a, const value_type & b){return a < b;});
+		}
+	}
+}
+
+#endif /* OPENMP_UTIL_HPP_ */
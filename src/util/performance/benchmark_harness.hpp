@@ -0,0 +1,557 @@
+/*
+ * benchmark_harness.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef BENCHMARK_HARNESS_HPP_
+#define BENCHMARK_HARNESS_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include "timer.hpp"
+#include "Vector/map_vector.hpp"
+#include "util/stat/common_statistics.hpp"
+
+/*! \brief Result of a benchmark
+ *
+ */
+struct benchmark_result
+{
+	//! group of the benchmark (vector, grid, ...)
+	std::string group;
+
+	//! name of the benchmark
+	std::string name;
+
+	//! number of measured repetitions
+	size_t n_rep = 0;
+
+	//! mean time of a repetition in seconds
+	double mean = 0.0;
+
+	//! standard deviation of the time in seconds
+	double dev = 0.0;
+
+	//! minimum time in seconds
+	double min = 0.0;
+
+	//! maximum time in seconds
+	double max = 0.0;
+
+	//! work done by a repetition (bytes, elements ...)
+	double work = 0.0;
+
+	//! unit of the work
+	std::string unit;
+
+	/*! \brief Full name of the benchmark
+	 *
+	 * \return group/name
+	 *
+	 */
+	std::string fullName() const
+	{
+		return group + "/" + name;
+	}
+
+	/*! \brief Throughput of the benchmark
+	 *
+	 * \return work per second (0 if the work is not set)
+	 *
+	 */
+	double throughput() const
+	{
+		return (mean != 0.0)?work / mean:0.0;
+	}
+};
+
+/*! \brief Options of a benchmark run
+ *
+ */
+struct benchmark_options
+{
+	//! run only the benchmarks with this sub-string in the full name
+	std::string filter;
+
+	//! number of repetitions not measured
+	size_t n_warmup = 1;
+
+	//! number of measured repetitions
+	size_t n_rep = 10;
+
+	//! scale of the problem size (1.0 is the default size)
+	double scale = 1.0;
+
+	//! JSON report (empty no report)
+	std::string json;
+
+	//! CSV report (empty no report)
+	std::string csv;
+
+	//! CSV baseline to compare with (empty no comparison)
+	std::string baseline;
+
+	//! relative slow-down that is considered a regression
+	double tolerance = 0.1;
+
+	//! only list the benchmarks
+	bool list = false;
+};
+
+/*! \brief Passed to each benchmark, it measure the repetitions of a kernel
+ *
+ * \code
+ *
+ * OPENFPM_BENCHMARK(vector,add)
+ * {
+ *	openfpm::vector<aggregate<float>> v;
+ *
+ *	br.measure([&]()
+ *	{
+ *		v.clear();
+ *		for (size_t i = 0 ; i < br.size(1000000) ; i++)
+ *		{v.add();}
+ *	});
+ *
+ *	br.setWork(br.size(1000000),"elements");
+ * }
+ *
+ * \endcode
+ *
+ */
+class benchmark_run
+{
+	//! options
+	const benchmark_options & opt;
+
+	//! result
+	benchmark_result res;
+
+	//! true if measure has been called
+	bool measured = false;
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param opt options
+	 * \param group group of the benchmark
+	 * \param name name of the benchmark
+	 *
+	 */
+	benchmark_run(const benchmark_options & opt, const std::string & group, const std::string & name)
+	:opt(opt)
+	{
+		res.group = group;
+		res.name = name;
+	}
+
+	/*! \brief Scale a problem size with the --scale option
+	 *
+	 * \param n default size
+	 *
+	 * \return the scaled size (at least 1)
+	 *
+	 */
+	size_t size(size_t n) const
+	{
+		return std::max((size_t)1,(size_t)(n * opt.scale));
+	}
+
+	/*! \brief Run the kernel n_warmup times, and measure it n_rep times
+	 *
+	 * \param kernel kernel to measure
+	 * \param reset called before each repetition, not measured
+	 *
+	 */
+	template<typename kernel_type, typename reset_type>
+	void measure(kernel_type kernel, reset_type reset)
+	{
+		std::vector<double> times;
+
+		for (size_t r = 0 ; r < opt.n_warmup + opt.n_rep ; r++)
+		{
+			reset();
+
+			timer t;
+			t.start();
+
+			kernel();
+
+			t.stop();
+
+			if (r >= opt.n_warmup)
+			{times.push_back(t.getwct());}
+		}
+
+		res.n_rep = times.size();
+		res.min = *std::min_element(times.begin(),times.end());
+		res.max = *std::max_element(times.begin(),times.end());
+
+		if (times.size() > 1)
+		{standard_deviation(times,res.mean,res.dev);}
+		else
+		{
+			res.mean = times[0];
+			res.dev = 0.0;
+		}
+
+		measured = true;
+	}
+
+	/*! \brief Run the kernel n_warmup times, and measure it n_rep times
+	 *
+	 * \param kernel kernel to measure
+	 *
+	 */
+	template<typename kernel_type>
+	void measure(kernel_type kernel)
+	{
+		measure(kernel,[](){});
+	}
+
+	/*! \brief Set the work done by one repetition, to report the throughput
+	 *
+	 * \param work work done
+	 * \param unit unit of the work
+	 *
+	 */
+	void setWork(double work, const std::string & unit)
+	{
+		res.work = work;
+		res.unit = unit;
+	}
+
+	/*! \brief Check if the benchmark measured something
+	 *
+	 * \return true if measure has been called
+	 *
+	 */
+	bool isMeasured() const
+	{
+		return measured;
+	}
+
+	/*! \brief Get the result
+	 *
+	 * \return the result
+	 *
+	 */
+	const benchmark_result & getResult() const
+	{
+		return res;
+	}
+};
+
+/*! \brief A registered benchmark
+ *
+ */
+struct benchmark_case
+{
+	//! group
+	std::string group;
+
+	//! name
+	std::string name;
+
+	//! benchmark function
+	std::function<void (benchmark_run &)> f;
+};
+
+/*! \brief Registry of all the benchmarks of the executable
+ *
+ */
+class benchmark_registry
+{
+	//! benchmarks
+	std::vector<benchmark_case> cases;
+
+public:
+
+	/*! \brief Get the registry
+	 *
+	 * \return the registry
+	 *
+	 */
+	static benchmark_registry & get()
+	{
+		static benchmark_registry reg;
+		return reg;
+	}
+
+	/*! \brief Register a benchmark
+	 *
+	 * \param group group
+	 * \param name name
+	 * \param f benchmark function
+	 *
+	 * \return true
+	 *
+	 */
+	bool add(const std::string & group, const std::string & name, std::function<void (benchmark_run &)> f)
+	{
+		cases.push_back({group,name,f});
+		return true;
+	}
+
+	/*! \brief Get the registered benchmarks, sorted by full name
+	 *
+	 * \return the benchmarks
+	 *
+	 */
+	std::vector<benchmark_case> & getCases()
+	{
+		std::sort(cases.begin(),cases.end(),[](const benchmark_case & a, const benchmark_case & b)
+				  {return a.group + "/" + a.name < b.group + "/" + b.name;});
+
+		return cases;
+	}
+};
+
+//! Register a benchmark, the body receive a benchmark_run & br
+#define OPENFPM_BENCHMARK(group,name) \
+	static void benchmark_ ## group ## _ ## name(benchmark_run & br); \
+	static bool benchmark_reg_ ## group ## _ ## name = benchmark_registry::get().add(#group,#name,benchmark_ ## group ## _ ## name); \
+	static void benchmark_ ## group ## _ ## name(benchmark_run & br)
+
+/*! \brief Write the results in JSON format
+ *
+ * \param out output stream
+ * \param res results
+ *
+ */
+static inline void benchmark_write_json(std::ostream & out, const std::vector<benchmark_result> & res)
+{
+	out.precision(9);
+	out << "{\n  \"benchmarks\": [";
+
+	for (size_t i = 0 ; i < res.size() ; i++)
+	{
+		out << ((i == 0)?"\n":",\n");
+		out << "    {\"group\": \"" << res[i].group << "\", \"name\": \"" << res[i].name << "\", \"reps\": " << res[i].n_rep
+		    << ", \"mean\": " << res[i].mean << ", \"dev\": " << res[i].dev << ", \"min\": " << res[i].min << ", \"max\": " << res[i].max
+		    << ", \"work\": " << res[i].work << ", \"unit\": \"" << res[i].unit << "\", \"throughput\": " << res[i].throughput() << "}";
+	}
+
+	out << "\n  ]\n}\n";
+}
+
+/*! \brief Write the results in CSV format, the file can be used as baseline
+ *
+ * \param out output stream
+ * \param res results
+ *
+ */
+static inline void benchmark_write_csv(std::ostream & out, const std::vector<benchmark_result> & res)
+{
+	out.precision(9);
+	out << "group,name,reps,mean,dev,min,max,work,unit\n";
+
+	for (size_t i = 0 ; i < res.size() ; i++)
+	{
+		out << res[i].group << "," << res[i].name << "," << res[i].n_rep << "," << res[i].mean << "," << res[i].dev << ","
+		    << res[i].min << "," << res[i].max << "," << res[i].work << "," << res[i].unit << "\n";
+	}
+}
+
+/*! \brief Read a baseline written by benchmark_write_csv
+ *
+ * \param file CSV file
+ * \param base map from the full name of the benchmark to its result
+ *
+ * \return false if the file cannot be read
+ *
+ */
+static inline bool benchmark_read_csv(const std::string & file, std::map<std::string,benchmark_result> & base)
+{
+	std::ifstream in(file);
+
+	if (in.is_open() == false)
+	{
+		std::cerr << __FILE__ << ":" << __LINE__ << " error, cannot open the baseline " << file << std::endl;
+		return false;
+	}
+
+	std::string line;
+
+	// skip the header
+	std::getline(in,line);
+
+	while (std::getline(in,line))
+	{
+		std::stringstream ss(line);
+		std::vector<std::string> col;
+		std::string c;
+
+		while (std::getline(ss,c,','))
+		{col.push_back(c);}
+
+		if (col.size() < 8)	{continue;}
+
+		benchmark_result r;
+		r.group = col[0];
+		r.name = col[1];
+		r.n_rep = std::stoul(col[2]);
+		r.mean = std::stod(col[3]);
+		r.dev = std::stod(col[4]);
+		r.min = std::stod(col[5]);
+		r.max = std::stod(col[6]);
+		r.work = std::stod(col[7]);
+		r.unit = (col.size() > 8)?col[8]:"";
+
+		base[r.fullName()] = r;
+	}
+
+	return true;
+}
+
+/*! \brief Check if a result is a regression with respect to the baseline
+ *
+ * A benchmark regress when it is slower than the baseline by more than the tolerance
+ * and more than two standard deviations of the two measures
+ *
+ * \param r result
+ * \param b baseline
+ * \param tolerance relative tolerance
+ *
+ * \return true if it is a regression
+ *
+ */
+static inline bool benchmark_is_regression(const benchmark_result & r, const benchmark_result & b, double tolerance)
+{
+	double noise = 2.0*std::sqrt(r.dev*r.dev + b.dev*b.dev);
+
+	return r.mean > b.mean*(1.0 + tolerance) && r.mean - b.mean > noise;
+}
+
+/*! \brief Parse the command line of the benchmark executable
+ *
+ * \param argc number of arguments
+ * \param argv arguments
+ * \param opt parsed options
+ *
+ * \return false if the command line is not valid
+ *
+ */
+static inline bool benchmark_parse_options(int argc, char * argv[], benchmark_options & opt)
+{
+	for (int i = 1 ; i < argc ; i++)
+	{
+		std::string a(argv[i]);
+		bool has_val = i + 1 < argc;
+
+		if (a == "--list")
+		{opt.list = true;}
+		else if (a == "--filter" && has_val)
+		{opt.filter = argv[++i];}
+		else if (a == "--warmup" && has_val)
+		{opt.n_warmup = std::stoul(argv[++i]);}
+		else if (a == "--reps" && has_val)
+		{opt.n_rep = std::max(1ul,std::stoul(argv[++i]));}
+		else if (a == "--scale" && has_val)
+		{opt.scale = std::stod(argv[++i]);}
+		else if (a == "--json" && has_val)
+		{opt.json = argv[++i];}
+		else if (a == "--csv" && has_val)
+		{opt.csv = argv[++i];}
+		else if (a == "--baseline" && has_val)
+		{opt.baseline = argv[++i];}
+		else if (a == "--tolerance" && has_val)
+		{opt.tolerance = std::stod(argv[++i]);}
+		else
+		{
+			std::cerr << "usage: " << argv[0] << " [--list] [--filter str] [--warmup n] [--reps n] [--scale s]"
+					  << " [--json file] [--csv file] [--baseline file.csv] [--tolerance t]" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*! \brief Run the registered benchmarks
+ *
+ * \param opt options
+ *
+ * \return the number of benchmarks that regressed with respect to the baseline, -1 on error
+ *
+ */
+static inline int benchmark_run_all(const benchmark_options & opt)
+{
+	std::map<std::string,benchmark_result> base;
+
+	if (opt.baseline.size() != 0 && benchmark_read_csv(opt.baseline,base) == false)
+	{return -1;}
+
+	std::vector<benchmark_result> res;
+	int n_regression = 0;
+
+	for (auto & bc : benchmark_registry::get().getCases())
+	{
+		std::string full = bc.group + "/" + bc.name;
+
+		if (full.find(opt.filter) == std::string::npos)	{continue;}
+
+		if (opt.list == true)
+		{
+			std::cout << full << std::endl;
+			continue;
+		}
+
+		benchmark_run br(opt,bc.group,bc.name);
+		bc.f(br);
+
+		if (br.isMeasured() == false)
+		{
+			std::cerr << full << " does not measure anything" << std::endl;
+			continue;
+		}
+
+		const benchmark_result & r = br.getResult();
+		res.push_back(r);
+
+		std::cout << full << "  " << r.mean << " +- " << r.dev << " s (min " << r.min << ")";
+
+		if (r.work != 0.0)
+		{std::cout << "  " << r.throughput() << " " << r.unit << "/s";}
+
+		auto fnd = base.find(full);
+		if (fnd != base.end())
+		{
+			std::cout << "  baseline " << fnd->second.mean << " s (" << fnd->second.mean / r.mean << "x)";
+
+			if (benchmark_is_regression(r,fnd->second,opt.tolerance) == true)
+			{
+				std::cout << "  REGRESSION";
+				n_regression++;
+			}
+		}
+
+		std::cout << std::endl;
+	}
+
+	if (opt.json.size() != 0)
+	{
+		std::ofstream out(opt.json);
+		benchmark_write_json(out,res);
+	}
+
+	if (opt.csv.size() != 0)
+	{
+		std::ofstream out(opt.csv);
+		benchmark_write_csv(out,res);
+	}
+
+	return n_regression;
+}
+
+#endif /* BENCHMARK_HARNESS_HPP_ */
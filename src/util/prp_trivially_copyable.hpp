@@ -0,0 +1,50 @@
+/*
+ * prp_trivially_copyable.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef PRP_TRIVIALLY_COPYABLE_HPP_
+#define PRP_TRIVIALLY_COPYABLE_HPP_
+
+#include <type_traits>
+#include <boost/fusion/include/vector.hpp>
+
+/*! \brief Check that all the properties of an object can be copied with memcpy
+ *
+ * \tparam T type of the properties (boost::fusion::vector)
+ *
+ */
+template<typename T>
+struct prp_trivially_copyable
+{
+	//! true if T can be copied with memcpy
+	static const bool value = std::is_trivially_copyable<T>::value;
+};
+
+/*! \brief Check that all the properties of an object can be copied with memcpy (no properties)
+ *
+ */
+template<>
+struct prp_trivially_copyable<boost::fusion::vector<>>
+{
+	//! no properties
+	static const bool value = true;
+};
+
+/*! \brief Check that all the properties of an object can be copied with memcpy
+ *
+ * \tparam T first property
+ * \tparam list other properties
+ *
+ */
+template<typename T, typename ... list>
+struct prp_trivially_copyable<boost::fusion::vector<T,list...>>
+{
+	//! true if all the properties can be copied with memcpy
+	static const bool value = std::is_trivially_copyable<T>::value &&
+							  prp_trivially_copyable<boost::fusion::vector<list...>>::value;
+};
+
+#endif /* PRP_TRIVIALLY_COPYABLE_HPP_ */
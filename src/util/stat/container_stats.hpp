@@ -0,0 +1,512 @@
+/*
+ * container_stats.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef CONTAINER_STATS_HPP_
+#define CONTAINER_STATS_HPP_
+
+#include <ostream>
+
+/*! \brief Events counted by the container statistics
+ *
+ * The counters are active only when the library is compiled with OPENFPM_CONTAINER_STATS defined
+ * (cmake -DENABLE_CONTAINER_STATS=ON), otherwise the counting macros expand to nothing. The macro must
+ * be defined in the same way for all the compilation units of a program
+ *
+ */
+enum container_stat_event
+{
+	//! reallocation of the structures of Mem_fast (a cell is full)
+	CSTAT_MEM_FAST_REALLOC,
+	//! bytes allocated by the reallocation of Mem_fast
+	CSTAT_MEM_FAST_BYTES,
+	//! reallocation of an openfpm::vector because the capacity is not enough
+	CSTAT_VECTOR_GROW,
+	//! bytes allocated growing openfpm::vector
+	CSTAT_VECTOR_BYTES,
+	//! allocation of the memory of a grid_base_impl (the storage of openfpm::vector is not counted)
+	CSTAT_GRID_ALLOC,
+	//! bytes allocated by grid_base_impl (the storage of openfpm::vector is not counted)
+	CSTAT_GRID_BYTES,
+	//! chunk created in sgrid_cpu
+	CSTAT_SGRID_CHUNK_ALLOC,
+	//! bytes of the chunks created in sgrid_cpu (data, mask and header)
+	CSTAT_SGRID_CHUNK_BYTES,
+	//! chunk of sgrid_cpu found in the chunk cache
+	CSTAT_SGRID_CACHE_HIT,
+	//! chunk of sgrid_cpu not found in the chunk cache
+	CSTAT_SGRID_CACHE_MISS,
+	//! lookup in the hopscotch map of the chunks of sgrid_cpu
+	CSTAT_HASH_MAP_LOOKUP,
+	//! number of events
+	CSTAT_N_EVENTS
+};
+
+/*! \brief Time counted by the container statistics
+ *
+ */
+enum container_stat_timer
+{
+	//! time spent in sgrid_cpu::flush_remove
+	CSTAT_TIME_FLUSH,
+	//! time spent in pack of vector, grid and sparse grid
+	CSTAT_TIME_PACK,
+	//! time spent in sgrid_cpu::reorder
+	CSTAT_TIME_REORDER,
+	//! number of timers
+	CSTAT_N_TIMERS
+};
+
+#ifdef OPENFPM_CONTAINER_STATS
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+/*! \brief Counters of the events in the containers
+ *
+ * Every thread count in its own counters (thread_local, aligned and padded to the cache line), so that
+ * counting does not write shared cache lines. Only the owner thread write its counters (relaxed load and
+ * store, no atomic read-modify-write), they are summed only when they are read (get, get_time, get_calls and
+ * the reports). The counters of a thread that terminate are added to the counters of the terminated threads.
+ * reset must be called when no other thread is counting
+ *
+ * \code
+ *
+ * container_stats::reset();
+ *
+ * // ... run
+ *
+ * container_stats_write_json(std::cout);
+ *
+ * \endcode
+ *
+ */
+class container_stats
+{
+	//! counters of a thread
+	struct alignas(64) counters
+	{
+		//! events
+		std::atomic<size_t> ev[CSTAT_N_EVENTS];
+
+		//! time in nanoseconds
+		std::atomic<size_t> time[CSTAT_N_TIMERS];
+
+		//! number of timed calls
+		std::atomic<size_t> calls[CSTAT_N_TIMERS];
+
+		//! Constructor, all the counters are zero
+		counters()
+		{
+			zero();
+		}
+
+		//! Set all the counters to zero
+		void zero()
+		{
+			for (size_t i = 0 ; i < CSTAT_N_EVENTS ; i++)
+			{ev[i].store(0,std::memory_order_relaxed);}
+
+			for (size_t i = 0 ; i < CSTAT_N_TIMERS ; i++)
+			{
+				time[i].store(0,std::memory_order_relaxed);
+				calls[i].store(0,std::memory_order_relaxed);
+			}
+		}
+	};
+
+	//! counters of all the threads
+	struct registry
+	{
+		//! protect threads and retired
+		std::mutex mtx;
+
+		//! counters of the running threads
+		std::vector<counters *> threads;
+
+		//! sum of the counters of the terminated threads
+		counters retired;
+	};
+
+	/*! \brief Get the registry of the counters
+	 *
+	 * \return the registry
+	 *
+	 */
+	static registry & get_registry()
+	{
+		static registry r;
+		return r;
+	}
+
+	/*! \brief Add the counters src to dst (dst is not shared)
+	 *
+	 * \param dst counters to increment
+	 * \param src counters to add
+	 *
+	 */
+	static void accumulate(counters & dst, const counters & src)
+	{
+		for (size_t i = 0 ; i < CSTAT_N_EVENTS ; i++)
+		{inc(dst.ev[i],src.ev[i].load(std::memory_order_relaxed));}
+
+		for (size_t i = 0 ; i < CSTAT_N_TIMERS ; i++)
+		{
+			inc(dst.time[i],src.time[i].load(std::memory_order_relaxed));
+			inc(dst.calls[i],src.calls[i].load(std::memory_order_relaxed));
+		}
+	}
+
+	//! counters of a thread registered for all its life
+	struct thread_counters
+	{
+		//! counters
+		counters c;
+
+		//! Register the counters
+		thread_counters()
+		{
+			registry & r = get_registry();
+			std::lock_guard<std::mutex> lock(r.mtx);
+
+			r.threads.push_back(&c);
+		}
+
+		//! Add the counters to the terminated threads and unregister them
+		~thread_counters()
+		{
+			registry & r = get_registry();
+			std::lock_guard<std::mutex> lock(r.mtx);
+
+			accumulate(r.retired,c);
+			r.threads.erase(std::find(r.threads.begin(),r.threads.end(),&c));
+		}
+	};
+
+	/*! \brief Get the counters of the calling thread
+	 *
+	 * \return the counters
+	 *
+	 */
+	static counters & local()
+	{
+		static thread_local thread_counters tc;
+		return tc.c;
+	}
+
+	/*! \brief Increment a counter written only by one thread
+	 *
+	 * \param c counter
+	 * \param n value to add
+	 *
+	 */
+	static inline void inc(std::atomic<size_t> & c, size_t n)
+	{
+		c.store(c.load(std::memory_order_relaxed) + n,std::memory_order_relaxed);
+	}
+
+	/*! \brief Sum a counter over all the threads
+	 *
+	 * \param f functor that return the counter from the counters of a thread
+	 *
+	 * \return the sum
+	 *
+	 */
+	template<typename lambda_t>
+	static size_t sum(lambda_t f)
+	{
+		registry & r = get_registry();
+		std::lock_guard<std::mutex> lock(r.mtx);
+
+		size_t s = f(r.retired).load(std::memory_order_relaxed);
+
+		for (size_t i = 0 ; i < r.threads.size() ; i++)
+		{s += f(*r.threads[i]).load(std::memory_order_relaxed);}
+
+		return s;
+	}
+
+public:
+
+	//! true if the statistics are compiled
+	static const bool enabled = true;
+
+	/*! \brief Add n to an event counter
+	 *
+	 * \param e event
+	 * \param n value to add
+	 *
+	 */
+	static inline void add(container_stat_event e, size_t n)
+	{
+		inc(local().ev[e],n);
+	}
+
+	/*! \brief Add time to a timer
+	 *
+	 * \param t timer
+	 * \param ns time in nanoseconds
+	 *
+	 */
+	static inline void add_time(container_stat_timer t, size_t ns)
+	{
+		counters & c = local();
+
+		inc(c.time[t],ns);
+		inc(c.calls[t],1);
+	}
+
+	/*! \brief Get an event counter
+	 *
+	 * \param e event
+	 *
+	 * \return the counter summed over the threads
+	 *
+	 */
+	static size_t get(container_stat_event e)
+	{
+		return sum([e](counters & c) -> std::atomic<size_t> & {return c.ev[e];});
+	}
+
+	/*! \brief Get the time of a timer in seconds
+	 *
+	 * \param t timer
+	 *
+	 * \return the time in seconds summed over the threads
+	 *
+	 */
+	static double get_time(container_stat_timer t)
+	{
+		return sum([t](counters & c) -> std::atomic<size_t> & {return c.time[t];}) * 1e-9;
+	}
+
+	/*! \brief Get the number of timed calls
+	 *
+	 * \param t timer
+	 *
+	 * \return the number of calls summed over the threads
+	 *
+	 */
+	static size_t get_calls(container_stat_timer t)
+	{
+		return sum([t](counters & c) -> std::atomic<size_t> & {return c.calls[t];});
+	}
+
+	//! Set all the counters to zero
+	static void reset()
+	{
+		registry & r = get_registry();
+		std::lock_guard<std::mutex> lock(r.mtx);
+
+		r.retired.zero();
+
+		for (size_t i = 0 ; i < r.threads.size() ; i++)
+		{r.threads[i]->zero();}
+	}
+};
+
+/*! \brief Measure the time of a scope and add it to a timer
+ *
+ * Nested scopes of the same timer on the same thread (a pack that pack its elements) are counted once
+ *
+ */
+template<unsigned int t>
+class container_stat_scope
+{
+	//! start time
+	std::chrono::steady_clock::time_point start;
+
+	//! true if this is the outermost scope
+	bool outer;
+
+	/*! \brief Depth of the scopes of this timer on this thread
+	 *
+	 * \return the depth
+	 *
+	 */
+	static int & depth()
+	{
+		static thread_local int d = 0;
+		return d;
+	}
+
+public:
+
+	//! Start measuring
+	container_stat_scope()
+	:outer(depth()++ == 0)
+	{
+		if (outer == true)
+		{start = std::chrono::steady_clock::now();}
+	}
+
+	//! Stop measuring
+	~container_stat_scope()
+	{
+		--depth();
+
+		if (outer == true)
+		{
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			container_stats::add_time((container_stat_timer)t,ns);
+		}
+	}
+};
+
+/*! \brief Exclude from grid_alloc/grid_bytes the allocations of grid_base_impl done in a scope
+ *
+ * openfpm::vector store its elements in a 1D grid_base_impl, its allocations are muted so that they
+ * are not counted twice (in vector_bytes or mem_fast_bytes and in grid_bytes)
+ *
+ */
+class container_stat_mute_grid
+{
+	/*! \brief Depth of the muted scopes on this thread
+	 *
+	 * \return the depth
+	 *
+	 */
+	static int & depth()
+	{
+		static thread_local int d = 0;
+		return d;
+	}
+
+public:
+
+	//! Start muting
+	container_stat_mute_grid()
+	{
+		depth()++;
+	}
+
+	//! Stop muting
+	~container_stat_mute_grid()
+	{
+		depth()--;
+	}
+
+	/*! \brief Check if the allocations of grid_base_impl are muted on this thread
+	 *
+	 * \return true if muted
+	 *
+	 */
+	static bool muted()
+	{
+		return depth() != 0;
+	}
+};
+
+#define CSTAT_CAT_(a,b) a ## b
+#define CSTAT_CAT(a,b) CSTAT_CAT_(a,b)
+
+//! count an event
+#define CONTAINER_STAT_INC(e) container_stats::add(e,1)
+//! add n to an event counter
+#define CONTAINER_STAT_ADD(e,n) container_stats::add(e,n)
+//! measure the time up to the end of the scope
+#define CONTAINER_STAT_SCOPE(t) container_stat_scope<t> CSTAT_CAT(cstat_scope_,__LINE__)
+//! do not count the allocations of grid_base_impl up to the end of the scope
+#define CONTAINER_STAT_MUTE_GRID container_stat_mute_grid CSTAT_CAT(cstat_mute_,__LINE__)
+//! count the allocation of n bytes by a grid_base_impl (if not muted)
+#define CONTAINER_STAT_GRID_ALLOC(n) {if (container_stat_mute_grid::muted() == false) {container_stats::add(CSTAT_GRID_ALLOC,1); container_stats::add(CSTAT_GRID_BYTES,n);}}
+
+#else
+
+/*! \brief Container statistics (disabled)
+ *
+ * All the counters are zero
+ *
+ */
+class container_stats
+{
+public:
+
+	//! true if the statistics are compiled
+	static const bool enabled = false;
+
+	//! Get an event counter
+	static size_t get(container_stat_event e)	{return 0;}
+
+	//! Get the time of a timer in seconds
+	static double get_time(container_stat_timer t)	{return 0.0;}
+
+	//! Get the number of timed calls
+	static size_t get_calls(container_stat_timer t)	{return 0;}
+
+	//! Set all the counters to zero
+	static void reset()	{}
+};
+
+#define CONTAINER_STAT_INC(e)
+#define CONTAINER_STAT_ADD(e,n)
+#define CONTAINER_STAT_SCOPE(t)
+#define CONTAINER_STAT_MUTE_GRID
+#define CONTAINER_STAT_GRID_ALLOC(n)
+
+#endif
+
+//! names of the events in the report
+static const char * const container_stat_event_name[CSTAT_N_EVENTS] = {"mem_fast_realloc",
+																 "mem_fast_bytes",
+																 "vector_grow",
+																 "vector_bytes",
+																 "grid_alloc",
+																 "grid_bytes",
+																 "sgrid_chunk_alloc",
+																 "sgrid_chunk_bytes",
+																 "sgrid_cache_hit",
+																 "sgrid_cache_miss",
+																 "hash_map_lookup"};
+
+//! names of the timers in the report
+static const char * const container_stat_timer_name[CSTAT_N_TIMERS] = {"flush","pack","reorder"};
+
+/*! \brief Write the container statistics in JSON format
+ *
+ * \param out output stream
+ *
+ */
+static inline void container_stats_write_json(std::ostream & out)
+{
+	out << "{\n  \"enabled\": " << ((container_stats::enabled)?"true":"false") << ",\n  \"events\": {";
+
+	for (size_t i = 0 ; i < CSTAT_N_EVENTS ; i++)
+	{
+		out << ((i == 0)?"\n":",\n") << "    \"" << container_stat_event_name[i] << "\": " << container_stats::get((container_stat_event)i);
+	}
+
+	out << "\n  },\n  \"timers\": {";
+
+	for (size_t i = 0 ; i < CSTAT_N_TIMERS ; i++)
+	{
+		out << ((i == 0)?"\n":",\n") << "    \"" << container_stat_timer_name[i] << "\": {\"seconds\": " << container_stats::get_time((container_stat_timer)i)
+		    << ", \"calls\": " << container_stats::get_calls((container_stat_timer)i) << "}";
+	}
+
+	out << "\n  }\n}\n";
+}
+
+/*! \brief Write the container statistics in CSV format (name,value,calls)
+ *
+ * \param out output stream
+ *
+ */
+static inline void container_stats_write_csv(std::ostream & out)
+{
+	out << "name,value,calls\n";
+
+	for (size_t i = 0 ; i < CSTAT_N_EVENTS ; i++)
+	{out << container_stat_event_name[i] << "," << container_stats::get((container_stat_event)i) << ",\n";}
+
+	for (size_t i = 0 ; i < CSTAT_N_TIMERS ; i++)
+	{out << "time_" << container_stat_timer_name[i] << "," << container_stats::get_time((container_stat_timer)i) << "," << container_stats::get_calls((container_stat_timer)i) << "\n";}
+}
+
+#endif /* CONTAINER_STATS_HPP_ */
@@ -0,0 +1,148 @@
+/*
+ * container_stats_unit_tests.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+// This executable is always compiled with the statistics active, the macro must be
+// defined before any include of the library
+#ifndef OPENFPM_CONTAINER_STATS
+#define OPENFPM_CONTAINER_STATS
+#endif
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "config.h"
+#include "Vector/map_vector.hpp"
+#include "Grid/map_grid.hpp"
+#include "SparseGrid/SparseGrid.hpp"
+#include "NN/Mem_type/MemFast.hpp"
+#include "util/stat/container_stats.hpp"
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE( container_stats_counters_test )
+
+BOOST_AUTO_TEST_CASE( container_stats_sgrid )
+{
+	BOOST_REQUIRE(container_stats::enabled == true);
+
+	size_t sz[3] = {64,64,64};
+	sgrid_cpu<3,aggregate<float>,HeapMemory> sg(sz);
+
+	container_stats::reset();
+
+	sg.template insert<0>(grid_key_dx<3>({1,1,1})) = 1.0;
+	sg.template insert<0>(grid_key_dx<3>({2,1,1})) = 1.0;
+	sg.template get<0>(grid_key_dx<3>({40,40,40}));
+	sg.flush_remove();
+
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_SGRID_CHUNK_ALLOC),1ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_SGRID_CACHE_MISS),2ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_SGRID_CACHE_HIT),1ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_HASH_MAP_LOOKUP),2ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get_calls(CSTAT_TIME_FLUSH),1ul);
+}
+
+BOOST_AUTO_TEST_CASE( container_stats_vector_grid_no_double_count )
+{
+	container_stats::reset();
+
+	// the storage of a vector is counted only in vector_grow/vector_bytes
+
+	openfpm::vector<aggregate<float>> v;
+	v.reserve(1000);
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{v.add();}
+
+	openfpm::vector<aggregate<float>> v2(v);
+
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_VECTOR_GROW),1ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_VECTOR_BYTES),1000*sizeof(float));
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_GRID_ALLOC),0ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_GRID_BYTES),0ul);
+
+	// a grid is counted only in grid_alloc/grid_bytes
+
+	container_stats::reset();
+
+	typedef aggregate<float,double> T;
+	size_t sz[3] = {8,8,8};
+	grid_cpu<3,T> g(sz);
+	g.setMemory();
+
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_GRID_ALLOC),1ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_GRID_BYTES),512*sizeof(T));
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_VECTOR_GROW),0ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_VECTOR_BYTES),0ul);
+}
+
+BOOST_AUTO_TEST_CASE( container_stats_mem_fast )
+{
+	Mem_fast<HeapMemory,size_t> mem(2);
+	mem.init_to_zero(2,4);
+
+	container_stats::reset();
+
+	// the third element does not fit in the 2 slots of the cell
+
+	mem.addCell(0,1);
+	mem.addCell(0,2);
+	mem.addCell(0,3);
+
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_MEM_FAST_REALLOC),1ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_MEM_FAST_BYTES),2*2*4*sizeof(size_t));
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_VECTOR_BYTES),0ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_GRID_BYTES),0ul);
+	BOOST_REQUIRE_EQUAL(mem.get(0,2),3ul);
+}
+
+BOOST_AUTO_TEST_CASE( container_stats_threads )
+{
+	container_stats::reset();
+
+	// every thread count in its own counters, they are summed when read
+
+	#pragma omp parallel for num_threads(4)
+	for (int i = 0 ; i < 4000 ; i++)
+	{
+		CONTAINER_STAT_INC(CSTAT_HASH_MAP_LOOKUP);
+		CONTAINER_STAT_ADD(CSTAT_GRID_BYTES,2);
+	}
+
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_HASH_MAP_LOOKUP),4000ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_GRID_BYTES),8000ul);
+
+	// the counters of a terminated thread are kept
+
+	std::thread th([]()
+	{
+		CONTAINER_STAT_INC(CSTAT_HASH_MAP_LOOKUP);
+		container_stats::add_time(CSTAT_TIME_PACK,1000);
+	});
+	th.join();
+
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_HASH_MAP_LOOKUP),4001ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get_calls(CSTAT_TIME_PACK),1ul);
+	BOOST_REQUIRE_CLOSE(container_stats::get_time(CSTAT_TIME_PACK),1e-6,1e-6);
+
+	container_stats::reset();
+
+	BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_HASH_MAP_LOOKUP),0ul);
+	BOOST_REQUIRE_EQUAL(container_stats::get_calls(CSTAT_TIME_PACK),0ul);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// initialization function:
+bool init_unit_test()
+{
+  return true;
+}
+
+// entry point:
+int main(int argc, char* argv[])
+{
+	return boost::unit_test::unit_test_main( &init_unit_test, argc, argv );
+}
@@ -22,6 +22,7 @@
 #include "util/mul_array_extents.hpp"
 #include "Packer_Unpacker/has_max_prop.hpp"
 #include "SparseGrid/SparseGrid.hpp"
+#include "util/performance/benchmark_harness.hpp"
 
 //! test type for has_max_prop
 struct test_has_max_prop
@@ -915,6 +916,118 @@ BOOST_AUTO_TEST_CASE( dyn_struct_check )
 	BOOST_REQUIRE_EQUAL(test,false);
 }
 
+BOOST_AUTO_TEST_CASE( container_stats_test )
+{
+	size_t sz[3] = {64,64,64};
+	sgrid_cpu<3,aggregate<float>,HeapMemory> sg(sz);
+
+	container_stats::reset();
+
+	sg.template insert<0>(grid_key_dx<3>({1,1,1})) = 1.0;
+	sg.template insert<0>(grid_key_dx<3>({2,1,1})) = 1.0;
+	sg.template get<0>(grid_key_dx<3>({40,40,40}));
+	sg.flush_remove();
+
+	std::stringstream out;
+	container_stats_write_json(out);
+
+	BOOST_REQUIRE(out.str().find("\"sgrid_cache_miss\": ") != std::string::npos);
+	BOOST_REQUIRE(out.str().find("\"reorder\": ") != std::string::npos);
+
+	// the values of the counters are checked in container_stats_unit_tests.cpp (always compiled with the statistics)
+	if (container_stats::enabled == false)
+	{
+		BOOST_REQUIRE_EQUAL(container_stats::get(CSTAT_SGRID_CACHE_MISS),0ul);
+		BOOST_REQUIRE(out.str().find("\"enabled\": false") != std::string::npos);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( benchmark_harness_csv_regression_test )
+{
+	std::vector<benchmark_result> res(2);
+
+	res[0].group = "vector";
+	res[0].name = "add";
+	res[0].n_rep = 10;
+	res[0].mean = 0.1;
+	res[0].dev = 0.005;
+	res[0].min = 0.09;
+	res[0].max = 0.11;
+	res[0].work = 4000000;
+	res[0].unit = "elements";
+
+	res[1].group = "grid";
+	res[1].name = "copy_box";
+	res[1].n_rep = 5;
+	res[1].mean = 0.008;
+	res[1].dev = 0.0;
+	res[1].min = 0.008;
+	res[1].max = 0.008;
+	res[1].work = 32006016;
+	res[1].unit = "B";
+
+	{
+		std::ofstream out("benchmark_harness_test.csv");
+		benchmark_write_csv(out,res);
+
+		// a truncated row is skipped
+		out << "vector,broken,10,0.1\n";
+	}
+
+	std::map<std::string,benchmark_result> base;
+	bool ret = benchmark_read_csv("benchmark_harness_test.csv",base);
+	std::remove("benchmark_harness_test.csv");
+
+	BOOST_REQUIRE_EQUAL(ret,true);
+	BOOST_REQUIRE_EQUAL(base.size(),2ul);
+	BOOST_REQUIRE(base.find("vector/broken") == base.end());
+
+	for (size_t i = 0 ; i < res.size() ; i++)
+	{
+		auto fnd = base.find(res[i].fullName());
+		BOOST_REQUIRE(fnd != base.end());
+
+		BOOST_REQUIRE_EQUAL(fnd->second.group,res[i].group);
+		BOOST_REQUIRE_EQUAL(fnd->second.name,res[i].name);
+		BOOST_REQUIRE_EQUAL(fnd->second.n_rep,res[i].n_rep);
+		BOOST_REQUIRE_CLOSE(fnd->second.mean,res[i].mean,1e-6);
+		BOOST_REQUIRE_CLOSE(fnd->second.min,res[i].min,1e-6);
+		BOOST_REQUIRE_CLOSE(fnd->second.max,res[i].max,1e-6);
+		BOOST_REQUIRE_CLOSE(fnd->second.work,res[i].work,1e-6);
+		BOOST_REQUIRE_EQUAL(fnd->second.unit,res[i].unit);
+	}
+
+	BOOST_REQUIRE_CLOSE(base["vector/add"].dev,0.005,1e-6);
+
+	// a missing baseline is an error
+	std::map<std::string,benchmark_result> none;
+	BOOST_REQUIRE_EQUAL(benchmark_read_csv("benchmark_harness_missing.csv",none),false);
+
+	benchmark_result b = res[0];
+	benchmark_result r = res[0];
+
+	// equal and faster are not a regression
+	BOOST_REQUIRE_EQUAL(benchmark_is_regression(r,b,0.1),false);
+	r.mean = 0.05;
+	BOOST_REQUIRE_EQUAL(benchmark_is_regression(r,b,0.1),false);
+
+	// slower but inside the tolerance
+	r.mean = 0.105;
+	BOOST_REQUIRE_EQUAL(benchmark_is_regression(r,b,0.1),false);
+
+	// slower than the tolerance and than the noise
+	r.mean = 0.13;
+	BOOST_REQUIRE_EQUAL(benchmark_is_regression(r,b,0.1),true);
+
+	// slower than the tolerance but inside two standard deviations
+	r.dev = 0.02;
+	BOOST_REQUIRE_EQUAL(benchmark_is_regression(r,b,0.1),false);
+
+	// a larger tolerance accept the slow-down
+	r.dev = 0.005;
+	BOOST_REQUIRE_EQUAL(benchmark_is_regression(r,b,0.5),false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* UTIL_TEST_HPP_ */